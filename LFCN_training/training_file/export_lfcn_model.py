@@ -0,0 +1,147 @@
+#!/usr/bin/env python
+# coding: utf-8
+
+# Exports trained LFCN split models to the model file read by the netTest encoder (--LFCNModelFile in HM,
+# --videoEncoderLFCNModelFile in TMC2), replacing the weight arrays printed by the training scripts.
+#
+# A model file holds any number of dense networks, each selected by slice type (P/I), video type
+# (geometry/attribute) and an inclusive QP range; the encoder takes the narrowest range covering the QP and
+# falls back to its compiled models when none matches.
+#
+#   # one set for all rates, from the folders written by py_LFCN_*.py
+#   python export_lfcn_model.py -o lfcn.model ../finally_weight_and_model/-10-5-
+#   # per-rate sets
+#   python export_lfcn_model.py -o lfcn.model low_rate_models:0-31 high_rate_models:32-51
+#
+# In a folder, Geo/Att and P/I come from the file names of py_LFCN_*.py (GeoPModule_model*.h5, ...).
+# Keras weight files do not record activations: by default the first hidden layer is relu and the other layers
+# sigmoid, as in py_LFCN_*.py; use --activations otherwise.
+
+import argparse
+import glob
+import os
+import struct
+
+import numpy as np
+
+MAGIC       = b"LFCNMODL"
+VERSION     = 1
+NUM_INPUT   = 3            # DV, CD, QP
+MAX_LAYERS  = 8
+MAX_WIDTH   = 64
+SLICE_TYPES = {"P": 1, "I": 2}
+VIDEO_TYPES = {"Geo": 0, "Att": 1}
+ACTIVATIONS = {"relu": 0, "sigmoid": 1, "linear": 2}
+MODULES     = [(video, slice_type) for video in ("Geo", "Att") for slice_type in ("P", "I")]
+
+
+def layers_from_h5(path):
+    """(kernel, bias) of the dense layers of a Keras weight file, kernel shaped (inputs, outputs)."""
+    import h5py
+    layers = []
+    with h5py.File(path, "r") as f:
+        group = f["model_weights"] if "model_weights" in f else f
+        for name in group.attrs["layer_names"]:
+            name = name.decode() if isinstance(name, bytes) else name
+            weight_names = [w.decode() if isinstance(w, bytes) else w for w in group[name].attrs["weight_names"]]
+            if not weight_names:
+                continue
+            kernel = [w for w in weight_names if "kernel" in w]
+            bias   = [w for w in weight_names if "bias" in w]
+            layers.append((np.array(group[name][kernel[0]]), np.array(group[name][bias[0]])))
+    return layers
+
+
+def layers_from_keras(model):
+    """(kernel, bias, activation) of the dense layers of a Keras model."""
+    layers = []
+    for layer in model.layers:
+        weights = layer.get_weights()
+        if len(weights) == 2:
+            layers.append((weights[0], weights[1], layer.activation.__name__))
+    return layers
+
+
+def default_activations(num_layers):
+    return ["relu"] + ["sigmoid"] * (num_layers - 1)
+
+
+def check_network(layers):
+    if not 1 <= len(layers) <= MAX_LAYERS:
+        raise ValueError("%d layers, between 1 and %d are supported" % (len(layers), MAX_LAYERS))
+    inputs = NUM_INPUT
+    for i, (kernel, bias, activation) in enumerate(layers):
+        outputs = 1 if i == len(layers) - 1 else kernel.shape[1]
+        if kernel.shape != (inputs, outputs) or bias.shape != (outputs,) or outputs > MAX_WIDTH:
+            raise ValueError("layer %d is %s, expected %d inputs and %s outputs"
+                             % (i, kernel.shape, inputs, "1" if outputs == 1 else "at most %d" % MAX_WIDTH))
+        if activation not in ACTIVATIONS:
+            raise ValueError("layer %d: unsupported activation %s" % (i, activation))
+        inputs = outputs
+
+
+def pack_network(slice_type, video_type, qp_range, layers):
+    """layers: (kernel (inputs, outputs), bias, activation) as in Keras."""
+    check_network(layers)
+    data = struct.pack("<iiiiI", SLICE_TYPES[slice_type], VIDEO_TYPES[video_type], qp_range[0], qp_range[1], len(layers))
+    for kernel, bias, activation in layers:
+        # the encoder stores the weights row-major [outputs][inputs]
+        data += struct.pack("<III", kernel.shape[0], kernel.shape[1], ACTIVATIONS[activation])
+        data += np.ascontiguousarray(kernel.T, dtype="<f4").tobytes()
+        data += np.ascontiguousarray(bias, dtype="<f4").tobytes()
+    return data
+
+
+def write_model_file(path, networks):
+    """networks: (slice type "P"/"I", video type "Geo"/"Att", (min QP, max QP), layers)."""
+    with open(path, "wb") as f:
+        f.write(MAGIC + struct.pack("<II", VERSION, len(networks)))
+        for network in networks:
+            f.write(pack_network(*network))
+
+
+def networks_from_folder(folder, qp_range, activations=None):
+    networks = []
+    for video_type, slice_type in MODULES:
+        files = sorted(glob.glob(os.path.join(folder, "%s%sModule_model*.h5" % (video_type, slice_type))))
+        if not files:
+            continue
+        weights = layers_from_h5(files[0])
+        names   = activations or default_activations(len(weights))
+        if len(names) != len(weights):
+            raise ValueError("%s has %d layers but %d activations are given" % (files[0], len(weights), len(names)))
+        layers = [(kernel, bias, name) for (kernel, bias), name in zip(weights, names)]
+        networks.append((slice_type, video_type, qp_range, layers))
+        print("%s: %s %s QP %d-%d, layers %s" % (files[0], slice_type, video_type, qp_range[0], qp_range[1],
+                                                 "-".join(str(k.shape[1]) for k, _, _ in layers)))
+    if not networks:
+        raise ValueError("no *Module_model*.h5 in " + folder)
+    return networks
+
+
+def parse_set(argument):
+    folder, _, qps = argument.partition(":")
+    if not qps:
+        return folder, (0, 51)
+    low, _, high = qps.partition("-")
+    return folder, (int(low), int(high or low))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Export trained LFCN split models to an encoder model file")
+    parser.add_argument("sets", nargs="+", help="model folder, optionally followed by :MINQP-MAXQP")
+    parser.add_argument("-o", "--output", required=True, help="model file to write")
+    parser.add_argument("--activations", help="comma-separated activation of each layer, e.g. relu,sigmoid,sigmoid")
+    args = parser.parse_args()
+
+    activations = args.activations.split(",") if args.activations else None
+    networks = []
+    for argument in args.sets:
+        folder, qp_range = parse_set(argument)
+        networks += networks_from_folder(folder, qp_range, activations)
+    write_model_file(args.output, networks)
+    print("%s: %d networks" % (args.output, len(networks)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,85 @@
+#!/usr/bin/env python
+# coding: utf-8
+
+# Reader of the binary CU feature datasets (.lfcn) written by the featuresExtracting encoder with
+# --extraFeaturesFormat=1. The records are memory-mapped, nothing is parsed row by row.
+#
+#   ds = open_dataset("oriP_extraFeatures_Geo_longdress_QP32.lfcn")
+#   ds["dv"], ds["split"], ds.qp, ds.sequence
+#   XY = load_xy(glob.glob("oriP_extraFeatures_Geo_*.lfcn"))   # same columns as oriP_extraFeatures_Geo.csv
+
+import struct
+import numpy as np
+
+MAGIC        = b"LFCNFEAT"
+VERSION      = 1
+FIXED_HEADER = 104
+COLUMN_ENTRY = 32
+VIDEO_TYPES  = {-1: "occupancy", 0: "geometry", 1: "attribute"}
+SLICE_TYPES  = {0: "B", 1: "P", 2: "I"}
+COLUMN_TYPES = {0: "<f2", 1: "u1"}
+
+# column order of the CSV files
+CSV_COLUMNS  = ["dv", "cbf", "cd", "qp", "category", "split", "npc", "pdm"]
+
+
+class Dataset(object):
+    def __init__(self, path, header, records):
+        self.path       = path
+        self.qp         = header["qp"]
+        self.video_type = VIDEO_TYPES.get(header["video_type"], header["video_type"])
+        self.slice_type = SLICE_TYPES.get(header["slice_type"], header["slice_type"])
+        self.sequence   = header["sequence"]
+        self.records    = records
+
+    def __len__(self):
+        return len(self.records)
+
+    def __getitem__(self, column):
+        return self.records[column]
+
+    @property
+    def columns(self):
+        return list(self.records.dtype.names)
+
+    def to_matrix(self, dtype=np.float32):
+        """Rows as a 2-D array with the columns of the CSV file, pdm expanded."""
+        parts = []
+        for name in self.columns:
+            values = np.asarray(self.records[name], dtype=dtype)
+            parts.append(values.reshape(len(self.records), -1))
+        return np.concatenate(parts, axis=1) if parts else np.empty((0, 0), dtype)
+
+
+def read_header(buffer):
+    if bytes(buffer[:8]) != MAGIC:
+        raise ValueError("not a CU feature dataset")
+    version, header_size, record_size, num_columns, qp, video_type, slice_type = struct.unpack_from("<IIIIiii", buffer, 8)
+    if version != VERSION:
+        raise ValueError("unsupported dataset version %d" % version)
+    sequence = bytes(buffer[40:104]).split(b"\0", 1)[0].decode("utf-8", "replace")
+    names, formats, offsets = [], [], []
+    for i in range(num_columns):
+        entry = FIXED_HEADER + COLUMN_ENTRY * i
+        name = bytes(buffer[entry:entry + 24]).split(b"\0", 1)[0].decode("ascii")
+        column_type, count, offset = struct.unpack_from("<B1xHI", buffer, entry + 24)
+        names.append(name)
+        formats.append(COLUMN_TYPES[column_type] if count == 1 else (COLUMN_TYPES[column_type], (count,)))
+        offsets.append(offset)
+    dtype = np.dtype({"names": names, "formats": formats, "offsets": offsets, "itemsize": record_size})
+    return {"header_size": header_size, "record_size": record_size, "qp": qp, "video_type": video_type,
+            "slice_type": slice_type, "sequence": sequence, "dtype": dtype}
+
+
+def open_dataset(path):
+    """Memory-maps one dataset file; a truncated last record is ignored."""
+    raw    = np.memmap(path, dtype=np.uint8, mode="r")
+    header = read_header(raw)
+    count  = (len(raw) - header["header_size"]) // header["record_size"]
+    records = np.memmap(path, dtype=header["dtype"], mode="r", offset=header["header_size"], shape=(count,))
+    return Dataset(path, header, records)
+
+
+def load_xy(paths, dtype=np.float32):
+    """Concatenates the rows of several datasets as a matrix laid out like the CSV files."""
+    return np.concatenate([open_dataset(path).to_matrix(dtype) for path in paths], axis=0)
@@ -41,6 +41,7 @@
 #include <stdio.h>
 #include <iomanip>
 #include <assert.h>
+#include <mutex>
 #include "TComDataCU.h"
 #include "Debug.h"
 namespace pcc_hm {
@@ -232,8 +233,65 @@ UChar g_getMsbP1Idx(UInt uiVal)
   return idx+g_ucMsbP1Idx[uiVal];
 }
 
+// The ROM tables are process-wide while several encoder instances may be alive at once (one per video of a
+// V-PCC group of frames), so they are reference counted: the first initROM() builds them, the last destroyROM()
+// frees them, and the CTU partition tables are only written by the first instance that needs them.
+static std::mutex s_romMutex;
+static UInt       s_romRefCount      = 0;
+static UInt       s_ctuTablesWidth   = 0;
+static UInt       s_ctuTablesHeight  = 0;
+static UInt       s_ctuTablesDepth   = 0;
+
+static Void xInitROM();
+static Void xDestroyROM();
+
 // initialize ROM variables
 Void initROM()
+{
+  std::lock_guard<std::mutex> lock( s_romMutex );
+  if ( s_romRefCount++ == 0 )
+  {
+    xInitROM();
+  }
+}
+
+Void destroyROM()
+{
+  std::lock_guard<std::mutex> lock( s_romMutex );
+  assert( s_romRefCount > 0 );
+  if ( --s_romRefCount == 0 )
+  {
+    xDestroyROM();
+    s_ctuTablesWidth  = 0;
+    s_ctuTablesHeight = 0;
+    s_ctuTablesDepth  = 0;
+  }
+}
+
+Void initCtuPartitionTables( UInt uiMaxCUWidth, UInt uiMaxCUHeight, UInt uiMaxDepth )
+{
+  std::lock_guard<std::mutex> lock( s_romMutex );
+  if ( s_ctuTablesDepth != 0 )
+  {
+    // tables are shared by every live coder instance, which therefore have to agree on the CTU geometry
+    assert( s_ctuTablesWidth == uiMaxCUWidth && s_ctuTablesHeight == uiMaxCUHeight && s_ctuTablesDepth == uiMaxDepth );
+    return;
+  }
+
+  // initialize partition order.
+  UInt* piTmp = &g_auiZscanToRaster[0];
+  initZscanToRaster( uiMaxDepth, 1, 0, piTmp );
+  initRasterToZscan( uiMaxCUWidth, uiMaxCUHeight, uiMaxDepth );
+
+  // initialize conversion matrix from partition index to pel
+  initRasterToPelXY( uiMaxCUWidth, uiMaxCUHeight, uiMaxDepth );
+
+  s_ctuTablesWidth  = uiMaxCUWidth;
+  s_ctuTablesHeight = uiMaxCUHeight;
+  s_ctuTablesDepth  = uiMaxDepth;
+}
+
+static Void xInitROM()
 {
   Int i, c;
 
@@ -318,7 +376,7 @@ Void initROM()
   g_initMsbP1IdxLut();
 }
 
-Void destroyROM()
+static Void xDestroyROM()
 {
   for(UInt groupTypeIndex = 0; groupTypeIndex < SCAN_NUMBER_OF_GROUP_TYPES; groupTypeIndex++)
   {
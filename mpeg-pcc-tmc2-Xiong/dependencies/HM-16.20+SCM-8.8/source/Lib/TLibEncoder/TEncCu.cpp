@@ -45,38 +45,19 @@
 #include <algorithm>
 
 #ifdef COMPARISON_OCCUPANCYGUID  // MesksCode
-extern unsigned char** occupancyData;
-extern int             occupancyHeight;
-extern int             occupancyWidth;
-extern bool            QPr5;
-extern int             OorGorA;
+#include "TEncOccupancySummary.h"
 
+extern thread_local pcc_hm::TEncOccupancySummary occupancySummary;
+extern thread_local int                          OorGorA;
+
+// =0 unoccupancy block, =1 boundary block, =2 fill block, in constant time from the occupancy summed-area tables.
 int CUClassify( int Width, int Height, int Y, int X, int nowPOC ) {
   if ( OorGorA == -1 ) return -1;
-  int numberOfOne = 0;  
-  int shrink      = 0;  
-  if ( QPr5 )
-    shrink = 2;
-  else
-    shrink = 4;
-
-  int oCUWidth  = Width / shrink;
-  int oCUHeight = Height / shrink;
-  int oCUY      = Y / shrink;
-  int oCUX      = X / shrink;
-
-  for ( int i = 0; i < oCUHeight; i++ )
-    for ( int j = 0; j < oCUWidth; j++ )
-      numberOfOne += ( occupancyData[nowPOC / 2][( oCUY + i ) * occupancyWidth + oCUX + j] - 0 );
-
-  // checkCUoinfo(oCUWidth, oCUHeight, oCUY, oCUX,nowPOC);
-
-  if ( numberOfOne == 0 )
-    return 0;  // unoccupancy block
-  else if ( numberOfOne == oCUWidth * oCUHeight )
-    return 2;  // fill block
-  else
-    return 1;  // boundary block
+  switch ( occupancySummary.getCategory( nowPOC / 2, X, Y, Width, Height ) ) {
+    case pcc_hm::OCCUPANCY_EMPTY: return 0;
+    case pcc_hm::OCCUPANCY_FULL: return 2;
+    default: return 1;
+  }
 }
 #endif  // MesksCode
 
@@ -147,13 +128,8 @@ Void TEncCu::create(UChar uhTotalDepth, UInt uiMaxWidth, UInt uiMaxHeight, Chrom
   m_cuChromaQpOffsetIdxPlus1       = 0;
   m_bFastDeltaQP                   = false;
 
-  // initialize partition order.
-  UInt* piTmp = &g_auiZscanToRaster[0];
-  initZscanToRaster( m_uhTotalDepth, 1, 0, piTmp);
-  initRasterToZscan( uiMaxWidth, uiMaxHeight, m_uhTotalDepth );
-
-  // initialize conversion matrix from partition index to pel
-  initRasterToPelXY( uiMaxWidth, uiMaxHeight, m_uhTotalDepth );
+  // initialize partition order and the conversion matrix from partition index to pel.
+  initCtuPartitionTables( uiMaxWidth, uiMaxHeight, m_uhTotalDepth );
 }
 
 Void TEncCu::destroy()
@@ -0,0 +1,131 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TEncOccupancySummary.cpp
+    \brief    summed-area tables of the V-PCC occupancy map for the CU level decisions
+*/
+
+#include "TEncOccupancySummary.h"
+
+namespace pcc_hm {
+
+//! \ingroup TLibEncoder
+//! \{
+
+TEncOccupancySummary::TEncOccupancySummary()
+: m_iWidth    ( 0 )
+, m_iHeight   ( 0 )
+, m_iPrecision( 1 )
+{
+}
+
+TEncOccupancySummary::~TEncOccupancySummary()
+{
+  destroy();
+}
+
+Void TEncOccupancySummary::create( const std::vector<const UChar*>& frames, Int iWidth, Int iHeight, Int iPrecision )
+{
+  destroy();
+  m_iWidth     = iWidth;
+  m_iHeight    = iHeight;
+  m_iPrecision = std::max( iPrecision, 1 );
+  m_frameSums.resize( frames.size() );
+
+  const Int iStride = iWidth + 1;
+  for ( size_t f = 0; f < frames.size(); f++ )
+  {
+    std::vector<UInt>& sums = m_frameSums[f];
+    sums.assign( iStride * ( iHeight + 1 ), 0 );
+
+    const UChar* pucOcc = frames[f];
+    for ( Int y = 0; y < iHeight; y++ )
+    {
+      UInt  uiRowSum = 0;
+      UInt* puiAbove = &sums[y * iStride + 1];
+      UInt* puiSum   = puiAbove + iStride;
+      for ( Int x = 0; x < iWidth; x++ )
+      {
+        uiRowSum  += pucOcc[x] != 0 ? 1 : 0;
+        puiSum[x]  = puiAbove[x] + uiRowSum;
+      }
+      pucOcc += iWidth;
+    }
+  }
+}
+
+Void TEncOccupancySummary::destroy()
+{
+  m_frameSums.clear();
+  m_iWidth     = 0;
+  m_iHeight    = 0;
+  m_iPrecision = 1;
+}
+
+UInt TEncOccupancySummary::getOccupiedCount( Int iFrame, Int x, Int y, Int iWidth, Int iHeight ) const
+{
+  assert( iFrame >= 0 && iFrame < getNumFrames() );
+  const Int iLeft   = Clip3( 0, m_iWidth,  x );
+  const Int iTop    = Clip3( 0, m_iHeight, y );
+  const Int iRight  = Clip3( 0, m_iWidth,  x + iWidth );
+  const Int iBottom = Clip3( 0, m_iHeight, y + iHeight );
+
+  const std::vector<UInt>& sums    = m_frameSums[iFrame];
+  const Int                iStride = m_iWidth + 1;
+  return sums[iBottom * iStride + iRight] - sums[iBottom * iStride + iLeft]
+       - sums[iTop    * iStride + iRight] + sums[iTop    * iStride + iLeft];
+}
+
+OccupancyCategory TEncOccupancySummary::getCategory( Int iFrame, Int iPelX, Int iPelY, Int iWidth, Int iHeight ) const
+{
+  const Int x       = iPelX / m_iPrecision;
+  const Int y       = iPelY / m_iPrecision;
+  const Int iOccW   = std::min( iWidth  / m_iPrecision, m_iWidth  - x );
+  const Int iOccH   = std::min( iHeight / m_iPrecision, m_iHeight - y );
+  if ( iOccW <= 0 || iOccH <= 0 )
+  {
+    return OCCUPANCY_EMPTY;   // outside of the occupancy map
+  }
+
+  const UInt uiCount = getOccupiedCount( iFrame, x, y, iOccW, iOccH );
+  if ( uiCount == 0 )
+  {
+    return OCCUPANCY_EMPTY;
+  }
+  return uiCount == UInt( iOccW * iOccH ) ? OCCUPANCY_FULL : OCCUPANCY_BOUNDARY;
+}
+
+//! \}
+
+} // namespace pcc_hm
@@ -4,18 +4,30 @@
 #include <fstream>
 #include <string>
 #include <map>
+#include <vector>
+#include "TEncOccupancySummary.h"
 using namespace std;
 
-unsigned char**     occupancyData;
-int                 occupancyHeight;
-int                 occupancyWidth;
-bool                QPr5;
-int                 OorGorA;
+// Occupancy map video of the current GOF as handed over by TMC2, the planes are not copied.
+struct OccupancyMapView {
+  vector<const unsigned char*> frames;         // luma plane of each occupancy frame, stride = width
+  int                          width     = 0;
+  int                          height    = 0;
+  int                          precision = 4;  // occupancy precision of the V-PCC encoder
+};
+
+// Per encoding thread: TMC2 may run the geometry and attribute video encodes concurrently, each HM run stays on
+// the thread that called occupancyDciInit().
+thread_local vector<const unsigned char*> occupancyData;
+thread_local int                          occupancyHeight;
+thread_local int                          occupancyWidth;
+thread_local pcc_hm::TEncOccupancySummary occupancySummary;
+thread_local int                          OorGorA;
 ofstream            extraFeatures;
 map<string, string> xyd_features;
 map<string, int>    frontModeFlag; 
 
-void occupancyDciInit(int height, int width, int frameNum, string occupancyName);
+void occupancyDciInit(const OccupancyMapView& occupancyView, string name);
 void checkData(int frameNum, int height, int width);
 
 #endif
\ No newline at end of file
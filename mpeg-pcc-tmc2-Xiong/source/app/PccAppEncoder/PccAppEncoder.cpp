@@ -591,6 +591,11 @@ bool parseParameters( int                   argc,
       encoderParams.nbThread_,
       encoderParams.nbThread_,
       "Number of thread used for parallel processing" )
+    ( "videoEncoderParallelSegments",
+      encoderParams.videoEncoderParallelSegments_,
+      encoderParams.videoEncoderParallelSegments_,
+      "Maximum number of closed intra period segments (all intra or IDR refresh) of a video encoded concurrently "
+      "by the HM library. 1: one sequence per video" )
     ( "keepIntermediateFiles",
       encoderParams.keepIntermediateFiles_,
       encoderParams.keepIntermediateFiles_,
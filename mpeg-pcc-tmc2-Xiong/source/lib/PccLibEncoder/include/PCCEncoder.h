@@ -37,6 +37,7 @@
 #include "PCCEncoderParameters.h"
 #include "PCCCodec.h"
 #include "PCCKdTree.h"
+#include <functional>
 #include <map>
 
 namespace pcc {
@@ -137,6 +138,8 @@ class PCCEncoder : public PCCCodec {
  private:
   template <typename T>
   T limit( T x, T minVal, T maxVal );
+  // video encodes that do not depend on each other; run concurrently on nbThread cores when TBB is enabled
+  void runVideoEncodeTasks( const std::vector<std::function<void()>>& tasks );
 
   //**occupancy map**//
   bool generateOccupancyMapVideo( const PCCGroupOfFrames& sources, PCCContext& context );
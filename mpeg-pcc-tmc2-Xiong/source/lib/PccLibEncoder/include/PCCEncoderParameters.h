@@ -72,6 +72,7 @@ class PCCEncoderParameters {
   std::string       colorSpaceConversionConfig_;
   std::string       inverseColorSpaceConversionConfig_;
   size_t            nbThread_;
+  size_t            videoEncoderParallelSegments_;
   size_t            frameCount_;
   size_t            groupOfFramesSize_;
   std::string       uncompressedDataPath_;
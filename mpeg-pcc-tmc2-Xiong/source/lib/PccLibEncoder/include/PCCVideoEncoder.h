@@ -83,9 +83,17 @@ class PCCVideoEncoder {
                  const bool         patchColorSubsampling             = false );
 
   void setLogger( PCCLogger& logger ) { logger_ = &logger; }
+  void setOccupancyMapVideo( const PCCVideo<uint8_t, 3>& video, const size_t occupancyPrecision ) {
+    occupancyMapVideo_  = &video;
+    occupancyPrecision_ = occupancyPrecision;
+  }
+  void setParallelSegments( const size_t parallelSegments ) { parallelSegments_ = parallelSegments; }
 
  private:
-  PCCLogger* logger_ = nullptr;
+  PCCLogger*                  logger_             = nullptr;
+  const PCCVideo<uint8_t, 3>* occupancyMapVideo_  = nullptr;
+  size_t                      occupancyPrecision_ = 4;
+  size_t                      parallelSegments_   = 1;
 };
 
 };  // namespace pcc
@@ -135,6 +135,7 @@ PCCEncoderParameters::PCCEncoderParameters() {
   geometryAuxVideoConfig_                  = {};
   attributeAuxVideoConfig_                 = {};
   nbThread_                                = 1;
+  videoEncoderParallelSegments_            = 1;
   keepIntermediateFiles_                   = false;
   absoluteD1_                              = false;
   absoluteT1_                              = false;
@@ -335,6 +336,7 @@ void PCCEncoderParameters::print() {
   std::cout << "\t groupOfFramesSize                          " << groupOfFramesSize_ << std::endl;
   std::cout << "\t colorTransform                             " << colorTransform_ << std::endl;
   std::cout << "\t nbThread                                   " << nbThread_ << std::endl;
+  std::cout << "\t videoEncoderParallelSegments               " << videoEncoderParallelSegments_ << std::endl;
   std::cout << "\t keepIntermediateFiles                      " << keepIntermediateFiles_ << std::endl;
   std::cout << "\t multipleStreams                            " << multipleStreams_ << std::endl;
   std::cout << "\t multipleStreams                            " << multipleStreams_ << std::endl;
@@ -379,6 +379,9 @@ bool PCCVideoEncoder::compress( PCCVideo<T, 3>&    video,
   params.shvcLayerIndex_              = shvcLayerIndex;
   params.shvcRateX_                   = shvcRateX;
   params.shvcRateY_                   = shvcRateY;
+  params.occupancyMapVideo_           = occupancyMapVideo_;
+  params.occupancyPrecision_          = occupancyPrecision_;
+  params.parallelSegments_            = parallelSegments_;
   printf( "Encode: video size = %zu x %zu num frames = %zu \n", video.getWidth(), video.getHeight(),
           video.getFrameCount() );
   fflush( stdout );
@@ -79,6 +79,14 @@ class PCCHMLibVideoEncoderImpl : public PCCHMLibVideoEncoderCfg {
                PCCVideoBitstream& bitstream,
 
                PCCVideo<T, 3>& videoRec );
+
+  // parses the HM command line, returns false on error; encode() then codes the video with this configuration
+  Bool configure( std::string arguments );
+  Void encode( PCCVideo<T, 3>& videoSrc, PCCVideoBitstream& bitstream, PCCVideo<T, 3>& videoRec );
+
+  // number of frames of the closed intra periods (all intra, or IDR refresh) that can be coded as separate
+  // sequences, 0 if the configuration does not allow it
+  Int getIndependentSegmentLength() const;
   // #if PCC_CF_EXT
   // void setLogger( PCCLogger& logger ) { logger_ = &logger; }
   // #endif
@@ -61,6 +61,11 @@ struct PCCVideoEncoderParameters {
   int32_t     shvcLayerIndex_              = 8;
   int32_t     shvcRateX_                   = 0;
   int32_t     shvcRateY_                   = 0;
+  // occupancy map video of the current GOF, shared with the encoder without going through intermediate files
+  const PCCVideo<uint8_t, 3>* occupancyMapVideo_  = nullptr;
+  size_t                      occupancyPrecision_ = 4;
+  // maximum number of independently decodable segments encoded concurrently, 1 encodes the video in one sequence
+  size_t                      parallelSegments_   = 1;
 };
 
 template <class T>
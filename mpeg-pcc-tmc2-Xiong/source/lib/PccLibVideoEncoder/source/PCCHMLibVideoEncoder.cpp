@@ -36,6 +36,10 @@
 #include "PCCVideo.h"
 #include "PCCHMLibVideoEncoder.h"
 #include "PCCHMLibVideoEncoderImpl.h"
+#include <memory>
+#if defined( ENABLE_TBB )
+#include <tbb/tbb.h>
+#endif
 
 #ifdef COMPARISON_OCCUPANCYGUID  // MesksCode
 #include "TLibEncoder/occGuid.h"
@@ -43,6 +47,18 @@
 #endif  // MesksCode
 using namespace pcc;
 
+// Length of the segments a video of frameCount frames is split into to be coded by up to workerCount HM
+// instances, 0 to code it as one sequence. Segments are made of whole independent periods and hold an even
+// number of frames, the two maps of a point cloud frame sharing one occupancy frame.
+static size_t getSegmentLength( const int independentLength, const size_t frameCount, const size_t workerCount ) {
+  if ( workerCount <= 1 || independentLength <= 0 ) { return 0; }
+  const size_t period = static_cast<size_t>( independentLength );
+  size_t       length = ( frameCount + workerCount - 1 ) / workerCount;
+  length              = ( ( length + period - 1 ) / period ) * period;
+  while ( length % 2 != 0 ) { length += period; }
+  return length < frameCount ? length : 0;
+}
+
 template <typename T>
 PCCHMLibVideoEncoder<T>::PCCHMLibVideoEncoder() {}
 template <typename T>
@@ -95,15 +111,73 @@ void PCCHMLibVideoEncoder<T>::encode( PCCVideo<T, 3>&            videoSrc,
 #endif
 
 #ifdef COMPARISON_OCCUPANCYGUID  // MesksCode
-  occupancyDciInit( videoSrc.getWidth(), videoSrc.getHeight(), videoSrc.getFrameCount(), params.srcYuvFileName_ );
+  OccupancyMapView occupancyView;
+  if ( params.occupancyMapVideo_ != nullptr ) {
+    const PCCVideo<uint8_t, 3>& occupancyMapVideo = *params.occupancyMapVideo_;
+    for ( size_t i = 0; i < occupancyMapVideo.getFrameCount(); i++ ) {
+      occupancyView.frames.push_back( occupancyMapVideo.getFrame( i ).getChannel( 0 ).data() );
+    }
+    occupancyView.width     = static_cast<int>( occupancyMapVideo.getWidth() );
+    occupancyView.height    = static_cast<int>( occupancyMapVideo.getHeight() );
+    occupancyView.precision = static_cast<int>( params.occupancyPrecision_ );
+  }
 #endif  // MesksCode
 
   if ( params.inputColourSpaceConvert_ ) { cmd << " --InputColourSpaceConvert=RGBtoGBR"; }
   std::cout << cmd.str() << std::endl;
 
   PCCHMLibVideoEncoderImpl<T> encoder;
-  clock_t                     startClock = clock();
-  encoder.encode( videoSrc, cmd.str(), bitstream, videoRec );
+  if ( !encoder.configure( cmd.str() ) ) { return; }
+  const size_t segmentLength =
+      getSegmentLength( encoder.getIndependentSegmentLength(), frameCount, params.parallelSegments_ );
+  clock_t startClock = clock();
+  if ( segmentLength == 0 ) {
+#ifdef COMPARISON_OCCUPANCYGUID  // MesksCode
+    occupancyDciInit( occupancyView, params.srcYuvFileName_ );
+#endif  // MesksCode
+    encoder.encode( videoSrc, bitstream, videoRec );
+  } else {
+    // Every segment is coded as its own sequence by its own HM instance, the access units and the
+    // reconstructed frames are then concatenated in segment order.
+    const size_t                   segmentCount = ( frameCount + segmentLength - 1 ) / segmentLength;
+    std::vector<PCCVideo<T, 3>>    segmentRec( segmentCount );
+    std::vector<PCCVideoBitstream> segmentBitstream( segmentCount, PCCVideoBitstream( bitstream.type() ) );
+    printf( "Encode %zu segments of %zu frames \n", segmentCount, segmentLength );
+    auto encodeSegment = [&]( const size_t s ) {
+      const size_t   start = s * segmentLength;
+      const size_t   count = ( std::min )( segmentLength, frameCount - start );
+      PCCVideo<T, 3> segmentSrc;
+      segmentSrc.getFrames().assign( videoSrc.getFrames().begin() + start,
+                                     videoSrc.getFrames().begin() + start + count );
+      std::unique_ptr<PCCHMLibVideoEncoderImpl<T>> segmentEncoder;
+      if ( s > 0 ) {
+        segmentEncoder.reset( new PCCHMLibVideoEncoderImpl<T>() );
+        segmentEncoder->configure( cmd.str() );
+      }
+      PCCHMLibVideoEncoderImpl<T>& impl = s > 0 ? *segmentEncoder : encoder;
+#ifdef COMPARISON_OCCUPANCYGUID  // MesksCode
+      // occupancy globals are thread_local, picture POC uses occupancy frame POC / 2
+      OccupancyMapView segmentView = occupancyView;
+      segmentView.frames.erase( segmentView.frames.begin(),
+                                segmentView.frames.begin() + ( std::min )( start / 2, segmentView.frames.size() ) );
+      occupancyDciInit( segmentView, params.srcYuvFileName_ );
+#endif  // MesksCode
+      impl.encode( segmentSrc, segmentBitstream[s], segmentRec[s] );
+    };
+#if defined( ENABLE_TBB )
+    tbb::task_arena limited( static_cast<int>( ( std::min )( params.parallelSegments_, segmentCount ) ) );
+    limited.execute( [&] { tbb::parallel_for( size_t( 0 ), segmentCount, encodeSegment ); } );
+#else
+    for ( size_t s = 0; s < segmentCount; s++ ) { encodeSegment( s ); }
+#endif
+    bitstream.vector().clear();
+    videoRec.clear();
+    for ( size_t s = 0; s < segmentCount; s++ ) {
+      bitstream.vector().insert( bitstream.vector().end(), segmentBitstream[s].vector().begin(),
+                                 segmentBitstream[s].vector().end() );
+      for ( auto& frame : segmentRec[s] ) { videoRec.getFrames().push_back( std::move( frame ) ); }
+    }
+  }
   clock_t endClock = clock();
   printf( "\nTotal Time: %12.3f sec. \n", ( endClock - startClock ) * 1.0 / CLOCKS_PER_SEC );
 }
@@ -58,8 +58,11 @@ Void PCCHMLibVideoEncoderImpl<T>::encode( PCCVideo<T, 3>&    videoSrc,
                                           std::string        arguments,
                                           PCCVideoBitstream& bitstream,
                                           PCCVideo<T, 3>&    videoRec ) {
-  std::ostringstream oss( ostringstream::binary | ostringstream::out );
-  std::ostream&      bitstreamFile = oss;
+  if ( configure( arguments ) ) { encode( videoSrc, bitstream, videoRec ); }
+}
+
+template <typename T>
+Bool PCCHMLibVideoEncoderImpl<T>::configure( std::string arguments ) {
   std::istringstream iss( arguments );
   std::string        token;
   std::vector<char*> args;
@@ -77,13 +80,36 @@ Void PCCHMLibVideoEncoderImpl<T>::encode( PCCVideo<T, 3>&    videoSrc,
 #if ENVIRONMENT_VARIABLE_DEBUG_AND_TEST
       EnvVar::printEnvVar();
 #endif
-      return;
+      return false;
     }
   } catch ( df::program_options_lite::ParseFailure& e ) {
     std::cerr << "Error parsing option \"" << e.arg << "\" with argument \"" << e.val << "\"." << std::endl;
-    return;
+    return false;
   }
   for ( size_t i = 0; i < args.size(); i++ ) { delete[] args[i]; }
+  return true;
+}
+
+template <typename T>
+Int PCCHMLibVideoEncoderImpl<T>::getIndependentSegmentLength() const {
+#if defined( PCC_ME_EXT ) && PCC_ME_EXT
+  // the PCC side information is indexed by POC, which restarts with every segment
+  if ( m_usePCCExt ) { return 0; }
+#endif
+#if defined( PCC_RDO_EXT ) && PCC_RDO_EXT
+  if ( m_usePCCRDO ) { return 0; }
+#endif
+  if ( m_iIntraPeriod == 1 ) { return 1; }
+  if ( m_iIntraPeriod > 1 && m_iDecodingRefreshType == 2 ) { return m_iIntraPeriod; }
+  return 0;
+}
+
+template <typename T>
+Void PCCHMLibVideoEncoderImpl<T>::encode( PCCVideo<T, 3>&    videoSrc,
+                                          PCCVideoBitstream& bitstream,
+                                          PCCVideo<T, 3>&    videoRec ) {
+  std::ostringstream oss( ostringstream::binary | ostringstream::out );
+  std::ostream&      bitstreamFile = oss;
   m_framesToBeEncoded     = std::min( m_framesToBeEncoded, (int)videoSrc.getFrameCount() );
   TComPicYuv* pcPicYuvOrg = new TComPicYuv;
   TComPicYuv* pcPicYuvRec = NULL;
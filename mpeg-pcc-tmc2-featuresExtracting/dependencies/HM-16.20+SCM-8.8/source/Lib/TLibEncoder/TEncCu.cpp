@@ -45,25 +45,26 @@
 #include <algorithm>
 
 #ifdef EXTRAFEATURES  // MesksCode
+#include "TEncFeatureSink.h"
+#include "TEncFeatureDataset.h"
+#include "TEncFeatureQuantizer.h"
+#include "TEncPatchSummary.h"
+
 extern unsigned char** occupancyData;
 extern int             occupancyHeight;
 extern int             occupancyWidth;
 extern bool            QPr5;
 
 
-extern ofstream            extraGeoMergeFeatures;
-extern ofstream            extraAttriMergeFeatures;
-extern ofstream            extraGeoInterFeatures;
-extern ofstream            extraAttriInterFeatures;
-extern map<string, string> xyd_GeoMergeFeatures;
-extern map<string, string> xyd_AttriMergeFeatures;
-extern map<string, string> xyd_GeoInterFeatures;
-extern map<string, string> xyd_AttriInterFeatures;
+extern pcc_hm::TEncFeatureSink extraGeoMergeFeatures;
+extern pcc_hm::TEncFeatureSink extraAttriMergeFeatures;
+extern pcc_hm::TEncFeatureSink extraGeoInterFeatures;
+extern pcc_hm::TEncFeatureSink extraAttriInterFeatures;
+extern pcc_hm::TEncFeatureDatasetWriter extraMergeDataset;
+extern pcc_hm::TEncFeatureDatasetWriter extraInterDataset;
+extern pcc_hm::TEncPatchSummary extraPatchSummary;
 extern int                 OorGorA;
 
-
-extern map<string, int>    frontModeFlag;
-
 // To classify the CU, input parameters are the current CU Width, Height, Y and Xcoordinates of the upper-left pixel,
 // and POC order.
 int CUClassify( int Width, int Height, int Y, int X, int nowPOC ) {
@@ -98,10 +99,8 @@ double cacAverage( int x_begin, int y_begin, int x_end, int y_end, int**& pixels
 
 // To calculate the Variance of the specified two-dimensional matrix.
 double cacVariance( int x_begin, int y_begin, int x_end, int y_end, int**& pixels, double average ) {
-  double sum              = 0;
-  int*   tmp_edge         = new int[y_end - y_begin];
-  int    tmp_edge_pointer = 0;
-  int    pixels_count     = 0;
+  double sum          = 0;
+  int    pixels_count = 0;
   for ( int y = y_begin; y < y_end; y++ ) {
     for ( int x = x_begin; x < x_end; x++ ) { sum += pow( pixels[y][x] - average, 2 ); }
   }
@@ -112,11 +111,7 @@ double cacVariance( int x_begin, int y_begin, int x_end, int y_end, int**& pixel
 
 // Preserves two decimal places for a number of type double.
 double twoDecimalDouble( const double& dbNum ) {
-  stringstream strCode;
-  strCode << std::setiosflags( std::ios::fixed ) << std::setprecision( 2 ) << dbNum;
-  double douCode;
-  strCode >> douCode;
-  return douCode;
+  return pcc_hm::TEncFeatureQuantizer::roundToHundredths( dbNum );
 }
 
 // Enable the following code when extracting the features of the T2 model.
@@ -364,6 +359,12 @@ Void TEncCu::create( UChar        uhTotalDepth,
 #endif
   }
 
+#ifdef EXTRAFEATURES  // MesksCode
+  // distortion tiles and pooled distortion maps of one CTU, enlarged on demand by the arena itself
+  m_cScratchArena.create( uiMaxWidth * uiMaxHeight * sizeof( Double ) * 4 );
+  m_cDecisionStore.create( uiMaxWidth, uhTotalDepth );
+#endif
+
   m_bEncodeDQP                    = false;
   m_stillToCodeChromaQpOffsetFlag = false;
   m_cuChromaQpOffsetIdxPlus1      = 0;
@@ -381,6 +382,12 @@ Void TEncCu::create( UChar        uhTotalDepth,
 Void TEncCu::destroy() {
   Int i;
 
+#ifdef EXTRAFEATURES  // MesksCode
+  m_cScratchArena.destroy();
+  m_cDecisionStore.destroy();
+  m_cSplitHistory.destroy();
+#endif
+
   for ( i = 0; i < m_uhTotalDepth - 1; i++ ) {
     if ( m_ppcBestCU[i] ) {
       m_ppcBestCU[i]->destroy();
@@ -506,6 +513,11 @@ Void TEncCu::init( TEncTop* pcEncTop ) {
   m_pcRateCtrl   = pcEncTop->getRateCtrl();
   m_lumaQPOffset = 0;
   initLumaDeltaQpLUT();
+
+#ifdef EXTRAFEATURES  // MesksCode
+  m_cSplitHistory.create( pcEncTop->getSourceWidth(), pcEncTop->getSourceHeight(), m_cDecisionStore.getMaxCUWidth(),
+                          m_cDecisionStore.getMaxDepth() );
+#endif
 }
 
 // ====================================================================================================================
@@ -532,6 +544,11 @@ Void TEncCu::compressCtu( TComDataCU* pCtu, UChar* lastPaletteSize, Pel lastPale
   // analysis of CU
   DEBUG_STRING_NEW( sDebug )
 
+#ifdef EXTRAFEATURES  // MesksCode
+  m_cScratchArena.reset();
+  m_cDecisionStore.initCtu( pCtu->getSlice()->getPOC(), pCtu->getCtuRsAddr(), pCtu->getCUPelX(), pCtu->getCUPelY(),
+                            &m_cSplitHistory );
+#endif
   xCompressCU( m_ppcBestCU[0], m_ppcTempCU[0], 0 DEBUG_STRING_PASS_INTO( sDebug ) );
   DEBUG_STRING_OUTPUT( std::cout, sDebug )
 
@@ -819,6 +836,7 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
   double noSplitRDCost  = 0;
   double splitRDCost    = 0;
   int    POC            = rpcBestCU->getSlice()->getPOC();
+  int    NPC            = 0;   // number of patches covered, the occupancy frame and the block to patch map go by POC / 2
   int    CUcate         = -1;  // =0 free block=1 fill block=2 boundary block
 
   bool M_lowVar  = false;
@@ -833,8 +851,12 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
 
   if ( OorGorA >= 0 ) 
     CUcate = CUClassify( uiWidth, uiWidth, uiTPelY, uiLPelX, POC );
+  if ( OorGorA >= 0 ) {
+    Bool bPatchPadding = false;
+    NPC = Int( extraPatchSummary.getPatchCount( POC / 2, uiLPelX, uiTPelY, uiWidth, uiWidth, bPatchPadding ) );
+  }
 #ifdef PRETRAIN
-  double* pdm = new double[256];
+  double* pdm = m_cScratchArena.alloc<double>( 256 );
 #endif
 #endif  // EXTRAFEATURES
 
@@ -1458,15 +1480,12 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
 
         int   cuHeight = rpcBestCU->getHeight( uiDepth );
         int   cuWidth  = rpcBestCU->getWidth( uiDepth );
-        int** pixels;
+        int** pixels  = m_cScratchArena.allocMatrix<int>( cuHeight, cuWidth );
         int   x_begin = 0;
         int   x_end   = cuWidth;
         int   y_begin = 0;
         int   y_end   = cuHeight;
 
-        pixels = new int*[cuHeight];
-        for ( int i = 0; i < cuHeight; i++ ) { pixels[i] = new int[cuWidth]; }
-
         // processing geometry and attribute separately
         if ( OorGorA == 0 ) {
           for ( int y = 0; y < cuHeight; y++ ) {
@@ -1554,24 +1573,13 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
         double statisticCUcate         = CUcate / 2.000;                              // CUC
         double statisticPredictionMode = rpcBestCU->getPredictionMode( 0 );
         // gain front mode
-        map<string, int>::iterator iter;
-        string                     frontKey;
-        double                     statisticFrontMode = -1;
+        double statisticFrontMode = -1;
         // =0 dont split, =1 further split, =-2 means error, =-1 means have not front mode
         if ( uiDepth == 0 )
           statisticFrontMode = -1;
         else {
-          int          nowX = int( uiLPelX / pow( 2, 6 - uiDepth + 1 ) ) * pow( 2, 6 - uiDepth + 1 );
-          int          nowY = int( uiTPelY / pow( 2, 6 - uiDepth + 1 ) ) * pow( 2, 6 - uiDepth + 1 );
-          stringstream ss_frontKey;
-          ss_frontKey << POC << "_" << nowX << "_" << nowY << "_" << uiDepth - 1;
-          ss_frontKey >> frontKey;
-          iter = frontModeFlag.find( frontKey );
-          if ( iter != frontModeFlag.end() )
-            statisticFrontMode = iter->second;
-          else {
-            statisticFrontMode = -2;
-          }
+          int frontSplit     = m_cDecisionStore.getSplit( uiDepth - 1, uiLPelX, uiTPelY );
+          statisticFrontMode = ( frontSplit == CU_SPLIT_UNKNOWN ) ? -2 : frontSplit;
         }
 
         // statisticFrontMode =
@@ -1579,39 +1587,14 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
         //        ? 0
         //        : ( ( statisticFrontMode == -1 ) ? 0.5 : ( ( statisticFrontMode == 1 ) ? 0.7 : 1 ) );  // FLM
 
-        stringstream ss_key, ss_value;
-        string       key, value;
-          ss_key << POC << "_" << uiLPelX << "_" << uiTPelY << "_" << uiDepth;
-          ss_key >> key;
-          ss_value << statisticVarMax << "," << statisticCBF << "," << statisticDepth << "," << statisticQP << ","
-                   << statisticCUcate << ",";
-          ss_value >> value;
-
-          ss_key << POC << "_" << uiLPelX << "_" << uiTPelY << "_" << uiDepth;
-          ss_key >> key;
-          ss_value << statisticVarMax << "," << statisticCBF << "," << statisticDepth << "," << statisticQP << ","
-                   << statisticCUcate << ",";
-          ss_value >> value;
-        
-        if ( OorGorA == 0 ) {
-          map<string, string>::iterator it;
-          it = xyd_GeoMergeFeatures.find( key );
-          if ( it != xyd_GeoMergeFeatures.end() ) {
-            xyd_GeoMergeFeatures.erase( it );
-            xyd_GeoMergeFeatures.insert( pair<string, string>( key, value ) );
-          } else {
-            xyd_GeoMergeFeatures.insert( pair<string, string>( key, value ) );
-          }
-        } else if ( OorGorA > 0 ) {
-          map<string, string>::iterator it;
-          it = xyd_AttriMergeFeatures.find( key );
-          if ( it != xyd_AttriMergeFeatures.end() ) {
-            xyd_AttriMergeFeatures.erase( it );
-            xyd_AttriMergeFeatures.insert( pair<string, string>( key, value ) );
-          } else {
-            xyd_AttriMergeFeatures.insert( pair<string, string>( key, value ) );
-          }
-        }
+        TEncCuFeatureRow featureRow;
+        featureRow.dVarMax     = statisticVarMax;
+        featureRow.iCBF        = statisticCBF;
+        featureRow.dDepth      = statisticDepth;
+        featureRow.dQP         = statisticQP;
+        featureRow.dCUCategory = statisticCUcate;
+        featureRow.iPatchCount = NPC;
+        m_cDecisionStore.setFeatures( uiDepth, uiLPelX, uiTPelY, featureRow );
       }
       if ( rpcBestCU->getSlice()->getSliceType() == I_SLICE ) {
         Pel* pReco = m_ppcRecoYuvBest[uiDepth]->getAddr( COMPONENT_Y );
@@ -1621,15 +1604,12 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
 
         int   cuHeight = rpcBestCU->getHeight( uiDepth );
         int   cuWidth  = rpcBestCU->getWidth( uiDepth );
-        int** pixels;
+        int** pixels  = m_cScratchArena.allocMatrix<int>( cuHeight, cuWidth );
         int   x_begin = 0;
         int   x_end   = cuWidth;
         int   y_begin = 0;
         int   y_end   = cuHeight;
 
-        pixels = new int*[cuHeight];
-        for ( int i = 0; i < cuHeight; i++ ) { pixels[i] = new int[cuWidth]; }
-
         // processing geometry and attribute separately
         if ( OorGorA == 0 ) {
           for ( int y = 0; y < cuHeight; y++ ) {
@@ -1718,24 +1698,13 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
         double statisticCUcate         = CUcate / 2.000;                              // CUC
         double statisticPredictionMode = rpcBestCU->getPredictionMode( 0 );
         // gain front mode
-        map<string, int>::iterator iter;
-        string                     frontKey;
-        double                     statisticFrontMode = -1;
+        double statisticFrontMode = -1;
         // =0 dont split, =1 further split, =-2 means error, =-1 means have not front mode
         if ( uiDepth == 0 )
           statisticFrontMode = -1;
         else {
-          int          nowX = int( uiLPelX / pow( 2, 6 - uiDepth + 1 ) ) * pow( 2, 6 - uiDepth + 1 );
-          int          nowY = int( uiTPelY / pow( 2, 6 - uiDepth + 1 ) ) * pow( 2, 6 - uiDepth + 1 );
-          stringstream ss_frontKey;
-          ss_frontKey << POC << "_" << nowX << "_" << nowY << "_" << uiDepth - 1;
-          ss_frontKey >> frontKey;
-          iter = frontModeFlag.find( frontKey );
-          if ( iter != frontModeFlag.end() )
-            statisticFrontMode = iter->second;
-          else {
-            statisticFrontMode = -2;
-          }
+          int frontSplit     = m_cDecisionStore.getSplit( uiDepth - 1, uiLPelX, uiTPelY );
+          statisticFrontMode = ( frontSplit == CU_SPLIT_UNKNOWN ) ? -2 : frontSplit;
         }
 
         // statisticFrontMode =
@@ -1743,32 +1712,14 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
         //        ? 0
         //        : ( ( statisticFrontMode == -1 ) ? 0.5 : ( ( statisticFrontMode == 1 ) ? 0.7 : 1 ) );  // FLM
 
-        stringstream ss_key, ss_value;
-        string       key, value;
-          ss_key << POC << "_" << uiLPelX << "_" << uiTPelY << "_" << uiDepth;
-          ss_key >> key;
-          ss_value << statisticVarMax << "," << statisticCBF << "," << statisticDepth << "," << statisticQP << ","
-                   << statisticCUcate << ",";
-          ss_value >> value;
-        if ( OorGorA == 0 ) {
-          map<string, string>::iterator it;
-          it = xyd_GeoInterFeatures.find( key );
-          if ( it != xyd_GeoInterFeatures.end() ) {
-            xyd_GeoInterFeatures.erase( it );
-            xyd_GeoInterFeatures.insert( pair<string, string>( key, value ) );
-          } else {
-            xyd_GeoInterFeatures.insert( pair<string, string>( key, value ) );
-          }
-        } else if ( OorGorA > 0 ) {
-          map<string, string>::iterator it;
-          it = xyd_AttriInterFeatures.find( key );
-          if ( it != xyd_AttriInterFeatures.end() ) {
-            xyd_AttriInterFeatures.erase( it );
-            xyd_AttriInterFeatures.insert( pair<string, string>( key, value ) );
-          } else {
-            xyd_AttriInterFeatures.insert( pair<string, string>( key, value ) );
-          }
-        }
+        TEncCuFeatureRow featureRow;
+        featureRow.dVarMax     = statisticVarMax;
+        featureRow.iCBF        = statisticCBF;
+        featureRow.dDepth      = statisticDepth;
+        featureRow.dQP         = statisticQP;
+        featureRow.dCUCategory = statisticCUcate;
+        featureRow.iPatchCount = NPC;
+        m_cDecisionStore.setFeatures( uiDepth, uiLPelX, uiTPelY, featureRow );
       }
   }
 #endif  // SPLITDECISION
@@ -1958,118 +1909,46 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
 #ifdef EXTRAFEATURES    // MesksCode
 #ifdef SPLITDECISION
   if ( bSubBranch && OorGorA >= 0 && uiDepth < sps.getLog2DiffMaxMinCodingBlockSize() ) {
-      if ( rpcBestCU->getSlice()->getSliceType() == P_SLICE ) { 
-        int splitResult = ( rpcBestCU->getDepth( 0 ) > uiDepth ) ? 1 : 0; 
-        splitRDCost = rpcBestCU->getTotalCost();
-    
-        stringstream ss_key;
-        string       key, value;
-        ss_key << POC << "_" << uiLPelX << "_" << uiTPelY << "_" << uiDepth;
-        ss_key >> key;
-        map<string, int>::iterator it;
-        it = frontModeFlag.find( key );
-        if ( it != frontModeFlag.end() ) {
-          frontModeFlag.erase( it );
-          frontModeFlag.insert( pair<string, int>( key, splitResult ) );
-        } else
-          frontModeFlag.insert( pair<string, int>( key, splitResult ) );
-
     #ifndef PRETRAIN
-        map<string, string>::iterator iter;
-        if ( OorGorA == 0 ) {
-          iter = xyd_GeoMergeFeatures.find( key );
-          if ( iter != xyd_GeoMergeFeatures.end() ) {
-            value = iter->second;
-            extraGeoMergeFeatures << value << splitResult << "\n";
-          }
-        } else if ( OorGorA > 0 ) {
-          iter = xyd_AttriMergeFeatures.find( key );
-          if ( iter != xyd_AttriMergeFeatures.end() ) {
-            value = iter->second;
-            extraAttriMergeFeatures << value << splitResult << "\n";
-          }
-        }
+      const double* pdmRow = NULL;
     #else
-        map<string, string>::iterator iter;
-        if ( OorGorA == 0 ) {
-          iter = xyd_GeoMergeFeatures.find( key );
-          if ( iter != xyd_GeoMergeFeatures.end() ) {
-            value = iter->second;
-            extraGeoMergeFeatures << value << splitResult << ",";
-          }
-        } else if ( OorGorA > 0 ) {
-          iter = xyd_AttriMergeFeatures.find( key );
-          if ( iter != xyd_AttriMergeFeatures.end() ) {
-            value = iter->second;
-            extraAttriMergeFeatures << value << splitResult << ",";
-          }
-        }
+      const double* pdmRow = pdm;
+    #endif  // !PRETRAIN
+      if ( rpcBestCU->getSlice()->getSliceType() == P_SLICE ) {
+        int splitResult = ( rpcBestCU->getDepth( 0 ) > uiDepth ) ? 1 : 0;
+        splitRDCost     = rpcBestCU->getTotalCost();
 
-        if ( OorGorA == 0 ) {
-          for ( int i = 0; i < 255; i++ ) extraGeoMergeFeatures << pdm[i] << ",";
-          extraGeoMergeFeatures << pdm[255] << "\n";
-        } else if ( OorGorA > 0 ) {
-          for ( int i = 0; i < 255; i++ ) extraAttriMergeFeatures << pdm[i] << ",";
-          extraAttriMergeFeatures << pdm[255] << "\n";
+        const TEncCuFeatureRow* featureRow = m_cDecisionStore.getFeatures( uiDepth, uiLPelX, uiTPelY );
+        TEncFeatureSink&        features   = ( OorGorA == 0 ) ? extraGeoMergeFeatures : extraAttriMergeFeatures;
+        if ( extraMergeDataset.isOpen() ) {
+          if ( featureRow != NULL ) extraMergeDataset.write( *featureRow, splitResult, pdmRow );
+        } else {
+    #ifndef PRETRAIN
+          if ( featureRow != NULL ) features << *featureRow << splitResult << "," << featureRow->iPatchCount << "\n";
+    #else
+          if ( featureRow != NULL ) features << *featureRow << splitResult << "," << featureRow->iPatchCount << ",";
+          for ( int i = 0; i < 255; i++ ) features << pdm[i] << ",";
+          features << pdm[255] << "\n";
+    #endif  // !PRETRAIN
         }
-    #endif
-      } 
+      }
       if ( rpcBestCU->getSlice()->getSliceType() == I_SLICE ) {
         int splitResult = ( rpcBestCU->getDepth( 0 ) > uiDepth ) ? 1 : 0;
         splitRDCost     = rpcBestCU->getTotalCost();
 
-        stringstream ss_key;
-        string       key, value;
-        ss_key << POC << "_" << uiLPelX << "_" << uiTPelY << "_" << uiDepth;
-        ss_key >> key;
-        map<string, int>::iterator it;
-        it = frontModeFlag.find( key );
-        if ( it != frontModeFlag.end() ) {
-          frontModeFlag.erase( it );
-          frontModeFlag.insert( pair<string, int>( key, splitResult ) );
-        } else
-          frontModeFlag.insert( pair<string, int>( key, splitResult ) );
-
+        const TEncCuFeatureRow* featureRow = m_cDecisionStore.getFeatures( uiDepth, uiLPelX, uiTPelY );
+        TEncFeatureSink&        features   = ( OorGorA == 0 ) ? extraGeoInterFeatures : extraAttriInterFeatures;
+        if ( extraInterDataset.isOpen() ) {
+          if ( featureRow != NULL ) extraInterDataset.write( *featureRow, splitResult, pdmRow );
+        } else {
     #ifndef PRETRAIN
-        map<string, string>::iterator iter;
-        if ( OorGorA == 0 ) {
-          iter = xyd_GeoInterFeatures.find( key );
-          if ( iter != xyd_GeoInterFeatures.end() ) {
-            value = iter->second;
-            extraGeoInterFeatures << value << splitResult << "\n";
-          }
-        } else if ( OorGorA > 0 ) {
-          iter = xyd_AttriInterFeatures.find( key );
-          if ( iter != xyd_AttriInterFeatures.end() ) {
-            value = iter->second;
-            extraAttriInterFeatures << value << splitResult << "\n";
-          }
-        }
+          if ( featureRow != NULL ) features << *featureRow << splitResult << "," << featureRow->iPatchCount << "\n";
     #else
-        map<string, string>::iterator iter;
-        if ( OorGorA == 0 ) {
-          iter = xyd_GeoInterFeatures.find( key );
-          if ( iter != xyd_GeoInterFeatures.end() ) {
-            value = iter->second;
-            extraGeoInterFeatures << value << splitResult << ",";
-          }
-        } else if ( OorGorA > 0 ) {
-          iter = xyd_AttriInterFeatures.find( key );
-          if ( iter != xyd_AttriInterFeatures.end() ) {
-            value = iter->second;
-            extraAttriInterFeatures << value << splitResult << ",";
-          }
-        }
-
-        if ( OorGorA == 0 ) {
-          for ( int i = 0; i < 255; i++ ) extraGeoInterFeatures << pdm[i] << ",";
-          extraGeoInterFeatures << pdm[255] << "\n";
-        } else if ( OorGorA > 0 ) {
-          for ( int i = 0; i < 255; i++ ) extraAttriInterFeatures << pdm[i] << ",";
-          extraAttriInterFeatures << pdm[255] << "\n";
-        }
-
+          if ( featureRow != NULL ) features << *featureRow << splitResult << "," << featureRow->iPatchCount << ",";
+          for ( int i = 0; i < 255; i++ ) features << pdm[i] << ",";
+          features << pdm[255] << "\n";
     #endif  // !PRETRAIN
+        }
       }
   }
 #endif
@@ -2078,6 +1957,9 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
 
   DEBUG_STRING_APPEND( sDebug_, sDebug );
 
+#ifdef EXTRAFEATURES  // MesksCode
+  m_cDecisionStore.setSplit( uiDepth, uiLPelX, uiTPelY, rpcBestCU->getDepth( 0 ) > uiDepth );
+#endif
   rpcBestCU->copyToPic( uiDepth );  // Copy Best data to Picture for next partition prediction.
 
   xCopyYuv2Pic( rpcBestCU->getPic(), rpcBestCU->getCtuRsAddr(), rpcBestCU->getZorderIdxInCtu(), uiDepth, uiDepth,
@@ -49,6 +49,10 @@
 #include "TEncEntropy.h"
 #include "TEncSearch.h"
 #include "TEncRateCtrl.h"
+#ifdef EXTRAFEATURES
+#include "TEncScratchArena.h"
+#include "TEncCuDecisionStore.h"
+#endif
 namespace pcc_hm {
 //! \ingroup TLibEncoder
 //! \{
@@ -83,6 +87,11 @@ private:
 #if PCC_RDO_EXT
   TComYuv**               m_ppcOccupancyYuv;
 #endif
+#ifdef EXTRAFEATURES
+  TEncScratchArena        m_cScratchArena;  ///< per-CTU scratch buffers of the feature extraction
+  TEncCuDecisionStore     m_cDecisionStore; ///< features and split decisions of the CUs of the current CTU
+  TEncCuSplitHistory      m_cSplitHistory;  ///< split decisions of the picture being compressed
+#endif
 
   //  Data : encoder control
   Bool                    m_bEncodeDQP;
@@ -0,0 +1,243 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TEncCuDecisionStore.cpp
+    \brief    split decisions and features of the CUs of a CTU, and split history of a picture
+*/
+
+#include "TEncCuDecisionStore.h"
+
+#include <algorithm>
+
+namespace pcc_hm {
+
+//! \ingroup TLibEncoder
+//! \{
+
+static const Int NO_POC = MAX_INT;
+
+static UInt xLog2( UInt uiSize )
+{
+  UInt uiLog2 = 0;
+  while ( ( 1u << uiLog2 ) < uiSize )
+  {
+    uiLog2++;
+  }
+  return uiLog2;
+}
+
+TEncCuSplitHistory::TEncCuSplitHistory()
+: m_uiLog2MaxCUSize( 0 )
+, m_uiMaxDepth     ( 0 )
+, m_uiNumEntries   ( 0 )
+, m_uiWidthInCtus  ( 0 )
+, m_uiHeightInCtus ( 0 )
+{
+}
+
+Void TEncCuSplitHistory::create( UInt uiPicWidth, UInt uiPicHeight, UInt uiMaxCUWidth, UInt uiMaxDepth )
+{
+  m_uiLog2MaxCUSize = xLog2( uiMaxCUWidth );
+  m_uiMaxDepth      = std::min( uiMaxDepth, m_uiLog2MaxCUSize );
+  m_uiNumEntries    = ( ( 1 << ( 2 * m_uiMaxDepth ) ) - 1 ) / 3;
+  m_uiWidthInCtus   = ( uiPicWidth  + uiMaxCUWidth - 1 ) / uiMaxCUWidth;
+  m_uiHeightInCtus  = ( uiPicHeight + uiMaxCUWidth - 1 ) / uiMaxCUWidth;
+  m_ctuPOC.assign( m_uiWidthInCtus * m_uiHeightInCtus, NO_POC );
+  m_splits.assign( m_uiWidthInCtus * m_uiHeightInCtus * m_uiNumEntries, SChar( CU_SPLIT_UNKNOWN ) );
+}
+
+Void TEncCuSplitHistory::destroy()
+{
+  m_ctuPOC.clear();
+  m_splits.clear();
+  m_uiWidthInCtus  = 0;
+  m_uiHeightInCtus = 0;
+}
+
+Void TEncCuSplitHistory::reset()
+{
+  std::fill( m_ctuPOC.begin(), m_ctuPOC.end(), NO_POC );
+}
+
+Void TEncCuSplitHistory::initCtu( Int iPOC, UInt uiCtuRsAddr )
+{
+  if ( uiCtuRsAddr >= m_ctuPOC.size() )
+  {
+    return;
+  }
+  m_ctuPOC[uiCtuRsAddr] = iPOC;
+  std::fill( m_splits.begin() + uiCtuRsAddr * m_uiNumEntries, m_splits.begin() + ( uiCtuRsAddr + 1 ) * m_uiNumEntries,
+             SChar( CU_SPLIT_UNKNOWN ) );
+}
+
+Void TEncCuSplitHistory::setSplit( UInt uiCtuRsAddr, UInt uiCuIndex, Int iSplit )
+{
+  if ( uiCtuRsAddr < m_ctuPOC.size() && uiCuIndex < m_uiNumEntries )
+  {
+    m_splits[uiCtuRsAddr * m_uiNumEntries + uiCuIndex] = SChar( iSplit );
+  }
+}
+
+Int TEncCuSplitHistory::getSplit( Int iPOC, UInt uiDepth, Int iPelX, Int iPelY ) const
+{
+  if ( iPelX < 0 || iPelY < 0 || uiDepth >= m_uiMaxDepth )
+  {
+    return CU_SPLIT_UNKNOWN;
+  }
+  const UInt uiCtuX = UInt( iPelX ) >> m_uiLog2MaxCUSize;
+  const UInt uiCtuY = UInt( iPelY ) >> m_uiLog2MaxCUSize;
+  if ( uiCtuX >= m_uiWidthInCtus || uiCtuY >= m_uiHeightInCtus )
+  {
+    return CU_SPLIT_UNKNOWN;
+  }
+  const UInt uiCtuRsAddr = uiCtuY * m_uiWidthInCtus + uiCtuX;
+  if ( m_ctuPOC[uiCtuRsAddr] != iPOC )
+  {
+    return CU_SPLIT_UNKNOWN;
+  }
+  return m_splits[uiCtuRsAddr * m_uiNumEntries + getCuIndex( m_uiLog2MaxCUSize, uiDepth, iPelX, iPelY )];
+}
+
+UInt TEncCuSplitHistory::getCuIndex( UInt uiLog2MaxCUSize, UInt uiDepth, UInt uiPelX, UInt uiPelY )
+{
+  const UInt uiLog2Size = uiLog2MaxCUSize - uiDepth;
+  const UInt uiMask     = ( 1 << uiLog2MaxCUSize ) - 1;
+  const UInt uiX        = ( uiPelX & uiMask ) >> uiLog2Size;
+  const UInt uiY        = ( uiPelY & uiMask ) >> uiLog2Size;
+
+  // interleave the bits of the column (even bits) and row (odd bits) of the CU
+  UInt uiZorder = 0;
+  for ( UInt uiBit = 0; uiBit < uiDepth; uiBit++ )
+  {
+    uiZorder |= ( ( uiX >> uiBit ) & 1 ) << ( 2 * uiBit );
+    uiZorder |= ( ( uiY >> uiBit ) & 1 ) << ( 2 * uiBit + 1 );
+  }
+  return ( ( 1 << ( 2 * uiDepth ) ) - 1 ) / 3 + uiZorder;
+}
+
+TEncCuDecisionStore::TEncCuDecisionStore()
+: m_uiLog2MaxCUSize( 0 )
+, m_uiMaxDepth     ( 0 )
+, m_iPOC           ( NO_POC )
+, m_uiCtuRsAddr    ( 0 )
+, m_uiCtuPelX      ( 0 )
+, m_uiCtuPelY      ( 0 )
+, m_pcHistory      ( NULL )
+{
+}
+
+Void TEncCuDecisionStore::create( UInt uiMaxCUWidth, UInt uiMaxDepth )
+{
+  m_uiLog2MaxCUSize = xLog2( uiMaxCUWidth );
+  m_uiMaxDepth      = std::min( uiMaxDepth, m_uiLog2MaxCUSize );
+  m_decisions.resize( ( ( 1 << ( 2 * m_uiMaxDepth ) ) - 1 ) / 3 );
+}
+
+Void TEncCuDecisionStore::destroy()
+{
+  m_decisions.clear();
+  m_pcHistory = NULL;
+}
+
+Void TEncCuDecisionStore::initCtu( Int iPOC, UInt uiCtuRsAddr, UInt uiCtuPelX, UInt uiCtuPelY, TEncCuSplitHistory* pcHistory )
+{
+  m_iPOC        = iPOC;
+  m_uiCtuRsAddr = uiCtuRsAddr;
+  m_uiCtuPelX   = uiCtuPelX;
+  m_uiCtuPelY   = uiCtuPelY;
+  m_pcHistory   = ( pcHistory != NULL && pcHistory->isCreated() ) ? pcHistory : NULL;
+
+  for ( size_t i = 0; i < m_decisions.size(); i++ )
+  {
+    m_decisions[i].bHasFeatures = false;
+    m_decisions[i].iSplit       = CU_SPLIT_UNKNOWN;
+  }
+  if ( m_pcHistory != NULL )
+  {
+    m_pcHistory->initCtu( iPOC, uiCtuRsAddr );
+  }
+}
+
+Void TEncCuDecisionStore::setFeatures( UInt uiDepth, UInt uiPelX, UInt uiPelY, const TEncCuFeatureRow& cFeatures )
+{
+  if ( !xIsInCtu( uiDepth, uiPelX, uiPelY ) )
+  {
+    return;
+  }
+  TEncCuDecision& rcDecision = m_decisions[TEncCuSplitHistory::getCuIndex( m_uiLog2MaxCUSize, uiDepth, uiPelX, uiPelY )];
+  rcDecision.bHasFeatures    = true;
+  rcDecision.cFeatures       = cFeatures;
+}
+
+const TEncCuFeatureRow* TEncCuDecisionStore::getFeatures( UInt uiDepth, UInt uiPelX, UInt uiPelY ) const
+{
+  if ( !xIsInCtu( uiDepth, uiPelX, uiPelY ) )
+  {
+    return NULL;
+  }
+  const TEncCuDecision& rcDecision = m_decisions[TEncCuSplitHistory::getCuIndex( m_uiLog2MaxCUSize, uiDepth, uiPelX, uiPelY )];
+  return rcDecision.bHasFeatures ? &rcDecision.cFeatures : NULL;
+}
+
+Void TEncCuDecisionStore::setSplit( UInt uiDepth, UInt uiPelX, UInt uiPelY, Bool bSplit )
+{
+  if ( !xIsInCtu( uiDepth, uiPelX, uiPelY ) )
+  {
+    return;
+  }
+  const UInt uiCuIndex          = TEncCuSplitHistory::getCuIndex( m_uiLog2MaxCUSize, uiDepth, uiPelX, uiPelY );
+  m_decisions[uiCuIndex].iSplit = bSplit ? 1 : 0;
+  if ( m_pcHistory != NULL )
+  {
+    m_pcHistory->setSplit( m_uiCtuRsAddr, uiCuIndex, bSplit ? 1 : 0 );
+  }
+}
+
+Int TEncCuDecisionStore::getSplit( UInt uiDepth, Int iPelX, Int iPelY ) const
+{
+  if ( xIsInCtu( uiDepth, iPelX, iPelY ) )
+  {
+    return m_decisions[TEncCuSplitHistory::getCuIndex( m_uiLog2MaxCUSize, uiDepth, iPelX, iPelY )].iSplit;
+  }
+  return m_pcHistory != NULL ? m_pcHistory->getSplit( m_iPOC, uiDepth, iPelX, iPelY ) : CU_SPLIT_UNKNOWN;
+}
+
+Bool TEncCuDecisionStore::xIsInCtu( UInt uiDepth, Int iPelX, Int iPelY ) const
+{
+  return uiDepth < m_uiMaxDepth && iPelX >= Int( m_uiCtuPelX ) && iPelY >= Int( m_uiCtuPelY ) &&
+         iPelX < Int( m_uiCtuPelX + getMaxCUWidth() ) && iPelY < Int( m_uiCtuPelY + getMaxCUWidth() );
+}
+
+//! \}
+
+} // namespace pcc_hm
@@ -0,0 +1,162 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TEncCuDecisionStore.h
+    \brief    split decisions and features of the CUs of a CTU, and split history of a picture (header)
+*/
+
+#ifndef __TENCCUDECISIONSTORE__
+#define __TENCCUDECISIONSTORE__
+
+#include <ostream>
+#include <vector>
+
+#include "TLibCommon/CommonDef.h"
+
+namespace pcc_hm {
+
+//! \ingroup TLibEncoder
+//! \{
+
+#define CU_SPLIT_UNKNOWN   -1   ///< split decision not taken yet, or CU outside of the picture
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// features of one CU as written to the training set, the split decision is appended to them
+struct TEncCuFeatureRow
+{
+  Double dVarMax;       ///< DV: maximum normalised distortion variance of the CU and its quadrants
+  Int    iCBF;          ///< CBF: root cbf of the best mode
+  Double dDepth;        ///< CD: normalised CU depth
+  Double dQP;           ///< QP: normalised QP
+  Double dCUCategory;   ///< CUC: occupancy category of the CU / 2
+  Int    iPatchCount;   ///< NPC: number of patches covered by the CU, 0 without block to patch map
+};
+
+/// CSV layout of a feature row: every value followed by a comma
+inline std::ostream& operator<<( std::ostream& os, const TEncCuFeatureRow& row )
+{
+  return os << row.dVarMax << "," << row.iCBF << "," << row.dDepth << "," << row.dQP << "," << row.dCUCategory << ",";
+}
+
+/// decision state of one CU of the current CTU
+struct TEncCuDecision
+{
+  Bool             bHasFeatures;
+  SChar            iSplit;      ///< 0 not split, 1 split, CU_SPLIT_UNKNOWN
+  TEncCuFeatureRow cFeatures;
+};
+
+/// split decisions of the CUs of a picture, one byte per CU and depth. The entries of a CTU are stamped with the POC
+/// they belong to, so that a CTU of the previous picture reads as unknown without clearing the whole picture. Each
+/// CTU is only written by the CU encoder compressing it.
+class TEncCuSplitHistory
+{
+private:
+  UInt               m_uiLog2MaxCUSize;
+  UInt               m_uiMaxDepth;      ///< number of recorded depths
+  UInt               m_uiNumEntries;    ///< CUs of all depths in one CTU
+  UInt               m_uiWidthInCtus;
+  UInt               m_uiHeightInCtus;
+  std::vector<Int>   m_ctuPOC;          ///< POC the entries of each CTU were written for
+  std::vector<SChar> m_splits;          ///< [ctuRsAddr * m_uiNumEntries + getCuIndex()]
+
+public:
+  TEncCuSplitHistory();
+  virtual ~TEncCuSplitHistory() {}
+
+  Void    create            ( UInt uiPicWidth, UInt uiPicHeight, UInt uiMaxCUWidth, UInt uiMaxDepth );
+  Void    destroy           ();
+  /// forgets every decision, e.g. when the POC numbering restarts
+  Void    reset             ();
+
+  /// clears the entries of a CTU before it is compressed for picture iPOC
+  Void    initCtu           ( Int iPOC, UInt uiCtuRsAddr );
+  Void    setSplit          ( UInt uiCtuRsAddr, UInt uiCuIndex, Int iSplit );
+  /// split decision of the CU of depth uiDepth covering the luma sample (iPelX, iPelY) of picture iPOC
+  Int     getSplit          ( Int iPOC, UInt uiDepth, Int iPelX, Int iPelY ) const;
+
+  Bool    isCreated         () const                  { return !m_splits.empty(); }
+  UInt    getNumEntries     () const                  { return m_uiNumEntries; }
+
+  /// position of the CU of depth uiDepth covering (uiPelX, uiPelY) in the per-CTU arrays: depths in increasing order,
+  /// z-scan order within a depth
+  static UInt getCuIndex    ( UInt uiLog2MaxCUSize, UInt uiDepth, UInt uiPelX, UInt uiPelY );
+};
+
+/// split decisions and feature rows of the CUs of the CTU being compressed, indexed by depth and z-order. The
+/// decisions are mirrored into an optional picture history for lookups of CUs in other CTUs.
+class TEncCuDecisionStore
+{
+private:
+  UInt                        m_uiLog2MaxCUSize;
+  UInt                        m_uiMaxDepth;
+  std::vector<TEncCuDecision> m_decisions;
+  Int                         m_iPOC;
+  UInt                        m_uiCtuRsAddr;
+  UInt                        m_uiCtuPelX;
+  UInt                        m_uiCtuPelY;
+  TEncCuSplitHistory*         m_pcHistory;
+
+public:
+  TEncCuDecisionStore();
+  virtual ~TEncCuDecisionStore() {}
+
+  Void    create            ( UInt uiMaxCUWidth, UInt uiMaxDepth );
+  Void    destroy           ();
+
+  /// forgets the decisions of the previous CTU, pcHistory may be NULL
+  Void    initCtu           ( Int iPOC, UInt uiCtuRsAddr, UInt uiCtuPelX, UInt uiCtuPelY, TEncCuSplitHistory* pcHistory );
+
+  Void    setFeatures       ( UInt uiDepth, UInt uiPelX, UInt uiPelY, const TEncCuFeatureRow& cFeatures );
+  /// feature row of the CU, NULL when none was recorded for this CTU
+  const TEncCuFeatureRow* getFeatures( UInt uiDepth, UInt uiPelX, UInt uiPelY ) const;
+
+  Void    setSplit          ( UInt uiDepth, UInt uiPelX, UInt uiPelY, Bool bSplit );
+  /// split decision of a CU of the current CTU, or of an earlier CTU of the picture when a history is attached
+  Int     getSplit          ( UInt uiDepth, Int iPelX, Int iPelY ) const;
+
+  UInt    getMaxCUWidth     () const                  { return 1 << m_uiLog2MaxCUSize; }
+  UInt    getMaxDepth       () const                  { return m_uiMaxDepth; }
+
+private:
+  Bool    xIsInCtu          ( UInt uiDepth, Int iPelX, Int iPelY ) const;
+};
+
+//! \}
+
+} // namespace pcc_hm
+
+#endif // __TENCCUDECISIONSTORE__
@@ -0,0 +1,507 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TEncFeatureDataset.cpp
+    \brief    fixed-record binary training set of the extracted CU features
+*/
+
+#include "TEncFeatureDataset.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <iostream>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace pcc_hm {
+
+//! \ingroup TLibEncoder
+//! \{
+
+static const TChar DATASET_MAGIC[8]        = { 'L', 'F', 'C', 'N', 'F', 'E', 'A', 'T' };
+static const UInt  DATASET_FIXED_HEADER    = 104;
+static const UInt  DATASET_COLUMN_ENTRY    = 32;
+static const UInt  DATASET_COLUMN_NAME     = 24;
+static const UInt  DATASET_SEQUENCE_NAME   = 64;
+static const UInt  DATASET_HEADER_ALIGN    = 64;
+
+static Void xPutU16( UChar* p, UInt uiValue )
+{
+  p[0] = (UChar)( uiValue       );
+  p[1] = (UChar)( uiValue >>  8 );
+}
+
+static Void xPutU32( UChar* p, UInt uiValue )
+{
+  p[0] = (UChar)( uiValue       );
+  p[1] = (UChar)( uiValue >>  8 );
+  p[2] = (UChar)( uiValue >> 16 );
+  p[3] = (UChar)( uiValue >> 24 );
+}
+
+static UInt xGetU16( const UChar* p )
+{
+  return (UInt)p[0] | ( (UInt)p[1] << 8 );
+}
+
+static UInt xGetU32( const UChar* p )
+{
+  return (UInt)p[0] | ( (UInt)p[1] << 8 ) | ( (UInt)p[2] << 16 ) | ( (UInt)p[3] << 24 );
+}
+
+static UInt xElementSize( FeatureColumnType eType )
+{
+  return ( eType == FEATURE_COLUMN_FLOAT16 ) ? 2 : 1;
+}
+
+// ====================================================================================================================
+// TEncFeatureDatasetInfo
+// ====================================================================================================================
+
+TEncFeatureDatasetInfo::TEncFeatureDatasetInfo()
+: m_iQP          ( 0 )
+, m_iVideoType   ( 0 )
+, m_iSliceType   ( P_SLICE )
+, m_uiRecordSize ( 0 )
+{
+}
+
+Void TEncFeatureDatasetInfo::initFeatureColumns( Int iQP, Int iVideoType, Int iSliceType, const std::string& sequence, Bool bPdm )
+{
+  m_iQP        = iQP;
+  m_iVideoType = iVideoType;
+  m_iSliceType = iSliceType;
+  m_sequence   = sequence;
+
+  clearColumns();
+  addColumn( "dv",       FEATURE_COLUMN_FLOAT16 );
+  addColumn( "cbf",      FEATURE_COLUMN_UINT8   );
+  addColumn( "cd",       FEATURE_COLUMN_FLOAT16 );
+  addColumn( "qp",       FEATURE_COLUMN_FLOAT16 );
+  addColumn( "category", FEATURE_COLUMN_FLOAT16 );
+  addColumn( "split",    FEATURE_COLUMN_UINT8   );
+  addColumn( "npc",      FEATURE_COLUMN_UINT8   );
+  if( bPdm )
+  {
+    addColumn( "pdm", FEATURE_COLUMN_FLOAT16, FEATURE_DATASET_PDM_SIZE );
+  }
+}
+
+Void TEncFeatureDatasetInfo::addColumn( const std::string& name, FeatureColumnType eType, UInt uiCount )
+{
+  TEncFeatureColumn column;
+  column.name     = name.substr( 0, DATASET_COLUMN_NAME - 1 );
+  column.eType    = eType;
+  column.uiCount  = uiCount;
+  column.uiOffset = m_uiRecordSize;
+  m_cColumns.push_back( column );
+  m_uiRecordSize += uiCount * xElementSize( eType );
+}
+
+Void TEncFeatureDatasetInfo::clearColumns()
+{
+  m_cColumns.clear();
+  m_uiRecordSize = 0;
+}
+
+Int TEncFeatureDatasetInfo::findColumn( const std::string& name ) const
+{
+  for( UInt i = 0; i < (UInt)m_cColumns.size(); i++ )
+  {
+    if( m_cColumns[i].name == name )
+    {
+      return (Int)i;
+    }
+  }
+  return -1;
+}
+
+UInt TEncFeatureDatasetInfo::getHeaderSize() const
+{
+  const UInt uiSize = DATASET_FIXED_HEADER + DATASET_COLUMN_ENTRY * (UInt)m_cColumns.size();
+  return ( uiSize + DATASET_HEADER_ALIGN - 1 ) / DATASET_HEADER_ALIGN * DATASET_HEADER_ALIGN;
+}
+
+Void TEncFeatureDatasetInfo::serialize( std::vector<UChar>& rcHeader ) const
+{
+  rcHeader.assign( getHeaderSize(), 0 );
+  UChar* p = &rcHeader[0];
+
+  memcpy( p, DATASET_MAGIC, sizeof( DATASET_MAGIC ) );
+  xPutU32( p +  8, FEATURE_DATASET_VERSION );
+  xPutU32( p + 12, getHeaderSize() );
+  xPutU32( p + 16, m_uiRecordSize );
+  xPutU32( p + 20, (UInt)m_cColumns.size() );
+  xPutU32( p + 24, (UInt)m_iQP );
+  xPutU32( p + 28, (UInt)m_iVideoType );
+  xPutU32( p + 32, (UInt)m_iSliceType );
+  memcpy( p + 40, m_sequence.c_str(), std::min<size_t>( m_sequence.size(), DATASET_SEQUENCE_NAME - 1 ) );
+
+  for( UInt i = 0; i < (UInt)m_cColumns.size(); i++ )
+  {
+    UChar*                   pEntry = p + DATASET_FIXED_HEADER + DATASET_COLUMN_ENTRY * i;
+    const TEncFeatureColumn& column = m_cColumns[i];
+    memcpy( pEntry, column.name.c_str(), column.name.size() );
+    pEntry[24] = (UChar)column.eType;
+    xPutU16( pEntry + 26, column.uiCount );
+    xPutU32( pEntry + 28, column.uiOffset );
+  }
+}
+
+Bool TEncFeatureDatasetInfo::deserialize( const UChar* pHeader, UInt64 uiSize )
+{
+  if( uiSize < DATASET_FIXED_HEADER || memcmp( pHeader, DATASET_MAGIC, sizeof( DATASET_MAGIC ) ) != 0 ||
+      xGetU32( pHeader + 8 ) != FEATURE_DATASET_VERSION )
+  {
+    return false;
+  }
+
+  const UInt uiHeaderSize = xGetU32( pHeader + 12 );
+  const UInt uiNumColumns = xGetU32( pHeader + 20 );
+  if( uiHeaderSize > uiSize || DATASET_FIXED_HEADER + (UInt64)DATASET_COLUMN_ENTRY * uiNumColumns > uiHeaderSize )
+  {
+    return false;
+  }
+
+  m_iQP        = (Int)xGetU32( pHeader + 24 );
+  m_iVideoType = (Int)xGetU32( pHeader + 28 );
+  m_iSliceType = (Int)xGetU32( pHeader + 32 );
+  const TChar* pSequence = (const TChar*)( pHeader + 40 );
+  m_sequence.assign( pSequence, strnlen( pSequence, DATASET_SEQUENCE_NAME ) );
+
+  clearColumns();
+  for( UInt i = 0; i < uiNumColumns; i++ )
+  {
+    const UChar* pEntry = pHeader + DATASET_FIXED_HEADER + DATASET_COLUMN_ENTRY * i;
+    const TChar* pName  = (const TChar*)pEntry;
+    if( pEntry[24] > FEATURE_COLUMN_UINT8 )
+    {
+      return false;
+    }
+    addColumn( std::string( pName, strnlen( pName, DATASET_COLUMN_NAME ) ), (FeatureColumnType)pEntry[24], xGetU16( pEntry + 26 ) );
+    if( m_cColumns.back().uiOffset != xGetU32( pEntry + 28 ) )
+    {
+      return false;
+    }
+  }
+  return m_uiRecordSize == xGetU32( pHeader + 16 ) && m_uiRecordSize > 0 && getHeaderSize() == uiHeaderSize;
+}
+
+/// IEEE half precision, rounded to nearest with ties to even as numpy does
+UShort TEncFeatureDatasetInfo::floatToHalf( Float fValue )
+{
+  UInt uiBits;
+  memcpy( &uiBits, &fValue, sizeof( uiBits ) );
+
+  const UInt uiSign     = ( uiBits >> 16 ) & 0x8000;
+  const Int  iExponent  = (Int)( ( uiBits >> 23 ) & 0xff );
+  UInt       uiMantissa = uiBits & 0x7fffff;
+
+  if( iExponent == 0xff )
+  {
+    return (UShort)( uiSign | 0x7c00 | ( uiMantissa ? 0x200 : 0 ) );
+  }
+
+  const Int iHalfExponent = iExponent - 127 + 15;
+  if( iHalfExponent >= 0x1f )
+  {
+    return (UShort)( uiSign | 0x7c00 );
+  }
+
+  UInt uiHalf;
+  UInt uiRemainder;
+  UInt uiMidpoint;
+  if( iHalfExponent <= 0 )
+  {
+    // subnormal half
+    if( iHalfExponent < -10 )
+    {
+      return (UShort)uiSign;
+    }
+    uiMantissa       |= 0x800000;
+    const UInt uiShift = (UInt)( 14 - iHalfExponent );
+    uiHalf      = uiMantissa >> uiShift;
+    uiRemainder = uiMantissa & ( ( 1u << uiShift ) - 1 );
+    uiMidpoint  = 1u << ( uiShift - 1 );
+  }
+  else
+  {
+    uiHalf      = ( (UInt)iHalfExponent << 10 ) | ( uiMantissa >> 13 );
+    uiRemainder = uiMantissa & 0x1fff;
+    uiMidpoint  = 0x1000;
+  }
+
+  // a carry out of the mantissa correctly moves to the next exponent, or to infinity
+  if( uiRemainder > uiMidpoint || ( uiRemainder == uiMidpoint && ( uiHalf & 1 ) ) )
+  {
+    uiHalf++;
+  }
+  return (UShort)( uiSign | uiHalf );
+}
+
+Float TEncFeatureDatasetInfo::halfToFloat( UShort uiHalf )
+{
+  const UInt uiSign     = ( (UInt)uiHalf & 0x8000 ) << 16;
+  const UInt uiExponent = ( uiHalf >> 10 ) & 0x1f;
+  const UInt uiMantissa = uiHalf & 0x3ff;
+
+  UInt uiBits;
+  if( uiExponent == 0 )
+  {
+    const Float fValue = ldexpf( (Float)uiMantissa, -24 );
+    return uiSign ? -fValue : fValue;
+  }
+  else if( uiExponent == 0x1f )
+  {
+    uiBits = uiSign | 0x7f800000 | ( uiMantissa << 13 );
+  }
+  else
+  {
+    uiBits = uiSign | ( ( uiExponent - 15 + 127 ) << 23 ) | ( uiMantissa << 13 );
+  }
+
+  Float fValue;
+  memcpy( &fValue, &uiBits, sizeof( fValue ) );
+  return fValue;
+}
+
+// ====================================================================================================================
+// TEncFeatureDatasetWriter
+// ====================================================================================================================
+
+TEncFeatureDatasetWriter::TEncFeatureDatasetWriter()
+: m_iPdmColumn ( -1 )
+{
+}
+
+TEncFeatureDatasetWriter::~TEncFeatureDatasetWriter()
+{
+  close();
+}
+
+Bool TEncFeatureDatasetWriter::open( const std::string& fileName, const TEncFeatureDatasetInfo& info )
+{
+  close();
+  m_cInfo      = info;
+  m_iPdmColumn = m_cInfo.findColumn( "pdm" );
+  m_cRecord.assign( m_cInfo.getRecordSize(), 0 );
+
+  std::vector<UChar> cHeader;
+  m_cInfo.serialize( cHeader );
+
+  // append only to a file with the same header and whole records
+  Bool  bAppend = false;
+  FILE* pFile   = fopen( fileName.c_str(), "rb" );
+  if( pFile != NULL )
+  {
+    std::vector<UChar> cExisting( cHeader.size() );
+    const Bool bSameHeader = fread( &cExisting[0], 1, cExisting.size(), pFile ) == cExisting.size() && cExisting == cHeader;
+    fseek( pFile, 0, SEEK_END );
+    const long lSize = ftell( pFile );
+    fclose( pFile );
+
+    if( bSameHeader && ( lSize - (long)cHeader.size() ) % m_cInfo.getRecordSize() == 0 )
+    {
+      bAppend = true;
+    }
+    else
+    {
+      std::cerr << "Warning: the features dataset " << fileName << " has another schema or a truncated record, it is rewritten" << std::endl;
+    }
+  }
+
+  if( !m_cSink.open( fileName, bAppend ) )
+  {
+    return false;
+  }
+  if( !bAppend )
+  {
+    m_cSink.write( (const TChar*)&cHeader[0], (std::streamsize)cHeader.size() );
+  }
+  return true;
+}
+
+Bool TEncFeatureDatasetWriter::close()
+{
+  return m_cSink.isOpen() ? m_cSink.close() : true;
+}
+
+Void TEncFeatureDatasetWriter::xPutColumn( UInt uiColumn, UInt uiElement, Double dValue )
+{
+  const TEncFeatureColumn& column = m_cInfo.getColumn( uiColumn );
+  if( column.eType == FEATURE_COLUMN_FLOAT16 )
+  {
+    xPutU16( &m_cRecord[column.uiOffset + 2 * uiElement], TEncFeatureDatasetInfo::floatToHalf( (Float)dValue ) );
+  }
+  else
+  {
+    m_cRecord[column.uiOffset + uiElement] = (UChar)Clip3<Int>( 0, 255, (Int)dValue );
+  }
+}
+
+Void TEncFeatureDatasetWriter::write( const TEncCuFeatureRow& row, Int iSplit, const Double* pdm )
+{
+  xPutColumn( 0, 0, row.dVarMax     );
+  xPutColumn( 1, 0, row.iCBF        );
+  xPutColumn( 2, 0, row.dDepth      );
+  xPutColumn( 3, 0, row.dQP         );
+  xPutColumn( 4, 0, row.dCUCategory );
+  xPutColumn( 5, 0, iSplit          );
+  xPutColumn( 6, 0, row.iPatchCount );
+  if( m_iPdmColumn >= 0 && pdm != NULL )
+  {
+    for( UInt i = 0; i < FEATURE_DATASET_PDM_SIZE; i++ )
+    {
+      xPutColumn( m_iPdmColumn, i, pdm[i] );
+    }
+  }
+  writeRecord( &m_cRecord[0] );
+}
+
+Void TEncFeatureDatasetWriter::writeRecord( const UChar* pRecord )
+{
+  m_cSink.write( (const TChar*)pRecord, (std::streamsize)m_cInfo.getRecordSize() );
+}
+
+// ====================================================================================================================
+// TEncFeatureDatasetReader
+// ====================================================================================================================
+
+TEncFeatureDatasetReader::TEncFeatureDatasetReader()
+: m_pData        ( NULL )
+, m_uiSize       ( 0 )
+, m_uiNumRecords ( 0 )
+#if !defined(_WIN32)
+, m_pMapping     ( NULL )
+#endif
+{
+}
+
+TEncFeatureDatasetReader::~TEncFeatureDatasetReader()
+{
+  close();
+}
+
+Bool TEncFeatureDatasetReader::open( const std::string& fileName )
+{
+  close();
+
+#if !defined(_WIN32)
+  const Int iFile = ::open( fileName.c_str(), O_RDONLY );
+  if( iFile < 0 )
+  {
+    return false;
+  }
+  struct stat cStat;
+  if( fstat( iFile, &cStat ) == 0 && cStat.st_size > 0 )
+  {
+    Void* pMapping = mmap( NULL, (size_t)cStat.st_size, PROT_READ, MAP_SHARED, iFile, 0 );
+    if( pMapping != MAP_FAILED )
+    {
+      m_pMapping = pMapping;
+      m_pData    = (const UChar*)pMapping;
+      m_uiSize   = (UInt64)cStat.st_size;
+    }
+  }
+  ::close( iFile );
+#else
+  FILE* pFile = fopen( fileName.c_str(), "rb" );
+  if( pFile == NULL )
+  {
+    return false;
+  }
+  fseek( pFile, 0, SEEK_END );
+  const long lSize = ftell( pFile );
+  fseek( pFile, 0, SEEK_SET );
+  if( lSize > 0 )
+  {
+    m_cFallback.resize( (size_t)lSize );
+    if( fread( &m_cFallback[0], 1, m_cFallback.size(), pFile ) == m_cFallback.size() )
+    {
+      m_pData  = &m_cFallback[0];
+      m_uiSize = m_cFallback.size();
+    }
+  }
+  fclose( pFile );
+#endif
+
+  if( m_pData == NULL || !m_cInfo.deserialize( m_pData, m_uiSize ) )
+  {
+    close();
+    return false;
+  }
+  m_uiNumRecords = ( m_uiSize - m_cInfo.getHeaderSize() ) / m_cInfo.getRecordSize();
+  return true;
+}
+
+Void TEncFeatureDatasetReader::close()
+{
+#if !defined(_WIN32)
+  if( m_pMapping != NULL )
+  {
+    munmap( m_pMapping, (size_t)m_uiSize );
+    m_pMapping = NULL;
+  }
+#endif
+  std::vector<UChar>().swap( m_cFallback );
+  m_pData        = NULL;
+  m_uiSize       = 0;
+  m_uiNumRecords = 0;
+}
+
+const UChar* TEncFeatureDatasetReader::getRecord( UInt64 uiRecord ) const
+{
+  return m_pData + m_cInfo.getHeaderSize() + uiRecord * m_cInfo.getRecordSize();
+}
+
+Double TEncFeatureDatasetReader::getValue( UInt64 uiRecord, UInt uiColumn, UInt uiElement ) const
+{
+  const TEncFeatureColumn& column = m_cInfo.getColumn( uiColumn );
+  const UChar*             p      = getRecord( uiRecord ) + column.uiOffset;
+  if( column.eType == FEATURE_COLUMN_FLOAT16 )
+  {
+    return TEncFeatureDatasetInfo::halfToFloat( (UShort)xGetU16( p + 2 * uiElement ) );
+  }
+  return p[uiElement];
+}
+
+//! \}
+
+} // namespace pcc_hm
@@ -0,0 +1,202 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TEncFeatureDataset.h
+    \brief    fixed-record binary training set of the extracted CU features (header)
+
+    File layout, all values little-endian:
+      offset   0  char[8]   magic "LFCNFEAT"
+      offset   8  UInt32    format version
+      offset  12  UInt32    header size; the records start there, it is a multiple of 64
+      offset  16  UInt32    record size
+      offset  20  UInt32    number of columns
+      offset  24  Int32     QP of the video
+      offset  28  Int32     video type: -1 occupancy, 0 geometry, 1 attribute
+      offset  32  Int32     slice type of the rows (SliceType)
+      offset  36  UInt32    reserved, 0
+      offset  40  char[64]  sequence name, zero padded
+      offset 104  column table, one 32-byte entry per column:
+                    char[24] name, UInt8 type (0 float16, 1 uint8), UInt8 0, UInt16 element count, UInt32 offset in the record
+    The records follow the header back to back; their number is ( file size - header size ) / record size, so an
+    interrupted run leaves a readable file and later videos with the same header simply append records.
+*/
+
+#ifndef __TENCFEATUREDATASET__
+#define __TENCFEATUREDATASET__
+
+#include <string>
+#include <vector>
+
+#include "TLibCommon/CommonDef.h"
+#include "TEncCuDecisionStore.h"
+#include "TEncFeatureSink.h"
+
+namespace pcc_hm {
+
+//! \ingroup TLibEncoder
+//! \{
+
+#define FEATURE_DATASET_VERSION       1
+#define FEATURE_DATASET_PDM_SIZE      256   ///< number of pooled distortion values of a row in PRETRAIN mode
+
+// ====================================================================================================================
+// Enumeration
+// ====================================================================================================================
+
+/// storage type of a dataset column
+enum FeatureColumnType
+{
+  FEATURE_COLUMN_FLOAT16 = 0,
+  FEATURE_COLUMN_UINT8   = 1
+};
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// one column of the record, an array when uiCount > 1
+struct TEncFeatureColumn
+{
+  std::string       name;
+  FeatureColumnType eType;
+  UInt              uiCount;
+  UInt              uiOffset;
+};
+
+/// schema and provenance of a dataset file
+class TEncFeatureDatasetInfo
+{
+private:
+  Int                            m_iQP;
+  Int                            m_iVideoType;
+  Int                            m_iSliceType;
+  std::string                    m_sequence;
+  std::vector<TEncFeatureColumn> m_cColumns;
+  UInt                           m_uiRecordSize;
+
+public:
+  TEncFeatureDatasetInfo();
+
+  /// columns of the extracted features in the CSV order: DV, CBF, CD, QP, category, split, NPC and, if bPdm, the pdm array
+  Void    initFeatureColumns  ( Int iQP, Int iVideoType, Int iSliceType, const std::string& sequence, Bool bPdm );
+  Void    addColumn           ( const std::string& name, FeatureColumnType eType, UInt uiCount = 1 );
+  Void    clearColumns        ();
+
+  Int     getQP               () const                { return m_iQP;            }
+  Int     getVideoType        () const                { return m_iVideoType;     }
+  Int     getSliceType        () const                { return m_iSliceType;     }
+  const std::string& getSequence() const              { return m_sequence;       }
+  UInt    getNumColumns       () const                { return (UInt)m_cColumns.size(); }
+  const TEncFeatureColumn& getColumn( UInt uiIdx ) const { return m_cColumns[uiIdx]; }
+  /// index of the column called name, -1 if there is none
+  Int     findColumn          ( const std::string& name ) const;
+  UInt    getRecordSize       () const                { return m_uiRecordSize;   }
+  UInt    getHeaderSize       () const;
+
+  Void    setQP               ( Int iQP )             { m_iQP = iQP;             }
+  Void    setVideoType        ( Int iVideoType )      { m_iVideoType = iVideoType; }
+  Void    setSliceType        ( Int iSliceType )      { m_iSliceType = iSliceType; }
+  Void    setSequence         ( const std::string& sequence ) { m_sequence = sequence; }
+
+  /// file header as written to disk
+  Void    serialize           ( std::vector<UChar>& rcHeader ) const;
+  /// parses a file header, false if it is not a dataset header of a supported version
+  Bool    deserialize         ( const UChar* pHeader, UInt64 uiSize );
+
+  static UShort floatToHalf   ( Float fValue );
+  static Float  halfToFloat   ( UShort uiHalf );
+};
+
+/// streaming writer of one dataset file, backed by a TEncFeatureSink
+class TEncFeatureDatasetWriter
+{
+private:
+  TEncFeatureSink        m_cSink;
+  TEncFeatureDatasetInfo m_cInfo;
+  std::vector<UChar>     m_cRecord;
+  Int                    m_iPdmColumn;
+
+public:
+  TEncFeatureDatasetWriter();
+  virtual ~TEncFeatureDatasetWriter();
+
+  /// opens fileName for info; records are appended when the file already holds the same header, otherwise it is
+  /// rewritten
+  Bool    open                ( const std::string& fileName, const TEncFeatureDatasetInfo& info );
+  Bool    close               ();
+  Bool    isOpen              () const                { return m_cSink.isOpen(); }
+  const TEncFeatureDatasetInfo& getInfo() const       { return m_cInfo;          }
+
+  /// appends one row of the feature columns; pdm holds FEATURE_DATASET_PDM_SIZE values when the schema has a pdm
+  /// column, and is ignored otherwise
+  Void    write               ( const TEncCuFeatureRow& row, Int iSplit, const Double* pdm = NULL );
+  /// appends one raw record of getInfo().getRecordSize() bytes
+  Void    writeRecord         ( const UChar* pRecord );
+
+private:
+  Void    xPutColumn          ( UInt uiColumn, UInt uiElement, Double dValue );
+};
+
+/// read-only, memory-mapped view of a dataset file
+class TEncFeatureDatasetReader
+{
+private:
+  TEncFeatureDatasetInfo m_cInfo;
+  const UChar*           m_pData;
+  UInt64                 m_uiSize;
+  UInt64                 m_uiNumRecords;
+  std::vector<UChar>     m_cFallback;   ///< file contents where mapping is not available
+#if !defined(_WIN32)
+  Void*                  m_pMapping;
+#endif
+
+public:
+  TEncFeatureDatasetReader();
+  virtual ~TEncFeatureDatasetReader();
+
+  Bool    open                ( const std::string& fileName );
+  Void    close               ();
+  Bool    isOpen              () const                { return m_pData != NULL;  }
+
+  const TEncFeatureDatasetInfo& getInfo() const       { return m_cInfo;          }
+  UInt64  getNumRecords       () const                { return m_uiNumRecords;   }
+  const UChar* getRecord      ( UInt64 uiRecord ) const;
+  /// element uiElement of column uiColumn of a record, converted to Double
+  Double  getValue            ( UInt64 uiRecord, UInt uiColumn, UInt uiElement = 0 ) const;
+};
+
+//! \}
+
+} // namespace pcc_hm
+
+#endif // __TENCFEATUREDATASET__
@@ -0,0 +1,222 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TEncFeatureSink.cpp
+    \brief    buffered output stream of the extracted CU features
+*/
+
+#include "TEncFeatureSink.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace pcc_hm {
+
+//! \ingroup TLibEncoder
+//! \{
+
+TEncFeatureSinkBuf::TEncFeatureSinkBuf()
+: m_pFile       ( NULL )
+, m_uiBufferSize( 0 )
+, m_bStop       ( false )
+, m_bWriteError ( false )
+{
+}
+
+TEncFeatureSinkBuf::~TEncFeatureSinkBuf()
+{
+  close();
+}
+
+Bool TEncFeatureSinkBuf::open( const std::string& fileName, Bool bAppend, UInt uiBufferSize )
+{
+  close();
+  m_pFile = fopen( fileName.c_str(), bAppend ? "ab" : "wb" );
+  if ( m_pFile == NULL )
+  {
+    return false;
+  }
+  m_fileName     = fileName;
+  m_uiBufferSize = std::max<UInt>( uiBufferSize, 1 );
+  m_bStop        = false;
+  m_bWriteError  = false;
+  m_cFillBuffer.resize( m_uiBufferSize );
+  setp( &m_cFillBuffer[0], &m_cFillBuffer[0] + m_uiBufferSize );
+  m_cWriter = std::thread( &TEncFeatureSinkBuf::xWriterLoop, this );
+  return true;
+}
+
+Bool TEncFeatureSinkBuf::close()
+{
+  if ( m_pFile == NULL )
+  {
+    return true;
+  }
+  xSubmit();
+  {
+    std::lock_guard<std::mutex> lock( m_cMutex );
+    m_bStop = true;
+  }
+  m_cWork.notify_one();
+  m_cWriter.join();
+
+  if ( fclose( m_pFile ) != 0 )
+  {
+    m_bWriteError = true;
+  }
+  m_pFile = NULL;
+  setp( NULL, NULL );
+  m_cFillBuffer.clear();
+  m_cSpare.clear();
+  if ( m_bWriteError )
+  {
+    std::cerr << "Warning: failed to write the features to " << m_fileName << std::endl;
+  }
+  return !m_bWriteError;
+}
+
+TEncFeatureSinkBuf::int_type TEncFeatureSinkBuf::overflow( int_type c )
+{
+  if ( m_pFile == NULL )
+  {
+    return traits_type::eof();
+  }
+  xSubmit();
+  if ( !traits_type::eq_int_type( c, traits_type::eof() ) )
+  {
+    *pptr() = traits_type::to_char_type( c );
+    pbump( 1 );
+  }
+  return traits_type::not_eof( c );
+}
+
+int TEncFeatureSinkBuf::sync()
+{
+  if ( m_pFile == NULL )
+  {
+    return -1;
+  }
+  xSubmit();
+  return 0;
+}
+
+Void TEncFeatureSinkBuf::xSubmit()
+{
+  const size_t uiUsed = pptr() - pbase();
+  if ( uiUsed == 0 )
+  {
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock( m_cMutex );
+  // keep the memory bounded when the encoder produces faster than the disk takes
+  m_cDrained.wait( lock, [this] { return m_cPending.size() < FEATURE_SINK_MAX_PENDING; } );
+
+  m_cFillBuffer.resize( uiUsed );
+  m_cPending.push_back( std::move( m_cFillBuffer ) );
+  if ( m_cSpare.empty() )
+  {
+    m_cFillBuffer = std::vector<TChar>();
+  }
+  else
+  {
+    m_cFillBuffer = std::move( m_cSpare.back() );
+    m_cSpare.pop_back();
+  }
+  lock.unlock();
+  m_cWork.notify_one();
+
+  m_cFillBuffer.resize( m_uiBufferSize );
+  setp( &m_cFillBuffer[0], &m_cFillBuffer[0] + m_uiBufferSize );
+}
+
+Void TEncFeatureSinkBuf::xWriterLoop()
+{
+  std::unique_lock<std::mutex> lock( m_cMutex );
+  while ( true )
+  {
+    m_cWork.wait( lock, [this] { return m_bStop || !m_cPending.empty(); } );
+    if ( m_cPending.empty() )
+    {
+      break;
+    }
+    std::vector<TChar> cBuffer = std::move( m_cPending.front() );
+    m_cPending.pop_front();
+    lock.unlock();
+
+    if ( fwrite( &cBuffer[0], 1, cBuffer.size(), m_pFile ) != cBuffer.size() )
+    {
+      m_bWriteError = true;
+    }
+
+    lock.lock();
+    m_cSpare.push_back( std::move( cBuffer ) );
+    m_cDrained.notify_one();
+  }
+}
+
+TEncFeatureSink::TEncFeatureSink()
+: std::ostream( NULL )
+{
+  rdbuf( &m_cBuffer );
+}
+
+TEncFeatureSink::~TEncFeatureSink()
+{
+  close();
+}
+
+Bool TEncFeatureSink::open( const std::string& fileName, Bool bAppend, UInt uiBufferSize )
+{
+  clear();
+  if ( !m_cBuffer.open( fileName, bAppend, uiBufferSize ) )
+  {
+    setstate( std::ios_base::failbit );
+    return false;
+  }
+  return true;
+}
+
+Bool TEncFeatureSink::close()
+{
+  const Bool bOk = m_cBuffer.close();
+  if ( !bOk )
+  {
+    setstate( std::ios_base::badbit );
+  }
+  return bOk;
+}
+
+//! \}
+
+} // namespace pcc_hm
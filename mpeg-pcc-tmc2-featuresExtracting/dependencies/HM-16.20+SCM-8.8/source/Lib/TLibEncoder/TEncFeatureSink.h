@@ -0,0 +1,123 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TEncFeatureSink.h
+    \brief    buffered output stream of the extracted CU features (header)
+*/
+
+#ifndef __TENCFEATURESINK__
+#define __TENCFEATURESINK__
+
+#include <cstdio>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "TLibCommon/CommonDef.h"
+
+namespace pcc_hm {
+
+//! \ingroup TLibEncoder
+//! \{
+
+#define FEATURE_SINK_BUFFER_SIZE   ( 1 << 22 )   ///< size of one write buffer, in bytes
+#define FEATURE_SINK_MAX_PENDING   4             ///< full buffers queued for the writer before the encoder waits
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// stream buffer that hands full buffers to a background thread, which appends them to the file
+class TEncFeatureSinkBuf : public std::streambuf
+{
+private:
+  FILE*                            m_pFile;
+  std::string                      m_fileName;
+  UInt                             m_uiBufferSize;
+  std::vector<TChar>               m_cFillBuffer;    ///< buffer currently written by the encoder
+  std::deque<std::vector<TChar> >  m_cPending;       ///< full buffers waiting for the writer, in output order
+  std::vector<std::vector<TChar> > m_cSpare;         ///< buffers given back by the writer
+  std::thread                      m_cWriter;
+  std::mutex                       m_cMutex;
+  std::condition_variable          m_cWork;          ///< signalled when a buffer is queued or on close()
+  std::condition_variable          m_cDrained;       ///< signalled when the writer has taken a buffer
+  Bool                             m_bStop;
+  Bool                             m_bWriteError;
+
+public:
+  TEncFeatureSinkBuf();
+  virtual ~TEncFeatureSinkBuf();
+
+  Bool    open              ( const std::string& fileName, Bool bAppend, UInt uiBufferSize );
+  /// queues what is left in the fill buffer, waits for the writer and closes the file
+  Bool    close             ();
+  Bool    isOpen            () const                  { return m_pFile != NULL; }
+  const std::string& getFileName() const              { return m_fileName; }
+
+protected:
+  virtual int_type overflow ( int_type c );
+  /// queues the fill buffer without waiting for it to be written
+  virtual int      sync     ();
+
+private:
+  Void    xSubmit           ();
+  Void    xWriterLoop       ();
+};
+
+/// output stream of one feature CSV file. Opened once per encoded video, formatted with the usual ostream operators;
+/// the file is written by a background thread in blocks of FEATURE_SINK_BUFFER_SIZE bytes.
+class TEncFeatureSink : public std::ostream
+{
+private:
+  TEncFeatureSinkBuf m_cBuffer;
+
+public:
+  TEncFeatureSink();
+  virtual ~TEncFeatureSink();
+
+  Bool    open              ( const std::string& fileName, Bool bAppend = true, UInt uiBufferSize = FEATURE_SINK_BUFFER_SIZE );
+  Bool    close             ();
+  Bool    isOpen            () const                  { return m_cBuffer.isOpen(); }
+  const std::string& getFileName() const              { return m_cBuffer.getFileName(); }
+};
+
+//! \}
+
+} // namespace pcc_hm
+
+#endif // __TENCFEATURESINK__
@@ -0,0 +1,156 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TEncPatchSummary.cpp
+    \brief    block to patch map of the V-PCC atlas frames for the CU level decisions
+*/
+
+#include <algorithm>
+
+#include "TEncPatchSummary.h"
+
+namespace pcc_hm {
+
+//! \ingroup TLibEncoder
+//! \{
+
+TEncPatchSummary::TEncPatchSummary()
+: m_iWidth    ( 0 )
+, m_iHeight   ( 0 )
+, m_iBlockSize( 16 )
+{
+}
+
+Void TEncPatchSummary::create( const std::vector<const size_t*>& frames, Int iWidth, Int iHeight, Int iBlockSize )
+{
+  destroy();
+  if ( frames.empty() || iWidth <= 0 || iHeight <= 0 || iBlockSize <= 0 )
+  {
+    return;
+  }
+  m_iWidth     = iWidth;
+  m_iHeight    = iHeight;
+  m_iBlockSize = iBlockSize;
+  m_frames.resize( frames.size() );
+  for ( size_t i = 0; i < frames.size(); i++ )
+  {
+    m_frames[i].assign( frames[i], frames[i] + size_t( iWidth ) * iHeight );
+  }
+}
+
+Void TEncPatchSummary::destroy()
+{
+  m_frames.clear();
+  m_iWidth  = 0;
+  m_iHeight = 0;
+}
+
+Bool TEncPatchSummary::xGetBlocks( Int iPelX, Int iPelY, Int iWidth, Int iHeight, Int& riX0, Int& riY0, Int& riX1, Int& riY1 ) const
+{
+  riX0 = std::max( iPelX, 0 ) / m_iBlockSize;
+  riY0 = std::max( iPelY, 0 ) / m_iBlockSize;
+  riX1 = std::min( ( iPelX + iWidth  - 1 ) / m_iBlockSize, m_iWidth  - 1 );
+  riY1 = std::min( ( iPelY + iHeight - 1 ) / m_iBlockSize, m_iHeight - 1 );
+  return riX0 <= riX1 && riY0 <= riY1;
+}
+
+UInt TEncPatchSummary::getPatchCount( Int iFrame, Int iPelX, Int iPelY, Int iWidth, Int iHeight, Bool& rbPadding ) const
+{
+  rbPadding = false;
+  Int iX0, iY0, iX1, iY1;
+  if ( iFrame < 0 || iFrame >= getNumFrames() || !xGetBlocks( iPelX, iPelY, iWidth, iHeight, iX0, iY0, iX1, iY1 ) )
+  {
+    return 0;
+  }
+  // a CU covers a few blocks, a linear search of the patches seen so far is enough
+  const std::vector<Int>& rcFrame = m_frames[iFrame];
+  std::vector<Int>        patches;
+  for ( Int iY = iY0; iY <= iY1; iY++ )
+  {
+    for ( Int iX = iX0; iX <= iX1; iX++ )
+    {
+      const Int iPatch = rcFrame[iY * m_iWidth + iX];
+      if ( iPatch == 0 )
+      {
+        rbPadding = true;
+      }
+      else if ( std::find( patches.begin(), patches.end(), iPatch ) == patches.end() )
+      {
+        patches.push_back( iPatch );
+      }
+    }
+  }
+  return UInt( patches.size() );
+}
+
+PatchAreaCategory TEncPatchSummary::getCategory( Int iFrame, Int iPelX, Int iPelY, Int iWidth, Int iHeight ) const
+{
+  Int iX0, iY0, iX1, iY1;
+  if ( iFrame < 0 || iFrame >= getNumFrames() || !xGetBlocks( iPelX, iPelY, iWidth, iHeight, iX0, iY0, iX1, iY1 ) )
+  {
+    return PATCH_AREA_UNKNOWN;
+  }
+  Bool       bPadding    = false;
+  const UInt uiNumPatches = getPatchCount( iFrame, iPelX, iPelY, iWidth, iHeight, bPadding );
+  if ( uiNumPatches == 0 )
+  {
+    return PATCH_AREA_NONE;
+  }
+  if ( uiNumPatches > 1 || bPadding )
+  {
+    return PATCH_AREA_BORDER;
+  }
+  // the ring of blocks around the area, clipped to the map, decides between interior and border-adjacent
+  const std::vector<Int>& rcFrame = m_frames[iFrame];
+  const Int               iPatch  = rcFrame[iY0 * m_iWidth + iX0];
+  const Int               iRingX0 = std::max( iX0 - 1, 0 );
+  const Int               iRingY0 = std::max( iY0 - 1, 0 );
+  const Int               iRingX1 = std::min( iX1 + 1, m_iWidth  - 1 );
+  const Int               iRingY1 = std::min( iY1 + 1, m_iHeight - 1 );
+  for ( Int iY = iRingY0; iY <= iRingY1; iY++ )
+  {
+    for ( Int iX = iRingX0; iX <= iRingX1; iX++ )
+    {
+      if ( rcFrame[iY * m_iWidth + iX] != iPatch )
+      {
+        return PATCH_AREA_INSIDE;
+      }
+    }
+  }
+  return PATCH_AREA_INTERIOR;
+}
+
+//! \}
+
+} // namespace pcc_hm
@@ -0,0 +1,103 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TEncPatchSummary.h
+    \brief    block to patch map of the V-PCC atlas frames for the CU level decisions (header)
+*/
+
+#ifndef __TENCPATCHSUMMARY__
+#define __TENCPATCHSUMMARY__
+
+#include <vector>
+
+#include "TLibCommon/CommonDef.h"
+
+#define LFCN_PATCH_INTERIOR_SHIFT    0.1    ///< split threshold change of the CUs inside a patch
+
+namespace pcc_hm {
+
+//! \ingroup TLibEncoder
+//! \{
+
+/// patches of a block of the coded picture
+enum PatchAreaCategory
+{
+  PATCH_AREA_UNKNOWN  = -1,  ///< no block to patch map for the frame
+  PATCH_AREA_NONE     = 0,   ///< padding only
+  PATCH_AREA_INTERIOR = 1,   ///< one patch, which also covers the blocks around the area
+  PATCH_AREA_INSIDE   = 2,   ///< one patch, the area touches its border
+  PATCH_AREA_BORDER   = 3    ///< several patches, or a patch and padding
+};
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// patch index of every block of the atlas frames, as packed by the V-PCC encoder, copied once per GOF
+class TEncPatchSummary
+{
+private:
+  std::vector< std::vector<Int> > m_frames;      ///< patch index + 1 of each block in raster order, 0 for padding
+  Int                             m_iWidth;      ///< in blocks
+  Int                             m_iHeight;
+  Int                             m_iBlockSize;  ///< luma samples per block in each direction
+
+public:
+  TEncPatchSummary();
+  virtual ~TEncPatchSummary() {}
+
+  /// copies the block to patch maps of the frames, iWidth x iHeight blocks of iBlockSize luma samples
+  Void    create            ( const std::vector<const size_t*>& frames, Int iWidth, Int iHeight, Int iBlockSize );
+  Void    destroy           ();
+
+  Bool    isEmpty           () const                  { return m_frames.empty(); }
+  Int     getNumFrames      () const                  { return Int( m_frames.size() ); }
+  Int     getBlockSize      () const                  { return m_iBlockSize; }
+
+  /// number of distinct patches of the blocks of the area given in luma samples, clipped to the map; rbPadding tells
+  /// whether a block of the area has no patch
+  UInt    getPatchCount     ( Int iFrame, Int iPelX, Int iPelY, Int iWidth, Int iHeight, Bool& rbPadding ) const;
+  /// category of the area given in luma samples
+  PatchAreaCategory getCategory( Int iFrame, Int iPelX, Int iPelY, Int iWidth, Int iHeight ) const;
+
+private:
+  /// blocks of the area, clipped to the map; false when it is outside of the map
+  Bool    xGetBlocks        ( Int iPelX, Int iPelY, Int iWidth, Int iHeight, Int& riX0, Int& riY0, Int& riX1, Int& riY1 ) const;
+};
+
+//! \}
+
+} // namespace pcc_hm
+
+#endif // __TENCPATCHSUMMARY__
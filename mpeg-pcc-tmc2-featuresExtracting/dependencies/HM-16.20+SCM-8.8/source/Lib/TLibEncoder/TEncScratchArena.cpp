@@ -0,0 +1,124 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TEncScratchArena.cpp
+    \brief    per-CTU scratch memory of the encoder side CU decision helpers
+*/
+
+#include "TEncScratchArena.h"
+
+namespace pcc_hm {
+
+//! \ingroup TLibEncoder
+//! \{
+
+TEncScratchArena::TEncScratchArena()
+: m_pucAlloc      ( NULL )
+, m_pucBuffer     ( NULL )
+, m_uiCapacity    ( 0 )
+, m_uiUsed        ( 0 )
+, m_uiOverflowSize( 0 )
+, m_uiPeak        ( 0 )
+{
+}
+
+TEncScratchArena::~TEncScratchArena()
+{
+  destroy();
+}
+
+Void TEncScratchArena::create( UInt uiCapacity )
+{
+  destroy();
+  m_uiCapacity = ( uiCapacity + SCRATCH_ARENA_ALIGNMENT - 1 ) & ~UInt( SCRATCH_ARENA_ALIGNMENT - 1 );
+  m_pucAlloc   = (UChar*)xMalloc( UChar, m_uiCapacity + SCRATCH_ARENA_ALIGNMENT );
+  m_pucBuffer  = m_pucAlloc + ( ( SCRATCH_ARENA_ALIGNMENT - ( size_t( m_pucAlloc ) & ( SCRATCH_ARENA_ALIGNMENT - 1 ) ) ) & ( SCRATCH_ARENA_ALIGNMENT - 1 ) );
+}
+
+Void TEncScratchArena::destroy()
+{
+  for ( size_t i = 0; i < m_overflowBlocks.size(); i++ )
+  {
+    xFree( m_overflowBlocks[i] );
+  }
+  m_overflowBlocks.clear();
+
+  if ( m_pucAlloc )
+  {
+    xFree( m_pucAlloc );
+    m_pucAlloc = NULL;
+  }
+  m_pucBuffer      = NULL;
+  m_uiCapacity     = 0;
+  m_uiUsed         = 0;
+  m_uiOverflowSize = 0;
+  m_uiPeak         = 0;
+}
+
+Void TEncScratchArena::reset()
+{
+  if ( !m_overflowBlocks.empty() )
+  {
+    // the last CTU did not fit: grow the buffer once to its peak demand
+    const UInt uiCapacity = m_uiPeak + ( m_uiPeak >> 1 );
+    create( uiCapacity );
+    return;
+  }
+  m_uiUsed = 0;
+  m_uiPeak = 0;
+}
+
+UChar* TEncScratchArena::xAlloc( UInt uiSize )
+{
+  uiSize = ( uiSize + SCRATCH_ARENA_ALIGNMENT - 1 ) & ~UInt( SCRATCH_ARENA_ALIGNMENT - 1 );
+
+  if ( m_uiUsed + uiSize <= m_uiCapacity )
+  {
+    UChar* pucBlock = m_pucBuffer + m_uiUsed;
+    m_uiUsed       += uiSize;
+    m_uiPeak        = std::max( m_uiPeak, m_uiUsed + m_uiOverflowSize );
+    return pucBlock;
+  }
+
+  // out of capacity: serve the request from the heap until the next reset()
+  UChar* pucAlloc = (UChar*)xMalloc( UChar, uiSize + SCRATCH_ARENA_ALIGNMENT );
+  m_overflowBlocks.push_back( pucAlloc );
+  m_uiOverflowSize += uiSize;
+  m_uiPeak          = std::max( m_uiPeak, m_uiUsed + m_uiOverflowSize );
+  return pucAlloc + ( ( SCRATCH_ARENA_ALIGNMENT - ( size_t( pucAlloc ) & ( SCRATCH_ARENA_ALIGNMENT - 1 ) ) ) & ( SCRATCH_ARENA_ALIGNMENT - 1 ) );
+}
+
+//! \}
+
+} // namespace pcc_hm
@@ -850,17 +850,9 @@ Void TEncSlice::compressSlice( TComPic* pcPic, const Bool bCompressEntireSlice,
 
       ( (TEncBinCABAC*)m_pcRDGoOnSbacCoder->getEncBinIf() )->setBinCountingEnableFlag( false );
 
-#ifdef EXTRAFEATURES  // MesksCode
-      initExtraFeatures( pcSlice->getSliceQp() );
-#endif  // EXTRAFEATURES
-
       // run CTU trial encoder
       m_pcCuEncoder->compressCtu( pCtu, lastPaletteSize, lastPalette );
 
-#ifdef EXTRAFEATURES  // MesksCode
-      destroyExtraFeatures();
-#endif  // EXTRAFEATURES
-
       // All CTU decisions have now been made. Restore entropy coder to an initial stage, ready to make a true encode,
       // which will result in the state of the contexts being correct. It will also count up the number of bits coded,
       // which is used if there is a limit of the number of bytes per slice-segment.
@@ -1108,17 +1100,9 @@ Void TEncSlice::compressSlice( TComPic* pcPic, const Bool bCompressEntireSlice,
 #endif
     }
 
-#ifdef EXTRAFEATURES  // MesksCode
-    initExtraFeatures( pcSlice->getSliceQp() );
-#endif  // EXTRAFEATURES
-
     // run CTU trial encoder
     m_pcCuEncoder->compressCtu( pCtu, lastPaletteSize, lastPalette );
 
-#ifdef EXTRAFEATURES  // MesksCode
-    destroyExtraFeatures();
-#endif  // EXTRAFEATURES
-
     // All CTU decisions have now been made. Restore entropy coder to an initial stage, ready to make a true encode,
     // which will result in the state of the contexts being correct. It will also count up the number of bits coded,
     // which is used if there is a limit of the number of bytes per slice-segment.
@@ -2,47 +2,64 @@
 #define __extraFeaturesCPP__ 
 #include "extraFeatures.h"
 
-extern ofstream                   extraGeoMergeFeatures;
-extern ofstream                   extraAttriMergeFeatures;
-extern ofstream                   extraGeoInterFeatures;
-extern ofstream                   extraAttriInterFeatures;
-extern map<string, string>        xyd_GeoMergeFeatures;
-extern map<string, string>        xyd_AttriMergeFeatures;
-extern map<string, string>        xyd_GeoInterFeatures;
-extern map<string, string>        xyd_AttriInterFeatures;
-extern int                        OorGorA;
+pcc_hm::TEncFeatureSink    extraGeoMergeFeatures;
+pcc_hm::TEncFeatureSink    extraAttriMergeFeatures;
+pcc_hm::TEncFeatureSink    extraGeoInterFeatures;
+pcc_hm::TEncFeatureSink    extraAttriInterFeatures;
+pcc_hm::TEncFeatureDatasetWriter extraMergeDataset;
+pcc_hm::TEncFeatureDatasetWriter extraInterDataset;
+pcc_hm::TEncPatchSummary   extraPatchSummary;
+extern int                 OorGorA;
 
-void initExtraFeatures(int QP) {
-  xyd_GeoMergeFeatures.clear();
-  xyd_AttriMergeFeatures.clear();
-  xyd_GeoInterFeatures.clear();
-  xyd_AttriInterFeatures.clear();
-  frontModeFlag.clear();
-  stringstream sm_gpath, sm_apath, si_gpath, si_apath, sp_gpath, sp_apath;
-  sm_gpath << "../__extraFeatures/oriP_extraFeatures_Geo.csv";
-  sm_apath << "../__extraFeatures/oriP_extraFeatures_Att.csv";
-  si_gpath << "../__extraFeatures/oriI_extraFeatures_Geo.csv";
-  si_apath << "../__extraFeatures/oriI_extraFeatures_Att.csv";
-  string gmpath, ampath, gipath, aipath;
-  sm_gpath >> gmpath;
-  sm_apath >> ampath;
-  si_gpath >> gipath;
-  si_apath >> aipath;
-  extraGeoMergeFeatures.open( gmpath, ios::app );
-  extraAttriMergeFeatures.open( ampath, ios::app );
-  extraGeoInterFeatures.open( gipath, ios::app );
-  extraAttriInterFeatures.open( aipath, ios::app );
+static void openExtraFeaturesFile( pcc_hm::TEncFeatureSink& sink, const string& path, int precision ) {
+  if ( !sink.open( path ) ) cerr << "Warning: can't open the features file " << path << endl;
+  sink.precision( precision );
 }
 
-void destroyExtraFeatures() {
-  xyd_GeoMergeFeatures.clear();
-  xyd_AttriMergeFeatures.clear();
-  xyd_GeoInterFeatures.clear();
-  xyd_AttriInterFeatures.clear();
-  frontModeFlag.clear();
+// Name of the sequence, taken from the source video name "<dir>/<sequence>_GOF0_<video>_<size>.yuv".
+static string extraFeaturesSequence( const string& srcYuvFileName ) {
+  string name  = srcYuvFileName.substr( 0, srcYuvFileName.find( "_GOF0_" ) );
+  size_t slash = name.find_last_of( "/\\" );
+  return slash == string::npos ? name : name.substr( slash + 1 );
+}
+
+static void openExtraFeaturesDataset( pcc_hm::TEncFeatureDatasetWriter& dataset, const string& path, int qp,
+                                      int sliceType, const string& sequence ) {
+  pcc_hm::TEncFeatureDatasetInfo info;
+#ifdef PRETRAIN
+  info.initFeatureColumns( qp, OorGorA, sliceType, sequence, true );
+#else
+  info.initFeatureColumns( qp, OorGorA, sliceType, sequence, false );
+#endif
+  if ( !dataset.open( path, info ) ) cerr << "Warning: can't open the features dataset " << path << endl;
+}
+
+// Opens the feature files of one encoded video; rows are appended to what previous videos wrote. The binary
+// datasets are only opened for the geometry and attribute videos, one file per sequence, QP and video type.
+void openExtraFeatures( const string& directory, int precision, int format, int qp, const string& srcYuvFileName ) {
+  string prefix = directory.empty() ? string() : directory + "/";
+  if ( format == EXTRA_FEATURES_BINARY ) {
+    if ( OorGorA < 0 ) return;
+    const string sequence = extraFeaturesSequence( srcYuvFileName );
+    stringstream suffix;
+    suffix << ( OorGorA == 0 ? "_Geo_" : "_Att_" ) << sequence << "_QP" << qp << ".lfcn";
+    openExtraFeaturesDataset( extraMergeDataset, prefix + "oriP_extraFeatures" + suffix.str(), qp, pcc_hm::P_SLICE, sequence );
+    openExtraFeaturesDataset( extraInterDataset, prefix + "oriI_extraFeatures" + suffix.str(), qp, pcc_hm::I_SLICE, sequence );
+    return;
+  }
+  openExtraFeaturesFile( extraGeoMergeFeatures, prefix + "oriP_extraFeatures_Geo.csv", precision );
+  openExtraFeaturesFile( extraAttriMergeFeatures, prefix + "oriP_extraFeatures_Att.csv", precision );
+  openExtraFeaturesFile( extraGeoInterFeatures, prefix + "oriI_extraFeatures_Geo.csv", precision );
+  openExtraFeaturesFile( extraAttriInterFeatures, prefix + "oriI_extraFeatures_Att.csv", precision );
+}
+
+// Writes out the buffered rows and closes the feature files.
+void closeExtraFeatures() {
   extraGeoMergeFeatures.close();
   extraAttriMergeFeatures.close();
   extraGeoInterFeatures.close();
   extraAttriInterFeatures.close();
+  extraMergeDataset.close();
+  extraInterDataset.close();
 }
 #endif
\ No newline at end of file
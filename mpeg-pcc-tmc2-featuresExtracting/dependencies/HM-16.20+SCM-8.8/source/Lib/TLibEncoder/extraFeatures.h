@@ -4,19 +4,27 @@
 #include <sstream>
 #include <fstream>
 #include <string>
-#include <map>
+#include "TLibEncoder/TEncFeatureSink.h"
+#include "TLibEncoder/TEncFeatureDataset.h"
+#include "TLibEncoder/TEncPatchSummary.h"
 using namespace std;
 
-ofstream            extraGeoMergeFeatures;
-ofstream            extraAttriMergeFeatures;
-ofstream            extraGeoInterFeatures;
-ofstream            extraAttriInterFeatures;
-map<string, string> xyd_GeoMergeFeatures;
-map<string, string> xyd_AttriMergeFeatures;
-map<string, string> xyd_GeoInterFeatures;
-map<string, string> xyd_AttriInterFeatures;
-map<string, int> frontModeFlag;
+// The four feature CSV files, opened once per encoded video by openExtraFeatures().
+extern pcc_hm::TEncFeatureSink extraGeoMergeFeatures;
+extern pcc_hm::TEncFeatureSink extraAttriMergeFeatures;
+extern pcc_hm::TEncFeatureSink extraGeoInterFeatures;
+extern pcc_hm::TEncFeatureSink extraAttriInterFeatures;
 
-void initExtraFeatures(int QP);
-void destroyExtraFeatures();
+// Binary datasets of the encoded video, used instead of the CSV files when the binary format is selected.
+extern pcc_hm::TEncFeatureDatasetWriter extraMergeDataset;
+extern pcc_hm::TEncFeatureDatasetWriter extraInterDataset;
+
+// Patch of each block of the frames of the encoded video, empty when the V-PCC encoder did not hand it over.
+extern pcc_hm::TEncPatchSummary extraPatchSummary;
+
+#define EXTRA_FEATURES_CSV     0
+#define EXTRA_FEATURES_BINARY  1
+
+void openExtraFeatures( const string& directory, int precision, int format, int qp, const string& srcYuvFileName );
+void closeExtraFeatures();
 #endif
\ No newline at end of file
@@ -591,6 +591,20 @@ bool parseParameters( int                   argc,
       encoderParams.nbThread_,
       encoderParams.nbThread_,
       "Number of thread used for parallel processing" )
+    ( "extraFeaturesPath",
+      encoderParams.extraFeaturesPath_,
+      encoderParams.extraFeaturesPath_,
+      "Directory of the CU feature CSV files written by the HM library, rows are appended to existing files" )
+    ( "extraFeaturesPrecision",
+      encoderParams.extraFeaturesPrecision_,
+      encoderParams.extraFeaturesPrecision_,
+      "Number of significant digits of the floating point values written to the CU feature CSV files" )
+    ( "extraFeaturesFormat",
+      encoderParams.extraFeaturesFormat_,
+      encoderParams.extraFeaturesFormat_,
+      "Format of the CU features written by the HM library:\n"
+      "  0: CSV files,\n"
+      "  1: binary datasets (.lfcn), one per sequence, QP and video type" )
     ( "keepIntermediateFiles",
       encoderParams.keepIntermediateFiles_,
       encoderParams.keepIntermediateFiles_,
@@ -72,6 +72,9 @@ class PCCEncoderParameters {
   std::string       colorSpaceConversionConfig_;
   std::string       inverseColorSpaceConversionConfig_;
   size_t            nbThread_;
+  std::string       extraFeaturesPath_;
+  size_t            extraFeaturesPrecision_;
+  size_t            extraFeaturesFormat_;
   size_t            frameCount_;
   size_t            groupOfFramesSize_;
   std::string       uncompressedDataPath_;
@@ -83,9 +83,23 @@ class PCCVideoEncoder {
                  const bool         patchColorSubsampling             = false );
 
   void setLogger( PCCLogger& logger ) { logger_ = &logger; }
+  void setExtraFeatures( const std::string& path, const size_t precision, const size_t format ) {
+    extraFeaturesPath_      = path;
+    extraFeaturesPrecision_ = precision;
+    extraFeaturesFormat_    = format;
+  }
+  // block to patch maps of the frames of the context, to be set once they are generated from the occupancy map video
+  void setBlockToPatch( PCCContext& context, const size_t occupancyResolution );
 
  private:
-  PCCLogger* logger_ = nullptr;
+  PCCLogger*  logger_                 = nullptr;
+  std::string extraFeaturesPath_      = {};
+  size_t      extraFeaturesPrecision_ = 6;
+  size_t      extraFeaturesFormat_    = 0;
+  std::vector<const size_t*> blockToPatch_       = {};
+  size_t      blockToPatchWidth_      = 0;
+  size_t      blockToPatchHeight_     = 0;
+  size_t      occupancyResolution_    = 16;
 };
 
 };  // namespace pcc
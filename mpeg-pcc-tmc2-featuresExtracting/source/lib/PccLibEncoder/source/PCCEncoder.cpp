@@ -117,6 +117,8 @@ int PCCEncoder::encode( const PCCGroupOfFrames& sources, PCCContext& context, PC
 
   PCCVideoEncoder videoEncoder;
   videoEncoder.setLogger( *logger_ );
+  videoEncoder.setExtraFeatures( params_.extraFeaturesPath_, params_.extraFeaturesPrecision_,
+                                params_.extraFeaturesFormat_ );
   size_t            atlasIndex = context.getAtlasIndex();
   const size_t      pointCount = sources[0].getPointCount();
   auto&             sps        = context.getVps();
@@ -167,6 +169,7 @@ int PCCEncoder::encode( const PCCGroupOfFrames& sources, PCCContext& context, PC
   } else {
     generateBlockToPatchFromOccupancyMapVideo( context, params_.occupancyResolution_, params_.occupancyPrecision_ );
   }
+  videoEncoder.setBlockToPatch( context, params_.occupancyResolution_ );
 
   // Generate GEOMETRY IMAGE & dilation
   generateGeometryVideo( sources, context );
@@ -135,6 +135,9 @@ PCCEncoderParameters::PCCEncoderParameters() {
   geometryAuxVideoConfig_                  = {};
   attributeAuxVideoConfig_                 = {};
   nbThread_                                = 1;
+  extraFeaturesPath_                       = "../__extraFeatures";
+  extraFeaturesPrecision_                  = 6;
+  extraFeaturesFormat_                     = 0;
   keepIntermediateFiles_                   = false;
   absoluteD1_                              = false;
   absoluteT1_                              = false;
@@ -335,6 +338,9 @@ void PCCEncoderParameters::print() {
   std::cout << "\t groupOfFramesSize                          " << groupOfFramesSize_ << std::endl;
   std::cout << "\t colorTransform                             " << colorTransform_ << std::endl;
   std::cout << "\t nbThread                                   " << nbThread_ << std::endl;
+  std::cout << "\t extraFeaturesPath                          " << extraFeaturesPath_ << std::endl;
+  std::cout << "\t extraFeaturesPrecision                     " << extraFeaturesPrecision_ << std::endl;
+  std::cout << "\t extraFeaturesFormat                        " << extraFeaturesFormat_ << std::endl;
   std::cout << "\t keepIntermediateFiles                      " << keepIntermediateFiles_ << std::endl;
   std::cout << "\t multipleStreams                            " << multipleStreams_ << std::endl;
   std::cout << "\t multipleStreams                            " << multipleStreams_ << std::endl;
@@ -851,6 +857,10 @@ bool PCCEncoderParameters::check() {
     colorSpaceConversionConfig_        = "";
   }
 
+  if ( extraFeaturesFormat_ > 1 ) {
+    ret = false;
+    std::cerr << "ERROR: extraFeaturesFormat must be 0 (CSV) or 1 (binary)\n";
+  }
   if ( compressedStreamPath_.empty() ) {
     ret = false;
     std::cerr << "compressedStreamPath not set\n";
@@ -61,6 +61,16 @@ struct PCCVideoEncoderParameters {
   int32_t     shvcLayerIndex_              = 8;
   int32_t     shvcRateX_                   = 0;
   int32_t     shvcRateY_                   = 0;
+  // directory, float precision and format (0: CSV, 1: binary) of the CU features written by the HM library
+  std::string extraFeaturesPath_           = {};
+  size_t      extraFeaturesPrecision_      = 6;
+  size_t      extraFeaturesFormat_         = 0;
+  // block to patch map of each atlas frame of the GOF (patch index + 1, 0 for padding), in blocks of
+  // occupancyResolution_ samples, giving the number of patches covered by each CU
+  std::vector<const size_t*> blockToPatch_      = {};
+  size_t      blockToPatchWidth_           = 0;
+  size_t      blockToPatchHeight_          = 0;
+  size_t      occupancyResolution_         = 16;
 };
 
 template <class T>
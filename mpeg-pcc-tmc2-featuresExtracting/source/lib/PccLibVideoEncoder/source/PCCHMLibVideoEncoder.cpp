@@ -40,6 +40,7 @@
 #ifdef EXTRAFEATURES  // MesksCode
 #include "TLibEncoder/occupancyGuidDudge.h"
 #include "TLibEncoder/occupancyGuidDudge.cpp"
+#include "TLibEncoder/extraFeatures.h"
 #endif  // MesksCode
 
 using namespace pcc;
@@ -100,6 +101,15 @@ void PCCHMLibVideoEncoder<T>::encode( PCCVideo<T, 3>&            videoSrc,
 
 #ifdef EXTRAFEATURES  // MesksCode
   occupancyDciInit( videoSrc.getWidth(), videoSrc.getHeight(), videoSrc.getFrameCount(), params.srcYuvFileName_ );
+  openExtraFeatures( params.extraFeaturesPath_, static_cast<int>( params.extraFeaturesPrecision_ ),
+                     static_cast<int>( params.extraFeaturesFormat_ ), params.qp_, params.srcYuvFileName_ );
+  // the map only describes the videos of the atlas frame size, not the occupancy map or the auxiliary videos
+  if ( params.blockToPatchWidth_ * params.occupancyResolution_ == videoSrc.getWidth() &&
+       params.blockToPatchHeight_ * params.occupancyResolution_ == videoSrc.getHeight() ) {
+    extraPatchSummary.create( params.blockToPatch_, static_cast<int>( params.blockToPatchWidth_ ),
+                              static_cast<int>( params.blockToPatchHeight_ ),
+                              static_cast<int>( params.occupancyResolution_ ) );
+  }
 #endif  // EXTRAFEATURES
 
   PCCHMLibVideoEncoderImpl<T> encoder;
@@ -109,6 +119,8 @@ void PCCHMLibVideoEncoder<T>::encode( PCCVideo<T, 3>&            videoSrc,
   printf( " Total Time: %12.3f sec. \n", ( endClock - startClock ) * 1.0 / CLOCKS_PER_SEC );
 
 #ifdef EXTRAFEATURES  // MesksCode
+  closeExtraFeatures();
+  extraPatchSummary.destroy();
   occupancyDciDestroy();
 #endif  // EXTRAFEATURES
 }
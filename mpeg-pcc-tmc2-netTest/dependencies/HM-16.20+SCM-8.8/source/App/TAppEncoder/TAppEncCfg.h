@@ -296,6 +296,14 @@ protected:
   std::vector<Int> m_tileColumnWidth;
   std::vector<Int> m_tileRowHeight;
   Bool      m_entropyCodingSyncEnabledFlag;
+  Int       m_wppThreads;                                     ///< number of CTU rows compressed concurrently
+  std::string m_lfcnModelFile;                                ///< LFCN model file, empty for the compiled split models
+  Double    m_lfcnTimeReduction;                              ///< fraction of the full RDO CTU time saved by the LFCN thresholds
+  Double    m_lfcnPictureTimeBudget;                          ///< CTU compression time of a picture in ms for the LFCN thresholds
+  Bool      m_lfcnEarlySplit;                                 ///< split confidently predicted CUs without checking their modes
+  Bool      m_lfcnCtuDepthRange;                              ///< bound the CU depths of each CTU by a predicted range
+  Bool      m_lfcnNearLayerPrior;                             ///< bound the CUs of the far layer pictures by those of the near layer
+  UInt      m_lfcnEmptyCtuFastPath;                           ///< video types whose unoccupied CTUs are coded without mode search
 
   Bool      m_bUseConstrainedIntraPred;                       ///< flag for using constrained intra prediction
   Bool      m_bFastUDIUseMPMEnabled;
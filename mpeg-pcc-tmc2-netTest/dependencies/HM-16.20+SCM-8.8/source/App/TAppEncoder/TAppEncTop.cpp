@@ -481,6 +481,16 @@ Void TAppEncTop::xInitLibCfg()
   }
   m_cTEncTop.setLFCrossTileBoundaryFlag                           ( m_bLFCrossTileBoundaryFlag );
   m_cTEncTop.setEntropyCodingSyncEnabledFlag                      ( m_entropyCodingSyncEnabledFlag );
+  m_cTEncTop.setWppThreads                                        ( m_wppThreads );
+#ifdef SDMTEST
+  m_cTEncTop.setLFCNModelFile                                     ( m_lfcnModelFile );
+  m_cTEncTop.setLFCNTimeReduction                                 ( m_lfcnTimeReduction );
+  m_cTEncTop.setLFCNPictureTimeBudget                             ( m_lfcnPictureTimeBudget );
+  m_cTEncTop.setLFCNEarlySplit                                    ( m_lfcnEarlySplit );
+  m_cTEncTop.setLFCNCtuDepthRange                                 ( m_lfcnCtuDepthRange );
+  m_cTEncTop.setLFCNNearLayerPrior                                ( m_lfcnNearLayerPrior );
+  m_cTEncTop.setLFCNEmptyCtuFastPath                              ( m_lfcnEmptyCtuFastPath );
+#endif
   m_cTEncTop.setTMVPModeId                                        ( m_TMVPModeId );
   m_cTEncTop.setUseScalingListId                                  ( m_useScalingListId  );
   m_cTEncTop.setScalingListFileName                               ( m_scalingListFileName );
@@ -0,0 +1,352 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     simdBenchmark.cpp
+    \brief    times the run-time selected vector kernels of TLibCommon against the C code and checks their results
+
+    usage: simdBenchmark [scale], where scale multiplies the number of calls timed (default 1)
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <vector>
+
+#include "TLibCommon/TComRom.h"
+#include "TLibCommon/TComRdCost.h"
+#include "TLibCommon/TComInterpolationFilter.h"
+#include "TLibCommon/TComTrQuant.h"
+#include "TLibCommon/TComSimd.h"
+
+using namespace pcc_hm;
+
+static const Int BENCH_MAX_SIZE = 64;
+static const Int BENCH_STRIDE   = BENCH_MAX_SIZE + 16;
+
+/// original, prediction and occupancy planes, the occupancy with a few holes as on the patch borders
+struct BenchPlanes
+{
+  std::vector<Pel> org, cur, occupancy;
+
+  BenchPlanes( Int bitDepth )
+    : org( BENCH_STRIDE * ( BENCH_MAX_SIZE + 1 ) ), cur( org.size() ), occupancy( org.size() )
+  {
+    for( size_t i = 0; i < org.size(); i++ )
+    {
+      org[i]       = rand() & ( ( 1 << bitDepth ) - 1 );
+      cur[i]       = std::min( std::max( org[i] + rand() % 33 - 16, 0 ), ( 1 << bitDepth ) - 1 );
+      occupancy[i] = ( rand() % 8 ) != 0;
+    }
+  }
+};
+
+/// calls per timing: enough for about the same number of samples whatever the block size
+static Int getNumCalls( Int iWidth, Int iHeight, Double dScale )
+{
+  return std::max( 16, Int( dScale * ( 1 << 25 ) / ( iWidth * iHeight ) ) );
+}
+
+/// results of the timed calls, kept so that the calls are not optimised out
+static volatile Distortion g_uiTimedResults = 0;
+
+/// nanoseconds per call of fCall
+template< typename F >
+static Double timeCalls( F fCall, Int iCalls )
+{
+  Distortion uiSum = 0;
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for( Int i = 0; i < iCalls; i++ )
+  {
+    uiSum += fCall();
+  }
+  const Double dNs = std::chrono::duration<Double, std::nano>( std::chrono::steady_clock::now() - start ).count();
+  g_uiTimedResults = uiSum;
+  return dNs / iCalls;
+}
+
+static Void printHeader( SimdExtension eBest )
+{
+  printf( "\n%-12s %7s %3s", "kernel", "size", "bd" );
+  for( Int e = SIMD_NONE; e <= eBest; e++ )
+  {
+    printf( " %17s", getSimdExtensionName( SimdExtension( e ) ) );
+  }
+  printf( "\n" );
+}
+
+/** one line of the table: ns per call of each extension and its speed-up, '!' where the result differs from the C code;
+ *  fCall( tool, bResult ) runs the kernel on a T built for the extension and returns its result, or anything without
+ *  bResult
+ */
+template< class T, typename F >
+static Bool benchmarkLine( const TChar* kernel, Int iWidth, Int iHeight, Int bitDepth, SimdExtension eBest, Double dScale, F fCall )
+{
+  Bool       bExact = true;
+  Distortion uiReference = 0;
+  Double     dReference  = 0;
+  printf( "%-12s %3dx%-3d %3d", kernel, iWidth, iHeight, bitDepth );
+  for( Int e = SIMD_NONE; e <= eBest; e++ )
+  {
+    setSimdExtension( SimdExtension( e ) );
+    T cTool;
+    const Double     dNs      = timeCalls( [&]() { return fCall( cTool, false ); }, getNumCalls( iWidth, iHeight, dScale ) );
+    const Distortion uiResult = fCall( cTool, true );
+    if( e == SIMD_NONE )
+    {
+      uiReference = uiResult;
+      dReference  = dNs;
+      printf( " %9.1f ns      ", dNs );
+    }
+    else
+    {
+      bExact = bExact && uiResult == uiReference;
+      printf( " %9.1f ns %4.1fx%c", dNs, dReference / dNs, uiResult == uiReference ? ' ' : '!' );
+    }
+  }
+  printf( "\n" );
+  return bExact;
+}
+
+static Bool benchmarkDistortion( SimdExtension eBest, Double dScale )
+{
+  Bool bExact = true;
+  const Int bitDepths[] = { 8, 10 };
+
+  printHeader( eBest );
+  for( Int bitDepth : bitDepths )
+  {
+    BenchPlanes planes( bitDepth );
+    for( Int iSize = 4; iSize <= BENCH_MAX_SIZE; iSize <<= 1 )
+    {
+      bExact &= benchmarkLine<TComRdCost>( "SSE", iSize, iSize, bitDepth, eBest, dScale, [&]( TComRdCost& cRdCost, Bool )
+      {
+#if PCC_RDO_EXT
+        return cRdCost.getDistPart( bitDepth, &planes.cur[1], BENCH_STRIDE, &planes.org[0], BENCH_STRIDE, iSize, iSize, COMPONENT_Y, DF_SSE, &planes.occupancy[0], BENCH_STRIDE );
+#else
+        return cRdCost.getDistPart( bitDepth, &planes.cur[1], BENCH_STRIDE, &planes.org[0], BENCH_STRIDE, iSize, iSize, COMPONENT_Y, DF_SSE );
+#endif
+      } );
+    }
+  }
+
+  const TChar* kernels[] = { "SAD", "HAD" };
+  for( Int k = 0; k < 2; k++ )
+  {
+    printHeader( eBest );
+    for( Int bitDepth : bitDepths )
+    {
+      BenchPlanes planes( bitDepth );
+      for( Int iSize = 4; iSize <= BENCH_MAX_SIZE; iSize <<= 1 )
+      {
+        bExact &= benchmarkLine<TComRdCost>( kernels[k], iSize, iSize, bitDepth, eBest, dScale, [&]( TComRdCost& cRdCost, Bool )
+        {
+          DistParam cDistParam;
+          cRdCost.setDistParam( cDistParam, bitDepth, &planes.org[0], BENCH_STRIDE, &planes.cur[1], BENCH_STRIDE, iSize, iSize, k == 1 );
+          return cDistParam.DistFunc( &cDistParam );
+        } );
+      }
+    }
+  }
+  return bExact;
+}
+
+/// checksum of a block, for the comparison of the filtered samples and of the coefficients
+template< typename T >
+static Distortion getChecksum( const T* piSrc, Int iStride, Int iWidth, Int iHeight )
+{
+  Distortion uiSum = 0;
+  for( Int y = 0; y < iHeight; y++, piSrc += iStride )
+  {
+    for( Int x = 0; x < iWidth; x++ )
+    {
+      uiSum = uiSum * 31 + Distortion( piSrc[x] );
+    }
+  }
+  return uiSum;
+}
+
+/// horizontal, vertical and 2-D filtering at a fractional position, as in TComPrediction::xPredInterBlk
+static Bool benchmarkInterpolation( SimdExtension eBest, Double dScale )
+{
+  Bool bExact = true;
+  const Int    bitDepths[] = { 8, 10 };
+  const TChar* kernels[]   = { "luma H", "luma V", "luma HV", "chroma H", "chroma V", "chroma HV" };
+  const Int    iMargin     = NTAPS_LUMA;
+  const Int    iStride     = BENCH_MAX_SIZE + 2 * iMargin;
+  std::vector<Pel> src( iStride * iStride ), tmp( src.size() ), dst( src.size() );
+
+  for( Int k = 0; k < 6; k++ )
+  {
+    const ComponentID compID   = k < 3 ? COMPONENT_Y : COMPONENT_Cb;
+    const Int         iFrac    = k < 3 ? 2 : 3;
+    const Int         iTaps    = k < 3 ? NTAPS_LUMA : NTAPS_CHROMA;
+    const Int         iHalfTap = ( iTaps >> 1 ) - 1;
+    printHeader( eBest );
+    for( Int bitDepth : bitDepths )
+    {
+      for( size_t i = 0; i < src.size(); i++ )
+      {
+        src[i] = rand() & ( ( 1 << bitDepth ) - 1 );
+      }
+      Pel* piSrc = &src[iMargin * iStride + iMargin];
+      Pel* piTmp = &tmp[iMargin * iStride + iMargin];
+      for( Int iSize = 4; iSize <= BENCH_MAX_SIZE; iSize <<= 1 )
+      {
+        bExact &= benchmarkLine<TComInterpolationFilter>( kernels[k], iSize, iSize, bitDepth, eBest, dScale, [&]( TComInterpolationFilter& cFilter, Bool bResult )
+        {
+          switch( k % 3 )
+          {
+          case 0:
+            cFilter.filterHor( compID, piSrc, iStride, &dst[0], iStride, iSize, iSize, iFrac, true, CHROMA_420, bitDepth );
+            break;
+          case 1:
+            cFilter.filterVer( compID, piSrc, iStride, &dst[0], iStride, iSize, iSize, iFrac, true, true, CHROMA_420, bitDepth );
+            break;
+          default:
+            cFilter.filterHor( compID, piSrc - iHalfTap * iStride, iStride, piTmp - iHalfTap * iStride, iStride, iSize, iSize + iTaps - 1, iFrac, false, CHROMA_420, bitDepth );
+            cFilter.filterVer( compID, piTmp, iStride, &dst[0], iStride, iSize, iSize, iFrac, false, true, CHROMA_420, bitDepth );
+            break;
+          }
+          return bResult ? getChecksum( &dst[0], iStride, iSize, iSize ) : Distortion( dst[0] );
+        } );
+      }
+    }
+  }
+  return bExact;
+}
+
+/// TComTrQuant with its transform and quantisation steps open to the benchmark
+class BenchTrQuant : public TComTrQuant
+{
+public:
+  using TComTrQuant::xT;
+  using TComTrQuant::xIT;
+  using TComTrQuant::xQuantCoefficients;
+  using TComTrQuant::xDeQuantCoefficients;
+};
+
+/// forward and inverse transforms of the residual of the planes, quantisation and dequantisation at QP 32 without
+/// scaling list, as in TComTrQuant::transformNxN and invTransformNxN
+static Bool benchmarkTransform( SimdExtension eBest, Double dScale )
+{
+  Bool bExact = true;
+  const Int    bitDepths[] = { 8, 10 };
+  const TChar* kernels[]   = { "DST", "IDST", "DCT", "IDCT", "quant", "dequant" };
+  const Int    iQP         = 32;
+  std::vector<Pel>    resi( BENCH_STRIDE * BENCH_MAX_SIZE ), recon( MAX_TU_SIZE * MAX_TU_SIZE );
+  std::vector<TCoeff> coeff( MAX_TU_SIZE * MAX_TU_SIZE ), quant( coeff.size() ), deltaU( coeff.size() ), dequant( coeff.size() ), out( coeff.size() );
+
+  for( Int k = 0; k < 6; k++ )
+  {
+    printHeader( eBest );
+    for( Int bitDepth : bitDepths )
+    {
+      BenchPlanes planes( bitDepth );
+      for( size_t i = 0; i < resi.size(); i++ )
+      {
+        resi[i] = planes.org[i] - planes.cur[i];
+      }
+      const Int  maxLog2TrDynamicRange = std::max<Int>( 15, bitDepth + 6 );
+      const Int  iPer                  = ( iQP + 6 * ( bitDepth - 8 ) ) / 6;
+      const Int  iRem                  = ( iQP + 6 * ( bitDepth - 8 ) ) % 6;
+      const Bool useDST                = k < 2;
+      for( Int iSize = 4; iSize <= ( useDST ? 4 : MAX_TU_SIZE ); iSize <<= 1 )
+      {
+        const Int    iTransformShift = getTransformShift( bitDepth, g_aucConvertToBit[iSize] + 2, maxLog2TrDynamicRange );
+        const Int    iQBits          = QUANT_SHIFT + iPer + iTransformShift;
+        const Int    iAdd            = 85 << ( iQBits - 9 );
+        const Int    rightShift      = IQUANT_SHIFT - ( iTransformShift + iPer );
+        const TCoeff coeffMinimum    = -( 1 << maxLog2TrDynamicRange );
+        const TCoeff coeffMaximum    =  ( 1 << maxLog2TrDynamicRange ) - 1;
+        const Int    iNumSamples     = iSize * iSize;
+
+        // inputs of the inverse steps from the C code
+        setSimdExtension( SIMD_NONE );
+        BenchTrQuant cReference;
+        cReference.xT( bitDepth, useDST, &resi[0], BENCH_STRIDE, &coeff[0], iSize, iSize, maxLog2TrDynamicRange );
+        cReference.xQuantCoefficients( &coeff[0], &quant[0], NULL, &deltaU[0], iNumSamples, NULL, g_quantScales[iRem], iQBits, iAdd, 0, 0, coeffMinimum, coeffMaximum );
+        cReference.xDeQuantCoefficients( &quant[0], &dequant[0], iNumSamples, NULL, g_invQuantScales[iRem], rightShift, coeffMinimum, coeffMaximum, coeffMinimum, coeffMaximum );
+
+        bExact &= benchmarkLine<BenchTrQuant>( kernels[k], iSize, iSize, bitDepth, eBest, dScale, [&]( BenchTrQuant& cTrQuant, Bool bResult )
+        {
+          switch( k )
+          {
+          case 0:
+          case 2:
+            cTrQuant.xT( bitDepth, useDST, &resi[0], BENCH_STRIDE, &out[0], iSize, iSize, maxLog2TrDynamicRange );
+            break;
+          case 1:
+          case 3:
+            cTrQuant.xIT( bitDepth, useDST, &dequant[0], &recon[0], iSize, iSize, iSize, maxLog2TrDynamicRange );
+            return bResult ? getChecksum( &recon[0], iSize, iSize, iSize ) : Distortion( recon[0] );
+          case 4:
+          {
+            const TCoeff uiAbsSum = cTrQuant.xQuantCoefficients( &coeff[0], &out[0], NULL, &deltaU[0], iNumSamples, NULL, g_quantScales[iRem], iQBits, iAdd, 0, 0, coeffMinimum, coeffMaximum );
+            if( !bResult )
+            {
+              return Distortion( uiAbsSum );
+            }
+            break;
+          }
+          default:
+            cTrQuant.xDeQuantCoefficients( &quant[0], &out[0], iNumSamples, NULL, g_invQuantScales[iRem], rightShift, coeffMinimum, coeffMaximum, coeffMinimum, coeffMaximum );
+            break;
+          }
+          return bResult ? getChecksum( &out[0], iSize, iSize, iSize ) : Distortion( out[0] );
+        } );
+      }
+    }
+  }
+  return bExact;
+}
+
+int main( int argc, char** argv )
+{
+  const Double dScale = argc > 1 ? atof( argv[1] ) : 1.0;
+  const SimdExtension eBest = getSimdExtension();
+  printf( "vector extension of this CPU: %s\n", getSimdExtensionName( eBest ) );
+
+  initROM();
+  srand( 1 );
+  Bool bExact = benchmarkDistortion( eBest, dScale );
+  bExact &= benchmarkInterpolation( eBest, dScale );
+  bExact &= benchmarkTransform( eBest, dScale );
+  setSimdExtension( eBest );
+  destroyROM();
+
+  if( !bExact )
+  {
+    printf( "\nresults differ from the C code where marked by !\n" );
+  }
+  return bExact ? 0 : 1;
+}
@@ -179,6 +179,17 @@ inline __m128i simdClip3( __m128i mmMin , __m128i mmMax , __m128i mmPix )
 }
 #endif
 
+// ====================================================================================================================
+// Constructor
+// ====================================================================================================================
+
+TComInterpolationFilter::TComInterpolationFilter()
+{
+#if VECTOR_CODING__RUNTIME_DISPATCH
+  initInterpolationFilterX86( getSimdExtension() );
+#endif
+}
+
 // ====================================================================================================================
 // Private member functions
 // ====================================================================================================================
@@ -509,6 +520,15 @@ Void TComInterpolationFilter::filter(Int bitDepth, Pel const *src, Int srcStride
 template<Int N>
 Void TComInterpolationFilter::filterHor(Int bitDepth, Pel *src, Int srcStride, Pel *dst, Int dstStride, Int width, Int height, Bool isLast, TFilterCoeff const *coeff)
 {
+#if VECTOR_CODING__RUNTIME_DISPATCH
+  const FpInterpolationFilter fpFilter = m_afpFilterX86[N == NTAPS_CHROMA][false][true][isLast];
+  if ( fpFilter != NULL && bitDepth <= 10 )
+  {
+    fpFilter(bitDepth, src, srcStride, dst, dstStride, width, height, coeff);
+    return;
+  }
+#endif
+
   if ( isLast )
   {
     filter<N, false, true, true>(bitDepth, src, srcStride, dst, dstStride, width, height, coeff);
@@ -537,6 +557,15 @@ Void TComInterpolationFilter::filterHor(Int bitDepth, Pel *src, Int srcStride, P
 template<Int N>
 Void TComInterpolationFilter::filterVer(Int bitDepth, Pel *src, Int srcStride, Pel *dst, Int dstStride, Int width, Int height, Bool isFirst, Bool isLast, TFilterCoeff const *coeff)
 {
+#if VECTOR_CODING__RUNTIME_DISPATCH
+  const FpInterpolationFilter fpFilter = m_afpFilterX86[N == NTAPS_CHROMA][true][isFirst][isLast];
+  if ( fpFilter != NULL && bitDepth <= 10 )
+  {
+    fpFilter(bitDepth, src, srcStride, dst, dstStride, width, height, coeff);
+    return;
+  }
+#endif
+
   if ( isFirst && isLast )
   {
     filter<N, true, true, true>(bitDepth, src, srcStride, dst, dstStride, width, height, coeff);
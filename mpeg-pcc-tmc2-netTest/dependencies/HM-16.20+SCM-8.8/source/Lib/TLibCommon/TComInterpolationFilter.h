@@ -40,6 +40,7 @@
 #define __TCOMINTERPOLATIONFILTER__
 
 #include "CommonDef.h"
+#include "TComSimd.h"
 namespace pcc_hm {
 
 //! \ingroup TLibCommon
@@ -51,6 +52,9 @@ namespace pcc_hm {
 #define IF_FILTER_PREC    6 ///< Log2 of sum of filter taps
 #define IF_INTERNAL_OFFS (1<<(IF_INTERNAL_PREC-1)) ///< Offset used internally
 
+/// FIR filter of a block, with the taps, rounding and clipping of one filtering operation
+typedef Void (*FpInterpolationFilter)( Int bitDepth, Pel const *src, Int srcStride, Pel *dst, Int dstStride, Int width, Int height, TFilterCoeff const *coeff );
+
 /**
  * \brief Interpolation filter class
  */
@@ -65,12 +69,17 @@ class TComInterpolationFilter
   static Void filter(Int bitDepth, Pel const *src, Int srcStride, Pel *dst, Int dstStride, Int width, Int height, TFilterCoeff const *coeff);
 
   template<Int N>
-  static Void filterHor(Int bitDepth, Pel *src, Int srcStride, Pel *dst, Int dstStride, Int width, Int height,               Bool isLast, TFilterCoeff const *coeff);
+  Void filterHor(Int bitDepth, Pel *src, Int srcStride, Pel *dst, Int dstStride, Int width, Int height,               Bool isLast, TFilterCoeff const *coeff);
   template<Int N>
-  static Void filterVer(Int bitDepth, Pel *src, Int srcStride, Pel *dst, Int dstStride, Int width, Int height, Bool isFirst, Bool isLast, TFilterCoeff const *coeff);
+  Void filterVer(Int bitDepth, Pel *src, Int srcStride, Pel *dst, Int dstStride, Int width, Int height, Bool isFirst, Bool isLast, TFilterCoeff const *coeff);
+
+#if VECTOR_CODING__RUNTIME_DISPATCH
+  FpInterpolationFilter m_afpFilterX86[2][2][2][2];  ///< vector kernels by [chroma][vertical][first][last], NULL where there is none
+  Void initInterpolationFilterX86( SimdExtension eExtension );   ///< in TComInterpolationFilterX86.cpp
+#endif
 
 public:
-  TComInterpolationFilter() {}
+  TComInterpolationFilter();
   ~TComInterpolationFilter() {}
 
   Void filterHor(const ComponentID compID, Pel *src, Int srcStride, Pel *dst, Int dstStride, Int width, Int height, Int frac,               Bool isLast, const ChromaFormat fmt, const Int bitDepth );
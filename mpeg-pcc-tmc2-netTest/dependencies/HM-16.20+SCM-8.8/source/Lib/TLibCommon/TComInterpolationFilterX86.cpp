@@ -0,0 +1,346 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComInterpolationFilterX86.cpp
+    \brief    AVX2 and AVX-512 kernels of TComInterpolationFilter, selected at run time
+*/
+
+#include "TComInterpolationFilter.h"
+
+#if VECTOR_CODING__RUNTIME_DISPATCH
+#include <immintrin.h>
+#endif
+namespace pcc_hm {
+
+//! \ingroup TLibCommon
+//! \{
+
+#if VECTOR_CODING__RUNTIME_DISPATCH
+
+// The kernels give the results of TComInterpolationFilter::filter() up to 10 bits. There the samples and the
+// intermediate values of the first filtering operation fit 16 bits: each 32-bit lane holds the samples of two taps,
+// multiplied by both taps at once with madd. The sums and rounding stay on 32 bits as in the C code.
+
+/// rounding, shift and clipping of a filtering operation, as in TComInterpolationFilter::filter()
+struct FilterRounding
+{
+  Int offset;
+  Int shift;
+  Int maxVal;
+
+  FilterRounding( Int bitDepth, Bool isFirst, Bool isLast )
+  {
+    const Int headRoom = std::max<Int>( 2, ( IF_INTERNAL_PREC - bitDepth ) );
+    shift = IF_FILTER_PREC;
+    if( isLast )
+    {
+      shift += isFirst ? 0 : headRoom;
+      offset = 1 << ( shift - 1 );
+      offset += isFirst ? 0 : IF_INTERNAL_OFFS << IF_FILTER_PREC;
+      maxVal = ( 1 << bitDepth ) - 1;
+    }
+    else
+    {
+      shift -= isFirst ? headRoom : 0;
+      offset = isFirst ? -IF_INTERNAL_OFFS << shift : 0;
+      maxVal = 0;
+    }
+  }
+};
+
+/// taps k and k + 1 in the low and high 16 bits
+static inline Int getTapPair( const TFilterCoeff* coeff, Int k )
+{
+  return ( coeff[k] & 0xFFFF ) | ( Int( coeff[k + 1] ) << 16 );
+}
+
+/// C filter of the columns from iCol to width of one row
+template< Int N, Bool isLast >
+static inline Void xFilterColumns( const Pel* src, Int cStride, Pel* dst, Int iCol, Int width, const TFilterCoeff* coeff, const FilterRounding& rounding )
+{
+  for( ; iCol < width; iCol++ )
+  {
+    Int sum = 0;
+    for( Int k = 0; k < N; k++ )
+    {
+      sum += src[iCol + k * cStride] * coeff[k];
+    }
+    Pel val = ( sum + rounding.offset ) >> rounding.shift;
+    if( isLast )
+    {
+      val = ( val < 0 ) ? 0 : val;
+      val = ( val > rounding.maxVal ) ? rounding.maxVal : val;
+    }
+    dst[iCol] = val;
+  }
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// AVX2
+// --------------------------------------------------------------------------------------------------------------------
+
+SIMD_TARGET_AVX2 static inline __m256i avx2LoadPel8( const Pel* piSrc )
+{
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  return _mm256_loadu_si256( ( const __m256i* )piSrc );
+#else
+  return _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* )piSrc ) );
+#endif
+}
+
+SIMD_TARGET_AVX2 static inline __m128i avx2LoadPel4( const Pel* piSrc )
+{
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  return _mm_loadu_si128( ( const __m128i* )piSrc );
+#else
+  return _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* )piSrc ) );
+#endif
+}
+
+SIMD_TARGET_AVX2 static inline Void avx2StorePel8( Pel* piDst, __m256i v )
+{
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  _mm256_storeu_si256( ( __m256i* )piDst, v );
+#else
+  _mm_storeu_si128( ( __m128i* )piDst, _mm_packs_epi32( _mm256_castsi256_si128( v ), _mm256_extracti128_si256( v, 1 ) ) );
+#endif
+}
+
+SIMD_TARGET_AVX2 static inline Void avx2StorePel4( Pel* piDst, __m128i v )
+{
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  _mm_storeu_si128( ( __m128i* )piDst, v );
+#else
+  _mm_storel_epi64( ( __m128i* )piDst, _mm_packs_epi32( v, v ) );
+#endif
+}
+
+/// 8 filtered samples from src on, the taps cStride apart
+template< Int N, Bool isLast >
+SIMD_TARGET_AVX2 static inline __m256i avx2Filter8( const Pel* src, Int cStride, const __m256i* tapPairs, __m256i offset, __m128i shift, __m256i maxVal )
+{
+  __m256i sum = _mm256_setzero_si256();
+  for( Int k = 0; k < N; k += 2 )
+  {
+    const __m256i pairs = _mm256_blend_epi16( avx2LoadPel8( src + k * cStride ), _mm256_slli_epi32( avx2LoadPel8( src + ( k + 1 ) * cStride ), 16 ), 0xAA );
+    sum = _mm256_add_epi32( sum, _mm256_madd_epi16( pairs, tapPairs[k >> 1] ) );
+  }
+  sum = _mm256_sra_epi32( _mm256_add_epi32( sum, offset ), shift );
+  if( isLast )
+  {
+    sum = _mm256_min_epi32( _mm256_max_epi32( sum, _mm256_setzero_si256() ), maxVal );
+  }
+  return sum;
+}
+
+template< Int N, Bool isLast >
+SIMD_TARGET_AVX2 static inline __m128i avx2Filter4( const Pel* src, Int cStride, const __m256i* tapPairs, __m256i offset, __m128i shift, __m256i maxVal )
+{
+  __m128i sum = _mm_setzero_si128();
+  for( Int k = 0; k < N; k += 2 )
+  {
+    const __m128i pairs = _mm_blend_epi16( avx2LoadPel4( src + k * cStride ), _mm_slli_epi32( avx2LoadPel4( src + ( k + 1 ) * cStride ), 16 ), 0xAA );
+    sum = _mm_add_epi32( sum, _mm_madd_epi16( pairs, _mm256_castsi256_si128( tapPairs[k >> 1] ) ) );
+  }
+  sum = _mm_sra_epi32( _mm_add_epi32( sum, _mm256_castsi256_si128( offset ) ), shift );
+  if( isLast )
+  {
+    sum = _mm_min_epi32( _mm_max_epi32( sum, _mm_setzero_si128() ), _mm256_castsi256_si128( maxVal ) );
+  }
+  return sum;
+}
+
+/// filter of the columns from iCol to width of one row, 8 and 4 at a time and the rest in C
+template< Int N, Bool isLast >
+SIMD_TARGET_AVX2 static inline Void avx2FilterColumns( const Pel* src, Int cStride, Pel* dst, Int iCol, Int width, const TFilterCoeff* coeff, const FilterRounding& rounding )
+{
+  __m256i tapPairs[N / 2];
+  for( Int k = 0; k < N; k += 2 )
+  {
+    tapPairs[k >> 1] = _mm256_set1_epi32( getTapPair( coeff, k ) );
+  }
+  const __m256i offset = _mm256_set1_epi32( rounding.offset );
+  const __m128i shift  = _mm_cvtsi32_si128( rounding.shift );
+  const __m256i maxVal = _mm256_set1_epi32( rounding.maxVal );
+
+  for( ; iCol + 8 <= width; iCol += 8 )
+  {
+    avx2StorePel8( dst + iCol, avx2Filter8<N, isLast>( src + iCol, cStride, tapPairs, offset, shift, maxVal ) );
+  }
+  if( iCol + 4 <= width )
+  {
+    avx2StorePel4( dst + iCol, avx2Filter4<N, isLast>( src + iCol, cStride, tapPairs, offset, shift, maxVal ) );
+    iCol += 4;
+  }
+  xFilterColumns<N, isLast>( src, cStride, dst, iCol, width, coeff, rounding );
+}
+
+template< Int N, Bool isVertical, Bool isFirst, Bool isLast >
+SIMD_TARGET_AVX2 static Void avx2Filter( Int bitDepth, Pel const* src, Int srcStride, Pel* dst, Int dstStride, Int width, Int height, TFilterCoeff const* coeff )
+{
+  const Int            cStride = isVertical ? srcStride : 1;
+  const FilterRounding rounding( bitDepth, isFirst, isLast );
+  src -= ( N / 2 - 1 ) * cStride;
+
+  for( Int row = 0; row < height; row++ )
+  {
+    avx2FilterColumns<N, isLast>( src, cStride, dst, 0, width, coeff, rounding );
+    src += srcStride;
+    dst += dstStride;
+  }
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// AVX-512
+// --------------------------------------------------------------------------------------------------------------------
+
+#if VECTOR_CODING__AVX512
+#if defined( __GNUC__ ) && !defined( __clang__ )
+// the AVX-512 intrinsic headers trigger false uninitialised warnings in GCC
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+SIMD_TARGET_AVX512 static inline __m512i avx512LoadPel16( const Pel* piSrc )
+{
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  return _mm512_loadu_si512( piSrc );
+#else
+  return _mm512_cvtepi16_epi32( _mm256_loadu_si256( ( const __m256i* )piSrc ) );
+#endif
+}
+
+SIMD_TARGET_AVX512 static inline Void avx512StorePel16( Pel* piDst, __m512i v )
+{
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  _mm512_storeu_si512( piDst, v );
+#else
+  _mm256_storeu_si256( ( __m256i* )piDst, _mm512_cvtepi32_epi16( v ) );
+#endif
+}
+
+/// 16 columns at a time, the rest as in AVX2
+template< Int N, Bool isVertical, Bool isFirst, Bool isLast >
+SIMD_TARGET_AVX512 static Void avx512Filter( Int bitDepth, Pel const* src, Int srcStride, Pel* dst, Int dstStride, Int width, Int height, TFilterCoeff const* coeff )
+{
+  if( width < 16 )
+  {
+    avx2Filter<N, isVertical, isFirst, isLast>( bitDepth, src, srcStride, dst, dstStride, width, height, coeff );
+    return;
+  }
+
+  const Int            cStride = isVertical ? srcStride : 1;
+  const FilterRounding rounding( bitDepth, isFirst, isLast );
+  src -= ( N / 2 - 1 ) * cStride;
+
+  __m512i tapPairs[N / 2];
+  for( Int k = 0; k < N; k += 2 )
+  {
+    tapPairs[k >> 1] = _mm512_set1_epi32( getTapPair( coeff, k ) );
+  }
+  const __m512i offset = _mm512_set1_epi32( rounding.offset );
+  const __m128i shift  = _mm_cvtsi32_si128( rounding.shift );
+  const __m512i maxVal = _mm512_set1_epi32( rounding.maxVal );
+
+  for( Int row = 0; row < height; row++ )
+  {
+    Int iCol = 0;
+    for( ; iCol + 16 <= width; iCol += 16 )
+    {
+      __m512i sum = _mm512_setzero_si512();
+      for( Int k = 0; k < N; k += 2 )
+      {
+        const __m512i pairs = _mm512_mask_blend_epi16( 0xAAAAAAAA, avx512LoadPel16( src + iCol + k * cStride ), _mm512_slli_epi32( avx512LoadPel16( src + iCol + ( k + 1 ) * cStride ), 16 ) );
+        sum = _mm512_add_epi32( sum, _mm512_madd_epi16( pairs, tapPairs[k >> 1] ) );
+      }
+      sum = _mm512_sra_epi32( _mm512_add_epi32( sum, offset ), shift );
+      if( isLast )
+      {
+        sum = _mm512_min_epi32( _mm512_max_epi32( sum, _mm512_setzero_si512() ), maxVal );
+      }
+      avx512StorePel16( dst + iCol, sum );
+    }
+    if( iCol < width )
+    {
+      avx2FilterColumns<N, isLast>( src, cStride, dst, iCol, width, coeff, rounding );
+    }
+    src += srcStride;
+    dst += dstStride;
+  }
+}
+
+#if defined( __GNUC__ ) && !defined( __clang__ )
+#pragma GCC diagnostic pop
+#endif
+#endif // VECTOR_CODING__AVX512
+
+// --------------------------------------------------------------------------------------------------------------------
+// Selection
+// --------------------------------------------------------------------------------------------------------------------
+
+template< Int N, Bool isVertical, Bool isFirst, Bool isLast >
+static FpInterpolationFilter xGetFilterX86( SimdExtension eExtension )
+{
+#if VECTOR_CODING__AVX512
+  if( eExtension >= SIMD_AVX512 )
+  {
+    return avx512Filter<N, isVertical, isFirst, isLast>;
+  }
+#endif
+  return eExtension >= SIMD_AVX2 ? avx2Filter<N, isVertical, isFirst, isLast> : NULL;
+}
+
+template< Int N >
+static Void xGetFiltersX86( SimdExtension eExtension, FpInterpolationFilter afpFilter[2][2][2] )
+{
+  // the horizontal filtering is always the first operation
+  afpFilter[false][false][false] = NULL;
+  afpFilter[false][false][true ] = NULL;
+  afpFilter[false][true ][false] = xGetFilterX86<N, false, true,  false>( eExtension );
+  afpFilter[false][true ][true ] = xGetFilterX86<N, false, true,  true >( eExtension );
+  afpFilter[true ][false][false] = xGetFilterX86<N, true,  false, false>( eExtension );
+  afpFilter[true ][false][true ] = xGetFilterX86<N, true,  false, true >( eExtension );
+  afpFilter[true ][true ][false] = xGetFilterX86<N, true,  true,  false>( eExtension );
+  afpFilter[true ][true ][true ] = xGetFilterX86<N, true,  true,  true >( eExtension );
+}
+
+Void TComInterpolationFilter::initInterpolationFilterX86( SimdExtension eExtension )
+{
+  xGetFiltersX86<NTAPS_LUMA  >( eExtension, m_afpFilterX86[false] );
+  xGetFiltersX86<NTAPS_CHROMA>( eExtension, m_afpFilterX86[true ] );
+}
+#endif
+
+//! \}
+
+} // namespace pcc_hm
@@ -41,7 +41,7 @@
 #include "TComRom.h"
 #include "TComRdCost.h"
 
-#if VECTOR_CODING__DISTORTION_CALCULATIONS && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+#if VECTOR_CODING__DISTORTION_CALCULATIONS
 #include <emmintrin.h>
 #include <xmmintrin.h>
 #endif
@@ -173,6 +173,10 @@ Void TComRdCost::init()
   m_afpDistortFunc[DF_HADS64 ] = TComRdCost::xGetHADs;
   m_afpDistortFunc[DF_HADS16N] = TComRdCost::xGetHADs;
 
+#if VECTOR_CODING__RUNTIME_DISPATCH
+  initRdCostX86( getSimdExtension() );
+#endif
+
   m_costMode                   = COST_STANDARD_LOSSY;
 
   m_motionLambda               = 0;
@@ -1196,12 +1200,151 @@ Distortion TComRdCost::xGetSAD48( DistParam* pcDtParam )
 // SSE
 // --------------------------------------------------------------------------------------------------------------------
 
+#if PCC_RDO_EXT
+#if VECTOR_CODING__DISTORTION_CALCULATIONS
+// 8 and 4 samples as 16-bit lanes, whatever the size of Pel; the samples must fit in 16 bits
+inline __m128i simdLoadPel8( const Pel * piSrc )
+{
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  return( _mm_packs_epi32( _mm_loadu_si128( ( __m128i* )piSrc ) , _mm_loadu_si128( ( __m128i* )( piSrc + 4 ) ) ) );
+#else
+  return( _mm_loadu_si128( ( __m128i* )piSrc ) );
+#endif
+}
+
+inline __m128i simdLoadPel4( const Pel * piSrc )
+{
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  return( _mm_packs_epi32( _mm_loadu_si128( ( __m128i* )piSrc ) , _mm_setzero_si128() ) );
+#else
+  return( _mm_loadl_epi64( ( __m128i* )piSrc ) );
+#endif
+}
+
+inline __m128i simdSquare16b( __m128i diff , UInt uiShift )
+{
+  if( uiShift == 0 )
+  {
+    return( _mm_madd_epi16( diff , diff ) );
+  }
+  // the squares are shifted one by one before they are summed, as in the scalar loops
+  __m128i lo = _mm_mullo_epi16( diff , diff );
+  __m128i hi = _mm_mulhi_epi16( diff , diff );
+  __m128i shift = _mm_cvtsi32_si128( uiShift );
+  return( _mm_add_epi32( _mm_srl_epi32( _mm_unpacklo_epi16( lo , hi ) , shift ) , _mm_srl_epi32( _mm_unpackhi_epi16( lo , hi ) , shift ) ) );
+}
+
+inline Distortion simdSSE4n( const Pel * piOrg , Int iStrideOrg , const Pel * piCur , Int iStrideCur , const Pel * piOccupancy , Int iStrideOccupancy , Int nWidth , Int nHeight , UInt uiShift )
+{
+  // internal bit-depth must be 10-bit or lower: the differences are taken on 16 bits and the squares of a line summed
+  // on 32 bits, the lines on 64 bits, which gives the scalar sum whether Distortion wraps at 32 or 64 bits
+  assert( !( nWidth & 0x03 ) );
+  __m128i zero = _mm_setzero_si128();
+  __m128i sum = zero;
+  __m128i line , diff;
+  for( ; nHeight != 0 ; nHeight-- )
+  {
+    line = zero;
+    Int n = 0;
+    for( ; n + 8 <= nWidth ; n += 8 )
+    {
+      diff = _mm_sub_epi16( simdLoadPel8( piOrg + n ) , simdLoadPel8( piCur + n ) );
+      if( piOccupancy != NULL )
+      {
+        diff = _mm_andnot_si128( _mm_cmpeq_epi16( simdLoadPel8( piOccupancy + n ) , zero ) , diff );
+      }
+      line = _mm_add_epi32( line , simdSquare16b( diff , uiShift ) );
+    }
+    if( n < nWidth )
+    {
+      diff = _mm_sub_epi16( simdLoadPel4( piOrg + n ) , simdLoadPel4( piCur + n ) );
+      if( piOccupancy != NULL )
+      {
+        diff = _mm_andnot_si128( _mm_cmpeq_epi16( simdLoadPel4( piOccupancy + n ) , zero ) , diff );
+      }
+      line = _mm_add_epi32( line , simdSquare16b( diff , uiShift ) );
+    }
+    sum = _mm_add_epi64( sum , _mm_add_epi64( _mm_unpacklo_epi32( line , zero ) , _mm_unpackhi_epi32( line , zero ) ) );
+    piOrg += iStrideOrg;
+    piCur += iStrideCur;
+    if( piOccupancy != NULL )
+    {
+      piOccupancy += iStrideOccupancy;
+    }
+  }
+  sum = _mm_add_epi64( sum , _mm_unpackhi_epi64( sum , sum ) );
+#if defined( _M_IX86 ) || ( defined( __i386__ ) && !defined( __x86_64__ ) )
+  UInt64 uiSum;
+  _mm_storel_epi64( ( __m128i* )&uiSum , sum );
+  return( Distortion( uiSum ) );
+#else
+  return( Distortion( _mm_cvtsi128_si64( sum ) ) );
+#endif
+}
+#endif
+
+/** SSE of all the block sizes, the samples of zero occupancy left out when the occupancy is given; a NULL occupancy
+ *  stands for a fully occupied block
+ */
+Distortion TComRdCost::xGetSSEOccupancy( DistParam* pcDtParam )
+{
+  const Pel* piOrg   = pcDtParam->pOrg;
+  const Pel* piCur   = pcDtParam->pCur;
+  const Pel* piOccupancy = pcDtParam->pOccupancy;
+  Int  iRows   = pcDtParam->iRows;
+  Int  iCols   = pcDtParam->iCols;
+  Int  iStrideOrg = pcDtParam->iStrideOrg;
+  Int  iStrideCur = pcDtParam->iStrideCur;
+  Int  iStrideOccupancy = pcDtParam->iStrideOccupancy;
+
+  Distortion uiSum   = 0;
+  UInt       uiShift = DISTORTION_PRECISION_ADJUSTMENT((pcDtParam->bitDepth-8) << 1);
+
+#if VECTOR_CODING__DISTORTION_CALCULATIONS
+  if( pcDtParam->bitDepth <= 10 && !( iCols & 0x03 ) )
+  {
+    return simdSSE4n( piOrg, iStrideOrg, piCur, iStrideCur, piOccupancy, iStrideOccupancy, iCols, iRows, uiShift );
+  }
+#endif
+
+  Intermediate_Int iTemp;
+
+  for( ; iRows != 0; iRows-- )
+  {
+    if ( piOccupancy != NULL )
+    {
+      for (Int n = 0; n < iCols; n++ )
+      {
+        iTemp = (piOrg[n] - piCur[n]) * ((piOccupancy[n] != 0) ? 1 : 0);
+        uiSum += Distortion(( iTemp * iTemp ) >> uiShift);
+      }
+      piOccupancy += iStrideOccupancy;
+    }
+    else
+    {
+      for (Int n = 0; n < iCols; n++ )
+      {
+        iTemp = piOrg[n] - piCur[n];
+        uiSum += Distortion(( iTemp * iTemp ) >> uiShift);
+      }
+    }
+    piOrg += iStrideOrg;
+    piCur += iStrideCur;
+  }
+
+  return ( uiSum );
+}
+#endif
+
 Distortion TComRdCost::xGetSSE( DistParam* pcDtParam )
 {
   if ( pcDtParam->bApplyWeight )
   {
     return TComRdCostWeightPrediction::xGetSSEw( pcDtParam );
   }
+#if PCC_RDO_EXT
+  return xGetSSEOccupancy( pcDtParam );
+#else
   const Pel* piOrg   = pcDtParam->pOrg;
   const Pel* piCur   = pcDtParam->pCur;
   Int  iRows   = pcDtParam->iRows;
@@ -1209,11 +1352,6 @@ Distortion TComRdCost::xGetSSE( DistParam* pcDtParam )
   Int  iStrideOrg = pcDtParam->iStrideOrg;
   Int  iStrideCur = pcDtParam->iStrideCur;
 
-#if PCC_RDO_EXT
-  const Pel* piOccupancy = pcDtParam->pOccupancy;
-  Int  iStrideOccupancy = pcDtParam->iStrideOccupancy;
-#endif
-
   Distortion uiSum   = 0;
   UInt       uiShift = DISTORTION_PRECISION_ADJUSTMENT((pcDtParam->bitDepth-8) << 1);
 
@@ -1223,21 +1361,15 @@ Distortion TComRdCost::xGetSSE( DistParam* pcDtParam )
   {
     for (Int n = 0; n < iCols; n++ )
     {
-#if PCC_RDO_EXT
-      iTemp = (piOrg[n] - piCur[n]) * ((piOccupancy[n] != 0) ? 1 : 0);
-#else
       iTemp = piOrg[n] - piCur[n];
-#endif
       uiSum += Distortion(( iTemp * iTemp ) >> uiShift);
     }
     piOrg += iStrideOrg;
     piCur += iStrideCur;
-#if PCC_RDO_EXT
-    piOccupancy += iStrideOccupancy;
-#endif
   }
 
   return ( uiSum );
+#endif
 }
 
 Distortion TComRdCost::xGetSSE4( DistParam* pcDtParam )
@@ -1247,15 +1379,14 @@ Distortion TComRdCost::xGetSSE4( DistParam* pcDtParam )
     assert( pcDtParam->iCols == 4 );
     return TComRdCostWeightPrediction::xGetSSEw( pcDtParam );
   }
+#if PCC_RDO_EXT
+  return xGetSSEOccupancy( pcDtParam );
+#else
   const Pel* piOrg   = pcDtParam->pOrg;
   const Pel* piCur   = pcDtParam->pCur;
   Int  iRows   = pcDtParam->iRows;
   Int  iStrideOrg = pcDtParam->iStrideOrg;
   Int  iStrideCur = pcDtParam->iStrideCur;
-#if PCC_RDO_EXT
-  const Pel* piOccupancy = pcDtParam->pOccupancy;
-  Int iStrideOccupancy = pcDtParam->iStrideOccupancy;
-#endif
 
   Distortion uiSum   = 0;
   UInt       uiShift = DISTORTION_PRECISION_ADJUSTMENT((pcDtParam->bitDepth-8) << 1);
@@ -1264,26 +1395,17 @@ Distortion TComRdCost::xGetSSE4( DistParam* pcDtParam )
 
   for( ; iRows != 0; iRows-- )
   {
-#if PCC_RDO_EXT
-    iTemp = (piOrg[0] - piCur[0]) * ((piOccupancy[0] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[1] - piCur[1]) * ((piOccupancy[1] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[2] - piCur[2]) * ((piOccupancy[2] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[3] - piCur[3]) * ((piOccupancy[3] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-#else
     iTemp = piOrg[0] - piCur[0]; uiSum += Distortion((iTemp * iTemp) >> uiShift);
     iTemp = piOrg[1] - piCur[1]; uiSum += Distortion((iTemp * iTemp) >> uiShift);
     iTemp = piOrg[2] - piCur[2]; uiSum += Distortion((iTemp * iTemp) >> uiShift);
     iTemp = piOrg[3] - piCur[3]; uiSum += Distortion((iTemp * iTemp) >> uiShift);
-#endif
 
     piOrg += iStrideOrg;
     piCur += iStrideCur;
-#if PCC_RDO_EXT
-    piOccupancy += iStrideOccupancy;
-#endif
   }
 
   return ( uiSum );
+#endif
 }
 
 Distortion TComRdCost::xGetSSE8( DistParam* pcDtParam )
@@ -1293,17 +1415,15 @@ Distortion TComRdCost::xGetSSE8( DistParam* pcDtParam )
     assert( pcDtParam->iCols == 8 );
     return TComRdCostWeightPrediction::xGetSSEw( pcDtParam );
   }
+#if PCC_RDO_EXT
+  return xGetSSEOccupancy( pcDtParam );
+#else
   const Pel* piOrg   = pcDtParam->pOrg;
   const Pel* piCur   = pcDtParam->pCur;
   Int  iRows   = pcDtParam->iRows;
   Int  iStrideOrg = pcDtParam->iStrideOrg;
   Int  iStrideCur = pcDtParam->iStrideCur;
 
-#if PCC_RDO_EXT
-  const Pel* piOccupancy = pcDtParam->pOccupancy;
-  Int iStrideOccupancy = pcDtParam->iStrideOccupancy;
-#endif
-
   Distortion uiSum   = 0;
   UInt       uiShift = DISTORTION_PRECISION_ADJUSTMENT((pcDtParam->bitDepth-8) << 1);
 
@@ -1311,16 +1431,6 @@ Distortion TComRdCost::xGetSSE8( DistParam* pcDtParam )
 
   for( ; iRows != 0; iRows-- )
   {
-#if PCC_RDO_EXT
-    iTemp = (piOrg[0] - piCur[0]) * ((piOccupancy[0] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[1] - piCur[1]) * ((piOccupancy[1] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[2] - piCur[2]) * ((piOccupancy[2] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[3] - piCur[3]) * ((piOccupancy[3] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[4] - piCur[4]) * ((piOccupancy[4] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[5] - piCur[5]) * ((piOccupancy[5] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[6] - piCur[6]) * ((piOccupancy[6] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[7] - piCur[7]) * ((piOccupancy[7] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-#else
     iTemp = piOrg[0] - piCur[0]; uiSum += Distortion((iTemp * iTemp) >> uiShift);
     iTemp = piOrg[1] - piCur[1]; uiSum += Distortion((iTemp * iTemp) >> uiShift);
     iTemp = piOrg[2] - piCur[2]; uiSum += Distortion((iTemp * iTemp) >> uiShift);
@@ -1329,16 +1439,13 @@ Distortion TComRdCost::xGetSSE8( DistParam* pcDtParam )
     iTemp = piOrg[5] - piCur[5]; uiSum += Distortion((iTemp * iTemp) >> uiShift);
     iTemp = piOrg[6] - piCur[6]; uiSum += Distortion((iTemp * iTemp) >> uiShift);
     iTemp = piOrg[7] - piCur[7]; uiSum += Distortion((iTemp * iTemp) >> uiShift);
-#endif
 
     piOrg += iStrideOrg;
     piCur += iStrideCur;
-#if PCC_RDO_EXT
-    piOccupancy += iStrideOccupancy;
-#endif
   }
 
   return ( uiSum );
+#endif
 }
 
 Distortion TComRdCost::xGetSSE16( DistParam* pcDtParam )
@@ -1348,17 +1455,15 @@ Distortion TComRdCost::xGetSSE16( DistParam* pcDtParam )
     assert( pcDtParam->iCols == 16 );
     return TComRdCostWeightPrediction::xGetSSEw( pcDtParam );
   }
+#if PCC_RDO_EXT
+  return xGetSSEOccupancy( pcDtParam );
+#else
   const Pel* piOrg   = pcDtParam->pOrg;
   const Pel* piCur   = pcDtParam->pCur;
   Int  iRows   = pcDtParam->iRows;
   Int  iStrideOrg = pcDtParam->iStrideOrg;
   Int  iStrideCur = pcDtParam->iStrideCur;
 
-#if PCC_RDO_EXT
-  const Pel* piOccupancy = pcDtParam->pOccupancy;
-  Int iStrideOccupancy = pcDtParam->iStrideOccupancy;
-#endif
-
   Distortion uiSum   = 0;
   UInt       uiShift = DISTORTION_PRECISION_ADJUSTMENT((pcDtParam->bitDepth-8) << 1);
 
@@ -1366,24 +1471,6 @@ Distortion TComRdCost::xGetSSE16( DistParam* pcDtParam )
 
   for( ; iRows != 0; iRows-- )
   {
-#if PCC_RDO_EXT
-    iTemp = (piOrg[0] - piCur[0]) * ((piOccupancy[0] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[1] - piCur[1]) * ((piOccupancy[1] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[2] - piCur[2]) * ((piOccupancy[2] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[3] - piCur[3]) * ((piOccupancy[3] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[4] - piCur[4]) * ((piOccupancy[4] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[5] - piCur[5]) * ((piOccupancy[5] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[6] - piCur[6]) * ((piOccupancy[6] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[7] - piCur[7]) * ((piOccupancy[7] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[8] - piCur[8]) * ((piOccupancy[8] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[9] - piCur[9]) * ((piOccupancy[9] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[10] - piCur[10]) * ((piOccupancy[10] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[11] - piCur[11]) * ((piOccupancy[11] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[12] - piCur[12]) * ((piOccupancy[12] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[13] - piCur[13]) * ((piOccupancy[13] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[14] - piCur[14]) * ((piOccupancy[14] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[15] - piCur[15]) * ((piOccupancy[15] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-#else
     iTemp = piOrg[0] - piCur[0]; uiSum += Distortion((iTemp * iTemp) >> uiShift);
     iTemp = piOrg[1] - piCur[1]; uiSum += Distortion((iTemp * iTemp) >> uiShift);
     iTemp = piOrg[2] - piCur[2]; uiSum += Distortion((iTemp * iTemp) >> uiShift);
@@ -1400,16 +1487,13 @@ Distortion TComRdCost::xGetSSE16( DistParam* pcDtParam )
     iTemp = piOrg[13] - piCur[13]; uiSum += Distortion((iTemp * iTemp) >> uiShift);
     iTemp = piOrg[14] - piCur[14]; uiSum += Distortion((iTemp * iTemp) >> uiShift);
     iTemp = piOrg[15] - piCur[15]; uiSum += Distortion((iTemp * iTemp) >> uiShift);
-#endif
 
     piOrg += iStrideOrg;
     piCur += iStrideCur;
-#if PCC_RDO_EXT
-    piOccupancy += iStrideOccupancy;
-#endif
   }
 
   return ( uiSum );
+#endif
 }
 
 Distortion TComRdCost::xGetSSE16N( DistParam* pcDtParam )
@@ -1418,6 +1502,9 @@ Distortion TComRdCost::xGetSSE16N( DistParam* pcDtParam )
   {
     return TComRdCostWeightPrediction::xGetSSEw( pcDtParam );
   }
+#if PCC_RDO_EXT
+  return xGetSSEOccupancy( pcDtParam );
+#else
   const Pel* piOrg   = pcDtParam->pOrg;
   const Pel* piCur   = pcDtParam->pCur;
   Int  iRows   = pcDtParam->iRows;
@@ -1425,11 +1512,6 @@ Distortion TComRdCost::xGetSSE16N( DistParam* pcDtParam )
   Int  iStrideOrg = pcDtParam->iStrideOrg;
   Int  iStrideCur = pcDtParam->iStrideCur;
 
-#if PCC_RDO_EXT
-  const Pel* piOccupancy = pcDtParam->pOccupancy;
-  Int  iStrideOccupancy = pcDtParam->iStrideOccupancy;
-#endif
-
   Distortion uiSum   = 0;
   UInt       uiShift = DISTORTION_PRECISION_ADJUSTMENT((pcDtParam->bitDepth-8) << 1);
 
@@ -1439,24 +1521,6 @@ Distortion TComRdCost::xGetSSE16N( DistParam* pcDtParam )
   {
     for (Int n = 0; n < iCols; n+=16 )
     {
-#if PCC_RDO_EXT
-      iTemp = (piOrg[n + 0] - piCur[n + 0]) * ((piOccupancy[n + 0] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-      iTemp = (piOrg[n + 1] - piCur[n + 1]) * ((piOccupancy[n + 1] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-      iTemp = (piOrg[n + 2] - piCur[n + 2]) * ((piOccupancy[n + 2] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-      iTemp = (piOrg[n + 3] - piCur[n + 3]) * ((piOccupancy[n + 3] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-      iTemp = (piOrg[n + 4] - piCur[n + 4]) * ((piOccupancy[n + 4] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-      iTemp = (piOrg[n + 5] - piCur[n + 5]) * ((piOccupancy[n + 5] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-      iTemp = (piOrg[n + 6] - piCur[n + 6]) * ((piOccupancy[n + 6] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-      iTemp = (piOrg[n + 7] - piCur[n + 7]) * ((piOccupancy[n + 7] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-      iTemp = (piOrg[n + 8] - piCur[n + 8]) * ((piOccupancy[n + 8] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-      iTemp = (piOrg[n + 9] - piCur[n + 9]) * ((piOccupancy[n + 9] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-      iTemp = (piOrg[n + 10] - piCur[n + 10]) * ((piOccupancy[n + 10] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-      iTemp = (piOrg[n + 11] - piCur[n + 11]) * ((piOccupancy[n + 11] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-      iTemp = (piOrg[n + 12] - piCur[n + 12]) * ((piOccupancy[n + 12] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-      iTemp = (piOrg[n + 13] - piCur[n + 13]) * ((piOccupancy[n + 13] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-      iTemp = (piOrg[n + 14] - piCur[n + 14]) * ((piOccupancy[n + 14] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-      iTemp = (piOrg[n + 15] - piCur[n + 15]) * ((piOccupancy[n + 15] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-#else
       iTemp = piOrg[n + 0] - piCur[n + 0]; uiSum += Distortion((iTemp * iTemp) >> uiShift);
       iTemp = piOrg[n + 1] - piCur[n + 1]; uiSum += Distortion((iTemp * iTemp) >> uiShift);
       iTemp = piOrg[n + 2] - piCur[n + 2]; uiSum += Distortion((iTemp * iTemp) >> uiShift);
@@ -1473,16 +1537,13 @@ Distortion TComRdCost::xGetSSE16N( DistParam* pcDtParam )
       iTemp = piOrg[n + 13] - piCur[n + 13]; uiSum += Distortion((iTemp * iTemp) >> uiShift);
       iTemp = piOrg[n + 14] - piCur[n + 14]; uiSum += Distortion((iTemp * iTemp) >> uiShift);
       iTemp = piOrg[n + 15] - piCur[n + 15]; uiSum += Distortion((iTemp * iTemp) >> uiShift);
-#endif
     }
     piOrg += iStrideOrg;
     piCur += iStrideCur;
-#if PCC_RDO_EXT
-    piOccupancy += iStrideOccupancy;
-#endif
   }
 
   return ( uiSum );
+#endif
 }
 
 Distortion TComRdCost::xGetSSE32( DistParam* pcDtParam )
@@ -1492,17 +1553,15 @@ Distortion TComRdCost::xGetSSE32( DistParam* pcDtParam )
     assert( pcDtParam->iCols == 32 );
     return TComRdCostWeightPrediction::xGetSSEw( pcDtParam );
   }
+#if PCC_RDO_EXT
+  return xGetSSEOccupancy( pcDtParam );
+#else
   const Pel* piOrg   = pcDtParam->pOrg;
   const Pel* piCur   = pcDtParam->pCur;
   Int  iRows   = pcDtParam->iRows;
   Int  iStrideOrg = pcDtParam->iStrideOrg;
   Int  iStrideCur = pcDtParam->iStrideCur;
 
-#if PCC_RDO_EXT
-  const Pel* piOccupancy = pcDtParam->pOccupancy;
-  Int  iStrideOccupancy = pcDtParam->iStrideOccupancy;
-#endif
-
   Distortion uiSum   = 0;
   UInt       uiShift = DISTORTION_PRECISION_ADJUSTMENT((pcDtParam->bitDepth-8) << 1);
 
@@ -1510,40 +1569,6 @@ Distortion TComRdCost::xGetSSE32( DistParam* pcDtParam )
 
   for( ; iRows != 0; iRows-- )
   {
-#if PCC_RDO_EXT
-    iTemp = (piOrg[0] - piCur[0]) * ((piOccupancy[0] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[1] - piCur[1]) * ((piOccupancy[1] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[2] - piCur[2]) * ((piOccupancy[2] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[3] - piCur[3]) * ((piOccupancy[3] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[4] - piCur[4]) * ((piOccupancy[4] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[5] - piCur[5]) * ((piOccupancy[5] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[6] - piCur[6]) * ((piOccupancy[6] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[7] - piCur[7]) * ((piOccupancy[7] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[8] - piCur[8]) * ((piOccupancy[8] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[9] - piCur[9]) * ((piOccupancy[9] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[10] - piCur[10]) * ((piOccupancy[10] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[11] - piCur[11]) * ((piOccupancy[11] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[12] - piCur[12]) * ((piOccupancy[12] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[13] - piCur[13]) * ((piOccupancy[13] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[14] - piCur[14]) * ((piOccupancy[14] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[15] - piCur[15]) * ((piOccupancy[15] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[16] - piCur[16]) * ((piOccupancy[16] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[17] - piCur[17]) * ((piOccupancy[17] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[18] - piCur[18]) * ((piOccupancy[18] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[19] - piCur[19]) * ((piOccupancy[19] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[20] - piCur[20]) * ((piOccupancy[20] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[21] - piCur[21]) * ((piOccupancy[21] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[22] - piCur[22]) * ((piOccupancy[22] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[23] - piCur[23]) * ((piOccupancy[23] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[24] - piCur[24]) * ((piOccupancy[24] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[25] - piCur[25]) * ((piOccupancy[25] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[26] - piCur[26]) * ((piOccupancy[26] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[27] - piCur[27]) * ((piOccupancy[27] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[28] - piCur[28]) * ((piOccupancy[28] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[29] - piCur[29]) * ((piOccupancy[29] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[30] - piCur[30]) * ((piOccupancy[30] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[31] - piCur[31]) * ((piOccupancy[31] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-#else
     iTemp = piOrg[0] - piCur[0]; uiSum += Distortion((iTemp * iTemp) >> uiShift);
     iTemp = piOrg[1] - piCur[1]; uiSum += Distortion((iTemp * iTemp) >> uiShift);
     iTemp = piOrg[2] - piCur[2]; uiSum += Distortion((iTemp * iTemp) >> uiShift);
@@ -1576,15 +1601,12 @@ Distortion TComRdCost::xGetSSE32( DistParam* pcDtParam )
     iTemp = piOrg[29] - piCur[29]; uiSum += Distortion((iTemp * iTemp) >> uiShift);
     iTemp = piOrg[30] - piCur[30]; uiSum += Distortion((iTemp * iTemp) >> uiShift);
     iTemp = piOrg[31] - piCur[31]; uiSum += Distortion((iTemp * iTemp) >> uiShift);
-#endif
     piOrg += iStrideOrg;
     piCur += iStrideCur;
-#if PCC_RDO_EXT
-    piOccupancy += iStrideOccupancy;
-#endif
   }
 
   return ( uiSum );
+#endif
 }
 
 Distortion TComRdCost::xGetSSE64( DistParam* pcDtParam )
@@ -1594,17 +1616,15 @@ Distortion TComRdCost::xGetSSE64( DistParam* pcDtParam )
     assert( pcDtParam->iCols == 64 );
     return TComRdCostWeightPrediction::xGetSSEw( pcDtParam );
   }
+#if PCC_RDO_EXT
+  return xGetSSEOccupancy( pcDtParam );
+#else
   const Pel* piOrg   = pcDtParam->pOrg;
   const Pel* piCur   = pcDtParam->pCur;
   Int  iRows   = pcDtParam->iRows;
   Int  iStrideOrg = pcDtParam->iStrideOrg;
   Int  iStrideCur = pcDtParam->iStrideCur;
 
-#if PCC_RDO_EXT
-  const Pel* piOccupancy = pcDtParam->pOccupancy;
-  Int  iStrideOccupancy = pcDtParam->iStrideOccupancy;
-#endif
-
   Distortion uiSum   = 0;
   UInt       uiShift = DISTORTION_PRECISION_ADJUSTMENT((pcDtParam->bitDepth-8) << 1);
 
@@ -1612,72 +1632,6 @@ Distortion TComRdCost::xGetSSE64( DistParam* pcDtParam )
 
   for( ; iRows != 0; iRows-- )
   {
-#if PCC_RDO_EXT
-    iTemp = (piOrg[0] - piCur[0]) * ((piOccupancy[0] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[1] - piCur[1]) * ((piOccupancy[1] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[2] - piCur[2]) * ((piOccupancy[2] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[3] - piCur[3]) * ((piOccupancy[3] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[4] - piCur[4]) * ((piOccupancy[4] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[5] - piCur[5]) * ((piOccupancy[5] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[6] - piCur[6]) * ((piOccupancy[6] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[7] - piCur[7]) * ((piOccupancy[7] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[8] - piCur[8]) * ((piOccupancy[8] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[9] - piCur[9]) * ((piOccupancy[9] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[10] - piCur[10]) * ((piOccupancy[10] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[11] - piCur[11]) * ((piOccupancy[11] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[12] - piCur[12]) * ((piOccupancy[12] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[13] - piCur[13]) * ((piOccupancy[13] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[14] - piCur[14]) * ((piOccupancy[14] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[15] - piCur[15]) * ((piOccupancy[15] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[16] - piCur[16]) * ((piOccupancy[16] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[17] - piCur[17]) * ((piOccupancy[17] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[18] - piCur[18]) * ((piOccupancy[18] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[19] - piCur[19]) * ((piOccupancy[19] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[20] - piCur[20]) * ((piOccupancy[20] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[21] - piCur[21]) * ((piOccupancy[21] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[22] - piCur[22]) * ((piOccupancy[22] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[23] - piCur[23]) * ((piOccupancy[23] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[24] - piCur[24]) * ((piOccupancy[24] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[25] - piCur[25]) * ((piOccupancy[25] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[26] - piCur[26]) * ((piOccupancy[26] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[27] - piCur[27]) * ((piOccupancy[27] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[28] - piCur[28]) * ((piOccupancy[28] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[29] - piCur[29]) * ((piOccupancy[29] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[30] - piCur[30]) * ((piOccupancy[30] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[31] - piCur[31]) * ((piOccupancy[31] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[32] - piCur[32]) * ((piOccupancy[32] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[33] - piCur[33]) * ((piOccupancy[33] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[34] - piCur[34]) * ((piOccupancy[34] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[35] - piCur[35]) * ((piOccupancy[35] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[36] - piCur[36]) * ((piOccupancy[36] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[37] - piCur[37]) * ((piOccupancy[37] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[38] - piCur[38]) * ((piOccupancy[38] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[39] - piCur[39]) * ((piOccupancy[39] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[40] - piCur[40]) * ((piOccupancy[40] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[41] - piCur[41]) * ((piOccupancy[41] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[42] - piCur[42]) * ((piOccupancy[42] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[43] - piCur[43]) * ((piOccupancy[43] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[44] - piCur[44]) * ((piOccupancy[44] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[45] - piCur[45]) * ((piOccupancy[45] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[46] - piCur[46]) * ((piOccupancy[46] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[47] - piCur[47]) * ((piOccupancy[47] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[48] - piCur[48]) * ((piOccupancy[48] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[49] - piCur[49]) * ((piOccupancy[49] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[50] - piCur[50]) * ((piOccupancy[50] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[51] - piCur[51]) * ((piOccupancy[51] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[52] - piCur[52]) * ((piOccupancy[52] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[53] - piCur[53]) * ((piOccupancy[53] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[54] - piCur[54]) * ((piOccupancy[54] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[55] - piCur[55]) * ((piOccupancy[55] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[56] - piCur[56]) * ((piOccupancy[56] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[57] - piCur[57]) * ((piOccupancy[57] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[58] - piCur[58]) * ((piOccupancy[58] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[59] - piCur[59]) * ((piOccupancy[59] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[60] - piCur[60]) * ((piOccupancy[60] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[61] - piCur[61]) * ((piOccupancy[61] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[62] - piCur[62]) * ((piOccupancy[62] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-    iTemp = (piOrg[63] - piCur[63]) * ((piOccupancy[63] != 0) ? 1 : 0); uiSum += Distortion((iTemp * iTemp) >> uiShift);
-#else
     iTemp = piOrg[0] - piCur[0]; uiSum += Distortion((iTemp * iTemp) >> uiShift);
     iTemp = piOrg[1] - piCur[1]; uiSum += Distortion((iTemp * iTemp) >> uiShift);
     iTemp = piOrg[2] - piCur[2]; uiSum += Distortion((iTemp * iTemp) >> uiShift);
@@ -1742,16 +1696,13 @@ Distortion TComRdCost::xGetSSE64( DistParam* pcDtParam )
     iTemp = piOrg[61] - piCur[61]; uiSum += Distortion((iTemp * iTemp) >> uiShift);
     iTemp = piOrg[62] - piCur[62]; uiSum += Distortion((iTemp * iTemp) >> uiShift);
     iTemp = piOrg[63] - piCur[63]; uiSum += Distortion((iTemp * iTemp) >> uiShift);
-#endif
 
     piOrg += iStrideOrg;
     piCur += iStrideCur;
-#if PCC_RDO_EXT
-    piOccupancy += iStrideOccupancy;
-#endif
   }
 
   return ( uiSum );
+#endif
 }
 
 // --------------------------------------------------------------------------------------------------------------------
@@ -45,6 +45,7 @@
 
 #include "TComSlice.h"
 #include "TComRdCostWeightPrediction.h"
+#include "TComSimd.h"
 namespace pcc_hm {
 
 //! \ingroup TLibCommon
@@ -265,6 +266,9 @@ private:
   static Distortion xGetSSE32         ( DistParam* pcDtParam );
   static Distortion xGetSSE64         ( DistParam* pcDtParam );
   static Distortion xGetSSE16N        ( DistParam* pcDtParam );
+#if PCC_RDO_EXT
+  static Distortion xGetSSEOccupancy  ( DistParam* pcDtParam );
+#endif
 
   static Distortion xGetSAD           ( DistParam* pcDtParam );
   static Distortion xGetSAD4          ( DistParam* pcDtParam );
@@ -287,6 +291,10 @@ private:
 #endif
                                       );
 
+#if VECTOR_CODING__RUNTIME_DISPATCH
+  Void initRdCostX86( SimdExtension eExtension );   ///< in TComRdCostX86.cpp
+#endif
+
 public:
 #if PCC_RDO_EXT
   Distortion   getDistPart(Int bitDepth, const Pel* piCur, Int iCurStride, const Pel* piOrg, Int iOrgStride, UInt uiBlkWidth, UInt uiBlkHeight, const ComponentID compID, DFunc eDFunc = DF_SSE, const Pel* piOccupancy = NULL, Int iOccupancyStride = 0);
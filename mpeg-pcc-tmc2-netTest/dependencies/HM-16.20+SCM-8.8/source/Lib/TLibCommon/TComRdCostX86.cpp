@@ -0,0 +1,739 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComRdCostX86.cpp
+    \brief    AVX2 and AVX-512 distortion kernels of TComRdCost, selected at run time
+*/
+
+#include "TComRdCost.h"
+
+#if VECTOR_CODING__RUNTIME_DISPATCH
+#include <immintrin.h>
+#endif
+namespace pcc_hm {
+
+//! \ingroup TLibCommon
+//! \{
+
+#if VECTOR_CODING__RUNTIME_DISPATCH
+
+// The kernels give the results of the C functions they replace, for every bit depth: the samples are handled as 32-bit
+// lanes whatever the size of Pel, 32-bit lane sums are moved to 64 bits before they can overflow, and the squares are
+// taken on 16 bits only when the differences fit.
+
+// --------------------------------------------------------------------------------------------------------------------
+// AVX2 helpers
+// --------------------------------------------------------------------------------------------------------------------
+
+SIMD_TARGET_AVX2 static inline __m256i avx2LoadPel8( const Pel* piSrc )
+{
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  return _mm256_loadu_si256( ( const __m256i* )piSrc );
+#else
+  return _mm256_cvtepi16_epi32( _mm_loadu_si128( ( const __m128i* )piSrc ) );
+#endif
+}
+
+SIMD_TARGET_AVX2 static inline __m128i avx2LoadPel4( const Pel* piSrc )
+{
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  return _mm_loadu_si128( ( const __m128i* )piSrc );
+#else
+  return _mm_cvtepi16_epi32( _mm_loadl_epi64( ( const __m128i* )piSrc ) );
+#endif
+}
+
+SIMD_TARGET_AVX2 static inline UInt64 avx2SumU64( __m256i v )
+{
+  __m128i sum = _mm_add_epi64( _mm256_castsi256_si128( v ), _mm256_extracti128_si256( v, 1 ) );
+  sum = _mm_add_epi64( sum, _mm_unpackhi_epi64( sum, sum ) );
+  UInt64 uiSum;
+  _mm_storel_epi64( ( __m128i* )&uiSum, sum );
+  return uiSum;
+}
+
+/// unsigned 32-bit lanes, of a 256-bit and a 128-bit register, added to 64-bit lanes
+SIMD_TARGET_AVX2 static inline __m256i avx2WidenU32( __m256i sum64, __m256i v, __m128i v4 )
+{
+  const __m256i zero = _mm256_setzero_si256();
+  v = _mm256_add_epi64( _mm256_unpacklo_epi32( v, zero ), _mm256_unpackhi_epi32( v, zero ) );
+  v4 = _mm_add_epi64( _mm_unpacklo_epi32( v4, _mm_setzero_si128() ), _mm_unpackhi_epi32( v4, _mm_setzero_si128() ) );
+  return _mm256_add_epi64( _mm256_add_epi64( sum64, v ), _mm256_inserti128_si256( zero, v4, 0 ) );
+}
+
+/// differences of 8 samples, zeroed where the occupancy is
+SIMD_TARGET_AVX2 static inline __m256i avx2Diff8( const Pel* piOrg, const Pel* piCur, const Pel* piOccupancy )
+{
+  __m256i diff = _mm256_sub_epi32( avx2LoadPel8( piOrg ), avx2LoadPel8( piCur ) );
+  if( piOccupancy != NULL )
+  {
+    diff = _mm256_andnot_si256( _mm256_cmpeq_epi32( avx2LoadPel8( piOccupancy ), _mm256_setzero_si256() ), diff );
+  }
+  return diff;
+}
+
+SIMD_TARGET_AVX2 static inline __m128i avx2Diff4( const Pel* piOrg, const Pel* piCur, const Pel* piOccupancy )
+{
+  __m128i diff = _mm_sub_epi32( avx2LoadPel4( piOrg ), avx2LoadPel4( piCur ) );
+  if( piOccupancy != NULL )
+  {
+    diff = _mm_andnot_si128( _mm_cmpeq_epi32( avx2LoadPel4( piOccupancy ), _mm_setzero_si128() ), diff );
+  }
+  return diff;
+}
+
+/// squares of 8 differences, each shifted right, added to 64-bit lanes
+SIMD_TARGET_AVX2 static inline __m256i avx2AddSquares64( __m256i sum64, __m256i diff, __m128i shift )
+{
+  __m256i even = _mm256_srl_epi64( _mm256_mul_epi32( diff, diff ), shift );
+  __m256i odd  = _mm256_srli_epi64( diff, 32 );
+  odd = _mm256_srl_epi64( _mm256_mul_epi32( odd, odd ), shift );
+  return _mm256_add_epi64( sum64, _mm256_add_epi64( even, odd ) );
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// AVX2 SAD
+// --------------------------------------------------------------------------------------------------------------------
+
+/** SAD of iWidth columns (pcDtParam->iCols if iWidth is 0) on every (1 << iSubShift)-th row, scaled back as in the C
+ *  code; with bEarlyExit the sum is checked against m_maximumDistortionForEarlyExit after each row, as xGetSAD does
+ */
+template< Int iWidth >
+SIMD_TARGET_AVX2 static Distortion avx2SAD( const DistParam* pcDtParam, Int iSubShift, Bool bEarlyExit )
+{
+  const Pel* piOrg           = pcDtParam->pOrg;
+  const Pel* piCur           = pcDtParam->pCur;
+  const Int  iCols           = iWidth ? iWidth : pcDtParam->iCols;
+  const Int  iSubStep        = 1 << iSubShift;
+  const Int  iStrideOrg      = pcDtParam->iStrideOrg * iSubStep;
+  const Int  iStrideCur      = pcDtParam->iStrideCur * iSubStep;
+  const UInt distortionShift = DISTORTION_PRECISION_ADJUSTMENT( pcDtParam->bitDepth - 8 );
+  // a lane takes at most iCols / 8 + 1 differences of less than 2^16 a row
+  const Int  iFlushRows      = bEarlyExit ? 1 : std::max( 1, 0xFFFF / ( ( iCols >> 3 ) + 1 ) );
+
+  Distortion uiSum  = 0;
+  __m256i    sum64  = _mm256_setzero_si256();
+  __m256i    sum    = _mm256_setzero_si256();
+  __m128i    sum4   = _mm_setzero_si128();
+  Int        iCount = 0;
+
+  for( Int iRows = pcDtParam->iRows; iRows != 0; iRows -= iSubStep )
+  {
+    Int n = 0;
+    for( ; n + 8 <= iCols; n += 8 )
+    {
+      sum = _mm256_add_epi32( sum, _mm256_abs_epi32( _mm256_sub_epi32( avx2LoadPel8( piOrg + n ), avx2LoadPel8( piCur + n ) ) ) );
+    }
+    if( n + 4 <= iCols )
+    {
+      sum4 = _mm_add_epi32( sum4, _mm_abs_epi32( _mm_sub_epi32( avx2LoadPel4( piOrg + n ), avx2LoadPel4( piCur + n ) ) ) );
+      n += 4;
+    }
+    for( ; n < iCols; n++ )
+    {
+      uiSum += abs( piOrg[n] - piCur[n] );
+    }
+    piOrg += iStrideOrg;
+    piCur += iStrideCur;
+
+    if( ++iCount == iFlushRows )
+    {
+      sum64  = avx2WidenU32( sum64, sum, sum4 );
+      sum    = _mm256_setzero_si256();
+      sum4   = _mm_setzero_si128();
+      iCount = 0;
+      if( bEarlyExit && pcDtParam->m_maximumDistortionForEarlyExit < ( ( uiSum + Distortion( avx2SumU64( sum64 ) ) ) >> distortionShift ) )
+      {
+        return ( uiSum + Distortion( avx2SumU64( sum64 ) ) ) >> distortionShift;
+      }
+    }
+  }
+
+  uiSum += Distortion( avx2SumU64( avx2WidenU32( sum64, sum, sum4 ) ) );
+  uiSum <<= iSubShift;
+  return ( uiSum >> distortionShift );
+}
+
+SIMD_TARGET_AVX2 static Distortion avx2GetSAD( DistParam* pcDtParam )
+{
+  if ( pcDtParam->bApplyWeight )
+  {
+    return TComRdCostWeightPrediction::xGetSADw( pcDtParam );
+  }
+  Bool bEarlyExit = pcDtParam->m_maximumDistortionForEarlyExit != std::numeric_limits<Distortion>::max();
+#if VECTOR_CODING__DISTORTION_CALCULATIONS && (RExt__HIGH_BIT_DEPTH_SUPPORT==0)
+  // the SSE2 path of xGetSAD does not stop early
+  bEarlyExit = bEarlyExit && pcDtParam->bitDepth > 10;
+#endif
+  return avx2SAD<0>( pcDtParam, 0, bEarlyExit );
+}
+
+template< Int iWidth >
+SIMD_TARGET_AVX2 static Distortion avx2GetSADN( DistParam* pcDtParam )
+{
+  if ( pcDtParam->bApplyWeight )
+  {
+    return TComRdCostWeightPrediction::xGetSADw( pcDtParam );
+  }
+  return avx2SAD<iWidth>( pcDtParam, pcDtParam->iSubShift, false );
+}
+
+// as xGetSAD16N, which does not apply the weighted prediction
+SIMD_TARGET_AVX2 static Distortion avx2GetSAD16N( DistParam* pcDtParam )
+{
+  return avx2SAD<0>( pcDtParam, pcDtParam->iSubShift, false );
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// AVX2 SSE
+// --------------------------------------------------------------------------------------------------------------------
+
+/// SSE of iWidth columns (pcDtParam->iCols if iWidth is 0), leaving out the samples of zero occupancy if it is given
+template< Int iWidth >
+SIMD_TARGET_AVX2 static Distortion avx2SSE( const DistParam* pcDtParam )
+{
+  const Pel* piOrg       = pcDtParam->pOrg;
+  const Pel* piCur       = pcDtParam->pCur;
+  const Int  iCols       = iWidth ? iWidth : pcDtParam->iCols;
+  const Int  iStrideOrg  = pcDtParam->iStrideOrg;
+  const Int  iStrideCur  = pcDtParam->iStrideCur;
+#if PCC_RDO_EXT
+  const Pel* piOccupancy = pcDtParam->pOccupancy;
+  const Int  iStrideOccupancy = pcDtParam->iStrideOccupancy;
+#else
+  const Pel* piOccupancy = NULL;
+  const Int  iStrideOccupancy = 0;
+#endif
+  const UInt uiShift     = DISTORTION_PRECISION_ADJUSTMENT( ( pcDtParam->bitDepth - 8 ) << 1 );
+
+  Distortion uiSum = 0;
+  __m256i    sum64 = _mm256_setzero_si256();
+
+  if( uiShift == 0 && pcDtParam->bitDepth <= 10 )
+  {
+    // differences on 16 bits, pairs of squares of less than 2^21 summed on 32-bit lanes, a lane taking at most
+    // iCols / 8 + 1 pairs a row
+    const Int iFlushRows = std::max( 1, 2047 / ( ( iCols >> 3 ) + 1 ) );
+    __m256i   sum        = _mm256_setzero_si256();
+    __m128i   sum4       = _mm_setzero_si128();
+    Int       iCount     = 0;
+    for( Int iRows = pcDtParam->iRows; iRows != 0; iRows-- )
+    {
+      Int n = 0;
+      for( ; n + 16 <= iCols; n += 16 )
+      {
+        __m256i diff = _mm256_packs_epi32( avx2Diff8( piOrg + n, piCur + n, piOccupancy ? piOccupancy + n : NULL ),
+                                           avx2Diff8( piOrg + n + 8, piCur + n + 8, piOccupancy ? piOccupancy + n + 8 : NULL ) );
+        sum = _mm256_add_epi32( sum, _mm256_madd_epi16( diff, diff ) );
+      }
+      if( n + 8 <= iCols )
+      {
+        __m256i diff = _mm256_packs_epi32( avx2Diff8( piOrg + n, piCur + n, piOccupancy ? piOccupancy + n : NULL ), _mm256_setzero_si256() );
+        sum = _mm256_add_epi32( sum, _mm256_madd_epi16( diff, diff ) );
+        n += 8;
+      }
+      if( n + 4 <= iCols )
+      {
+        __m128i diff = _mm_packs_epi32( avx2Diff4( piOrg + n, piCur + n, piOccupancy ? piOccupancy + n : NULL ), _mm_setzero_si128() );
+        sum4 = _mm_add_epi32( sum4, _mm_madd_epi16( diff, diff ) );
+        n += 4;
+      }
+      for( ; n < iCols; n++ )
+      {
+        const Intermediate_Int iTemp = piOccupancy == NULL || piOccupancy[n] != 0 ? piOrg[n] - piCur[n] : 0;
+        uiSum += Distortion( iTemp * iTemp );
+      }
+      piOrg += iStrideOrg;
+      piCur += iStrideCur;
+      if( piOccupancy != NULL )
+      {
+        piOccupancy += iStrideOccupancy;
+      }
+      if( ++iCount == iFlushRows )
+      {
+        sum64  = avx2WidenU32( sum64, sum, sum4 );
+        sum    = _mm256_setzero_si256();
+        sum4   = _mm_setzero_si128();
+        iCount = 0;
+      }
+    }
+    sum64 = avx2WidenU32( sum64, sum, sum4 );
+  }
+  else
+  {
+    // squares on 64 bits, each shifted as in the C code
+    const __m128i shift = _mm_cvtsi32_si128( uiShift );
+    for( Int iRows = pcDtParam->iRows; iRows != 0; iRows-- )
+    {
+      Int n = 0;
+      for( ; n + 8 <= iCols; n += 8 )
+      {
+        sum64 = avx2AddSquares64( sum64, avx2Diff8( piOrg + n, piCur + n, piOccupancy ? piOccupancy + n : NULL ), shift );
+      }
+      if( n + 4 <= iCols )
+      {
+        sum64 = avx2AddSquares64( sum64, _mm256_inserti128_si256( _mm256_setzero_si256(), avx2Diff4( piOrg + n, piCur + n, piOccupancy ? piOccupancy + n : NULL ), 0 ), shift );
+        n += 4;
+      }
+      for( ; n < iCols; n++ )
+      {
+        const Intermediate_Int iTemp = piOccupancy == NULL || piOccupancy[n] != 0 ? piOrg[n] - piCur[n] : 0;
+        uiSum += Distortion( ( iTemp * iTemp ) >> uiShift );
+      }
+      piOrg += iStrideOrg;
+      piCur += iStrideCur;
+      if( piOccupancy != NULL )
+      {
+        piOccupancy += iStrideOccupancy;
+      }
+    }
+  }
+
+  return uiSum + Distortion( avx2SumU64( sum64 ) );
+}
+
+template< Int iWidth >
+SIMD_TARGET_AVX2 static Distortion avx2GetSSE( DistParam* pcDtParam )
+{
+  if ( pcDtParam->bApplyWeight )
+  {
+    return TComRdCostWeightPrediction::xGetSSEw( pcDtParam );
+  }
+  return avx2SSE<iWidth>( pcDtParam );
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// AVX2 Hadamard
+// --------------------------------------------------------------------------------------------------------------------
+
+/// 8-point Hadamard transforms across the registers
+SIMD_TARGET_AVX2 static inline Void avx2Hadamard8( __m256i m[8] )
+{
+  __m256i t[8];
+  for( Int k = 0; k < 4; k++ )
+  {
+    t[k]     = _mm256_add_epi32( m[k], m[k + 4] );
+    t[k + 4] = _mm256_sub_epi32( m[k], m[k + 4] );
+  }
+  for( Int k = 0; k < 8; k += 4 )
+  {
+    m[k]     = _mm256_add_epi32( t[k],     t[k + 2] );
+    m[k + 1] = _mm256_add_epi32( t[k + 1], t[k + 3] );
+    m[k + 2] = _mm256_sub_epi32( t[k],     t[k + 2] );
+    m[k + 3] = _mm256_sub_epi32( t[k + 1], t[k + 3] );
+  }
+  for( Int k = 0; k < 8; k += 2 )
+  {
+    t[k]     = _mm256_add_epi32( m[k], m[k + 1] );
+    t[k + 1] = _mm256_sub_epi32( m[k], m[k + 1] );
+  }
+  for( Int k = 0; k < 8; k++ )
+  {
+    m[k] = t[k];
+  }
+}
+
+SIMD_TARGET_AVX2 static inline Void avx2Transpose8x8( __m256i m[8] )
+{
+  __m256i a[8], b[8];
+  for( Int k = 0; k < 8; k += 2 )
+  {
+    a[k]     = _mm256_unpacklo_epi32( m[k], m[k + 1] );
+    a[k + 1] = _mm256_unpackhi_epi32( m[k], m[k + 1] );
+  }
+  for( Int k = 0; k < 8; k += 4 )
+  {
+    b[k]     = _mm256_unpacklo_epi64( a[k],     a[k + 2] );
+    b[k + 1] = _mm256_unpackhi_epi64( a[k],     a[k + 2] );
+    b[k + 2] = _mm256_unpacklo_epi64( a[k + 1], a[k + 3] );
+    b[k + 3] = _mm256_unpackhi_epi64( a[k + 1], a[k + 3] );
+  }
+  for( Int k = 0; k < 4; k++ )
+  {
+    m[k]     = _mm256_permute2x128_si256( b[k], b[k + 4], 0x20 );
+    m[k + 4] = _mm256_permute2x128_si256( b[k], b[k + 4], 0x31 );
+  }
+}
+
+SIMD_TARGET_AVX2 static Distortion avx2HADs8x8( const Pel* piOrg, const Pel* piCur, Int iStrideOrg, Int iStrideCur )
+{
+  __m256i m[8];
+  for( Int k = 0; k < 8; k++, piOrg += iStrideOrg, piCur += iStrideCur )
+  {
+    m[k] = _mm256_sub_epi32( avx2LoadPel8( piOrg ), avx2LoadPel8( piCur ) );
+  }
+  avx2Hadamard8( m );
+  avx2Transpose8x8( m );
+  avx2Hadamard8( m );
+
+  __m256i sum = _mm256_abs_epi32( m[0] );
+  for( Int k = 1; k < 8; k++ )
+  {
+    sum = _mm256_add_epi32( sum, _mm256_abs_epi32( m[k] ) );
+  }
+  const Distortion sad = Distortion( avx2SumU64( avx2WidenU32( _mm256_setzero_si256(), sum, _mm_setzero_si128() ) ) );
+  return ( sad + 2 ) >> 2;
+}
+
+SIMD_TARGET_AVX2 static inline Void avx2Hadamard4( __m128i m[4] )
+{
+  const __m128i t0 = _mm_add_epi32( m[0], m[2] );
+  const __m128i t1 = _mm_add_epi32( m[1], m[3] );
+  const __m128i t2 = _mm_sub_epi32( m[0], m[2] );
+  const __m128i t3 = _mm_sub_epi32( m[1], m[3] );
+  m[0] = _mm_add_epi32( t0, t1 );
+  m[1] = _mm_sub_epi32( t0, t1 );
+  m[2] = _mm_add_epi32( t2, t3 );
+  m[3] = _mm_sub_epi32( t2, t3 );
+}
+
+SIMD_TARGET_AVX2 static Distortion avx2HADs4x4( const Pel* piOrg, const Pel* piCur, Int iStrideOrg, Int iStrideCur )
+{
+  __m128i m[4];
+  for( Int k = 0; k < 4; k++, piOrg += iStrideOrg, piCur += iStrideCur )
+  {
+    m[k] = _mm_sub_epi32( avx2LoadPel4( piOrg ), avx2LoadPel4( piCur ) );
+  }
+  avx2Hadamard4( m );
+  const __m128i a0 = _mm_unpacklo_epi32( m[0], m[1] );
+  const __m128i a1 = _mm_unpackhi_epi32( m[0], m[1] );
+  const __m128i a2 = _mm_unpacklo_epi32( m[2], m[3] );
+  const __m128i a3 = _mm_unpackhi_epi32( m[2], m[3] );
+  m[0] = _mm_unpacklo_epi64( a0, a2 );
+  m[1] = _mm_unpackhi_epi64( a0, a2 );
+  m[2] = _mm_unpacklo_epi64( a1, a3 );
+  m[3] = _mm_unpackhi_epi64( a1, a3 );
+  avx2Hadamard4( m );
+
+  __m128i sum = _mm_add_epi32( _mm_add_epi32( _mm_abs_epi32( m[0] ), _mm_abs_epi32( m[1] ) ),
+                               _mm_add_epi32( _mm_abs_epi32( m[2] ), _mm_abs_epi32( m[3] ) ) );
+  sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+  sum = _mm_add_epi32( sum, _mm_shuffle_epi32( sum, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+  const Distortion satd = Distortion( UInt( _mm_cvtsi128_si32( sum ) ) );
+  return ( satd + 1 ) >> 1;
+}
+
+static Distortion xHADs2x2( const Pel* piOrg, const Pel* piCur, Int iStrideOrg, Int iStrideCur )
+{
+  const TCoeff m0 = ( piOrg[0] - piCur[0] ) + ( piOrg[iStrideOrg]     - piCur[iStrideCur]     );
+  const TCoeff m1 = ( piOrg[1] - piCur[1] ) + ( piOrg[iStrideOrg + 1] - piCur[iStrideCur + 1] );
+  const TCoeff m2 = ( piOrg[0] - piCur[0] ) - ( piOrg[iStrideOrg]     - piCur[iStrideCur]     );
+  const TCoeff m3 = ( piOrg[1] - piCur[1] ) - ( piOrg[iStrideOrg + 1] - piCur[iStrideCur + 1] );
+  return Distortion( abs( m0 + m1 ) ) + Distortion( abs( m0 - m1 ) ) + Distortion( abs( m2 + m3 ) ) + Distortion( abs( m2 - m3 ) );
+}
+
+/// as xGetHADs: 8x8 transforms when the size allows, otherwise 4x4, otherwise 2x2, otherwise none
+SIMD_TARGET_AVX2 static Distortion avx2GetHADs( DistParam* pcDtParam )
+{
+  if ( pcDtParam->bApplyWeight )
+  {
+    return TComRdCostWeightPrediction::xGetHADsw( pcDtParam );
+  }
+  const Pel* piOrg      = pcDtParam->pOrg;
+  const Pel* piCur      = pcDtParam->pCur;
+  const Int  iRows      = pcDtParam->iRows;
+  const Int  iCols      = pcDtParam->iCols;
+  const Int  iStrideCur = pcDtParam->iStrideCur;
+  const Int  iStrideOrg = pcDtParam->iStrideOrg;
+  const Int  iStep      = pcDtParam->iStep;
+  assert( iStep == 1 );
+
+  Distortion uiSum = 0;
+  const Int iSize = ( iRows % 8 == 0 && iCols % 8 == 0 ) ? 8 : ( iRows % 4 == 0 && iCols % 4 == 0 ) ? 4 : ( iRows % 2 == 0 && iCols % 2 == 0 ) ? 2 : 0;
+  if( iSize == 0 )
+  {
+    assert( false );
+    return 0;
+  }
+
+  for( Int y = 0; y < iRows; y += iSize )
+  {
+    for( Int x = 0; x < iCols; x += iSize )
+    {
+      switch( iSize )
+      {
+        case 8:  uiSum += avx2HADs8x8( &piOrg[x], &piCur[x*iStep], iStrideOrg, iStrideCur ); break;
+        case 4:  uiSum += avx2HADs4x4( &piOrg[x], &piCur[x*iStep], iStrideOrg, iStrideCur ); break;
+        default: uiSum += xHADs2x2   ( &piOrg[x], &piCur[x*iStep], iStrideOrg, iStrideCur ); break;
+      }
+    }
+    piOrg += iStrideOrg * iSize;
+    piCur += iStrideCur * iSize;
+  }
+
+  return ( uiSum >> DISTORTION_PRECISION_ADJUSTMENT( pcDtParam->bitDepth - 8 ) );
+}
+
+#if VECTOR_CODING__AVX512
+#if defined( __GNUC__ ) && !defined( __clang__ )
+// the AVX-512 intrinsics of GCC start some results from undefined registers, which -Wmaybe-uninitialized reports
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+// --------------------------------------------------------------------------------------------------------------------
+// AVX-512 SAD and SSE, for widths multiple of 16
+// --------------------------------------------------------------------------------------------------------------------
+
+SIMD_TARGET_AVX512 static inline __m512i avx512LoadPel16( const Pel* piSrc )
+{
+#if RExt__HIGH_BIT_DEPTH_SUPPORT
+  return _mm512_loadu_si512( ( const void* )piSrc );
+#else
+  return _mm512_cvtepi16_epi32( _mm256_loadu_si256( ( const __m256i* )piSrc ) );
+#endif
+}
+
+SIMD_TARGET_AVX512 static inline __m512i avx512WidenU32( __m512i sum64, __m512i v )
+{
+  const __m512i zero = _mm512_setzero_si512();
+  return _mm512_add_epi64( sum64, _mm512_add_epi64( _mm512_unpacklo_epi32( v, zero ), _mm512_unpackhi_epi32( v, zero ) ) );
+}
+
+SIMD_TARGET_AVX512 static inline UInt64 avx512SumU64( __m512i v )
+{
+  return avx2SumU64( _mm256_add_epi64( _mm512_castsi512_si256( v ), _mm512_extracti64x4_epi64( v, 1 ) ) );
+}
+
+/// differences of 16 samples, zeroed where the occupancy is
+SIMD_TARGET_AVX512 static inline __m512i avx512Diff16( const Pel* piOrg, const Pel* piCur, const Pel* piOccupancy )
+{
+  if( piOccupancy != NULL )
+  {
+    const __m512i occupancy = avx512LoadPel16( piOccupancy );
+    return _mm512_maskz_sub_epi32( _mm512_test_epi32_mask( occupancy, occupancy ), avx512LoadPel16( piOrg ), avx512LoadPel16( piCur ) );
+  }
+  return _mm512_sub_epi32( avx512LoadPel16( piOrg ), avx512LoadPel16( piCur ) );
+}
+
+template< Int iWidth >
+SIMD_TARGET_AVX512 static Distortion avx512SAD( const DistParam* pcDtParam, Int iSubShift )
+{
+  const Pel* piOrg      = pcDtParam->pOrg;
+  const Pel* piCur      = pcDtParam->pCur;
+  const Int  iCols      = iWidth ? iWidth : pcDtParam->iCols;
+  const Int  iSubStep   = 1 << iSubShift;
+  const Int  iStrideOrg = pcDtParam->iStrideOrg * iSubStep;
+  const Int  iStrideCur = pcDtParam->iStrideCur * iSubStep;
+  const Int  iFlushRows = std::max( 1, 0xFFFF / ( iCols >> 4 ) );
+  assert( !( iCols & 0x0F ) );
+
+  __m512i sum64  = _mm512_setzero_si512();
+  __m512i sum    = _mm512_setzero_si512();
+  Int     iCount = 0;
+  for( Int iRows = pcDtParam->iRows; iRows != 0; iRows -= iSubStep )
+  {
+    for( Int n = 0; n < iCols; n += 16 )
+    {
+      sum = _mm512_add_epi32( sum, _mm512_abs_epi32( _mm512_sub_epi32( avx512LoadPel16( piOrg + n ), avx512LoadPel16( piCur + n ) ) ) );
+    }
+    piOrg += iStrideOrg;
+    piCur += iStrideCur;
+    if( ++iCount == iFlushRows )
+    {
+      sum64  = avx512WidenU32( sum64, sum );
+      sum    = _mm512_setzero_si512();
+      iCount = 0;
+    }
+  }
+
+  Distortion uiSum = Distortion( avx512SumU64( avx512WidenU32( sum64, sum ) ) );
+  uiSum <<= iSubShift;
+  return ( uiSum >> DISTORTION_PRECISION_ADJUSTMENT( pcDtParam->bitDepth - 8 ) );
+}
+
+template< Int iWidth >
+SIMD_TARGET_AVX512 static Distortion avx512GetSADN( DistParam* pcDtParam )
+{
+  if ( pcDtParam->bApplyWeight )
+  {
+    return TComRdCostWeightPrediction::xGetSADw( pcDtParam );
+  }
+  return avx512SAD<iWidth>( pcDtParam, pcDtParam->iSubShift );
+}
+
+SIMD_TARGET_AVX512 static Distortion avx512GetSAD16N( DistParam* pcDtParam )
+{
+  return avx512SAD<0>( pcDtParam, pcDtParam->iSubShift );
+}
+
+template< Int iWidth >
+SIMD_TARGET_AVX512 static Distortion avx512SSE( const DistParam* pcDtParam )
+{
+  const Pel* piOrg       = pcDtParam->pOrg;
+  const Pel* piCur       = pcDtParam->pCur;
+  const Int  iCols       = iWidth ? iWidth : pcDtParam->iCols;
+  const Int  iStrideOrg  = pcDtParam->iStrideOrg;
+  const Int  iStrideCur  = pcDtParam->iStrideCur;
+#if PCC_RDO_EXT
+  const Pel* piOccupancy = pcDtParam->pOccupancy;
+  const Int  iStrideOccupancy = pcDtParam->iStrideOccupancy;
+#else
+  const Pel* piOccupancy = NULL;
+  const Int  iStrideOccupancy = 0;
+#endif
+  const UInt uiShift     = DISTORTION_PRECISION_ADJUSTMENT( ( pcDtParam->bitDepth - 8 ) << 1 );
+  assert( !( iCols & 0x0F ) );
+
+  __m512i sum64 = _mm512_setzero_si512();
+  if( uiShift == 0 && pcDtParam->bitDepth <= 10 )
+  {
+    const Int iFlushRows = std::max( 1, 2047 / ( ( iCols >> 5 ) + 1 ) );
+    __m512i   sum        = _mm512_setzero_si512();
+    Int       iCount     = 0;
+    for( Int iRows = pcDtParam->iRows; iRows != 0; iRows-- )
+    {
+      Int n = 0;
+      for( ; n + 32 <= iCols; n += 32 )
+      {
+        __m512i diff = _mm512_packs_epi32( avx512Diff16( piOrg + n, piCur + n, piOccupancy ? piOccupancy + n : NULL ),
+                                           avx512Diff16( piOrg + n + 16, piCur + n + 16, piOccupancy ? piOccupancy + n + 16 : NULL ) );
+        sum = _mm512_add_epi32( sum, _mm512_madd_epi16( diff, diff ) );
+      }
+      if( n < iCols )
+      {
+        __m512i diff = _mm512_packs_epi32( avx512Diff16( piOrg + n, piCur + n, piOccupancy ? piOccupancy + n : NULL ), _mm512_setzero_si512() );
+        sum = _mm512_add_epi32( sum, _mm512_madd_epi16( diff, diff ) );
+      }
+      piOrg += iStrideOrg;
+      piCur += iStrideCur;
+      if( piOccupancy != NULL )
+      {
+        piOccupancy += iStrideOccupancy;
+      }
+      if( ++iCount == iFlushRows )
+      {
+        sum64  = avx512WidenU32( sum64, sum );
+        sum    = _mm512_setzero_si512();
+        iCount = 0;
+      }
+    }
+    sum64 = avx512WidenU32( sum64, sum );
+  }
+  else
+  {
+    const __m128i shift = _mm_cvtsi32_si128( uiShift );
+    for( Int iRows = pcDtParam->iRows; iRows != 0; iRows-- )
+    {
+      for( Int n = 0; n < iCols; n += 16 )
+      {
+        const __m512i diff = avx512Diff16( piOrg + n, piCur + n, piOccupancy ? piOccupancy + n : NULL );
+        const __m512i odd  = _mm512_srli_epi64( diff, 32 );
+        sum64 = _mm512_add_epi64( sum64, _mm512_srl_epi64( _mm512_mul_epi32( diff, diff ), shift ) );
+        sum64 = _mm512_add_epi64( sum64, _mm512_srl_epi64( _mm512_mul_epi32( odd, odd ), shift ) );
+      }
+      piOrg += iStrideOrg;
+      piCur += iStrideCur;
+      if( piOccupancy != NULL )
+      {
+        piOccupancy += iStrideOccupancy;
+      }
+    }
+  }
+
+  return Distortion( avx512SumU64( sum64 ) );
+}
+
+template< Int iWidth >
+SIMD_TARGET_AVX512 static Distortion avx512GetSSE( DistParam* pcDtParam )
+{
+  if ( pcDtParam->bApplyWeight )
+  {
+    return TComRdCostWeightPrediction::xGetSSEw( pcDtParam );
+  }
+  return avx512SSE<iWidth>( pcDtParam );
+}
+#if defined( __GNUC__ ) && !defined( __clang__ )
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+// --------------------------------------------------------------------------------------------------------------------
+// Selection
+// --------------------------------------------------------------------------------------------------------------------
+
+Void TComRdCost::initRdCostX86( SimdExtension eExtension )
+{
+  if( eExtension >= SIMD_AVX2 )
+  {
+    m_afpDistortFunc[DF_SSE    ] = avx2GetSSE<0>;
+    m_afpDistortFunc[DF_SSE4   ] = avx2GetSSE<4>;
+    m_afpDistortFunc[DF_SSE8   ] = avx2GetSSE<8>;
+    m_afpDistortFunc[DF_SSE16  ] = avx2GetSSE<16>;
+    m_afpDistortFunc[DF_SSE32  ] = avx2GetSSE<32>;
+    m_afpDistortFunc[DF_SSE64  ] = avx2GetSSE<64>;
+    m_afpDistortFunc[DF_SSE16N ] = avx2GetSSE<0>;
+
+    m_afpDistortFunc[DF_SAD    ] = avx2GetSAD;
+    m_afpDistortFunc[DF_SAD4   ] = avx2GetSADN<4>;
+    m_afpDistortFunc[DF_SAD8   ] = avx2GetSADN<8>;
+    m_afpDistortFunc[DF_SAD16  ] = avx2GetSADN<16>;
+    m_afpDistortFunc[DF_SAD32  ] = avx2GetSADN<32>;
+    m_afpDistortFunc[DF_SAD64  ] = avx2GetSADN<64>;
+    m_afpDistortFunc[DF_SAD16N ] = avx2GetSAD16N;
+    m_afpDistortFunc[DF_SAD12  ] = avx2GetSADN<12>;
+    m_afpDistortFunc[DF_SAD24  ] = avx2GetSADN<24>;
+    m_afpDistortFunc[DF_SAD48  ] = avx2GetSADN<48>;
+
+    m_afpDistortFunc[DF_HADS   ] = avx2GetHADs;
+  }
+#if VECTOR_CODING__AVX512
+  if( eExtension >= SIMD_AVX512 )
+  {
+    m_afpDistortFunc[DF_SSE16  ] = avx512GetSSE<16>;
+    m_afpDistortFunc[DF_SSE32  ] = avx512GetSSE<32>;
+    m_afpDistortFunc[DF_SSE64  ] = avx512GetSSE<64>;
+    m_afpDistortFunc[DF_SSE16N ] = avx512GetSSE<0>;
+
+    m_afpDistortFunc[DF_SAD16  ] = avx512GetSADN<16>;
+    m_afpDistortFunc[DF_SAD32  ] = avx512GetSADN<32>;
+    m_afpDistortFunc[DF_SAD64  ] = avx512GetSADN<64>;
+    m_afpDistortFunc[DF_SAD16N ] = avx512GetSAD16N;
+    m_afpDistortFunc[DF_SAD48  ] = avx512GetSADN<48>;
+  }
+#endif
+
+  // the SAD and Hadamard with step use the same functions
+  for( Int i = 0; i <= DF_SAD16N - DF_SAD; i++ )
+  {
+    m_afpDistortFunc[DF_SADS + i] = m_afpDistortFunc[DF_SAD + i];
+    m_afpDistortFunc[DF_HADS + i] = m_afpDistortFunc[DF_HADS];
+  }
+  m_afpDistortFunc[DF_SADS12 ] = m_afpDistortFunc[DF_SAD12];
+  m_afpDistortFunc[DF_SADS24 ] = m_afpDistortFunc[DF_SAD24];
+  m_afpDistortFunc[DF_SADS48 ] = m_afpDistortFunc[DF_SAD48];
+}
+#endif
+
+//! \}
+
+} // namespace pcc_hm
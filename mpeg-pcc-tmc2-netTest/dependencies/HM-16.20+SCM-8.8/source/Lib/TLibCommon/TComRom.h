@@ -72,6 +72,9 @@ extern       UInt   g_auiRasterToPelY[ MAX_NUM_PART_IDXS_IN_CTU_WIDTH*MAX_NUM_PA
 
 Void         initRasterToPelXY ( UInt uiMaxCUWidth, UInt uiMaxCUHeight, UInt uiMaxDepth );
 
+// thread-safe, once-per-process initialisation of the three tables above; called by the CU coders
+Void         initCtuPartitionTables ( UInt uiMaxCUWidth, UInt uiMaxCUHeight, UInt uiMaxDepth );
+
 extern const UInt g_auiPUOffset[NUMBER_OF_PART_SIZES];
 
 extern const Int g_quantScales[SCALING_LIST_REM_NUM];             // Q(QP%6)
@@ -0,0 +1,143 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComSimd.cpp
+    \brief    run-time selection of the x86 vector kernels
+*/
+
+#include "TComSimd.h"
+
+#if VECTOR_CODING__RUNTIME_DISPATCH
+#ifdef _MSC_VER
+#include <intrin.h>
+#include <immintrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+namespace pcc_hm {
+
+//! \ingroup TLibCommon
+//! \{
+
+#if VECTOR_CODING__RUNTIME_DISPATCH
+static Void xCpuid( UInt auiRegs[4], UInt uiLeaf, UInt uiSubLeaf )
+{
+#ifdef _MSC_VER
+  Int aiRegs[4];
+  __cpuidex( aiRegs, uiLeaf, uiSubLeaf );
+  for( Int i = 0; i < 4; i++ )
+  {
+    auiRegs[i] = UInt( aiRegs[i] );
+  }
+#else
+  __cpuid_count( uiLeaf, uiSubLeaf, auiRegs[0], auiRegs[1], auiRegs[2], auiRegs[3] );
+#endif
+}
+
+/// register states the OS saves on context switches (XCR0)
+static UInt64 xGetEnabledStates()
+{
+#ifdef _MSC_VER
+  return _xgetbv( 0 );
+#else
+  UInt uiLow, uiHigh;
+  __asm__ __volatile__( "xgetbv" : "=a"( uiLow ), "=d"( uiHigh ) : "c"( 0 ) );
+  return ( UInt64( uiHigh ) << 32 ) | uiLow;
+#endif
+}
+#endif
+
+static SimdExtension xDetectSimdExtension()
+{
+#if VECTOR_CODING__RUNTIME_DISPATCH
+  UInt auiRegs[4];   // eax, ebx, ecx, edx
+  xCpuid( auiRegs, 0, 0 );
+  if( auiRegs[0] < 7 )
+  {
+    return SIMD_NONE;
+  }
+  xCpuid( auiRegs, 1, 0 );
+  const Bool bOSXSave = ( auiRegs[2] >> 27 ) & 1;
+  const Bool bAVX     = ( auiRegs[2] >> 28 ) & 1;
+  if( !bOSXSave || !bAVX )
+  {
+    return SIMD_NONE;
+  }
+  const UInt64 uiStates = xGetEnabledStates();
+  xCpuid( auiRegs, 7, 0 );
+  const Bool bAVX2     = ( auiRegs[1] >>  5 ) & 1;
+  const Bool bAVX512F  = ( auiRegs[1] >> 16 ) & 1;
+  const Bool bAVX512BW = ( auiRegs[1] >> 30 ) & 1;
+  // XMM and YMM registers, then the opmask and ZMM registers
+  if( !bAVX2 || ( uiStates & 0x06 ) != 0x06 )
+  {
+    return SIMD_NONE;
+  }
+#if VECTOR_CODING__AVX512
+  if( bAVX512F && bAVX512BW && ( uiStates & 0xE0 ) == 0xE0 )
+  {
+    return SIMD_AVX512;
+  }
+#else
+  (Void)bAVX512F;
+  (Void)bAVX512BW;
+#endif
+  return SIMD_AVX2;
+#else
+  return SIMD_NONE;
+#endif
+}
+
+static SimdExtension g_eMaxSimdExtension = SimdExtension( NUMBER_OF_SIMD_EXTENSIONS - 1 );
+
+SimdExtension getSimdExtension()
+{
+  static const SimdExtension eDetected = xDetectSimdExtension();
+  return std::min( eDetected, g_eMaxSimdExtension );
+}
+
+Void setSimdExtension( SimdExtension eExtension )
+{
+  g_eMaxSimdExtension = eExtension;
+}
+
+const TChar* getSimdExtensionName( SimdExtension eExtension )
+{
+  static const TChar* const names[NUMBER_OF_SIMD_EXTENSIONS] = { "none", "AVX2", "AVX-512" };
+  return names[eExtension];
+}
+
+//! \}
+
+} // namespace pcc_hm
@@ -0,0 +1,77 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComSimd.h
+    \brief    run-time selection of the x86 vector kernels (header)
+*/
+
+#ifndef __TCOMSIMD__
+#define __TCOMSIMD__
+
+#include "CommonDef.h"
+
+namespace pcc_hm {
+
+//! \ingroup TLibCommon
+//! \{
+
+// kernels for another extension than the one of the command line are built with a target attribute; MSVC needs none
+#if VECTOR_CODING__RUNTIME_DISPATCH && defined( __GNUC__ )
+#define SIMD_TARGET_AVX2    __attribute__(( target( "avx2" ) ))
+#define SIMD_TARGET_AVX512  __attribute__(( target( "avx2,avx512f,avx512bw" ) ))
+#else
+#define SIMD_TARGET_AVX2
+#define SIMD_TARGET_AVX512
+#endif
+
+/// x86 vector extensions of the run-time selected kernels, in increasing order
+enum SimdExtension
+{
+  SIMD_NONE   = 0,   ///< C code, with the SSE2 paths enabled at compile time by VECTOR_CODING__*
+  SIMD_AVX2   = 1,
+  SIMD_AVX512 = 2,   ///< AVX-512 F and BW
+  NUMBER_OF_SIMD_EXTENSIONS
+};
+
+/// best extension of the CPU that is built in, detected once, and at most the one given to setSimdExtension()
+SimdExtension getSimdExtension();
+
+/// caps the extension of the kernels selected from now on, e.g. SIMD_NONE to run the C reference
+Void setSimdExtension( SimdExtension eExtension );
+
+const TChar* getSimdExtensionName( SimdExtension eExtension );
+
+//! \}
+
+} // namespace pcc_hm
+#endif // __TCOMSIMD__
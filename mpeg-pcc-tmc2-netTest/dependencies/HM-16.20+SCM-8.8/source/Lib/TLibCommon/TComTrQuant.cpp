@@ -160,6 +160,9 @@ TComTrQuant::TComTrQuant()
   // allocate bit estimation class  (for RDOQ)
   m_pcEstBitsSbac = new estBitsSbacStruct;
   initScalingList();
+#if TRQUANT_X86
+  initTrQuantX86( getSimdExtension() );
+#endif
 }
 
 TComTrQuant::~TComTrQuant()
@@ -1242,31 +1245,15 @@ Void TComTrQuant::xQuant(       TComTU       &rTu,
 #endif
 
     const Int iAdd   = (pcCU->getSlice()->getSliceType()==I_SLICE || pcCU->getSlice()->isOnlyCurrentPictureAsReference() ? 171 : 85) << (iQBits-9);
-    const Int qBits8 = iQBits - 8;
-
-    for( Int uiBlockPos = 0; uiBlockPos < uiWidth*uiHeight; uiBlockPos++ )
-    {
-      const TCoeff iLevel   = piCoef[uiBlockPos];
-      const TCoeff iSign    = (iLevel < 0 ? -1: 1);
-
-      const Int64  tmpLevel = (Int64)abs(iLevel) * (enableScalingLists ? piQuantCoeff[uiBlockPos] : defaultQuantisationCoefficient);
 
 #if ADAPTIVE_QP_SELECTION
-      if( m_bUseAdaptQpSelect )
-      {
-        piArlCCoef[uiBlockPos] = (TCoeff)((tmpLevel + iAddC ) >> iQBitsC);
-      }
+    uiAbsSum += xQuantCoefficients( piCoef, piQCoef, m_bUseAdaptQpSelect ? piArlCCoef : NULL, deltaU, uiWidth*uiHeight, enableScalingLists ? piQuantCoeff : NULL, defaultQuantisationCoefficient,
+                                    iQBits, iAdd, iQBitsC, iAddC, entropyCodingMinimum, entropyCodingMaximum );
+#else
+    uiAbsSum += xQuantCoefficients( piCoef, piQCoef, NULL, deltaU, uiWidth*uiHeight, enableScalingLists ? piQuantCoeff : NULL, defaultQuantisationCoefficient,
+                                    iQBits, iAdd, 0, 0, entropyCodingMinimum, entropyCodingMaximum );
 #endif
 
-      const TCoeff quantisedMagnitude = TCoeff((tmpLevel + iAdd ) >> iQBits);
-      deltaU[uiBlockPos] = (TCoeff)((tmpLevel - (quantisedMagnitude<<iQBits) )>> qBits8);
-
-      uiAbsSum += quantisedMagnitude;
-      const TCoeff quantisedCoefficient = quantisedMagnitude * iSign;
-
-      piQCoef[uiBlockPos] = Clip3<TCoeff>( entropyCodingMinimum, entropyCodingMaximum, quantisedCoefficient );
-    } // for n
-
     if( pcCU->getSlice()->getPPS()->getSignDataHidingEnabledFlag() )
     {
       if(uiAbsSum >= 2) //this prevents TUs with only one coefficient of value 1 from being tested
@@ -1278,6 +1265,44 @@ Void TComTrQuant::xQuant(       TComTU       &rTu,
   //return;
 }
 
+TCoeff TComTrQuant::xQuantCoefficients( const TCoeff* piCoef, TCoeff* piQCoef, TCoeff* piArlCCoef, TCoeff* piDeltaU, const Int numSamples, const Int* piQuantCoeff, const Int iQuantCoeff,
+                                        const Int iQBits, const Int iAdd, const Int iQBitsC, const Int iAddC, const TCoeff entropyCodingMinimum, const TCoeff entropyCodingMaximum ) const
+{
+  TCoeff uiAbsSum = 0;
+
+#if TRQUANT_X86
+  if( m_fpQuantX86 != NULL && m_fpQuantX86( piCoef, piQCoef, piArlCCoef, piDeltaU, numSamples, piQuantCoeff, iQuantCoeff, iQBits, iAdd, iQBitsC, iAddC, entropyCodingMinimum, entropyCodingMaximum, uiAbsSum ) )
+  {
+    return uiAbsSum;
+  }
+#endif
+
+  const Int qBits8 = iQBits - 8;
+
+  for( Int uiBlockPos = 0; uiBlockPos < numSamples; uiBlockPos++ )
+  {
+    const TCoeff iLevel   = piCoef[uiBlockPos];
+    const TCoeff iSign    = (iLevel < 0 ? -1: 1);
+
+    const Int64  tmpLevel = (Int64)abs(iLevel) * (piQuantCoeff != NULL ? piQuantCoeff[uiBlockPos] : iQuantCoeff);
+
+    if( piArlCCoef != NULL )
+    {
+      piArlCCoef[uiBlockPos] = (TCoeff)((tmpLevel + iAddC ) >> iQBitsC);
+    }
+
+    const TCoeff quantisedMagnitude = TCoeff((tmpLevel + iAdd ) >> iQBits);
+    piDeltaU[uiBlockPos] = (TCoeff)((tmpLevel - (quantisedMagnitude<<iQBits) )>> qBits8);
+
+    uiAbsSum += quantisedMagnitude;
+    const TCoeff quantisedCoefficient = quantisedMagnitude * iSign;
+
+    piQCoef[uiBlockPos] = Clip3<TCoeff>( entropyCodingMinimum, entropyCodingMaximum, quantisedCoefficient );
+  } // for n
+
+  return uiAbsSum;
+}
+
 Bool TComTrQuant::xNeedRDOQ( TComTU &rTu, TCoeff * pSrc, const ComponentID compID, const QpParam &cQP )
 {
   const TComRectangle &rect = rTu.getRect(compID);
@@ -1388,30 +1413,7 @@ Void TComTrQuant::xDeQuant(       TComTU        &rTu,
 
     Int *piDequantCoef = getDequantCoeff(scalingListType,QP_rem,uiLog2TrSize-2);
 
-    if(rightShift > 0)
-    {
-      const Intermediate_Int iAdd = 1 << (rightShift - 1);
-
-      for( Int n = 0; n < numSamplesInBlock; n++ )
-      {
-        const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMinimum, inputMaximum, piQCoef[n]));
-        const Intermediate_Int iCoeffQ   = ((Intermediate_Int(clipQCoef) * piDequantCoef[n]) + iAdd ) >> rightShift;
-
-        piCoef[n] = TCoeff(Clip3<Intermediate_Int>(transformMinimum,transformMaximum,iCoeffQ));
-      }
-    }
-    else
-    {
-      const Int leftShift = -rightShift;
-
-      for( Int n = 0; n < numSamplesInBlock; n++ )
-      {
-        const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMinimum, inputMaximum, piQCoef[n]));
-        const Intermediate_Int iCoeffQ   = (Intermediate_Int(clipQCoef) * piDequantCoef[n]) << leftShift;
-
-        piCoef[n] = TCoeff(Clip3<Intermediate_Int>(transformMinimum,transformMaximum,iCoeffQ));
-      }
-    }
+    xDeQuantCoefficients( piQCoef, piCoef, numSamplesInBlock, piDequantCoef, 0, rightShift, inputMinimum, inputMaximum, transformMinimum, transformMaximum );
   }
   else
   {
@@ -1425,29 +1427,42 @@ Void TComTrQuant::xDeQuant(       TComTU        &rTu,
     const Intermediate_Int inputMinimum        = -(1 << (targetInputBitDepth - 1));
     const Intermediate_Int inputMaximum        =  (1 << (targetInputBitDepth - 1)) - 1;
 
-    if (rightShift > 0)
-    {
-      const Intermediate_Int iAdd = 1 << (rightShift - 1);
+    xDeQuantCoefficients( piQCoef, piCoef, numSamplesInBlock, NULL, scale, rightShift, inputMinimum, inputMaximum, transformMinimum, transformMaximum );
+  }
+}
 
-      for( Int n = 0; n < numSamplesInBlock; n++ )
-      {
-        const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMinimum, inputMaximum, piQCoef[n]));
-        const Intermediate_Int iCoeffQ   = (Intermediate_Int(clipQCoef) * scale + iAdd) >> rightShift;
+Void TComTrQuant::xDeQuantCoefficients( const TCoeff* piQCoef, TCoeff* piCoef, const Int numSamples, const Int* piDequantCoef, const Int iScale, const Int rightShift,
+                                        const Intermediate_Int inputMinimum, const Intermediate_Int inputMaximum, const TCoeff transformMinimum, const TCoeff transformMaximum ) const
+{
+#if TRQUANT_X86
+  if( m_fpDeQuantX86 != NULL && m_fpDeQuantX86( piQCoef, piCoef, numSamples, piDequantCoef, iScale, rightShift, inputMinimum, inputMaximum, transformMinimum, transformMaximum ) )
+  {
+    return;
+  }
+#endif
 
-        piCoef[n] = TCoeff(Clip3<Intermediate_Int>(transformMinimum,transformMaximum,iCoeffQ));
-      }
-    }
-    else
+  if(rightShift > 0)
+  {
+    const Intermediate_Int iAdd = 1 << (rightShift - 1);
+
+    for( Int n = 0; n < numSamples; n++ )
     {
-      const Int leftShift = -rightShift;
+      const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMinimum, inputMaximum, piQCoef[n]));
+      const Intermediate_Int iCoeffQ   = ((Intermediate_Int(clipQCoef) * (piDequantCoef != NULL ? piDequantCoef[n] : iScale)) + iAdd ) >> rightShift;
 
-      for( Int n = 0; n < numSamplesInBlock; n++ )
-      {
-        const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMinimum, inputMaximum, piQCoef[n]));
-        const Intermediate_Int iCoeffQ   = (Intermediate_Int(clipQCoef) * scale) << leftShift;
+      piCoef[n] = TCoeff(Clip3<Intermediate_Int>(transformMinimum,transformMaximum,iCoeffQ));
+    }
+  }
+  else
+  {
+    const Int leftShift = -rightShift;
 
-        piCoef[n] = TCoeff(Clip3<Intermediate_Int>(transformMinimum,transformMaximum,iCoeffQ));
-      }
+    for( Int n = 0; n < numSamples; n++ )
+    {
+      const TCoeff           clipQCoef = TCoeff(Clip3<Intermediate_Int>(inputMinimum, inputMaximum, piQCoef[n]));
+      const Intermediate_Int iCoeffQ   = (Intermediate_Int(clipQCoef) * (piDequantCoef != NULL ? piDequantCoef[n] : iScale)) << leftShift;
+
+      piCoef[n] = TCoeff(Clip3<Intermediate_Int>(transformMinimum,transformMaximum,iCoeffQ));
     }
   }
 }
@@ -2049,6 +2064,12 @@ Void TComTrQuant::xT( const Int channelBitDepth, Bool useDST, Pel* piBlkResi, UI
     return;
   }
 #endif
+#if TRQUANT_X86
+  if( m_fpForwardTransformX86 != NULL && m_fpForwardTransformX86( channelBitDepth, useDST, piBlkResi, uiStride, psCoeff, iWidth, iHeight, maxLog2TrDynamicRange ) )
+  {
+    return;
+  }
+#endif
 
   TCoeff block[ MAX_TU_SIZE * MAX_TU_SIZE ];
   TCoeff coeff[ MAX_TU_SIZE * MAX_TU_SIZE ];
@@ -2085,6 +2106,12 @@ Void TComTrQuant::xIT( const Int channelBitDepth, Bool useDST, TCoeff* plCoef, P
     return;
   }
 #endif
+#if TRQUANT_X86
+  if( m_fpInverseTransformX86 != NULL && m_fpInverseTransformX86( channelBitDepth, useDST, plCoef, pResidual, uiStride, iWidth, iHeight, maxLog2TrDynamicRange ) )
+  {
+    return;
+  }
+#endif
 
   TCoeff block[ MAX_TU_SIZE * MAX_TU_SIZE ];
   TCoeff coeff[ MAX_TU_SIZE * MAX_TU_SIZE ];
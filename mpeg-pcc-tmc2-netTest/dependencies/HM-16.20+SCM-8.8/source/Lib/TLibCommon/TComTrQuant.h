@@ -43,6 +43,7 @@
 #include "TComDataCU.h"
 #include "TComChromaFormat.h"
 #include "ContextTables.h"
+#include "TComSimd.h"
 namespace pcc_hm {
 
 //! \ingroup TLibCommon
@@ -54,6 +55,9 @@ namespace pcc_hm {
 
 #define QP_BITS                 15
 
+/// the vector kernels of TComTrQuantX86.cpp are written for the 64-bit TCoeff of RExt__HIGH_BIT_DEPTH_SUPPORT
+#define TRQUANT_X86             ( VECTOR_CODING__RUNTIME_DISPATCH && RExt__HIGH_BIT_DEPTH_SUPPORT )
+
 // ====================================================================================================================
 // Type definition
 // ====================================================================================================================
@@ -73,6 +77,17 @@ typedef struct
   Int golombRiceAdaptationStatistics[RExt__GOLOMB_RICE_ADAPTATION_STATISTICS_SETS];
 } estBitsSbacStruct;
 
+/// 2-D forward transform of a residual block as in xTrMxN(), false where the residual is out of the range of the kernel
+typedef Bool (*FpForwardTransform)( Int bitDepth, Bool useDST, const Pel *piResi, UInt uiStride, TCoeff *piCoeff, Int iWidth, Int iHeight, Int maxLog2TrDynamicRange );
+/// 2-D inverse transform of a coefficient block as in xITrMxN(), false where the coefficients are out of the range of the kernel
+typedef Bool (*FpInverseTransform)( Int bitDepth, Bool useDST, const TCoeff *piCoeff, Pel *piResi, UInt uiStride, Int iWidth, Int iHeight, Int maxLog2TrDynamicRange );
+/// TComTrQuant::xQuantCoefficients(), false where a coefficient is out of the range of the kernel
+typedef Bool (*FpQuant)( const TCoeff *piCoef, TCoeff *piQCoef, TCoeff *piArlCCoef, TCoeff *piDeltaU, Int numSamples, const Int *piQuantCoeff, Int iQuantCoeff,
+                         Int iQBits, Int iAdd, Int iQBitsC, Int iAddC, TCoeff entropyCodingMinimum, TCoeff entropyCodingMaximum, TCoeff &uiAbsSum );
+/// TComTrQuant::xDeQuantCoefficients(), false where the clipping range is out of the range of the kernel
+typedef Bool (*FpDeQuant)( const TCoeff *piQCoef, TCoeff *piCoef, Int numSamples, const Int *piDequantCoef, Int iScale, Int rightShift,
+                           Intermediate_Int inputMinimum, Intermediate_Int inputMaximum, TCoeff transformMinimum, TCoeff transformMaximum );
+
 // ====================================================================================================================
 // Class definition
 // ====================================================================================================================
@@ -148,12 +163,19 @@ public:
 
 #if RDOQ_CHROMA_LAMBDA
   Void setLambdas(const Double lambdas[MAX_NUM_COMPONENT]) { for (UInt component = 0; component < MAX_NUM_COMPONENT; component++) m_lambdas[component] = lambdas[component]; }
+  const Double* getLambdas() const { return m_lambdas; }
   Void selectLambda(const ComponentID compIdx) { m_dLambda = m_lambdas[compIdx]; }
   Void adjustBitDepthandLambdaForColourTrans(Int delta_QP);
 #else
   Void setLambda(Double dLambda) { m_dLambda = dLambda;}
+  Double getLambda() const { return m_dLambda; }
 #endif
   Void setRDOQOffset( UInt uiRDOQOffset ) { m_uiRDOQOffset = uiRDOQOffset; }
+#ifdef SDMTEST
+  Bool getUseRDOQ  () const { return m_useRDOQ;   }
+  Bool getUseRDOQTS() const { return m_useRDOQTS; }
+  Void setUseRDOQ  ( Bool bUseRDOQ, Bool bUseRDOQTS ) { m_useRDOQ = bUseRDOQ; m_useRDOQTS = bUseRDOQTS; }
+#endif
 
   estBitsSbacStruct* m_pcEstBitsSbac;
 
@@ -232,10 +254,30 @@ protected:
   Double   *m_errScale             [SCALING_LIST_SIZE_NUM][SCALING_LIST_NUM][SCALING_LIST_REM_NUM]; ///< array of quantization matrix coefficient 4x4
   Double    m_errScaleNoScalingList[SCALING_LIST_SIZE_NUM][SCALING_LIST_NUM][SCALING_LIST_REM_NUM]; ///< array of quantization matrix coefficient 4x4
 
-private:
+#if TRQUANT_X86
+  FpForwardTransform m_fpForwardTransformX86;   ///< vector kernels, NULL where there is none
+  FpInverseTransform m_fpInverseTransformX86;
+  FpQuant            m_fpQuantX86;
+  FpDeQuant          m_fpDeQuantX86;
+  Void initTrQuantX86( SimdExtension eExtension );   ///< in TComTrQuantX86.cpp
+#endif
+
   // forward Transform
   Void xT   ( const Int channelBitDepth, Bool useDST, Pel* piBlkResi, UInt uiStride, TCoeff* psCoeff, Int iWidth, Int iHeight, const Int maxLog2TrDynamicRange );
 
+  // inverse transform
+  Void xIT    ( const Int channelBitDepth, Bool useDST, TCoeff* plCoef, Pel* pResidual, UInt uiStride, Int iWidth, Int iHeight, const Int maxLog2TrDynamicRange );
+
+  // quantization without RDOQ of the coefficients of a block, piArlCCoef NULL without adaptive QP selection and piQuantCoeff NULL without scaling list; returns the sum of the quantised magnitudes
+  TCoeff xQuantCoefficients  ( const TCoeff* piCoef, TCoeff* piQCoef, TCoeff* piArlCCoef, TCoeff* piDeltaU, const Int numSamples, const Int* piQuantCoeff, const Int iQuantCoeff,
+                               const Int iQBits, const Int iAdd, const Int iQBitsC, const Int iAddC, const TCoeff entropyCodingMinimum, const TCoeff entropyCodingMaximum ) const;
+
+  // dequantization of the coefficients of a block, piDequantCoef NULL without scaling list
+  Void   xDeQuantCoefficients( const TCoeff* piQCoef, TCoeff* piCoef, const Int numSamples, const Int* piDequantCoef, const Int iScale, const Int rightShift,
+                               const Intermediate_Int inputMinimum, const Intermediate_Int inputMaximum, const TCoeff transformMinimum, const TCoeff transformMaximum ) const;
+
+private:
+
   // skipping Transform
   Void xTransformSkip ( Pel* piBlkResi, UInt uiStride, TCoeff* psCoeff, TComTU &rTu, const ComponentID component );
 
@@ -312,9 +354,6 @@ __inline UInt              xGetCodedLevel  ( Double&          rd64CodedCost,
                  const ComponentID   compID,
                  const QpParam      &cQP );
 
-  // inverse transform
-  Void xIT    ( const Int channelBitDepth, Bool useDST, TCoeff* plCoef, Pel* pResidual, UInt uiStride, Int iWidth, Int iHeight, const Int maxLog2TrDynamicRange );
-
   // inverse skipping transform
   Void xITransformSkip ( TCoeff* plCoef, Pel* pResidual, UInt uiStride, TComTU &rTu, const ComponentID component );
 
@@ -0,0 +1,676 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TComTrQuantX86.cpp
+    \brief    AVX2 and AVX-512 kernels of TComTrQuant, selected at run time
+*/
+
+#include "TComTrQuant.h"
+#include "TComRom.h"
+
+#include <limits>
+#if TRQUANT_X86
+#include <immintrin.h>
+#endif
+namespace pcc_hm {
+
+//! \ingroup TLibCommon
+//! \{
+
+#if TRQUANT_X86
+
+// The kernels give the results of the C code whenever they return true.
+//
+// The 1-D transforms run on the lines of a block at once, one line per lane, with the partial butterflies of the C
+// code. Any order of the exact integer operations gives the same sums, so the lanes only need to hold every
+// intermediate value: the inputs are checked against the bound below, the kernel returns false otherwise and the C
+// code runs. The first stage of the forward transform and both stages of the inverse transform run on 32 bits. The
+// products of the 14-bit forward matrices in the second stage do not fit 32 bits, which runs on 64-bit lanes with
+// 32-bit inputs.
+//
+// Quantisation and dequantisation run on 64-bit lanes as in the C code.
+
+#if defined( __GNUC__ ) && !defined( __clang__ )
+// GCC sees neither the stores of the kernels into the temporary blocks nor those of the AVX-512 intrinsic headers
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+/// largest |input| of a 1-D transform of size whose sums and rounding offset fit 32 bits, the entries of the
+/// matrices being below 2^(matrixShift + 1)
+static inline Int xGetInputBound( Int size, Int matrixShift, Int shift )
+{
+  const Int64 maxSum = ( Int64( 1 ) << 31 ) - 1 - ( Int64( 1 ) << shift );
+  return Int( std::max<Int64>( -1, maxSum / ( Int64( size ) << ( matrixShift + 1 ) ) ) );
+}
+
+template< Int N >
+static inline const TMatrixCoeff* xGetMatrix( TransformDirection eDirection )
+{
+  switch( N )
+  {
+  case 4:  return g_aiT4 [eDirection][0];
+  case 8:  return g_aiT8 [eDirection][0];
+  case 16: return g_aiT16[eDirection][0];
+  default: return g_aiT32[eDirection][0];
+  }
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// AVX2
+// --------------------------------------------------------------------------------------------------------------------
+
+/// 8 lines on 32 bits
+struct Avx2Lines32x8
+{
+  typedef __m256i Vec;
+  static const Int NUM_LANES = 8;
+
+  SIMD_TARGET_AVX2 static inline Vec  load ( const Int* p )        { return _mm256_loadu_si256( ( const __m256i* )p ); }
+  SIMD_TARGET_AVX2 static inline Void store( Int* p, Vec v )       { _mm256_storeu_si256( ( __m256i* )p, v ); }
+  SIMD_TARGET_AVX2 static inline Vec  add  ( Vec a, Vec b )        { return _mm256_add_epi32( a, b ); }
+  SIMD_TARGET_AVX2 static inline Vec  sub  ( Vec a, Vec b )        { return _mm256_sub_epi32( a, b ); }
+  SIMD_TARGET_AVX2 static inline Vec  mul  ( Vec a, Int c )        { return _mm256_mullo_epi32( a, _mm256_set1_epi32( c ) ); }
+  SIMD_TARGET_AVX2 static inline Vec  round( Vec a, Int shift )
+  {
+    return _mm256_sra_epi32( _mm256_add_epi32( a, _mm256_set1_epi32( shift > 0 ? 1 << ( shift - 1 ) : 0 ) ), _mm_cvtsi32_si128( shift ) );
+  }
+  SIMD_TARGET_AVX2 static inline Vec  clip ( Vec a, Int iMin, Int iMax )
+  {
+    return _mm256_min_epi32( _mm256_max_epi32( a, _mm256_set1_epi32( iMin ) ), _mm256_set1_epi32( iMax ) );
+  }
+};
+
+/// 4 lines on 32 bits
+struct Avx2Lines32x4
+{
+  typedef __m128i Vec;
+  static const Int NUM_LANES = 4;
+
+  SIMD_TARGET_AVX2 static inline Vec  load ( const Int* p )        { return _mm_loadu_si128( ( const __m128i* )p ); }
+  SIMD_TARGET_AVX2 static inline Void store( Int* p, Vec v )       { _mm_storeu_si128( ( __m128i* )p, v ); }
+  SIMD_TARGET_AVX2 static inline Vec  add  ( Vec a, Vec b )        { return _mm_add_epi32( a, b ); }
+  SIMD_TARGET_AVX2 static inline Vec  sub  ( Vec a, Vec b )        { return _mm_sub_epi32( a, b ); }
+  SIMD_TARGET_AVX2 static inline Vec  mul  ( Vec a, Int c )        { return _mm_mullo_epi32( a, _mm_set1_epi32( c ) ); }
+  SIMD_TARGET_AVX2 static inline Vec  round( Vec a, Int shift )
+  {
+    return _mm_sra_epi32( _mm_add_epi32( a, _mm_set1_epi32( shift > 0 ? 1 << ( shift - 1 ) : 0 ) ), _mm_cvtsi32_si128( shift ) );
+  }
+  SIMD_TARGET_AVX2 static inline Vec  clip ( Vec a, Int iMin, Int iMax )
+  {
+    return _mm_min_epi32( _mm_max_epi32( a, _mm_set1_epi32( iMin ) ), _mm_set1_epi32( iMax ) );
+  }
+};
+
+/// arithmetic right shift of 64-bit lanes, which AVX2 lacks: logical shift and sign extension from bit 63 - shift
+SIMD_TARGET_AVX2 static inline __m256i avx2SraEpi64( __m256i a, Int shift )
+{
+  const __m256i sign = _mm256_set1_epi64x( Int64( UInt64( 1 ) << ( 63 - shift ) ) );
+  return _mm256_sub_epi64( _mm256_xor_si256( _mm256_srl_epi64( a, _mm_cvtsi32_si128( shift ) ), sign ), sign );
+}
+
+/// 4 lines on 64 bits, loaded from 32 bits and stored as coefficients; the values multiplied must fit 32 bits
+struct Avx2Lines64x4
+{
+  typedef __m256i Vec;
+  static const Int NUM_LANES = 4;
+
+  SIMD_TARGET_AVX2 static inline Vec  load ( const Int* p )        { return _mm256_cvtepi32_epi64( _mm_loadu_si128( ( const __m128i* )p ) ); }
+  SIMD_TARGET_AVX2 static inline Void store( TCoeff* p, Vec v )    { _mm256_storeu_si256( ( __m256i* )p, v ); }
+  SIMD_TARGET_AVX2 static inline Vec  add  ( Vec a, Vec b )        { return _mm256_add_epi64( a, b ); }
+  SIMD_TARGET_AVX2 static inline Vec  sub  ( Vec a, Vec b )        { return _mm256_sub_epi64( a, b ); }
+  SIMD_TARGET_AVX2 static inline Vec  mul  ( Vec a, Int c )        { return _mm256_mul_epi32( a, _mm256_set1_epi64x( c ) ); }
+  SIMD_TARGET_AVX2 static inline Vec  round( Vec a, Int shift )
+  {
+    return avx2SraEpi64( _mm256_add_epi64( a, _mm256_set1_epi64x( shift > 0 ? Int64( 1 ) << ( shift - 1 ) : 0 ) ), shift );
+  }
+};
+
+/// y[k * SIZE / N] = sum of mat[k * SIZE / N][n] * x[n] over n < N, for k < N: the forward partial butterflies of a
+/// transform of SIZE samples, with the even rows as a transform of N / 2 samples
+template< class V, Int SIZE, Int N >
+struct ForwardButterfly
+{
+  SIMD_TARGET_AVX2 static inline Void apply( const TMatrixCoeff* mat, const typename V::Vec* x, typename V::Vec* y )
+  {
+    const Int rowStep = SIZE / N;
+    typename V::Vec e[N / 2], o[N / 2];
+    for( Int n = 0; n < N / 2; n++ )
+    {
+      e[n] = V::add( x[n], x[N - 1 - n] );
+      o[n] = V::sub( x[n], x[N - 1 - n] );
+    }
+    for( Int k = 1; k < N; k += 2 )
+    {
+      const TMatrixCoeff* row = mat + k * rowStep * SIZE;
+      typename V::Vec sum = V::mul( o[0], row[0] );
+      for( Int n = 1; n < N / 2; n++ )
+      {
+        sum = V::add( sum, V::mul( o[n], row[n] ) );
+      }
+      y[k * rowStep] = sum;
+    }
+    ForwardButterfly<V, SIZE, N / 2>::apply( mat, e, y );
+  }
+};
+
+template< class V, Int SIZE >
+struct ForwardButterfly<V, SIZE, 1>
+{
+  SIMD_TARGET_AVX2 static inline Void apply( const TMatrixCoeff* mat, const typename V::Vec* x, typename V::Vec* y )
+  {
+    y[0] = V::mul( x[0], mat[0] );
+  }
+};
+
+/// y[n] = sum of mat[k * SIZE / N][n] * x[k * SIZE / N] over k < N, for n < N: the inverse partial butterflies of a
+/// transform of SIZE samples, with the even coefficients as a transform of N / 2 samples
+template< class V, Int SIZE, Int N >
+struct InverseButterfly
+{
+  SIMD_TARGET_AVX2 static inline Void apply( const TMatrixCoeff* mat, const typename V::Vec* x, typename V::Vec* y )
+  {
+    const Int rowStep = SIZE / N;
+    typename V::Vec e[N / 2];
+    InverseButterfly<V, SIZE, N / 2>::apply( mat, x, e );
+    for( Int n = 0; n < N / 2; n++ )
+    {
+      typename V::Vec o = V::mul( x[rowStep], mat[rowStep * SIZE + n] );
+      for( Int k = 3; k < N; k += 2 )
+      {
+        o = V::add( o, V::mul( x[k * rowStep], mat[k * rowStep * SIZE + n] ) );
+      }
+      y[n]         = V::add( e[n], o );
+      y[N - 1 - n] = V::sub( e[n], o );
+    }
+  }
+};
+
+template< class V, Int SIZE >
+struct InverseButterfly<V, SIZE, 1>
+{
+  SIMD_TARGET_AVX2 static inline Void apply( const TMatrixCoeff* mat, const typename V::Vec* x, typename V::Vec* y )
+  {
+    y[0] = V::mul( x[0], mat[0] );
+  }
+};
+
+/// 4-sample DST as the full matrix product of the C code, forward y[k] = sum of mat[k][n] * x[n], inverse y[n] = sum of mat[k][n] * x[k]
+template< class V, Bool bInverse >
+SIMD_TARGET_AVX2 static inline Void avx2Dst4( const TMatrixCoeff mat[4][4], const typename V::Vec* x, typename V::Vec* y )
+{
+  for( Int i = 0; i < 4; i++ )
+  {
+    typename V::Vec sum = V::mul( x[0], bInverse ? mat[0][i] : mat[i][0] );
+    for( Int j = 1; j < 4; j++ )
+    {
+      sum = V::add( sum, V::mul( x[j], bInverse ? mat[j][i] : mat[i][j] ) );
+    }
+    y[i] = sum;
+  }
+}
+
+/// forward 1-D transform of N samples of each line, src[n * lines + line] to dst[k * lines + line]
+template< class V, Int N, typename TDst >
+SIMD_TARGET_AVX2 static inline Void avx2ForwardLines( const Int* src, TDst* dst, Int lines, Bool useDST, Int shift )
+{
+  const TMatrixCoeff* mat = xGetMatrix<N>( TRANSFORM_FORWARD );
+  for( Int j = 0; j < lines; j += V::NUM_LANES )
+  {
+    typename V::Vec x[N], y[N];
+    for( Int n = 0; n < N; n++ )
+    {
+      x[n] = V::load( src + n * lines + j );
+    }
+    if( N == 4 && useDST )
+    {
+      avx2Dst4<V, false>( g_as_DST_MAT_4[TRANSFORM_FORWARD], x, y );
+    }
+    else
+    {
+      ForwardButterfly<V, N, N>::apply( mat, x, y );
+    }
+    for( Int k = 0; k < N; k++ )
+    {
+      V::store( dst + k * lines + j, V::round( y[k], shift ) );
+    }
+  }
+}
+
+/// inverse 1-D transform of N coefficients of each line with clipping, src[k * lines + line] to dst[n * lines + line]
+template< class V, Int N >
+SIMD_TARGET_AVX2 static inline Void avx2InverseLines( const Int* src, Int* dst, Int lines, Bool useDST, Int shift, Int clipMinimum, Int clipMaximum )
+{
+  const TMatrixCoeff* mat = xGetMatrix<N>( TRANSFORM_INVERSE );
+  for( Int j = 0; j < lines; j += V::NUM_LANES )
+  {
+    typename V::Vec x[N], y[N];
+    for( Int k = 0; k < N; k++ )
+    {
+      x[k] = V::load( src + k * lines + j );
+    }
+    if( N == 4 && useDST )
+    {
+      avx2Dst4<V, true>( g_as_DST_MAT_4[TRANSFORM_INVERSE], x, y );
+    }
+    else
+    {
+      InverseButterfly<V, N, N>::apply( mat, x, y );
+    }
+    for( Int n = 0; n < N; n++ )
+    {
+      V::store( dst + n * lines + j, V::clip( V::round( y[n], shift ), clipMinimum, clipMaximum ) );
+    }
+  }
+}
+
+/// 1-D transforms of size samples, 8 lines at a time on 32 bits where there are enough
+template< Bool bInverse >
+SIMD_TARGET_AVX2 static Void avx2TransformLines32( const Int* src, Int* dst, Int lines, Int size, Bool useDST, Int shift, Int clipMinimum = 0, Int clipMaximum = 0 )
+{
+#define TRANSFORM_LINES( V, N ) \
+  ( bInverse ? avx2InverseLines<V, N>( src, dst, lines, useDST, shift, clipMinimum, clipMaximum ) : avx2ForwardLines<V, N>( src, dst, lines, useDST, shift ) )
+
+  if( lines >= 8 )
+  {
+    switch( size )
+    {
+    case 4:  TRANSFORM_LINES( Avx2Lines32x8, 4  ); break;
+    case 8:  TRANSFORM_LINES( Avx2Lines32x8, 8  ); break;
+    case 16: TRANSFORM_LINES( Avx2Lines32x8, 16 ); break;
+    default: TRANSFORM_LINES( Avx2Lines32x8, 32 ); break;
+    }
+  }
+  else
+  {
+    switch( size )
+    {
+    case 4:  TRANSFORM_LINES( Avx2Lines32x4, 4  ); break;
+    case 8:  TRANSFORM_LINES( Avx2Lines32x4, 8  ); break;
+    case 16: TRANSFORM_LINES( Avx2Lines32x4, 16 ); break;
+    default: TRANSFORM_LINES( Avx2Lines32x4, 32 ); break;
+    }
+  }
+#undef TRANSFORM_LINES
+}
+
+/// dst[c * dstStride + r] = src[r * srcStride + c], 8x8 tiles where both sizes allow and 4x4 otherwise
+SIMD_TARGET_AVX2 static Void avx2Transpose( const Int* src, Int srcStride, Int* dst, Int dstStride, Int rows, Int cols )
+{
+  if( ( ( rows | cols ) & 7 ) == 0 )
+  {
+    for( Int r = 0; r < rows; r += 8 )
+    {
+      for( Int c = 0; c < cols; c += 8 )
+      {
+        const Int* s = src + r * srcStride + c;
+        __m256i    t[8], u[8];
+        for( Int i = 0; i < 8; i += 2 )
+        {
+          const __m256i a = _mm256_loadu_si256( ( const __m256i* )( s + i * srcStride ) );
+          const __m256i b = _mm256_loadu_si256( ( const __m256i* )( s + ( i + 1 ) * srcStride ) );
+          t[i]     = _mm256_unpacklo_epi32( a, b );
+          t[i + 1] = _mm256_unpackhi_epi32( a, b );
+        }
+        for( Int i = 0; i < 8; i += 4 )
+        {
+          u[i]     = _mm256_unpacklo_epi64( t[i],     t[i + 2] );
+          u[i + 1] = _mm256_unpackhi_epi64( t[i],     t[i + 2] );
+          u[i + 2] = _mm256_unpacklo_epi64( t[i + 1], t[i + 3] );
+          u[i + 3] = _mm256_unpackhi_epi64( t[i + 1], t[i + 3] );
+        }
+        Int* d = dst + c * dstStride + r;
+        for( Int i = 0; i < 4; i++ )
+        {
+          _mm256_storeu_si256( ( __m256i* )( d + i * dstStride ),       _mm256_permute2x128_si256( u[i], u[i + 4], 0x20 ) );
+          _mm256_storeu_si256( ( __m256i* )( d + ( i + 4 ) * dstStride ), _mm256_permute2x128_si256( u[i], u[i + 4], 0x31 ) );
+        }
+      }
+    }
+    return;
+  }
+
+  for( Int r = 0; r < rows; r += 4 )
+  {
+    for( Int c = 0; c < cols; c += 4 )
+    {
+      const Int*    s  = src + r * srcStride + c;
+      const __m128i a  = _mm_loadu_si128( ( const __m128i* )( s ) );
+      const __m128i b  = _mm_loadu_si128( ( const __m128i* )( s + srcStride ) );
+      const __m128i e  = _mm_loadu_si128( ( const __m128i* )( s + 2 * srcStride ) );
+      const __m128i f  = _mm_loadu_si128( ( const __m128i* )( s + 3 * srcStride ) );
+      const __m128i t0 = _mm_unpacklo_epi32( a, b );
+      const __m128i t1 = _mm_unpackhi_epi32( a, b );
+      const __m128i t2 = _mm_unpacklo_epi32( e, f );
+      const __m128i t3 = _mm_unpackhi_epi32( e, f );
+      Int* d = dst + c * dstStride + r;
+      _mm_storeu_si128( ( __m128i* )( d ),                 _mm_unpacklo_epi64( t0, t2 ) );
+      _mm_storeu_si128( ( __m128i* )( d + dstStride ),     _mm_unpackhi_epi64( t0, t2 ) );
+      _mm_storeu_si128( ( __m128i* )( d + 2 * dstStride ), _mm_unpacklo_epi64( t1, t3 ) );
+      _mm_storeu_si128( ( __m128i* )( d + 3 * dstStride ), _mm_unpackhi_epi64( t1, t3 ) );
+    }
+  }
+}
+
+/// whether |src| <= bound over a block whose width is a multiple of 4
+SIMD_TARGET_AVX2 static Bool avx2IsInRange( const Int* src, Int srcStride, Int iWidth, Int iHeight, Int bound )
+{
+  const __m128i maxVal = _mm_set1_epi32( bound );
+  const __m128i minVal = _mm_set1_epi32( -bound );
+  __m128i       out    = _mm_setzero_si128();
+  for( Int y = 0; y < iHeight; y++, src += srcStride )
+  {
+    for( Int x = 0; x < iWidth; x += 4 )
+    {
+      const __m128i v = _mm_loadu_si128( ( const __m128i* )( src + x ) );
+      out = _mm_or_si128( out, _mm_or_si128( _mm_cmpgt_epi32( v, maxVal ), _mm_cmplt_epi32( v, minVal ) ) );
+    }
+  }
+  return _mm_testz_si128( out, out ) != 0;
+}
+
+/// coefficients to 32 bits, false where one is out of [-bound, bound]
+SIMD_TARGET_AVX2 static Bool avx2NarrowCoefficients( const TCoeff* src, Int* dst, Int numSamples, Int bound )
+{
+  const __m256i maxVal = _mm256_set1_epi64x( bound );
+  const __m256i minVal = _mm256_set1_epi64x( -bound );
+  const __m256i low    = _mm256_setr_epi32( 0, 2, 4, 6, 0, 2, 4, 6 );
+  __m256i       out    = _mm256_setzero_si256();
+  for( Int n = 0; n < numSamples; n += 4 )
+  {
+    const __m256i v = _mm256_loadu_si256( ( const __m256i* )( src + n ) );
+    out = _mm256_or_si256( out, _mm256_or_si256( _mm256_cmpgt_epi64( v, maxVal ), _mm256_cmpgt_epi64( minVal, v ) ) );
+    _mm_storeu_si128( ( __m128i* )( dst + n ), _mm256_castsi256_si128( _mm256_permutevar8x32_epi32( v, low ) ) );
+  }
+  return _mm256_testz_si256( out, out ) != 0;
+}
+
+/// xTrMxN(): first stage on 32 bits, second stage on 64 bits
+SIMD_TARGET_AVX2 static Bool avx2ForwardTransform( Int bitDepth, Bool useDST, const Pel* piResi, UInt uiStride, TCoeff* piCoeff, Int iWidth, Int iHeight, Int maxLog2TrDynamicRange )
+{
+  const Int  matrixShift = g_transformMatrixShift[TRANSFORM_FORWARD];
+  const Int  shift_1st   = ( ( g_aucConvertToBit[iWidth] + 2 ) + bitDepth + matrixShift ) - maxLog2TrDynamicRange;
+  const Int  shift_2nd   = ( g_aucConvertToBit[iHeight] + 2 ) + matrixShift;
+  const Bool bDST        = useDST && iWidth == 4 && iHeight == 4;
+
+  // with 2^shift_1st >= iHeight, the results of the first stage are below 2^31 / iHeight and so are the sums of the
+  // second stage before the multiplications
+  if( shift_1st < 0 || ( 1 << shift_1st ) < iHeight || !avx2IsInRange( piResi, uiStride, iWidth, iHeight, xGetInputBound( iWidth, matrixShift, shift_1st ) ) )
+  {
+    return false;
+  }
+
+  Int block[MAX_TU_SIZE * MAX_TU_SIZE];
+  Int tmp  [MAX_TU_SIZE * MAX_TU_SIZE];
+
+  avx2Transpose( piResi, uiStride, block, iHeight, iHeight, iWidth );
+  avx2TransformLines32<false>( block, tmp, iHeight, iWidth, bDST, shift_1st );
+  avx2Transpose( tmp, iHeight, block, iWidth, iWidth, iHeight );
+
+  switch( iHeight )
+  {
+  case 4:  avx2ForwardLines<Avx2Lines64x4, 4 >( block, piCoeff, iWidth, bDST,  shift_2nd ); break;
+  case 8:  avx2ForwardLines<Avx2Lines64x4, 8 >( block, piCoeff, iWidth, false, shift_2nd ); break;
+  case 16: avx2ForwardLines<Avx2Lines64x4, 16>( block, piCoeff, iWidth, false, shift_2nd ); break;
+  default: avx2ForwardLines<Avx2Lines64x4, 32>( block, piCoeff, iWidth, false, shift_2nd ); break;
+  }
+  return true;
+}
+
+/// xITrMxN(): both stages on 32 bits
+SIMD_TARGET_AVX2 static Bool avx2InverseTransform( Int bitDepth, Bool useDST, const TCoeff* piCoeff, Pel* piResi, UInt uiStride, Int iWidth, Int iHeight, Int maxLog2TrDynamicRange )
+{
+  const Int  matrixShift = g_transformMatrixShift[TRANSFORM_INVERSE];
+  const Int  shift_1st   = matrixShift + 1;
+  const Int  shift_2nd   = ( matrixShift + maxLog2TrDynamicRange - 1 ) - bitDepth;
+  const Int  clipMinimum = -( 1 << maxLog2TrDynamicRange );
+  const Int  clipMaximum =  ( 1 << maxLog2TrDynamicRange ) - 1;
+  const Bool bDST        = useDST && iWidth == 4 && iHeight == 4;
+
+  // the second stage takes the clipped results of the first one
+  if( shift_2nd < 0 || ( 1 << maxLog2TrDynamicRange ) > xGetInputBound( iWidth, matrixShift, shift_2nd ) )
+  {
+    return false;
+  }
+
+  Int coeff[MAX_TU_SIZE * MAX_TU_SIZE];
+  Int tmp  [MAX_TU_SIZE * MAX_TU_SIZE];
+
+  if( !avx2NarrowCoefficients( piCoeff, coeff, iWidth * iHeight, xGetInputBound( iHeight, matrixShift, shift_1st ) ) )
+  {
+    return false;
+  }
+  avx2TransformLines32<true>( coeff, tmp, iWidth, iHeight, bDST, shift_1st, clipMinimum, clipMaximum );
+  avx2Transpose( tmp, iWidth, coeff, iHeight, iHeight, iWidth );
+  avx2TransformLines32<true>( coeff, tmp, iHeight, iWidth, bDST, shift_2nd, std::numeric_limits<Pel>::min(), std::numeric_limits<Pel>::max() );
+  avx2Transpose( tmp, iHeight, piResi, uiStride, iWidth, iHeight );
+  return true;
+}
+
+/// clipping of 64-bit lanes
+SIMD_TARGET_AVX2 static inline __m256i avx2ClipEpi64( __m256i a, __m256i minVal, __m256i maxVal )
+{
+  a = _mm256_blendv_epi8( a, maxVal, _mm256_cmpgt_epi64( a, maxVal ) );
+  return _mm256_blendv_epi8( a, minVal, _mm256_cmpgt_epi64( minVal, a ) );
+}
+
+/// TComTrQuant::xQuantCoefficients(), false where a |coefficient| does not fit 32 bits for the 32x32-bit multiplications
+SIMD_TARGET_AVX2 static Bool avx2Quant( const TCoeff* piCoef, TCoeff* piQCoef, TCoeff* piArlCCoef, TCoeff* piDeltaU, Int numSamples, const Int* piQuantCoeff, Int iQuantCoeff,
+                                        Int iQBits, Int iAdd, Int iQBitsC, Int iAddC, TCoeff entropyCodingMinimum, TCoeff entropyCodingMaximum, TCoeff& uiAbsSum )
+{
+  if( ( numSamples & 3 ) != 0 || iQBits < 8 )
+  {
+    return false;
+  }
+  const __m128i qBits   = _mm_cvtsi32_si128( iQBits );
+  const __m128i qBitsC  = _mm_cvtsi32_si128( iQBitsC );
+  const __m256i add     = _mm256_set1_epi64x( iAdd );
+  const __m256i addC    = _mm256_set1_epi64x( iAddC );
+  const __m256i scale   = _mm256_set1_epi64x( iQuantCoeff );
+  const __m256i minVal  = _mm256_set1_epi64x( entropyCodingMinimum );
+  const __m256i maxVal  = _mm256_set1_epi64x( entropyCodingMaximum );
+  const __m256i zero    = _mm256_setzero_si256();
+  __m256i       sum     = zero;
+  __m256i       out     = zero;
+
+  for( Int n = 0; n < numSamples; n += 4 )
+  {
+    const __m256i level    = _mm256_loadu_si256( ( const __m256i* )( piCoef + n ) );
+    const __m256i sign     = _mm256_cmpgt_epi64( zero, level );
+    const __m256i absLevel = _mm256_sub_epi64( _mm256_xor_si256( level, sign ), sign );
+    out = _mm256_or_si256( out, _mm256_srli_epi64( absLevel, 32 ) );
+
+    const __m256i q        = piQuantCoeff != NULL ? _mm256_cvtepu32_epi64( _mm_loadu_si128( ( const __m128i* )( piQuantCoeff + n ) ) ) : scale;
+    const __m256i tmpLevel = _mm256_mul_epu32( absLevel, q );
+    if( piArlCCoef != NULL )
+    {
+      _mm256_storeu_si256( ( __m256i* )( piArlCCoef + n ), _mm256_srl_epi64( _mm256_add_epi64( tmpLevel, addC ), qBitsC ) );
+    }
+
+    const __m256i magnitude = _mm256_srl_epi64( _mm256_add_epi64( tmpLevel, add ), qBits );
+    _mm256_storeu_si256( ( __m256i* )( piDeltaU + n ), avx2SraEpi64( _mm256_sub_epi64( tmpLevel, _mm256_sll_epi64( magnitude, qBits ) ), iQBits - 8 ) );
+    sum = _mm256_add_epi64( sum, magnitude );
+
+    const __m256i coefficient = _mm256_sub_epi64( _mm256_xor_si256( magnitude, sign ), sign );
+    _mm256_storeu_si256( ( __m256i* )( piQCoef + n ), avx2ClipEpi64( coefficient, minVal, maxVal ) );
+  }
+  if( !_mm256_testz_si256( out, out ) )
+  {
+    return false;
+  }
+
+  const __m128i sum2 = _mm_add_epi64( _mm256_castsi256_si128( sum ), _mm256_extracti128_si256( sum, 1 ) );
+  _mm_storel_epi64( ( __m128i* )&uiAbsSum, _mm_add_epi64( sum2, _mm_unpackhi_epi64( sum2, sum2 ) ) );
+  return true;
+}
+
+/// TComTrQuant::xDeQuantCoefficients(), false where the clipped inputs do not fit 32 bits for the 32x32-bit multiplications
+SIMD_TARGET_AVX2 static Bool avx2DeQuant( const TCoeff* piQCoef, TCoeff* piCoef, Int numSamples, const Int* piDequantCoef, Int iScale, Int rightShift,
+                                          Intermediate_Int inputMinimum, Intermediate_Int inputMaximum, TCoeff transformMinimum, TCoeff transformMaximum )
+{
+  if( ( numSamples & 3 ) != 0 || inputMinimum < std::numeric_limits<Int>::min() || inputMaximum > std::numeric_limits<Int>::max() )
+  {
+    return false;
+  }
+  const __m256i inMin  = _mm256_set1_epi64x( inputMinimum );
+  const __m256i inMax  = _mm256_set1_epi64x( inputMaximum );
+  const __m256i minVal = _mm256_set1_epi64x( transformMinimum );
+  const __m256i maxVal = _mm256_set1_epi64x( transformMaximum );
+  const __m256i scale  = _mm256_set1_epi64x( iScale );
+  const __m256i add    = _mm256_set1_epi64x( rightShift > 0 ? Intermediate_Int( 1 ) << ( rightShift - 1 ) : 0 );
+  const __m128i shift  = _mm_cvtsi32_si128( -rightShift );
+
+  for( Int n = 0; n < numSamples; n += 4 )
+  {
+    const __m256i level = avx2ClipEpi64( _mm256_loadu_si256( ( const __m256i* )( piQCoef + n ) ), inMin, inMax );
+    const __m256i s     = piDequantCoef != NULL ? _mm256_cvtepi32_epi64( _mm_loadu_si128( ( const __m128i* )( piDequantCoef + n ) ) ) : scale;
+    const __m256i coeff = _mm256_mul_epi32( level, s );
+    const __m256i value = rightShift > 0 ? avx2SraEpi64( _mm256_add_epi64( coeff, add ), rightShift ) : _mm256_sll_epi64( coeff, shift );
+    _mm256_storeu_si256( ( __m256i* )( piCoef + n ), avx2ClipEpi64( value, minVal, maxVal ) );
+  }
+  return true;
+}
+
+// --------------------------------------------------------------------------------------------------------------------
+// AVX-512
+// --------------------------------------------------------------------------------------------------------------------
+
+#if VECTOR_CODING__AVX512
+
+/// as avx2Quant(), 8 coefficients at a time with the 64-bit arithmetic shifts and clipping of AVX-512
+SIMD_TARGET_AVX512 static Bool avx512Quant( const TCoeff* piCoef, TCoeff* piQCoef, TCoeff* piArlCCoef, TCoeff* piDeltaU, Int numSamples, const Int* piQuantCoeff, Int iQuantCoeff,
+                                            Int iQBits, Int iAdd, Int iQBitsC, Int iAddC, TCoeff entropyCodingMinimum, TCoeff entropyCodingMaximum, TCoeff& uiAbsSum )
+{
+  if( ( numSamples & 7 ) != 0 || iQBits < 8 )
+  {
+    return avx2Quant( piCoef, piQCoef, piArlCCoef, piDeltaU, numSamples, piQuantCoeff, iQuantCoeff, iQBits, iAdd, iQBitsC, iAddC, entropyCodingMinimum, entropyCodingMaximum, uiAbsSum );
+  }
+  const __m128i qBits   = _mm_cvtsi32_si128( iQBits );
+  const __m128i qBits8  = _mm_cvtsi32_si128( iQBits - 8 );
+  const __m128i qBitsC  = _mm_cvtsi32_si128( iQBitsC );
+  const __m512i add     = _mm512_set1_epi64( iAdd );
+  const __m512i addC    = _mm512_set1_epi64( iAddC );
+  const __m512i scale   = _mm512_set1_epi64( iQuantCoeff );
+  const __m512i minVal  = _mm512_set1_epi64( entropyCodingMinimum );
+  const __m512i maxVal  = _mm512_set1_epi64( entropyCodingMaximum );
+  const __m512i zero    = _mm512_setzero_si512();
+  __m512i       sum     = zero;
+  __m512i       out     = zero;
+
+  for( Int n = 0; n < numSamples; n += 8 )
+  {
+    const __m512i level    = _mm512_loadu_si512( piCoef + n );
+    const __m512i absLevel = _mm512_abs_epi64( level );
+    out = _mm512_or_si512( out, _mm512_srli_epi64( absLevel, 32 ) );
+
+    const __m512i q        = piQuantCoeff != NULL ? _mm512_cvtepu32_epi64( _mm256_loadu_si256( ( const __m256i* )( piQuantCoeff + n ) ) ) : scale;
+    const __m512i tmpLevel = _mm512_mul_epu32( absLevel, q );
+    if( piArlCCoef != NULL )
+    {
+      _mm512_storeu_si512( piArlCCoef + n, _mm512_srl_epi64( _mm512_add_epi64( tmpLevel, addC ), qBitsC ) );
+    }
+
+    const __m512i magnitude = _mm512_srl_epi64( _mm512_add_epi64( tmpLevel, add ), qBits );
+    _mm512_storeu_si512( piDeltaU + n, _mm512_sra_epi64( _mm512_sub_epi64( tmpLevel, _mm512_sll_epi64( magnitude, qBits ) ), qBits8 ) );
+    sum = _mm512_add_epi64( sum, magnitude );
+
+    const __m512i coefficient = _mm512_mask_sub_epi64( magnitude, _mm512_cmplt_epi64_mask( level, zero ), zero, magnitude );
+    _mm512_storeu_si512( piQCoef + n, _mm512_min_epi64( _mm512_max_epi64( coefficient, minVal ), maxVal ) );
+  }
+  if( _mm512_test_epi64_mask( out, out ) != 0 )
+  {
+    return false;
+  }
+
+  const __m256i sum4 = _mm256_add_epi64( _mm512_castsi512_si256( sum ), _mm512_extracti64x4_epi64( sum, 1 ) );
+  const __m128i sum2 = _mm_add_epi64( _mm256_castsi256_si128( sum4 ), _mm256_extracti128_si256( sum4, 1 ) );
+  _mm_storel_epi64( ( __m128i* )&uiAbsSum, _mm_add_epi64( sum2, _mm_unpackhi_epi64( sum2, sum2 ) ) );
+  return true;
+}
+
+/// as avx2DeQuant(), 8 coefficients at a time
+SIMD_TARGET_AVX512 static Bool avx512DeQuant( const TCoeff* piQCoef, TCoeff* piCoef, Int numSamples, const Int* piDequantCoef, Int iScale, Int rightShift,
+                                              Intermediate_Int inputMinimum, Intermediate_Int inputMaximum, TCoeff transformMinimum, TCoeff transformMaximum )
+{
+  if( ( numSamples & 7 ) != 0 || inputMinimum < std::numeric_limits<Int>::min() || inputMaximum > std::numeric_limits<Int>::max() )
+  {
+    return avx2DeQuant( piQCoef, piCoef, numSamples, piDequantCoef, iScale, rightShift, inputMinimum, inputMaximum, transformMinimum, transformMaximum );
+  }
+  const __m512i inMin  = _mm512_set1_epi64( inputMinimum );
+  const __m512i inMax  = _mm512_set1_epi64( inputMaximum );
+  const __m512i minVal = _mm512_set1_epi64( transformMinimum );
+  const __m512i maxVal = _mm512_set1_epi64( transformMaximum );
+  const __m512i scale  = _mm512_set1_epi64( iScale );
+  const __m512i add    = _mm512_set1_epi64( rightShift > 0 ? Intermediate_Int( 1 ) << ( rightShift - 1 ) : 0 );
+  const __m128i shift  = _mm_cvtsi32_si128( rightShift > 0 ? rightShift : -rightShift );
+
+  for( Int n = 0; n < numSamples; n += 8 )
+  {
+    const __m512i level = _mm512_min_epi64( _mm512_max_epi64( _mm512_loadu_si512( piQCoef + n ), inMin ), inMax );
+    const __m512i s     = piDequantCoef != NULL ? _mm512_cvtepi32_epi64( _mm256_loadu_si256( ( const __m256i* )( piDequantCoef + n ) ) ) : scale;
+    const __m512i coeff = _mm512_mul_epi32( level, s );
+    const __m512i value = rightShift > 0 ? _mm512_sra_epi64( _mm512_add_epi64( coeff, add ), shift ) : _mm512_sll_epi64( coeff, shift );
+    _mm512_storeu_si512( piCoef + n, _mm512_min_epi64( _mm512_max_epi64( value, minVal ), maxVal ) );
+  }
+  return true;
+}
+#endif // VECTOR_CODING__AVX512
+
+// --------------------------------------------------------------------------------------------------------------------
+// Selection
+// --------------------------------------------------------------------------------------------------------------------
+
+Void TComTrQuant::initTrQuantX86( SimdExtension eExtension )
+{
+  // transforms of 4 to 32 lines are too short for 16 lanes: the AVX2 ones serve AVX-512 too
+  m_fpForwardTransformX86 = eExtension >= SIMD_AVX2 ? avx2ForwardTransform : NULL;
+  m_fpInverseTransformX86 = eExtension >= SIMD_AVX2 ? avx2InverseTransform : NULL;
+  m_fpQuantX86            = eExtension >= SIMD_AVX2 ? avx2Quant            : NULL;
+  m_fpDeQuantX86          = eExtension >= SIMD_AVX2 ? avx2DeQuant          : NULL;
+#if VECTOR_CODING__AVX512
+  if( eExtension >= SIMD_AVX512 )
+  {
+    m_fpQuantX86   = avx512Quant;
+    m_fpDeQuantX86 = avx512DeQuant;
+  }
+#endif
+}
+
+#if defined( __GNUC__ ) && !defined( __clang__ )
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+//! \}
+
+} // namespace pcc_hm
@@ -160,9 +160,22 @@ namespace pcc_hm {
 #if defined __SSE2__ || defined __AVX2__ || defined __AVX__ || defined _M_AMD64 || defined _M_X64
 #define VECTOR_CODING__INTERPOLATION_FILTER               1 ///< enable vector coding for the interpolation filter. 1 (default if SSE possible) disable SSE vector coding. Should not affect RD costs/decisions. Code back-ported from JEM2.0.
 #define VECTOR_CODING__DISTORTION_CALCULATIONS            1 ///< enable vector coding for distortion calculations   1 (default if SSE possible) disable SSE vector coding. Should not affect RD costs/decisions. Code back-ported from JEM2.0.
+#if defined __clang__ || defined _MSC_VER || ( defined __GNUC__ && ( __GNUC__ > 4 || ( __GNUC__ == 4 && __GNUC_MINOR__ >= 9 ) ) )
+#define VECTOR_CODING__RUNTIME_DISPATCH                   1 ///< AVX2 kernels built with per-function target attributes and selected at run time from the CPU features (TComSimd.h). Should not affect RD costs/decisions.
+#if defined __clang__ || ( defined _MSC_VER && _MSC_VER >= 1911 ) || ( defined __GNUC__ && __GNUC__ >= 5 )
+#define VECTOR_CODING__AVX512                             1 ///< also build the AVX-512 (F and BW) kernels
+#else
+#define VECTOR_CODING__AVX512                             0
+#endif
+#else
+#define VECTOR_CODING__RUNTIME_DISPATCH                   0 ///< the compiler cannot build code for another target than the one of the command line
+#define VECTOR_CODING__AVX512                             0
+#endif
 #else
 #define VECTOR_CODING__INTERPOLATION_FILTER               0 ///< enable vector coding for the interpolation filter. 0 (default if SSE not possible) disable SSE vector coding. Should not affect RD costs/decisions. Code back-ported from JEM2.0.
 #define VECTOR_CODING__DISTORTION_CALCULATIONS            0 ///< enable vector coding for distortion calculations   0 (default if SSE not possible) disable SSE vector coding. Should not affect RD costs/decisions. Code back-ported from JEM2.0.
+#define VECTOR_CODING__RUNTIME_DISPATCH                   0 ///< no x86 vector extension to select at run time
+#define VECTOR_CODING__AVX512                             0
 #endif
 
 // ====================================================================================================================
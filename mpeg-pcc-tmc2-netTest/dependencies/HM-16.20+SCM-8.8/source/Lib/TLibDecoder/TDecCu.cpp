@@ -109,13 +109,8 @@ Void TDecCu::create( UInt uiMaxDepth, UInt uiMaxWidth, UInt uiMaxHeight, ChromaF
   m_bDecodeDQP = false;
   m_IsChromaQpAdjCoded = false;
 
-  // initialize partition order.
-  UInt* piTmp = &g_auiZscanToRaster[0];
-  initZscanToRaster(m_uiMaxDepth, 1, 0, piTmp);
-  initRasterToZscan( uiMaxWidth, uiMaxHeight, m_uiMaxDepth );
-
-  // initialize conversion matrix from partition index to pel
-  initRasterToPelXY( uiMaxWidth, uiMaxHeight, m_uiMaxDepth );
+  // initialize partition order and the conversion matrix from partition index to pel.
+  initCtuPartitionTables( uiMaxWidth, uiMaxHeight, m_uiMaxDepth );
 }
 
 Void TDecCu::destroy()
@@ -4,19 +4,25 @@
 #include <fstream>
 #include <string>
 #include <map>
+#include <vector>
+#include "TEncLFCNContext.h"
 using namespace std;
 
-unsigned char** occupancyData;
-int occupancyHeight;
-int occupancyWidth;
-bool                QPr5;
-int                 OorGorA;
-ofstream          extraFeatures;
-map<string, string> xyd_features;
-map<string, int>    frontModeFlag; 
+// Occupancy map video of the current GOF as handed over by TMC2, the planes are not copied.
+struct OccupancyMapView {
+  vector<const unsigned char*> frames;         // luma plane of each occupancy frame, stride = width
+  int                          width     = 0;
+  int                          height    = 0;
+  int                          precision = 4;  // occupancy precision of the V-PCC encoder
+  vector<const size_t*>        blockToPatch;   // patch index + 1 of each block of each frame, 0 for padding
+  int                          blockToPatchWidth  = 0;  // in blocks
+  int                          blockToPatchHeight = 0;
+  int                          blockSize          = 16; // occupancy resolution of the V-PCC encoder
+};
 
-void occupancyDciInit(int height, int width, int frameNum, string occupancyName);
-void checkData(int frameNum, int height, int width);
+// The LFCN state lives in the TEncLFCNContext of each HM encoder, these helpers only fill it in.
+void occupancyDciInit(pcc_hm::TEncLFCNContext& context, const OccupancyMapView& occupancyView, string name);
+void checkData(const OccupancyMapView& occupancyView);
 
-void imgClassicate(string name);
+pcc_hm::LFCNVideoType imgClassicate(string name);
 #endif
\ No newline at end of file
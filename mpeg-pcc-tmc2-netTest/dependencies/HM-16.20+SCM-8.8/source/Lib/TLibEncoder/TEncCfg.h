@@ -143,6 +143,15 @@ protected:
 #endif
 #if PCC_RDO_EXT && !PCC_ME_EXT
   std::string m_occupancyFileName;
+#endif
+#ifdef SDMTEST
+  std::string m_lfcnModelFile;                                ///< LFCN model file replacing the compiled split models, empty for none
+  Double      m_lfcnTimeReduction;                            ///< fraction of the full RDO CTU time saved by adapting the LFCN thresholds, 0 off
+  Double      m_lfcnPictureTimeBudget;                        ///< CTU compression time of a picture in ms the LFCN thresholds adapt to, 0 off
+  Bool        m_lfcnEarlySplit;                               ///< split confidently predicted CUs without checking their modes
+  Bool        m_lfcnCtuDepthRange;                            ///< bound the CU depths of each CTU by a predicted range
+  Bool        m_lfcnNearLayerPrior;                           ///< bound the CUs of the far layer pictures by those of the near layer
+  UInt        m_lfcnEmptyCtuFastPath;                         ///< video types whose unoccupied CTUs are coded without mode search: 1 geometry, 2 attribute
 #endif
   //==== File I/O ========
   Int       m_iFrameRate;
@@ -326,6 +335,7 @@ protected:
   std::vector<Int> m_tileRowHeight;
 
   Bool      m_entropyCodingSyncEnabledFlag;
+  Int       m_wppThreads;                                     ///< number of CTU rows compressed concurrently with entropy coding sync
 
   HashType  m_decodedPictureHashSEIType;
   Bool      m_bufferingPeriodSEIEnabled;
@@ -562,8 +572,19 @@ protected:
 
 public:
   TEncCfg()
-  : m_tileColumnWidth()
+  :
+#ifdef SDMTEST
+    m_lfcnTimeReduction(0)
+  , m_lfcnPictureTimeBudget(0)
+  , m_lfcnEarlySplit(false)
+  , m_lfcnCtuDepthRange(false)
+  , m_lfcnNearLayerPrior(false)
+  , m_lfcnEmptyCtuFastPath(0)
+  ,
+#endif
+    m_tileColumnWidth()
   , m_tileRowHeight()
+  , m_wppThreads(1)
   {
     m_PCMBitDepth[CHANNEL_TYPE_LUMA]=8;
     m_PCMBitDepth[CHANNEL_TYPE_CHROMA]=8;
@@ -593,6 +614,23 @@ public:
   std::string getOccupancyMapFileName() { return m_occupancyFileName; }
 #endif
 
+#ifdef SDMTEST
+  Void setLFCNModelFile(const std::string& lfcnModelFile) { m_lfcnModelFile = lfcnModelFile; }
+  const std::string& getLFCNModelFile() const { return m_lfcnModelFile; }
+  Void setLFCNTimeReduction(Double d) { m_lfcnTimeReduction = d; }
+  Double getLFCNTimeReduction() const { return m_lfcnTimeReduction; }
+  Void setLFCNPictureTimeBudget(Double d) { m_lfcnPictureTimeBudget = d; }
+  Double getLFCNPictureTimeBudget() const { return m_lfcnPictureTimeBudget; }
+  Void setLFCNEarlySplit(Bool b) { m_lfcnEarlySplit = b; }
+  Bool getLFCNEarlySplit() const { return m_lfcnEarlySplit; }
+  Void setLFCNCtuDepthRange(Bool b) { m_lfcnCtuDepthRange = b; }
+  Bool getLFCNCtuDepthRange() const { return m_lfcnCtuDepthRange; }
+  Void setLFCNNearLayerPrior(Bool b) { m_lfcnNearLayerPrior = b; }
+  Bool getLFCNNearLayerPrior() const { return m_lfcnNearLayerPrior; }
+  Void setLFCNEmptyCtuFastPath(UInt u) { m_lfcnEmptyCtuFastPath = u; }
+  UInt getLFCNEmptyCtuFastPath() const { return m_lfcnEmptyCtuFastPath; }
+#endif
+
   Void setProfile(Profile::Name profile) { m_profile = profile; }
   Void setLevel(Level::Tier tier, Level::Name level) { m_levelTier = tier; m_level = level; }
 
@@ -666,6 +704,9 @@ public:
   Void      setMaxCUWidth                   ( UInt  u )      { m_maxCUWidth  = u; }
   Void      setMaxCUHeight                  ( UInt  u )      { m_maxCUHeight = u; }
   Void      setMaxTotalCUDepth              ( UInt  u )      { m_maxTotalCUDepth = u; }
+  UInt      getMaxCUWidth                   () const         { return m_maxCUWidth; }
+  UInt      getMaxCUHeight                  () const         { return m_maxCUHeight; }
+  UInt      getMaxTotalCUDepth              () const         { return m_maxTotalCUDepth; }
   Void      setLog2DiffMaxMinCodingBlockSize( UInt  u )      { m_log2DiffMaxMinCodingBlockSize = u; }
 
   //======== Transform =============
@@ -688,6 +729,7 @@ public:
   Void      setMotionEstimationSearchMethod ( MESearchMethod e ) { m_motionEstimationSearchMethod = e; }
   Void      setSearchRange                  ( Int   i )      { m_iSearchRange = i; }
   Void      setBipredSearchRange            ( Int   i )      { m_bipredSearchRange = i; }
+  Int       getBipredSearchRange            () const         { return m_bipredSearchRange; }
   Void      setClipForBiPredMeEnabled       ( Bool  b )      { m_bClipForBiPredMeEnabled = b; }
   Void      setFastMEAssumingSmootherMVEnabled ( Bool b )    { m_bFastMEAssumingSmootherMVEnabled = b; }
   Void      setMinSearchWindow              ( Int   i )      { m_minSearchWindow = i; }
@@ -921,6 +963,8 @@ public:
   Void  xCheckGSParameters();
   Void  setEntropyCodingSyncEnabledFlag(Bool b)                      { m_entropyCodingSyncEnabledFlag = b; }
   Bool  getEntropyCodingSyncEnabledFlag() const                      { return m_entropyCodingSyncEnabledFlag; }
+  Void  setWppThreads                  ( Int i )                     { m_wppThreads = i; }
+  Int   getWppThreads                  () const                      { return m_wppThreads; }
   Void  setDecodedPictureHashSEIType(HashType m)                     { m_decodedPictureHashSEIType = m; }
   HashType getDecodedPictureHashSEIType() const                      { return m_decodedPictureHashSEIType; }
   Void  setBufferingPeriodSEIEnabled(Bool b)                         { m_bufferingPeriodSEIEnabled = b; }
@@ -0,0 +1,141 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TEncCtuDepthPredictor.cpp
+    \brief    CTU level prediction of the CU depth range searched by the RDO
+*/
+
+#include <cmath>
+#include <algorithm>
+
+#include "TEncCtuDepthPredictor.h"
+
+namespace pcc_hm {
+
+//! \ingroup TLibEncoder
+//! \{
+
+TEncCtuDepthPredictor::TEncCtuDepthPredictor()
+: m_uiMaxCUWidth ( 0 )
+, m_uiMaxCUHeight( 0 )
+{
+}
+
+Void TEncCtuDepthPredictor::create( UInt uiMaxCUWidth, UInt uiMaxCUHeight )
+{
+  m_uiMaxCUWidth  = uiMaxCUWidth;
+  m_uiMaxCUHeight = uiMaxCUHeight;
+  // the first row and column of the tables stay zero
+  m_sum  .assign( ( uiMaxCUWidth + 1 ) * ( uiMaxCUHeight + 1 ), Int64( 0 ) );
+  m_sumSq.assign( ( uiMaxCUWidth + 1 ) * ( uiMaxCUHeight + 1 ), Int64( 0 ) );
+}
+
+Void TEncCtuDepthPredictor::destroy()
+{
+  m_sum  .clear();
+  m_sumSq.clear();
+}
+
+Void TEncCtuDepthPredictor::predict( const Pel* piOrg, Int iStride, Int iBitDepth, Int iQP, Int iMaxDepth,
+                                     OccupancyCategory eCategory, Int iColMinDepth, Int iColMaxDepth,
+                                     Int& riMinDepth, Int& riMaxDepth )
+{
+  const UInt uiTableStride = m_uiMaxCUWidth + 1;
+  for( UInt y = 0; y < m_uiMaxCUHeight; y++ )
+  {
+    const Int64* piSumUp   = &m_sum  [y * uiTableStride];
+    const Int64* piSqUp    = &m_sumSq[y * uiTableStride];
+    Int64*       piSum     = &m_sum  [( y + 1 ) * uiTableStride];
+    Int64*       piSumSq   = &m_sumSq[( y + 1 ) * uiTableStride];
+    Int64        iRowSum   = 0;
+    Int64        iRowSumSq = 0;
+    for( UInt x = 0; x < m_uiMaxCUWidth; x++ )
+    {
+      iRowSum       += piOrg[x];
+      iRowSumSq     += Int64( piOrg[x] ) * piOrg[x];
+      piSum  [x + 1] = piSumUp[x + 1] + iRowSum;
+      piSumSq[x + 1] = piSqUp [x + 1] + iRowSumSq;
+    }
+    piOrg += iStride;
+  }
+
+  // quantization step of the QP at the bit depth of the samples
+  const Double dQStep     = pow( 2.0, ( iQP - 4 ) / 6.0 ) * ( 1 << std::max( 0, iBitDepth - 8 ) );
+  const Int    iFlatDepth = xGetFlatDepth( LFCN_CTU_FLAT_FACTOR * dQStep * dQStep, iMaxDepth );
+  const Bool   bColocated = iColMinDepth >= 0;
+
+  riMaxDepth = std::max( iFlatDepth, bColocated ? iColMaxDepth : 0 ) + ( eCategory == OCCUPANCY_EMPTY ? 0 : 1 );
+  riMaxDepth = Clip3( 0, iMaxDepth, riMaxDepth );
+  riMinDepth = bColocated ? Clip3( 0, riMaxDepth, std::min( iColMinDepth - 1, iFlatDepth ) ) : 0;
+}
+
+Int TEncCtuDepthPredictor::xGetFlatDepth( Double dThreshold, Int iMaxDepth ) const
+{
+  for( Int iDepth = 0; iDepth < iMaxDepth; iDepth++ )
+  {
+    const Int iWidth  = Int( m_uiMaxCUWidth  >> iDepth );
+    const Int iHeight = Int( m_uiMaxCUHeight >> iDepth );
+    Bool      bFlat   = true;
+    for( Int y = 0; y < Int( m_uiMaxCUHeight ) && bFlat; y += iHeight )
+    {
+      for( Int x = 0; x < Int( m_uiMaxCUWidth ) && bFlat; x += iWidth )
+      {
+        bFlat = xGetVariance( x, y, iWidth, iHeight ) <= dThreshold;
+      }
+    }
+    if( bFlat )
+    {
+      return iDepth;
+    }
+  }
+  return iMaxDepth;
+}
+
+Double TEncCtuDepthPredictor::xGetVariance( Int x, Int y, Int iWidth, Int iHeight ) const
+{
+  const UInt   uiStride = m_uiMaxCUWidth + 1;
+  const Int64* piTop    = &m_sum  [y * uiStride + x];
+  const Int64* piBottom = piTop + iHeight * uiStride;
+  const Int64* piTopSq  = &m_sumSq[y * uiStride + x];
+  const Int64* piBotSq  = piTopSq + iHeight * uiStride;
+  const Int64  iNum     = Int64( iWidth ) * iHeight;
+  const Int64  iSum     = piBottom[iWidth] - piBottom[0] - piTop[iWidth] + piTop[0];
+  const Int64  iSumSq   = piBotSq [iWidth] - piBotSq [0] - piTopSq[iWidth] + piTopSq[0];
+  // n * sum(s^2) - sum(s)^2 is exact in integer arithmetic
+  return Double( iNum * iSumSq - iSum * iSum ) / ( Double( iNum ) * Double( iNum ) );
+}
+
+//! \}
+
+} // namespace pcc_hm
@@ -0,0 +1,95 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TEncCtuDepthPredictor.h
+    \brief    CTU level prediction of the CU depth range searched by the RDO (header)
+*/
+
+#ifndef __TENCCTUDEPTHPREDICTOR__
+#define __TENCCTUDEPTHPREDICTOR__
+
+#include <vector>
+
+#include "TLibCommon/CommonDef.h"
+#include "TEncOccupancySummary.h"
+
+namespace pcc_hm {
+
+//! \ingroup TLibEncoder
+//! \{
+
+#define LFCN_CTU_FLAT_FACTOR         0.25   ///< a CU is flat when its variance is below this fraction of Qstep^2
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// predicts once per CTU the range of CU depths worth checking, from the activity of the original samples, the
+/// occupancy of the CTU, the QP and the final depths of the collocated CTU in the previous picture:
+///  - the maximum is one above the larger of the depth at which every CU is flat and the collocated maximum, without
+///    the margin in a CTU without occupied sample, whose samples are padding the decoder discards
+///  - the minimum is one below the collocated minimum, and 0 when the CTU is flat at a lower depth or has no
+///    collocated depths
+class TEncCtuDepthPredictor
+{
+private:
+  UInt                m_uiMaxCUWidth;
+  UInt                m_uiMaxCUHeight;
+  std::vector<Int64>  m_sum;             ///< summed-area table of the samples, stride m_uiMaxCUWidth + 1
+  std::vector<Int64>  m_sumSq;           ///< summed-area table of the squared samples
+
+public:
+  TEncCtuDepthPredictor();
+  virtual ~TEncCtuDepthPredictor() {}
+
+  Void    create            ( UInt uiMaxCUWidth, UInt uiMaxCUHeight );
+  Void    destroy           ();
+
+  /// depth range [riMinDepth, riMaxDepth] within [0, iMaxDepth] of a CTU lying entirely in the picture; iColMinDepth
+  /// is negative when the collocated CTU has no recorded depths
+  Void    predict           ( const Pel* piOrg, Int iStride, Int iBitDepth, Int iQP, Int iMaxDepth,
+                              OccupancyCategory eCategory, Int iColMinDepth, Int iColMaxDepth,
+                              Int& riMinDepth, Int& riMaxDepth );
+
+private:
+  /// smallest depth up to iMaxDepth at which the luma variance of every CU is below the flatness threshold
+  Int     xGetFlatDepth     ( Double dThreshold, Int iMaxDepth ) const;
+  Double  xGetVariance      ( Int x, Int y, Int iWidth, Int iHeight ) const;
+};
+
+//! \}
+
+} // namespace pcc_hm
+
+#endif // __TENCCTUDEPTHPREDICTOR__
@@ -43,8 +43,13 @@
 
 #include <cmath>
 #include <algorithm>
+#include <chrono>
 
 #ifdef SDMTEST            // MesksCode
+#include "TEncLFCN.h"
+#include "TEncScratchArena.h"
+#include "TEncFeatureQuantizer.h"
+
 #define P_GEO_INPUT 3     
 #define P_ATT_INPUT 3  
 #define P_GEO_OUTPUT 1    
@@ -102,57 +107,7 @@
 #define I_GEO_CONCATENATE_OUTPUT 1               // IGeometry Frames CONCATENATE output number
 #define I_ATT_CONCATENATE_OUTPUT 1               // IAttribute Frames CONCATENATE output number
 
-extern unsigned char** occupancyData;
-extern int             occupancyHeight;
-extern int             occupancyWidth;
-extern bool            QPr5;
-extern int             OorGorA;
-
-int CUClassify( int Width, int Height, int Y, int X, int nowPOC ) {
-  int numberOfOne = 0; 
-  int shrink      = 0; 
-  if ( QPr5 )
-    shrink = 2;
-  else
-    shrink = 4;
-
-  int oCUWidth  = Width / shrink;
-  int oCUHeight = Height / shrink;
-  int oCUY      = Y / shrink;
-  int oCUX      = X / shrink;
-
-  for ( int i = 0; i < oCUHeight; i++ )
-    for ( int j = 0; j < oCUWidth; j++ )
-      numberOfOne += ( occupancyData[nowPOC / 2][( oCUY + i ) * occupancyWidth + oCUX + j] - 0 );
-
-  // checkCUoinfo(oCUWidth, oCUHeight, oCUY, oCUX,nowPOC);
-
-  if ( numberOfOne == 0 )
-    return 0;  // unoccupancy block
-  else if ( numberOfOne == oCUWidth * oCUHeight )
-    return 1;  // fill block
-  else
-    return 2;  // boundary block
-}
-
-extern map<string, int> frontModeFlag;
 typedef double          input_dtype;
-const unsigned int      P_G_hidden1_num = 10;
-const unsigned int      P_A_hidden1_num = 10;
-const unsigned int      P_G_hidden2_num = 5;
-const unsigned int      P_A_hidden2_num = 5;
-const unsigned int      P_G_input_node  = P_GEO_INPUT;
-const unsigned int      P_A_input_node  = P_ATT_INPUT;
-const unsigned int      P_G_output_node = P_GEO_OUTPUT;
-const unsigned int      P_A_output_node = P_ATT_OUTPUT;
-const unsigned int      I_G_hidden1_num = 10;
-const unsigned int      I_A_hidden1_num = 10;
-const unsigned int      I_G_hidden2_num = 5;
-const unsigned int      I_A_hidden2_num = 5;
-const unsigned int      I_G_input_node  = I_GEO_INPUT;
-const unsigned int      I_A_input_node  = I_ATT_INPUT;
-const unsigned int      I_G_output_node = I_GEO_OUTPUT;
-const unsigned int      I_A_output_node = I_ATT_OUTPUT;
 
 // PDCNNwithMLP
 // P Geo
@@ -279,83 +234,6 @@ double I_A_concatenateOutputWeight[I_ATT_CONCATENATE_DENSE_SIZE2 * I_ATT_CONCATE
     2.3603811, -4.5765676, 2.5549712, 2.5744483, -4.0866103 };
 double I_A_concatenateOutputBias[I_ATT_CONCATENATE_OUTPUT * 1]{ -0.6012961 };
 
-// LFCN
-double P_G_weight1[P_G_hidden1_num * P_G_input_node]{
-    -0.1798137,   0.015715983,  -0.09532983,  -0.12949441,  -0.016367447, 0.56853455,   -0.13140851,  -0.12590483,
-    0.5730921,    0.07826559,   -0.119140275, 0.010980937,  -0.041487183, -0.015314037, -0.019670215, 0.4799034,
-    -0.040534467, -0.050889056, 0.57576144,   -0.029060448, -0.5683938,   0.013555974,  0.042025037,  -0.7310104,
-    -0.004070325, 1.1931382,    -0.6871277,   -0.026506832, 1.1419412,    -0.056911822 };
-double P_G_bias1[P_G_hidden1_num]{ 0.8574694,  -0.03832592, -0.029819846, 0.8761555,   -0.05974367,
-                                   -0.2603977, 0.86793953,  -0.04469238,  -0.18879512, -0.078819275 };
-double P_G_weight2[P_G_hidden1_num * P_G_hidden2_num]{
-    -1.5059104,  -1.3450825,  -1.43051,    1.477028,     1.480278,     -0.0066613876, -0.010042782, -0.10854612,
-    0.043490637, 0.025427084, 0.010881705, -0.031549543, -0.010803781, -0.035900652,  -0.08626275,  -1.8950084,
-    -1.8535957,  -1.8098618,  1.8292805,   1.7869675,    0.008852309,  -0.011014264,  0.023642553,  0.037875876,
-    0.035256337, 1.2992209,   1.3258094,   1.350649,     -1.3084512,   -1.28103,      -1.8162,      -1.7824688,
-    -1.7318273,  1.8208646,   1.7572726,   0.06479486,   0.057287093,  0.059295353,   0.07287708,   -0.05606584,
-    1.1962177,   1.0893365,   1.1233077,   -1.1840847,   -1.1880049,   0.071519755,   0.0057525644, -0.06867385,
-    -0.06903744, -0.036188617 };
-double P_G_bias2[P_G_hidden2_num]{ -0.18987358, -0.08684765, -0.29997537, 0.23931256, 0.29157344 };
-double P_G_weight3[P_G_hidden2_num * P_G_output_node]{ 2.3271866, 2.291772, 2.3157434, -2.4887452, -2.4943295 };
-double P_G_bias3[P_G_output_node]{ -0.3431725 };
-
-double P_A_weight1[P_A_hidden1_num * P_A_input_node]{
-    0.38778436,   -0.007314995,  0.33233833,   0.36591738,  0.4208757,   0.3915192,   0.022857603, -0.015012168,
-    0.0021270008, -0.0051038982, 0.059003677,  0.065315135, 0.07027739,  0.41112804,  0.0588191,   0.02490963,
-    0.04832394,   0.008314324,   -0.03013271,  0.024819389, 0.92511517,  -0.09174364, 0.9075054,   0.8722612,
-    1.0292256,    1.1075729,     -0.039412506, 0.039779317, 0.009898708, 0.036773242 };
-double P_A_bias1[P_A_hidden1_num]{ -0.09741153, -0.05833369, -0.09079688,  -0.6771248,  -0.11397923,
-                                   -0.6344252,  -0.06651615, -0.029567974, -0.05385367, -0.04727762 };
-double P_A_weight2[P_A_hidden1_num * P_A_hidden2_num]{
-    -0.9188661,   -1.0477335,   -0.9269158,   0.8647607,    1.0614995,   -0.08677276, 0.050005186, -0.0061682737,
-    0.10102158,   -0.047413867, -0.8767638,   -1.1435426,   -0.9832114,  0.9889068,   1.1729834,   -2.9734714,
-    -2.757544,    -2.9321315,   2.9902015,    2.7917132,    -1.0080203,  -1.1630646,  -1.0566517,  0.93173665,
-    1.1421729,    -3.598869,    -3.1084049,   -3.3781476,   3.4908228,   3.0106144,   -0.09670318, -0.04485282,
-    -0.022119856, -0.050046027, -0.060104396, -0.010417917, 0.03764891,  0.026927702, 0.016772207, -0.025491703,
-    0.01552383,   -0.0738545,   0.030917257,  -0.0945312,   0.037042968, 0.004715443, -0.06587834, 0.0051364466,
-    -0.041220848, -0.021615531 };
-double P_A_bias2[P_A_hidden2_num]{ 1.7809409, 1.437488, 1.700708, -1.6271535, -1.4059961 };
-double P_A_weight3[P_A_hidden2_num * P_A_output_node]{ -2.4459467, -2.511491, -2.4142091, 2.8143487, 2.7357085 };
-double P_A_bias3[P_A_output_node]{ 0.48611394 };
-
-double I_G_weight1[I_G_hidden1_num * I_G_input_node]{
-    0.6891816,    -0.032851584, -0.07149959, 0.1327268,    -0.031111201, -0.013056578, -0.17099088, -0.13880853,
-    -2.5727057,   -0.5805173,   0.13167034,  -0.054828633, -0.47254786,  0.6590843,    0.014007426, -0.032431256,
-    -0.6763731,   -0.43721578,  -0.11417717, -0.59266067,  1.7472414,    0.04121032,   -0.75080377, 1.8364912,
-    -0.101214945, -0.004063612, -0.5388431,  -0.76438826,  0.29453498,   -0.35285744 };
-double I_G_bias1[I_G_hidden1_num]{ 0.053268004,  -0.15858771, 0.9373012, -0.0056827045, -0.060157437,
-                                   -0.011107092, 1.0216832,   0.9162116, 0.7341579,     0.9352663 };
-double I_G_weight2[I_G_hidden1_num * I_G_hidden2_num]{
-    0.730095,     -1.5902374,   -1.4260284,  1.8777653,   2.1345243,      0.009160237,  0.0020384693, -0.024743749,
-    0.029532894,  -0.025439087, -2.1620114,  1.9589972,   -0.50337994,    -2.2293231,   -2.6179252,   0.57881624,
-    -1.7947954,   -0.67919695,  1.8029268,   2.536627,    -0.00031412483, -0.029971926, 0.057302352,  0.03557874,
-    -0.014848113, 0.072738044,  -0.08819018, 0.013006314, -0.1172115,     0.086894706,  -3.095519,    1.5223482,
-    -0.6347482,   -1.7568599,   -2.2616343,  -2.2669876,  2.0884976,      -0.42797062,  -2.1458473,   -2.5100088,
-    -3.8781316,   1.2264118,    4.9437575,   -0.46441874, 1.3488111,      -3.7643235,   1.1565139,    -0.026370969,
-    -1.3415911,   -1.7141935 };
-double I_G_bias2[I_G_hidden2_num]{ -0.40222603, 0.038892575, -0.48762688, -0.06750394, 0.04712745 };
-double I_G_weight3[I_G_hidden2_num * I_G_output_node]{ 4.585394, -4.635746, -5.3902903, 1.4180381, 1.6833978 };
-double I_G_bias3[I_G_output_node]{ -1.2666923 };
-
-double I_A_weight1[I_A_hidden1_num * I_A_input_node]{
-    -0.3399334,  -4.2346177,  -0.09606053, -1.9594648,  -0.083944865, 0.7173832,    0.5212202,   -0.029234419,
-    -0.42640632, 0.035182115, -0.28761864, -0.2260642,  -0.030421784, -0.1238716,   -0.05297501, 0.84043366,
-    0.7088765,   -0.05069234, -0.20634308, -0.04941558, -1.027468,    0.0034996956, 0.015534068, 1.1255032,
-    0.024796126, 1.6061252,   1.6438757,   0.08391107,  -1.0014163,   -0.10561229 };
-double I_A_bias1[I_A_hidden1_num]{ 1.0356098,  0.4776824,  -0.1347511,  0.11729125, -0.052083444,
-                                   -0.2584819, -0.1723621, -0.09161258, 1.0184947,  -0.03605778 };
-double I_A_weight2[I_A_hidden1_num * I_A_hidden2_num]{
-    -2.437292,    1.610624,   -1.5597881,  1.6304326,   -1.4551742,   1.157308,       6.680512,     -2.5165,
-    6.8099475,    -5.1118183, 0.043091673, 0.05795094,  -0.016092842, 0.0010595184,   0.042020276,  -3.456434,
-    0.05806105,   -2.4778214, -0.06356614, -1.4688472,  -0.09521533,  -0.00036730454, -0.089662425, -0.059034307,
-    -0.010170054, 0.8435426,  -1.6657287,  1.1937068,   -1.6841154,   1.5154018,      0.6038032,    -1.8238503,
-    0.95434284,   -1.814911,  1.2709001,   0.044319823, 0.031158386,  0.038542103,    -0.024861578, -0.06378681,
-    -2.3413324,   1.5640033,  -1.2784584,  1.5854845,   -1.3741953,   -0.022077857,   0.013171807,  -0.014771372,
-    0.022822618,  0.03274649 };
-double I_A_bias2[I_A_hidden2_num]{ -0.88686234, 0.00551265, -0.46492913, -0.017391888, -0.17816842 };
-double I_A_weight3[I_A_hidden2_num * I_A_output_node]{ 2.8143318, -3.5012615, 1.5834863, -3.524372, 1.5158705 };
-double I_A_bias3[I_A_output_node]{ -0.7981659 };
-
 
 double softmax( double* y, int cateNum ) {
   double sum   = 0;
@@ -381,122 +259,18 @@ double optimizer( double u, string activation ) {
   else
     return 0.0;
 }
-double vanillayNN( string whichMode, int GorA, const vector<input_dtype>& x, string activation ) {
-  int     i, j;
-  double  u1;
-  double  y0, y;
-  int     hidden1_num, hidden2_num;
-  int     input_node, output_node;
-  double *weight_h1, *weight_h2, *bias_h1, *bias_h2, *weight_h3, *bias_h3;
-  if ( whichMode == "PModule" ) {
-    if ( GorA == 0 ) {
-      input_node  = P_G_input_node;
-      hidden1_num = P_G_hidden1_num;
-      weight_h1   = P_G_weight1;
-      weight_h2   = P_G_weight2;
-      bias_h1     = P_G_bias1;
-      bias_h2     = P_G_bias2;
-      hidden2_num = P_G_hidden2_num;
-      weight_h3   = P_G_weight3;
-      bias_h3     = P_G_bias3;
-    } else {
-      input_node  = P_A_input_node;
-      hidden1_num = P_A_hidden1_num;
-      weight_h1   = P_A_weight1;
-      weight_h2   = P_A_weight2;
-      bias_h1     = P_A_bias1;
-      bias_h2     = P_A_bias2;
-      hidden2_num = P_A_hidden2_num;
-      weight_h3   = P_A_weight3;
-      bias_h3     = P_A_bias3;
-    }
-    double *x_hidden1, *x_hidden2;
-    x_hidden1 = new double[hidden1_num];
-    x_hidden2 = new double[hidden2_num];
-    // layer1: input layer --> hidden layer1
-    for ( i = 0; i < hidden1_num; i++ ) {
-      u1 = 0;
-      for ( j = 0; j < input_node; j++ ) u1 += (double)x[j] * weight_h1[j * hidden1_num + i];
-      u1 += bias_h1[i];  // bias of layer 1
-      x_hidden1[i] = optimizer( u1, "relu" );
-    }
-    // layer2: hidden layer1 --> hidden layer2
-    for ( i = 0; i < hidden2_num; i++ ) {
-      u1 = 0;
-      for ( j = 0; j < hidden1_num; j++ ) u1 += (double)x_hidden1[j] * weight_h2[j * hidden2_num + i];
-      u1 += bias_h2[i];  // bias of layer 1
-      x_hidden2[i] = optimizer( u1, activation );
-    }
-    // layer3: hidden layer3 --> output layer
-    y = 0;
-    for ( i = 0; i < hidden2_num; ++i ) y += x_hidden2[i] * weight_h3[i];
-    y += bias_h3[0];  // bias of layer 2
-    delete[] x_hidden2;
-    y0 = optimizer( y, "sigmoid" );
-    delete[] x_hidden1;
-  } 
-  else if ( whichMode == "IModule" ) {
-    if ( GorA == 0 ) {
-      input_node  = I_G_input_node;
-      hidden1_num = I_G_hidden1_num;
-      weight_h1   = I_G_weight1;
-      weight_h2   = I_G_weight2;
-      bias_h1     = I_G_bias1;
-      bias_h2     = I_G_bias2;
-      hidden2_num = I_G_hidden2_num;
-      weight_h3   = I_G_weight3;
-      bias_h3     = I_G_bias3;
-    } else {
-      input_node  = I_A_input_node;
-      hidden1_num = I_A_hidden1_num;
-      weight_h1   = I_A_weight1;
-      weight_h2   = I_A_weight2;
-      bias_h1     = I_A_bias1;
-      bias_h2     = I_A_bias2;
-      hidden2_num = I_A_hidden2_num;
-      weight_h3   = I_A_weight3;
-      bias_h3     = I_A_bias3;
-    }
-    double *x_hidden1, *x_hidden2;
-    x_hidden1 = new double[hidden1_num];
-    x_hidden2 = new double[hidden2_num];
-    // layer1: input layer --> hidden layer1
-    for ( i = 0; i < hidden1_num; i++ ) {
-      u1 = 0;
-      for ( j = 0; j < input_node; j++ ) u1 += (double)x[j] * weight_h1[j * hidden1_num + i];
-      u1 += bias_h1[i];  // bias of layer 1
-      x_hidden1[i] = optimizer( u1, "relu" );
-    }
-    // layer2: hidden layer1 --> hidden layer2
-    for ( i = 0; i < hidden2_num; i++ ) {
-      u1 = 0;
-      for ( j = 0; j < hidden1_num; j++ ) u1 += (double)x_hidden1[j] * weight_h2[j * hidden2_num + i];
-      u1 += bias_h2[i];  // bias of layer 1
-      x_hidden2[i] = optimizer( u1, activation );
-    }
-    // layer3: hidden layer3 --> output layer
-    y = 0;
-    for ( i = 0; i < hidden2_num; ++i ) y += x_hidden2[i] * weight_h3[i];
-    y += bias_h3[0];  // bias of layer 2
-    delete[] x_hidden2;
-    y0 = optimizer( y, "sigmoid" );
-    delete[] x_hidden1;
-  }
-  return y0;
-}
 
-// Same conv layer
-double** convLayer( double** inputMatrix,
-                    int      inputSize,
-                    double*  kernel,
-                    int      kernelSize,
-                    double*  bias,
-                    string   activation ) {
-  double** outputMatrix = new double*[inputSize];
-  for ( int i = 0; i < inputSize; i++ ) outputMatrix[i] = new double[inputSize];
-  int      paddingSize  = kernelSize / 2;
-  double**    matrixPadding = new double*[inputSize + 2 * paddingSize];
-  for ( int i = 0; i < inputSize + 2 * paddingSize; i++ ) matrixPadding[i] = new double[inputSize + 2 * paddingSize];
+// Same conv layer, the output and the padded input are taken from the scratch arena.
+double** convLayer( pcc_hm::TEncScratchArena& rcArena,
+                    double**                  inputMatrix,
+                    int                       inputSize,
+                    double*                   kernel,
+                    int                       kernelSize,
+                    double*                   bias,
+                    string                    activation ) {
+  double** outputMatrix  = rcArena.allocMatrix<double>( inputSize, inputSize );
+  int      paddingSize   = kernelSize / 2;
+  double** matrixPadding = rcArena.allocMatrix<double>( inputSize + 2 * paddingSize, inputSize + 2 * paddingSize );
   for ( int i = 0; i < inputSize + 2 * paddingSize; i++ ) {
     for ( int j = 0; j < inputSize + 2 * paddingSize; j++ ) {
       if ( i < paddingSize || i >= inputSize + paddingSize || j < paddingSize || j >= inputSize + paddingSize )
@@ -522,11 +296,10 @@ double** convLayer( double** inputMatrix,
   return outputMatrix;
 }
 
-// Pooling layer.
-double** poolingLayer( double** inputMatrix, int inputSize, int poolingSize ){
+// Pooling layer, the output is taken from the scratch arena.
+double** poolingLayer( pcc_hm::TEncScratchArena& rcArena, double** inputMatrix, int inputSize, int poolingSize ){
   int      outputSize   = inputSize / poolingSize;
-  double** outputMatrix = new double*[outputSize];
-  for ( int i = 0; i < outputSize; i++ ) outputMatrix[i] = new double[outputSize];
+  double** outputMatrix = rcArena.allocMatrix<double>( outputSize, outputSize );
   for ( int i = 0; i < inputSize; i += poolingSize ) {
     for ( int j = 0; j < inputSize; j += poolingSize ) {
       double maxEle = -1;
@@ -544,7 +317,8 @@ double** poolingLayer( double** inputMatrix, int inputSize, int poolingSize ){
 }
 
 
-double SLPADDCNN( double** inputMatrix, const vector<input_dtype>& x, int GorA, string whichModule ) {
+// Every intermediate feature map is released from the scratch arena before returning.
+double SLPADDCNN( pcc_hm::TEncScratchArena& rcArena, double** inputMatrix, const vector<input_dtype>& x, int GorA, string whichModule ) {
   int convInputSize = 16, convKernelSize1 = 3, convOutputSize1 = 16, convPoolingSize1 = 4, 
                           convKernelSize2 = 2, convOutputSize2 = 4, convPoolingSize2 = 4;
   double **convOutput1;
@@ -602,22 +376,23 @@ double SLPADDCNN( double** inputMatrix, const vector<input_dtype>& x, int GorA,
     concatenateOutputBias   = ( GorA == 0 ) ? I_G_concatenateOutputBias : I_A_concatenateOutputBias;
   }
 
-  // initialization
-  convOutput1 = new double*[1];
-  convOutput1[0] = new double[1];
-  
+  const unsigned int arenaMark = rcArena.getMark();
+
   convOutput1 = poolingLayer(
+      rcArena,
       convLayer(
-          poolingLayer( convLayer( inputMatrix, convInputSize, convWeight1, convKernelSize1, convBias1, "sigmoid" ),
+          rcArena,
+          poolingLayer( rcArena,
+                        convLayer( rcArena, inputMatrix, convInputSize, convWeight1, convKernelSize1, convBias1, "sigmoid" ),
                         convOutputSize1, convPoolingSize1 ),
           convOutputSize1 / convPoolingSize1, convWeight2, convKernelSize2, convBias2, "sigmoid" ),
       convOutputSize2, convPoolingSize2 );
 
   // concatenate.
-  concatenateInput       = new double[concatenateInputSize];
-  concatenateDense1Output = new double[concatenateDenseSize1];
-  concatenateDense2Output = new double[concatenateDenseSize2];
-  concatenateOutput      = new double[concatenateOutputSize];
+  concatenateInput        = rcArena.alloc<double>( concatenateInputSize );
+  concatenateDense1Output = rcArena.alloc<double>( concatenateDenseSize1 );
+  concatenateDense2Output = rcArena.alloc<double>( concatenateDenseSize2 );
+  concatenateOutput       = rcArena.alloc<double>( concatenateOutputSize );
   for ( int i = 0; i < concatenateInputSize; i++ ) {
     if ( i == 0)
       concatenateInput[i] = convOutput1[0][0];
@@ -647,6 +422,8 @@ double SLPADDCNN( double** inputMatrix, const vector<input_dtype>& x, int GorA,
   }
 
   for ( int i = 0; i < concatenateOutputSize; i++ ) y += concatenateOutput[i];
+
+  rcArena.release( arenaMark );
   return y;
 }
 
@@ -685,34 +462,8 @@ double D_sum_32[2][2]   = { 0 };
 double P_ave_32[2][2]   = { 0 };
 double P_D_sum_32[2][2] = { 0 };
 
-double cacAverage( int x_begin, int y_begin, int x_end, int y_end, int**& pixels ) {
-  double sum = 0;
-  for ( int y = y_begin; y < y_end; y++ ) {
-    for ( int x = x_begin; x < x_end; x++ ) { sum += pixels[y][x]; }
-  }
-  return sum / ( ( (double)x_end - x_begin ) * ( (double)y_end - y_begin ) );
-}
-
-double cacVariance( int x_begin, int y_begin, int x_end, int y_end, int**& pixels, double average )
-{
-  double sum              = 0;
-  int*   tmp_edge         = new int[y_end - y_begin];
-  int    tmp_edge_pointer = 0;
-  int    pixels_count     = 0;
-  for ( int y = y_begin; y < y_end; y++ ) {
-    for ( int x = x_begin; x < x_end; x++ ) { sum += pow( pixels[y][x] - average, 2 ); }
-  }
-  pixels_count = ( ( x_end - x_begin ) * ( y_end - y_begin ) );
-
-  return sum / pixels_count;
-}
-
 double twoDecimalDouble( const double& dbNum ) {
-  stringstream strCode;
-  strCode << std::setiosflags( std::ios::fixed ) << std::setprecision( 2 ) << dbNum;
-  double douCode;
-  strCode >> douCode;
-  return douCode;
+  return pcc_hm::TEncFeatureQuantizer::roundToHundredths( dbNum );
 }
 #endif  // SDMTEST
 
@@ -778,18 +529,23 @@ Void TEncCu::create(UChar uhTotalDepth, UInt uiMaxWidth, UInt uiMaxHeight, Chrom
 #endif
   }
 
+#ifdef SDMTEST
+  m_cLFCNFeature.create( uiMaxWidth, uiMaxHeight );
+  // distortion tiles and CNN feature maps of one CTU, enlarged on demand by the arena itself
+  m_cScratchArena.create( uiMaxWidth * uiMaxHeight * sizeof( Double ) * 4 );
+  m_cDecisionStore.create( uiMaxWidth, uhTotalDepth );
+  m_cCtuDepthPredictor.create( uiMaxWidth, uiMaxHeight );
+  m_iCtuMinDepth = 0;
+  m_iCtuMaxDepth = MAX_INT;
+#endif
+
   m_bEncodeDQP                     = false;
   m_stillToCodeChromaQpOffsetFlag  = false;
   m_cuChromaQpOffsetIdxPlus1       = 0;
   m_bFastDeltaQP                   = false;
 
-  // initialize partition order.
-  UInt* piTmp = &g_auiZscanToRaster[0];
-  initZscanToRaster( m_uhTotalDepth, 1, 0, piTmp);
-  initRasterToZscan( uiMaxWidth, uiMaxHeight, m_uhTotalDepth );
-
-  // initialize conversion matrix from partition index to pel
-  initRasterToPelXY( uiMaxWidth, uiMaxHeight, m_uhTotalDepth );
+  // initialize partition order and the conversion matrix from partition index to pel.
+  initCtuPartitionTables( uiMaxWidth, uiMaxHeight, m_uhTotalDepth );
 }
 
 Void TEncCu::destroy()
@@ -845,6 +601,12 @@ Void TEncCu::destroy()
     }
 #endif
   }
+#ifdef SDMTEST
+  m_cLFCNFeature.destroy();
+  m_cScratchArena.destroy();
+  m_cDecisionStore.destroy();
+  m_cCtuDepthPredictor.destroy();
+#endif
   if(m_ppcBestCU)
   {
     delete [] m_ppcBestCU;
@@ -908,19 +670,29 @@ Void TEncCu::destroy()
 /** \param    pcEncTop      pointer of encoder class
  */
 Void TEncCu::init( TEncTop* pcEncTop )
+{
+  init( pcEncTop, pcEncTop->getPredSearch(), pcEncTop->getTrQuant(), pcEncTop->getRdCost(),
+        pcEncTop->getEntropyCoder(), pcEncTop->getRDSbacCoder(), pcEncTop->getRDGoOnSbacCoder() );
+}
+
+Void TEncCu::init( TEncTop* pcEncTop, TEncSearch* pcPredSearch, TComTrQuant* pcTrQuant, TComRdCost* pcRdCost,
+                   TEncEntropy* pcEntropyCoder, TEncSbac*** pppcRDSbacCoder, TEncSbac* pcRDGoOnSbacCoder )
 {
   m_pcEncCfg           = pcEncTop;
-  m_pcPredSearch       = pcEncTop->getPredSearch();
-  m_pcTrQuant          = pcEncTop->getTrQuant();
-  m_pcRdCost           = pcEncTop->getRdCost();
+  m_pcPredSearch       = pcPredSearch;
+  m_pcTrQuant          = pcTrQuant;
+  m_pcRdCost           = pcRdCost;
 
-  m_pcEntropyCoder     = pcEncTop->getEntropyCoder();
+  m_pcEntropyCoder     = pcEntropyCoder;
   m_pcBinCABAC         = pcEncTop->getBinCABAC();
 
-  m_pppcRDSbacCoder    = pcEncTop->getRDSbacCoder();
-  m_pcRDGoOnSbacCoder  = pcEncTop->getRDGoOnSbacCoder();
+  m_pppcRDSbacCoder    = pppcRDSbacCoder;
+  m_pcRDGoOnSbacCoder  = pcRDGoOnSbacCoder;
 
   m_pcRateCtrl         = pcEncTop->getRateCtrl();
+#ifdef SDMTEST
+  m_pcLFCNContext      = pcEncTop->getLFCNContext();
+#endif
   m_lumaQPOffset       = 0;
   initLumaDeltaQpLUT();
 }
@@ -952,7 +724,32 @@ Void TEncCu::compressCtu( TComDataCU* pCtu, UChar* lastPaletteSize, Pel lastPale
   // analysis of CU
   DEBUG_STRING_NEW(sDebug)
 
+#ifdef SDMTEST
+  m_cScratchArena.reset();
+  // reads the final depths of the collocated CTU before the decision store clears them
+  xPredictCtuDepthRange( pCtu );
+  m_bEmptyCtu = xIsEmptyCtu( pCtu );
+  if ( m_pcEncCfg->getLFCNEmptyCtuFastPath() )
+  {
+    m_pcLFCNContext->setEmptyCtu( pCtu->getCtuRsAddr(), m_bEmptyCtu );
+  }
+  m_cDecisionStore.initCtu( pCtu->getSlice()->getPOC(), pCtu->getCtuRsAddr(), pCtu->getCUPelX(), pCtu->getCUPelY(),
+                            &m_pcLFCNContext->getSplitHistory() );
+  const std::chrono::steady_clock::time_point cCtuStart = std::chrono::steady_clock::now();
+#endif
   xCompressCU( m_ppcBestCU[0], m_ppcTempCU[0], 0 DEBUG_STRING_PASS_INTO(sDebug) );
+#ifdef SDMTEST
+  m_pcLFCNContext->getThresholdControl().addCtuTime(
+      std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - cCtuStart ).count() );
+  if ( m_pcEncCfg->getLFCNNearLayerPrior() && TEncNearLayerPrior::isNearLayer( pCtu->getSlice()->getPOC() ) )
+  {
+    m_pcLFCNContext->getNearLayerPrior().storeCtu( pCtu->getSlice()->getPOC(), pCtu );
+  }
+  if ( m_pcLFCNContext->getCuDepthMap().isCreated() )
+  {
+    m_pcLFCNContext->getCuDepthMap().storeCtu( pCtu->getSlice()->getPOC(), pCtu );
+  }
+#endif
   DEBUG_STRING_OUTPUT(std::cout, sDebug)
 
 #if ADAPTIVE_QP_SELECTION
@@ -1279,28 +1076,69 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
   int  POC      = rpcBestCU->getSlice()->getPOC();
   int  QP = rpcBestCU->getQP( 0 );
   int  CUcate   = -1;
+  const int OorGorA = m_pcLFCNContext->getVideoType();  // =-1 occupancy, =0 geometry, =1 attribute
 
   double b_max_variance = 0;
   double b_min_variance = 999999;
   double q_max_variance = 0;
   double q_min_variance = 999999;
 
-  double IGeoTH = 0.3;
-  double IAttTH = 0.3;
-  double PGeoTH = 0.6;
-  double PAttTH = 0.6;
+  // the final CUs of the geometry picture of the same frame, coded over the same patches, bound the depths of an
+  // attribute CU and move its split thresholds: up where the geometry stopped splitting, down where it went on
+  Int        iPriorMinDepth = 0;
+  Int        iPriorMaxDepth = 0;
+  const Bool bDepthPrior    = OorGorA >= 0 && m_pcLFCNContext->getCuDepthPrior().getDepthRange(
+                                 POC, uiLPelX, uiTPelY, uiWidth, sps.getLog2MinCodingBlockSize() + sps.getLog2DiffMaxMinCodingBlockSize(),
+                                 iPriorMinDepth, iPriorMaxDepth );
+  const double dPriorShift  = !bDepthPrior ? 0.
+                              : Int( uiDepth ) < iPriorMaxDepth ? -LFCN_CU_DEPTH_PRIOR_SHIFT : LFCN_CU_DEPTH_PRIOR_SHIFT;
+
+  // the splits gather along the patch borders, where the depth and texture jump: a CU over several patches or over a
+  // patch and the padding gets the full RDO, one well inside a patch is pruned more readily
+  const PatchAreaCategory ePatchArea   = OorGorA >= 0 ? m_pcLFCNContext->classifyPatchArea( uiWidth, uiWidth, uiTPelY, uiLPelX, POC )
+                                                      : PATCH_AREA_UNKNOWN;
+  const Bool              bPatchBorder = ePatchArea == PATCH_AREA_BORDER;
+  const double            dPatchShift  = ePatchArea == PATCH_AREA_INTERIOR ? LFCN_PATCH_INTERIOR_SHIFT : 0.;
+
+  // an unoccupied CTU is not reconstructed into points, it is coded as one CU without mode search
+  const Bool bEmptyCtu = uiDepth == 0 && m_bEmptyCtu;
+
+  // split thresholds of the picture, fixed or adapted to the time target; geometry and attribute have their own encoder
+  TEncLFCNThresholdControl& rcThresholdControl = m_pcLFCNContext->getThresholdControl();
+  const double              ITH                = rcThresholdControl.getThreshold( I_SLICE, dPriorShift + dPatchShift );
+  const double              PTH                = rcThresholdControl.getThreshold( P_SLICE, dPriorShift + dPatchShift );
 
   if ( OorGorA >= 0 )
-    CUcate = CUClassify( uiWidth, uiWidth, uiTPelY, uiLPelX, POC );  // =0 unoccupancy block=1 fill block=2 boundary block
+    CUcate = m_pcLFCNContext->classifyCU( uiWidth, uiWidth, uiTPelY, uiLPelX, POC );  // =0 unoccupancy block=1 fill block=2 boundary block
 
   double LFCNSWITCH = rpcBestCU->getSlice()->getSliceType() == P_SLICE ? true : false;
   //LFCNSWITCH        = true;
+
+  // a far layer picture (odd POC) follows its near layer picture in coding order, with the same patches and nearly the
+  // same content: the near layer CUs of the area bound the depths, the PUs and the intra check of this CU
+  TEncNearLayerCu cNearCu;
+  const Bool      bNearLayer = m_pcEncCfg->getLFCNNearLayerPrior() && OorGorA >= 0 && !TEncNearLayerPrior::isNearLayer( POC ) &&
+                               m_pcLFCNContext->getNearLayerPrior().getCu( POC - 1, rpcBestCU->getCtuRsAddr(), rpcBestCU->getZorderIdxInCtu(),
+                                                                           rpcBestCU->getTotalNumPart(), cNearCu );
+  const Bool      bNearLayerInter = bNearLayer && cNearCu.bInter && rpcBestCU->getSlice()->getSliceType() != I_SLICE;
 #endif
 
 
   const Bool bBoundary = !( uiRPelX < sps.getPicWidthInLumaSamples() && uiBPelY < sps.getPicHeightInLumaSamples() );
 
+#ifdef SDMTEST  // MesksCode
+  // a CU above the depth range of the CTU, or confidently split, skips the modes of this depth like a CU crossing the
+  // picture boundary
+  const Bool bEarlySplit = !bBoundary && !bEmptyCtu && uiDepth < sps.getLog2DiffMaxMinCodingBlockSize() &&
+                           ( !getFastDeltaQp() || uiWidth > fastDeltaQPCuMaxSize ) &&
+                           ( Int( uiDepth ) < m_iCtuMinDepth || ( bNearLayer && Int( uiDepth ) < cNearCu.iMinDepth ) ||
+                             ( bDepthPrior && Int( uiDepth ) + LFCN_CU_DEPTH_PRIOR_MARGIN < iPriorMinDepth ) ||
+                             ( OorGorA >= 0 && LFCNSWITCH && m_pcEncCfg->getLFCNEarlySplit() && !bPatchBorder &&
+                               xCheckLFCNEarlySplit( rpcBestCU, uiDepth, QP ) ) );
+  if ( !bBoundary && !bEarlySplit )
+#else
   if ( !bBoundary )
+#endif
   {
     for (Int iQP=iMinQP; iQP<=iMaxQP; iQP++)
     {
@@ -1329,6 +1167,13 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
       }
 
       rpcTempCU->initEstData( uiDepth, iQP, bIsLosslessMode );
+#ifdef SDMTEST  // MesksCode
+      if ( bEmptyCtu )
+      {
+        xCheckEmptyCtu( rpcBestCU, rpcTempCU );
+        continue;
+      }
+#endif
 
       // do inter modes, SKIP and 2Nx2N
       if ( ( !rpcBestCU->getSlice()->getPPS()->getPpsScreenExtension().getUseIntraBlockCopy() && rpcBestCU->getSlice()->getSliceType() != I_SLICE ) ||
@@ -1376,7 +1221,16 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
       }
     }
 
+#ifdef SDMTEST  // MesksCode
+    // the near layer kept one PU for this CU
+    if ( bNearLayer && cNearCu.b2Nx2N && Int( uiDepth ) == cNearCu.iMinDepth )
+    {
+      doNotBlockPu = false;
+    }
+    if(!earlyDetectionSkipMode && !terminateAllFurtherRDO && !bEmptyCtu)
+#else
     if(!earlyDetectionSkipMode && !terminateAllFurtherRDO)
+#endif
     {
       for (Int iQP=iMinQP; iQP<=iMaxQP; iQP++)
       {
@@ -1542,7 +1396,12 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
         Double dIntraBcCostPred = 0.0;
         if ( ( !rpcBestCU->getSlice()->getPPS()->getPpsScreenExtension().getUseIntraBlockCopy() && rpcBestCU->getSlice()->getSliceType() == I_SLICE ) ||
              ( rpcBestCU->getSlice()->getPPS()->getPpsScreenExtension().getUseIntraBlockCopy() && rpcBestCU->getSlice()->isOnlyCurrentPictureAsReference() ) ||
+#ifdef SDMTEST  // MesksCode
+             // nor if the near layer area is inter coded
+             ( !rpcBestCU->isSkipped(0) && !bNearLayerInter ) ) // avoid very complex intra if it is unlikely
+#else
              !rpcBestCU->isSkipped(0) ) // avoid very complex intra if it is unlikely
+#endif
         {
           if (m_pcEncCfg->getUseIntraBlockCopyFastSearch() && rpcTempCU->getWidth(0) <= SCM_S0067_MAX_CAND_SIZE )
           {
@@ -1976,8 +1835,15 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
   if ( rpcBestCU->isIntraBC( 0 ) && rpcBestCU->getQtRootCbf( 0 ) == 0 ) { bSubBranch = false; }
    
   #ifdef SDMTEST  // MesksCode
+  // the CUs of the deepest depth of the CTU range are final
+  if ( !bBoundary && Int( uiDepth ) >= m_iCtuMaxDepth ) bSubBranch = false;
+  // so are those as deep as the near layer CUs of the area
+  if ( !bBoundary && bNearLayer && Int( uiDepth ) >= cNearCu.iMaxDepth ) bSubBranch = false;
+  if ( !bBoundary && bDepthPrior && Int( uiDepth ) >= iPriorMaxDepth + LFCN_CU_DEPTH_PRIOR_MARGIN ) bSubBranch = false;
+  if ( bEmptyCtu && rpcBestCU->getTotalCost() != MAX_DOUBLE ) bSubBranch = false;
+
   // Compute residuals of split.
-  if ( bSubBranch && OorGorA >= 0 && uiDepth < sps.getLog2DiffMaxMinCodingBlockSize() && LFCNSWITCH) {
+  if ( bSubBranch && !bEarlySplit && !bPatchBorder && OorGorA >= 0 && uiDepth < sps.getLog2DiffMaxMinCodingBlockSize() && LFCNSWITCH) {
       if ( rpcBestCU->getSlice()->getSliceType() == P_SLICE ) {
         Pel* pReco = m_ppcRecoYuvBest[uiDepth]->getAddr( COMPONENT_Y );
         Pel* pPred = m_ppcPredYuvBest[uiDepth]->getAddr( COMPONENT_Y );
@@ -1986,35 +1852,11 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
 
         int   cuHeight = rpcBestCU->getHeight( uiDepth );
         int   cuWidth  = rpcBestCU->getWidth( uiDepth );
-        int** pixels;
-        int   x_begin = 0;
-        int   x_end   = cuWidth;
-        int   y_begin = 0;
-        int   y_end   = cuHeight;
-
-        pixels = new int*[cuHeight];
-        for ( int i = 0; i < cuHeight; i++ ) { pixels[i] = new int[cuWidth]; }
-
-        // processing geometry and attribute separately
-        if ( OorGorA == 0 ) {
-          for ( int y = 0; y < cuHeight; y++ ) {
-            for ( int x = 0; x < cuWidth; x++ ) {
-              // computational prediction distortion
-              pixels[y][x] = 24 * abs( ( *pOri ) - ( *pPred ) ) / QP;
-              pPred++;
-              pOri++;
-            }
-          }
-        } else if ( OorGorA > 0 ) {
-          for ( int y = 0; y < cuHeight; y++ ) {
-            for ( int x = 0; x < cuWidth; x++ ) {
-              // computational prediction distortion
-              pixels[y][x] = 32 * abs( ( *pOri ) - ( *pPred ) ) / QP;
-              pPred++;
-              pOri++;
-            }
-          }
-        }
+
+        // computational prediction distortion, processing geometry and attribute separately
+        m_cLFCNFeature.initDistortion( pOri, m_ppcOrigYuv[uiDepth]->getStride( COMPONENT_Y ), pPred,
+                                       m_ppcPredYuvBest[uiDepth]->getStride( COMPONENT_Y ), cuWidth, cuHeight,
+                                       ( OorGorA == 0 ) ? 24 : 32, QP );
 
         // normalization processing
         double normalizingFactor = 0;
@@ -2031,14 +1873,13 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
         else if ( uiDepth == 2 )
           kernelSize = 1;
 
-        double** pdm = new double*[16];
-        for ( int i = 0; i < 16; i++ ) pdm[i] = new double[16];
+        double** pdm = m_cScratchArena.allocMatrix<double>( 16, 16 );
         for ( int i = 0; i < cuHeight; i += kernelSize ) {
           for ( int j = 0; j < cuWidth; j += kernelSize ) {
             double maxDistortion = -1;
             for ( int k = i; k < i + kernelSize; k++ ) {
               for ( int l = j; l < j + kernelSize; l++ ) {
-                if ( pixels[k][l] > maxDistortion ) maxDistortion = pixels[k][l];
+                if ( m_cLFCNFeature.getDistortion( l, k ) > maxDistortion ) maxDistortion = m_cLFCNFeature.getDistortion( l, k );
               }
             }
             pdm[i / kernelSize][j / kernelSize] =
@@ -2046,49 +1887,25 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
           }
         }
 
-        double    AVERAGE         = 0;
-        const int SPLIT           = 2;
-        double    overallVariance = 0;
-        AVERAGE                   = cacAverage( 0, 0, cuWidth, cuHeight, pixels );
-        overallVariance           = cacVariance( 0, 0, cuWidth, cuHeight, pixels, AVERAGE );
-        for ( int i = 0; i < SPLIT; i++ ) {
-          for ( int j = 0; j < SPLIT; j++ ) {
-            AVERAGE            = cacAverage( j * cuWidth / SPLIT, i * cuHeight / SPLIT, ( j + 1 ) * cuWidth / SPLIT,
-                                  ( i + 1 ) * cuHeight / SPLIT, pixels );
-            double subVariance = cacVariance( j * cuWidth / SPLIT, i * cuHeight / SPLIT, ( j + 1 ) * cuWidth / SPLIT,
-                                              ( i + 1 ) * cuHeight / SPLIT, pixels, AVERAGE );
-            if ( subVariance > overallVariance ) { overallVariance = subVariance; }
-          }
-        }
+        // maximum variance of the CU and its quadrants from the summed-area tables
+        double overallVariance = m_cLFCNFeature.getMaxQuadrantVariance();
 
         double statisticVarMax = twoDecimalDouble( overallVariance / normalizingFactor );  // DV
         if ( statisticVarMax > 1 ) statisticVarMax = 1;
         int    statisticCBF    = ( rpcBestCU->getQtRootCbf( 0 ) == 0 ) ? 0 : 1;  // CBF
-        double statisticDepth  = uiDepth == 0 ? 2 : ( uiDepth == 1 ? 1 : ( uiDepth == 2 ? 0 : -1 ) );
-        statisticDepth         = twoDecimalDouble( statisticDepth / 2.000 );  // CD
-        double statisticQP     = twoDecimalDouble( ( 51 - QP ) / 51.000 );    // QP
+        double statisticDepth  = twoDecimalDouble( TEncLFCNFeature::getDepthFeature( uiDepth ) );  // CD
+        double statisticQP     = twoDecimalDouble( TEncLFCNFeature::getQPFeature( QP ) );         // QP
         double statisticCUcate = CUcate / 2.000;                              // CUC
         // int    statisticPOC    = ( POC % 2 == 0 ) ? 1 : 0;                    // POC
         // double statisticPredictionMode = rpcBestCU->getPredictionMode( 0 );
         // gain front mode
-        // map<string, int>::iterator iter;
-        // string                     frontKey;
         // double                     statisticFrontMode = -1;
         //// =0 dont split, =1 further split, =-2 means error, =-1 means have not front mode
         // if ( uiDepth == 0 )
         //  statisticFrontMode = -1;
         // else {
-        //  int          nowX = int( uiLPelX / pow( 2, 6 - uiDepth + 1 ) ) * pow( 2, 6 - uiDepth + 1 );
-        //  int          nowY = int( uiTPelY / pow( 2, 6 - uiDepth + 1 ) ) * pow( 2, 6 - uiDepth + 1 );
-        //  stringstream ss_frontKey;
-        //  ss_frontKey << POC << "_" << nowX << "_" << nowY << "_" << uiDepth - 1;
-        //  ss_frontKey >> frontKey;
-        //  iter = frontModeFlag.find( frontKey );
-        //  if ( iter != frontModeFlag.end() )
-        //    statisticFrontMode = iter->second;
-        //  else {
-        //    statisticFrontMode = -2;
-        //  }
+        //  Int iFrontSplit    = m_cDecisionStore.getSplit( uiDepth - 1, uiLPelX, uiTPelY );
+        //  statisticFrontMode = ( iFrontSplit == CU_SPLIT_UNKNOWN ) ? -2 : iFrontSplit;
         //}
 
         // statisticFrontMode =
@@ -2096,33 +1913,21 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
         //        ? 0
         //        : ( ( statisticFrontMode == -1 ) ? 0.5 : ( ( statisticFrontMode == 1 ) ? 0.7 : 1 ) );  // FLM
 
-        std::vector<double> x( ( OorGorA == 0 ) ? P_GEO_INPUT : P_ATT_INPUT );
-        if ( OorGorA == 0 ) {
-          x[0] = statisticVarMax;
-          x[1] = statisticDepth;
-          x[2] = statisticQP;
-          //x[0] = statisticVarMax;
-          //x[1] = statisticCBF;
-          //x[2] = statisticDepth;
-          //x[3] = statisticQP;
-          //x[4] = statisticCUcate;
-        } else if ( OorGorA > 0 ) {
-          x[0] = statisticVarMax;
-          x[1] = statisticDepth;
-          x[2] = statisticQP;
-          //x[0] = statisticVarMax;
-          //x[1] = statisticCBF;
-          //x[2] = statisticDepth;
-          //x[3] = statisticQP;
-          //x[4] = statisticCUcate;
-        }
-
-        double y = vanillayNN( "PModule", OorGorA, x, "sigmoid" );
-        //double y = SLPADDCNN( pdm, x, OorGorA, "PModule" );
-        if ( OorGorA == 0 && y < PGeoTH ) 
-            bSubBranch = false;
-        else if ( OorGorA > 0 && y < PAttTH )
-          bSubBranch = false;
+        Float x[LFCN_NUM_INPUT];
+        x[0] = Float( statisticVarMax );
+        x[1] = Float( statisticDepth );
+        x[2] = Float( statisticQP );
+        //x[0] = statisticVarMax;
+        //x[1] = statisticCBF;
+        //x[2] = statisticDepth;
+        //x[3] = statisticQP;
+        //x[4] = statisticCUcate;
+
+        double y = m_pcLFCNContext->predictSplit( P_SLICE, QP, x );
+        //double y = SLPADDCNN( m_cScratchArena, pdm, x, OorGorA, "PModule" );
+        const bool bPrune = y < PTH;
+        rcThresholdControl.addDecision( bPrune );
+        if ( bPrune ) bSubBranch = false;
         //cout << "P Frame Geometry: " << endl << "  y: " << y << endl << "  autoTH: " << autoTH( QP, 1 ) << endl;
 
         //cout << "P Frame: --" <<OorGorA<< endl << "pdm: " << endl;
@@ -2138,35 +1943,11 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
 
         int   cuHeight = rpcBestCU->getHeight( uiDepth );
         int   cuWidth  = rpcBestCU->getWidth( uiDepth );
-        int** pixels;
-        int   x_begin = 0;
-        int   x_end   = cuWidth;
-        int   y_begin = 0;
-        int   y_end   = cuHeight;
-
-        pixels = new int*[cuHeight];
-        for ( int i = 0; i < cuHeight; i++ ) { pixels[i] = new int[cuWidth]; }
-
-        // processing geometry and attribute separately
-        if ( OorGorA == 0 ) {
-          for ( int y = 0; y < cuHeight; y++ ) {
-            for ( int x = 0; x < cuWidth; x++ ) {
-              // computational prediction distortion
-              pixels[y][x] = 24 * abs( ( *pOri ) - ( *pPred ) ) / QP;
-              pPred++;
-              pOri++;
-            }
-          }
-        } else if ( OorGorA > 0 ) {
-          for ( int y = 0; y < cuHeight; y++ ) {
-            for ( int x = 0; x < cuWidth; x++ ) {
-              // computational prediction distortion
-              pixels[y][x] = 32 * abs( ( *pOri ) - ( *pPred ) ) / QP;
-              pPred++;
-              pOri++;
-            }
-          }
-        }
+
+        // computational prediction distortion, processing geometry and attribute separately
+        m_cLFCNFeature.initDistortion( pOri, m_ppcOrigYuv[uiDepth]->getStride( COMPONENT_Y ), pPred,
+                                       m_ppcPredYuvBest[uiDepth]->getStride( COMPONENT_Y ), cuWidth, cuHeight,
+                                       ( OorGorA == 0 ) ? 24 : 32, QP );
 
         // normalization processing
         double normalizingFactor = 0;
@@ -2183,14 +1964,13 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
         else if ( uiDepth == 2 )
           kernelSize = 1;
 
-        double** pdm = new double*[16];
-        for ( int i = 0; i < 16; i++ ) pdm[i] = new double[16];
+        double** pdm = m_cScratchArena.allocMatrix<double>( 16, 16 );
         for ( int i = 0; i < cuHeight; i += kernelSize ) {
           for ( int j = 0; j < cuWidth; j += kernelSize ) {
             double maxDistortion = -1;
             for ( int k = i; k < i + kernelSize; k++ ) {
               for ( int l = j; l < j + kernelSize; l++ ) {
-                if ( pixels[k][l] > maxDistortion ) maxDistortion = pixels[k][l];
+                if ( m_cLFCNFeature.getDistortion( l, k ) > maxDistortion ) maxDistortion = m_cLFCNFeature.getDistortion( l, k );
               }
             }
             pdm[i / kernelSize][j / kernelSize] =
@@ -2198,82 +1978,46 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
           }
         }
 
-        double    AVERAGE         = 0;
-        const int SPLIT           = 2;
-        double    overallVariance = 0;
-        AVERAGE                   = cacAverage( 0, 0, cuWidth, cuHeight, pixels );
-        overallVariance           = cacVariance( 0, 0, cuWidth, cuHeight, pixels, AVERAGE );
-        for ( int i = 0; i < SPLIT; i++ ) {
-          for ( int j = 0; j < SPLIT; j++ ) {
-            AVERAGE            = cacAverage( j * cuWidth / SPLIT, i * cuHeight / SPLIT, ( j + 1 ) * cuWidth / SPLIT,
-                                  ( i + 1 ) * cuHeight / SPLIT, pixels );
-            double subVariance = cacVariance( j * cuWidth / SPLIT, i * cuHeight / SPLIT, ( j + 1 ) * cuWidth / SPLIT,
-                                              ( i + 1 ) * cuHeight / SPLIT, pixels, AVERAGE );
-            if ( subVariance > overallVariance ) { overallVariance = subVariance; }
-          }
-        }
+        // maximum variance of the CU and its quadrants from the summed-area tables
+        double overallVariance = m_cLFCNFeature.getMaxQuadrantVariance();
 
         double statisticVarMax = twoDecimalDouble( overallVariance / normalizingFactor );  // DV
         if ( statisticVarMax > 1 ) statisticVarMax = 1;
         int    statisticCBF    = ( rpcBestCU->getQtRootCbf( 0 ) == 0 ) ? 0 : 1;  // CBF
-        double statisticDepth  = uiDepth == 0 ? 2 : ( uiDepth == 1 ? 1 : ( uiDepth == 2 ? 0 : -1 ) );
-        statisticDepth         = twoDecimalDouble( statisticDepth / 2.000 );  // CD
-        double statisticQP     = twoDecimalDouble( ( 51 - QP ) / 51.000 );    // QP
+        double statisticDepth  = twoDecimalDouble( TEncLFCNFeature::getDepthFeature( uiDepth ) );  // CD
+        double statisticQP     = twoDecimalDouble( TEncLFCNFeature::getQPFeature( QP ) );         // QP
         double statisticCUcate = CUcate / 2.000;                              // CUC
         // int    statisticPOC    = ( POC % 2 == 0 ) ? 1 : 0;                    // POC
         // double statisticPredictionMode = rpcBestCU->getPredictionMode( 0 );
         //// gain front mode
-        // map<string, int>::iterator iter;
-        // string                     frontKey;
         // double                     statisticFrontMode = -1;
         //// =0 dont split, =1 further split, =-2 means error, =-1 means have not front mode
         // if ( uiDepth == 0 )
         //  statisticFrontMode = -1;
         // else {
-        //  int          nowX = int( uiLPelX / pow( 2, 6 - uiDepth + 1 ) ) * pow( 2, 6 - uiDepth + 1 );
-        //  int          nowY = int( uiTPelY / pow( 2, 6 - uiDepth + 1 ) ) * pow( 2, 6 - uiDepth + 1 );
-        //  stringstream ss_frontKey;
-        //  ss_frontKey << POC << "_" << nowX << "_" << nowY << "_" << uiDepth - 1;
-        //  ss_frontKey >> frontKey;
-        //  iter = frontModeFlag.find( frontKey );
-        //  if ( iter != frontModeFlag.end() )
-        //    statisticFrontMode = iter->second;
-        //  else {
-        //    statisticFrontMode = -2;
-        //  }
+        //  Int iFrontSplit    = m_cDecisionStore.getSplit( uiDepth - 1, uiLPelX, uiTPelY );
+        //  statisticFrontMode = ( iFrontSplit == CU_SPLIT_UNKNOWN ) ? -2 : iFrontSplit;
         //}
 
         // statisticFrontMode =
         //    ( statisticFrontMode == 0 )
         //        ? 0
         //        : ( ( statisticFrontMode == -1 ) ? 0.5 : ( ( statisticFrontMode == 1 ) ? 0.7 : 1 ) );  // FLM
-        std::vector<double> x( ( OorGorA == 0 ) ? I_GEO_INPUT : I_ATT_INPUT );
-        if ( OorGorA == 0 ) {
-          x[0] = statisticVarMax;
-          x[1] = statisticDepth;
-          x[2] = statisticQP;
-          //x[0] = statisticVarMax;
-          //x[1] = statisticCBF;
-          //x[2] = statisticDepth;
-          //x[3] = statisticQP;
-          //x[4] = statisticCUcate;
-        } else if ( OorGorA > 0 ) {
-          x[0] = statisticVarMax;
-          x[1] = statisticDepth;
-          x[2] = statisticQP;
-          //x[0] = statisticVarMax;
-          //x[1] = statisticCBF;
-          //x[2] = statisticDepth;
-          //x[3] = statisticQP;
-          //x[4] = statisticCUcate;
-        }
-
-         double y = vanillayNN( "IModule", OorGorA, x, "sigmoid" );
-        //double y = SLPADDCNN( pdm, x, OorGorA, "IModule" );
-        if ( OorGorA == 0 && y < IGeoTH )
-          bSubBranch = false;
-        else if ( OorGorA > 0 && y < IAttTH )
-          bSubBranch = false;
+        Float x[LFCN_NUM_INPUT];
+        x[0] = Float( statisticVarMax );
+        x[1] = Float( statisticDepth );
+        x[2] = Float( statisticQP );
+        //x[0] = statisticVarMax;
+        //x[1] = statisticCBF;
+        //x[2] = statisticDepth;
+        //x[3] = statisticQP;
+        //x[4] = statisticCUcate;
+
+        double y = m_pcLFCNContext->predictSplit( I_SLICE, QP, x );
+        //double y = SLPADDCNN( m_cScratchArena, pdm, x, OorGorA, "IModule" );
+        const bool bPrune = y < ITH;
+        rcThresholdControl.addDecision( bPrune );
+        if ( bPrune ) bSubBranch = false;
 
         //cout << "I Frame: (OorGorA: " << OorGorA << " )" << endl
         //     << "  y: " << y << endl
@@ -2497,6 +2241,9 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
 
   DEBUG_STRING_APPEND(sDebug_, sDebug);
 
+#ifdef SDMTEST
+  m_cDecisionStore.setSplit( uiDepth, uiLPelX, uiTPelY, rpcBestCU->getDepth( 0 ) > uiDepth );
+#endif
   rpcBestCU->copyToPic(uiDepth);                                                     // Copy Best data to Picture for next partition prediction.
 
   xCopyYuv2Pic( rpcBestCU->getPic(), rpcBestCU->getCtuRsAddr(), rpcBestCU->getZorderIdxInCtu(), uiDepth, uiDepth, rpcBestCU );   // Copy Yuv data to picture Yuv
@@ -2519,6 +2266,143 @@ Void TEncCu::xCompressCU( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU, const
   assert( rpcBestCU->getTotalCost     (   ) != MAX_DOUBLE                 );
 }
 
+#ifdef SDMTEST
+/** LFCN early split decision of a CU before its modes are checked
+ * \param pcCU    CU of the depth, its original samples are in m_ppcOrigYuv
+ * \param uiDepth depth of the CU
+ * \param iQP     QP of the CU
+ * \returns true when the CU is split without checking its modes
+ */
+Bool TEncCu::xCheckLFCNEarlySplit( TComDataCU* pcCU, UInt uiDepth, Int iQP )
+{
+  TComSlice*      pcSlice    = pcCU->getSlice();
+  const SliceType eSliceType = pcSlice->getSliceType();
+  const Int       iVideoType = m_pcLFCNContext->getVideoType();
+  const Int       iWidth     = pcCU->getWidth( 0 );
+  const Int       iHeight    = pcCU->getHeight( 0 );
+  const Pel*      piOrg      = m_ppcOrigYuv[uiDepth]->getAddr( COMPONENT_Y );
+  const Int       iOrgStride = m_ppcOrigYuv[uiDepth]->getStride( COMPONENT_Y );
+  const Int       iScale     = ( iVideoType == 0 ) ? 24 : 32;
+
+  // the collocated block of the first reference picture is the prediction of a zero motion vector
+  TComPic* pcRefPic = ( eSliceType != I_SLICE && pcSlice->getNumRefIdx( REF_PIC_LIST_0 ) > 0 ) ? pcSlice->getRefPic( REF_PIC_LIST_0, 0 ) : NULL;
+  if ( pcRefPic != NULL && pcRefPic->getPOC() != pcSlice->getPOC() )
+  {
+    TComPicYuv* pcRefYuv = pcRefPic->getPicYuvRec();
+    m_cLFCNFeature.initDistortion( piOrg, iOrgStride,
+                                   pcRefYuv->getAddr( COMPONENT_Y, pcCU->getCtuRsAddr(), pcCU->getZorderIdxInCtu() ),
+                                   pcRefYuv->getStride( COMPONENT_Y ), iWidth, iHeight, iScale, iQP );
+  }
+  else
+  {
+    m_cLFCNFeature.initActivity( piOrg, iOrgStride, iWidth, iHeight, iScale, iQP );
+  }
+
+  // features normalized as for the decision after the mode checks
+  const Double dNormalizingFactor = ( iVideoType == 0 ) ? 20 : 200;
+  Float x[LFCN_NUM_INPUT];
+  x[0] = Float( std::min( twoDecimalDouble( m_cLFCNFeature.getMaxQuadrantVariance() / dNormalizingFactor ), 1.0 ) );  // DV
+  x[1] = Float( twoDecimalDouble( TEncLFCNFeature::getDepthFeature( uiDepth ) ) );                                     // CD
+  x[2] = Float( twoDecimalDouble( TEncLFCNFeature::getQPFeature( iQP ) ) );                                            // QP
+
+  TEncLFCNThresholdControl& rcThresholdControl = m_pcLFCNContext->getThresholdControl();
+  if ( m_pcLFCNContext->predictSplit( eSliceType, iQP, x ) < rcThresholdControl.getSplitThreshold( eSliceType ) )
+  {
+    return false;
+  }
+  rcThresholdControl.addEarlySplit();
+  return true;
+}
+#endif
+
+/** depth range of the CTU, from the original samples, the occupancy, the QP and the final depths of the collocated CTU
+ * \param pCtu CTU about to be compressed, before its decisions are initialized
+ * \returns Void
+ */
+Void TEncCu::xPredictCtuDepthRange( TComDataCU* pCtu )
+{
+  const TComSPS& sps       = *pCtu->getSlice()->getSPS();
+  const Int      iMaxDepth = Int( sps.getLog2DiffMaxMinCodingBlockSize() );
+  const UInt     uiPelX    = pCtu->getCUPelX();
+  const UInt     uiPelY    = pCtu->getCUPelY();
+
+  m_iCtuMinDepth = 0;
+  m_iCtuMaxDepth = iMaxDepth;
+  if ( !m_pcEncCfg->getLFCNCtuDepthRange() || m_pcLFCNContext->getVideoType() == LFCN_VIDEO_OCCUPANCY ||
+       uiPelX + sps.getMaxCUWidth() > sps.getPicWidthInLumaSamples() || uiPelY + sps.getMaxCUHeight() > sps.getPicHeightInLumaSamples() )
+  {
+    return;
+  }
+
+  Int iColMinDepth = -1;
+  Int iColMaxDepth = -1;
+  if ( !m_pcLFCNContext->getSplitHistory().getCtuDepthRange( pCtu->getCtuRsAddr(), iColMinDepth, iColMaxDepth ) )
+  {
+    iColMinDepth = -1;
+  }
+  const OccupancyCategory eCategory = OccupancyCategory( m_pcLFCNContext->classifyCU( sps.getMaxCUWidth(), sps.getMaxCUHeight(), uiPelY, uiPelX,
+                                                                                      pCtu->getSlice()->getPOC() ) );
+  const TComPicYuv*       pcOrgYuv  = pCtu->getPic()->getPicYuvOrg();
+  m_cCtuDepthPredictor.predict( pcOrgYuv->getAddr( COMPONENT_Y, pCtu->getCtuRsAddr() ), pcOrgYuv->getStride( COMPONENT_Y ),
+                                sps.getBitDepth( CHANNEL_TYPE_LUMA ), pCtu->getSlice()->getSliceQp(), iMaxDepth, eCategory,
+                                iColMinDepth, iColMaxDepth, m_iCtuMinDepth, m_iCtuMaxDepth );
+}
+
+/** whether the CTU is coded by the empty CTU fast path: enabled for its video type, fully inside the picture, unoccupied
+ * in the occupancy map of its frame, and without lossless coding or fast delta QP, which restrict the modes checked
+ * \param pCtu CTU about to be compressed
+ * \returns Bool
+ */
+Bool TEncCu::xIsEmptyCtu( TComDataCU* pCtu )
+{
+  const TComSPS& sps        = *pCtu->getSlice()->getSPS();
+  const Int      iVideoType = m_pcLFCNContext->getVideoType();
+  const UInt     uiPelX     = pCtu->getCUPelX();
+  const UInt     uiPelY     = pCtu->getCUPelY();
+
+  if ( iVideoType == LFCN_VIDEO_OCCUPANCY || !( m_pcEncCfg->getLFCNEmptyCtuFastPath() & ( 1 << iVideoType ) ) ||
+       pCtu->getSlice()->getPPS()->getTransquantBypassEnabledFlag() || getFastDeltaQp() ||
+       uiPelX + sps.getMaxCUWidth() > sps.getPicWidthInLumaSamples() || uiPelY + sps.getMaxCUHeight() > sps.getPicHeightInLumaSamples() )
+  {
+    return false;
+  }
+  return m_pcLFCNContext->classifyCU( sps.getMaxCUWidth(), sps.getMaxCUHeight(), uiPelY, uiPelX, pCtu->getSlice()->getPOC() ) ==
+         OCCUPANCY_EMPTY;
+}
+
+/** codes an unoccupied CTU as one 2Nx2N CU. Inter slices check the merge candidates in skip mode only; intra slices,
+ * and inter slices without a usable candidate, code the planar mode with a direct chroma mode and without RDOQ.
+ * \param rpcBestCU best CU of depth 0
+ * \param rpcTempCU temporary CU of depth 0, initialized for the QP
+ * \returns Void
+ */
+Void TEncCu::xCheckEmptyCtu( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU )
+{
+  DEBUG_STRING_NEW(sDebug)
+  const UInt       uiDepth = rpcTempCU->getDepth( 0 );
+  TComSlice*       pcSlice = rpcTempCU->getSlice();
+
+  if ( ( !pcSlice->getPPS()->getPpsScreenExtension().getUseIntraBlockCopy() && pcSlice->getSliceType() != I_SLICE ) ||
+       ( pcSlice->getPPS()->getPpsScreenExtension().getUseIntraBlockCopy() && !pcSlice->isOnlyCurrentPictureAsReference() ) )
+  {
+    Bool bEarlyDetectionSkipMode = false;
+    xCheckRDCostMerge2Nx2N( rpcBestCU, rpcTempCU DEBUG_STRING_PASS_INTO(sDebug), &bEarlyDetectionSkipMode, true );
+    if ( rpcBestCU->getTotalCost() != MAX_DOUBLE )
+    {
+      return;
+    }
+  }
+
+  const Bool bUseRDOQ   = m_pcTrQuant->getUseRDOQ();
+  const Bool bUseRDOQTS = m_pcTrQuant->getUseRDOQTS();
+  Double     dIntraCost = MAX_DOUBLE;
+  rpcTempCU->setIntraDirSubParts( CHANNEL_TYPE_LUMA, PLANAR_IDX, 0, uiDepth );
+  rpcTempCU->setIntraDirSubParts( CHANNEL_TYPE_CHROMA, DM_CHROMA_IDX, 0, uiDepth );
+  m_pcTrQuant->setUseRDOQ( false, false );
+  xCheckRDCostIntra( rpcBestCU, rpcTempCU, dIntraCost, SIZE_2Nx2N DEBUG_STRING_PASS_INTO(sDebug), true );
+  m_pcTrQuant->setUseRDOQ( bUseRDOQ, bUseRDOQTS );
+}
+
 /** finish encoding a cu and handle end-of-slice conditions
  * \param pcCU
  * \param uiAbsPartIdx
@@ -49,6 +49,12 @@
 #include "TEncEntropy.h"
 #include "TEncSearch.h"
 #include "TEncRateCtrl.h"
+#ifdef SDMTEST
+#include "TEncLFCNFeature.h"
+#include "TEncScratchArena.h"
+#include "TEncLFCNContext.h"
+#include "TEncCtuDepthPredictor.h"
+#endif
 namespace pcc_hm {
 //! \ingroup TLibEncoder
 //! \{
@@ -83,6 +89,15 @@ private:
 #if PCC_RDO_EXT
   TComYuv**               m_ppcOccupancyYuv;
 #endif
+#ifdef SDMTEST
+  TEncLFCNFeature         m_cLFCNFeature;   ///< prediction distortion features of the LFCN split decision
+  TEncScratchArena        m_cScratchArena;  ///< per-CTU scratch buffers of the LFCN split decision
+  TEncCuDecisionStore     m_cDecisionStore; ///< split decisions of the CUs of the current CTU
+  TEncCtuDepthPredictor   m_cCtuDepthPredictor;
+  Int                     m_iCtuMinDepth;   ///< CUs above this depth are split without checking their modes
+  Int                     m_iCtuMaxDepth;   ///< CUs of this depth are not split
+  Bool                    m_bEmptyCtu;      ///< the CTU is unoccupied and coded at depth 0 without mode search
+#endif
 
   //  Data : encoder control
   Bool                    m_bEncodeDQP;
@@ -106,6 +121,9 @@ private:
   TEncSbac***             m_pppcRDSbacCoder;
   TEncSbac*               m_pcRDGoOnSbacCoder;
   TEncRateCtrl*           m_pcRateCtrl;
+#ifdef SDMTEST
+  TEncLFCNContext*        m_pcLFCNContext;  ///< video type and occupancy of the encoder owning this CU encoder
+#endif
   Bool                    m_bEnableIntraTUACTRD;
   Bool                    m_bEnableIBCTUACTRD;
   Bool                    m_bEnableInterTUACTRD;
@@ -113,6 +131,9 @@ private:
 public:
   /// copy parameters from encoder class
   Void  init                ( TEncTop* pcEncTop );
+  /// copy parameters from encoder class, with the search, transform, RD cost and entropy coders of a wavefront thread
+  Void  init                ( TEncTop* pcEncTop, TEncSearch* pcPredSearch, TComTrQuant* pcTrQuant, TComRdCost* pcRdCost,
+                              TEncEntropy* pcEntropyCoder, TEncSbac*** pppcRDSbacCoder, TEncSbac* pcRDGoOnSbacCoder );
 
   Void       setSliceEncoder( TEncSlice* pSliceEncoder ) { m_pcSliceEncoder = pSliceEncoder; }
   TEncSlice* getSliceEncoder() { return m_pcSliceEncoder; }
@@ -231,6 +252,18 @@ protected:
 #endif
 
   Void  xFillPCMBuffer     ( TComDataCU* pCU, TComYuv* pOrgYuv );
+
+#ifdef SDMTEST
+  /// LFCN decision taken before the mode checks of the CU: true when the CU is confidently split. The distortion
+  /// features use the collocated reconstruction of the first reference picture, or the CU mean without one.
+  Bool  xCheckLFCNEarlySplit( TComDataCU* pcCU, UInt uiDepth, Int iQP );
+  /// depth range of the CTU searched by xCompressCU, the full range unless the CTU depth range prediction is enabled
+  Void  xPredictCtuDepthRange( TComDataCU* pCtu );
+  /// true when the CTU lies in the picture, is unoccupied and its video type has the empty CTU fast path enabled
+  Bool  xIsEmptyCtu         ( TComDataCU* pCtu );
+  /// codes an unoccupied CTU as one CU: skipped with the best merge candidate in inter slices, planar in intra slices
+  Void  xCheckEmptyCtu      ( TComDataCU*& rpcBestCU, TComDataCU*& rpcTempCU );
+#endif
 };
 
 //! \}
@@ -0,0 +1,129 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TEncCuDepthMap.cpp
+    \brief    final CU sizes of the pictures of a video, exchanged between the encoders of the videos of a point cloud
+*/
+
+#include <algorithm>
+
+#include "TEncCuDepthMap.h"
+#include "TLibCommon/TComDataCU.h"
+#include "TLibCommon/TComPic.h"
+
+namespace pcc_hm {
+
+//! \ingroup TLibEncoder
+//! \{
+
+Void TEncCuDepthMap::create( Int iPicWidth, Int iPicHeight, Int iNumFrames )
+{
+  const Int iUnit = 1 << CU_DEPTH_MAP_LOG2_UNIT;
+  m_iWidth  = ( iPicWidth  + iUnit - 1 ) >> CU_DEPTH_MAP_LOG2_UNIT;
+  m_iHeight = ( iPicHeight + iUnit - 1 ) >> CU_DEPTH_MAP_LOG2_UNIT;
+  m_frames.assign( std::max( iNumFrames, 0 ), std::vector<UChar>( size_t( m_iWidth ) * m_iHeight, 0 ) );
+}
+
+Void TEncCuDepthMap::destroy()
+{
+  m_iWidth  = 0;
+  m_iHeight = 0;
+  m_frames.clear();
+}
+
+Void TEncCuDepthMap::storeCtu( Int iPOC, const TComDataCU* pCtu )
+{
+  if ( iPOC < 0 || iPOC >= getNumFrames() )
+  {
+    return;
+  }
+  std::vector<UChar>& rcFrame    = m_frames[iPOC];
+  const UInt          uiNumParts = pCtu->getPic()->getNumPartitionsInCtu();
+  for ( UInt uiIdx = 0; uiIdx < uiNumParts; uiIdx++ )
+  {
+    const UInt uiRaster = g_auiZscanToRaster[uiIdx];
+    const Int  iPelX    = pCtu->getCUPelX() + g_auiRasterToPelX[uiRaster];
+    const Int  iPelY    = pCtu->getCUPelY() + g_auiRasterToPelY[uiRaster];
+    const Int  iX       = iPelX >> CU_DEPTH_MAP_LOG2_UNIT;
+    const Int  iY       = iPelY >> CU_DEPTH_MAP_LOG2_UNIT;
+    // the top-left partition of each block, those outside of the picture have no CU
+    if ( ( ( iPelX | iPelY ) & ( ( 1 << CU_DEPTH_MAP_LOG2_UNIT ) - 1 ) ) != 0 || iX >= m_iWidth || iY >= m_iHeight ||
+         pCtu->getPartitionSize( uiIdx ) == NUMBER_OF_PART_SIZES )
+    {
+      continue;
+    }
+    rcFrame[iY * m_iWidth + iX] = UChar( g_aucConvertToBit[pCtu->getWidth( uiIdx )] + 2 );
+  }
+}
+
+Bool TEncCuDepthMap::getDepthRange( Int iPOC, Int iPelX, Int iPelY, Int iSize, UInt uiLog2MaxCUSize,
+                                    Int& riMinDepth, Int& riMaxDepth ) const
+{
+  if ( iPOC < 0 || iPOC >= getNumFrames() )
+  {
+    return false;
+  }
+  const std::vector<UChar>& rcFrame = m_frames[iPOC];
+  const Int iX0 = iPelX >> CU_DEPTH_MAP_LOG2_UNIT;
+  const Int iY0 = iPelY >> CU_DEPTH_MAP_LOG2_UNIT;
+  const Int iX1 = std::min( ( iPelX + iSize - 1 ) >> CU_DEPTH_MAP_LOG2_UNIT, m_iWidth  - 1 );
+  const Int iY1 = std::min( ( iPelY + iSize - 1 ) >> CU_DEPTH_MAP_LOG2_UNIT, m_iHeight - 1 );
+  if ( iX0 > iX1 || iY0 > iY1 )
+  {
+    return false;
+  }
+  Int iMinLog2Size = MAX_INT;
+  Int iMaxLog2Size = 0;
+  for ( Int iY = iY0; iY <= iY1; iY++ )
+  {
+    for ( Int iX = iX0; iX <= iX1; iX++ )
+    {
+      const Int iLog2Size = rcFrame[iY * m_iWidth + iX];
+      if ( iLog2Size == 0 )
+      {
+        return false;
+      }
+      iMinLog2Size = std::min( iMinLog2Size, iLog2Size );
+      iMaxLog2Size = std::max( iMaxLog2Size, iLog2Size );
+    }
+  }
+  // a CU larger than the CTUs of this video reads as depth 0
+  riMinDepth = std::max( Int( uiLog2MaxCUSize ) - iMaxLog2Size, 0 );
+  riMaxDepth = std::max( Int( uiLog2MaxCUSize ) - iMinLog2Size, 0 );
+  return true;
+}
+
+//! \}
+
+} // namespace pcc_hm
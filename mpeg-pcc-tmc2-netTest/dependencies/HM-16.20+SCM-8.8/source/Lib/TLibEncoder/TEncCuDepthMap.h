@@ -0,0 +1,99 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TEncCuDepthMap.h
+    \brief    final CU sizes of the pictures of a video, exchanged between the encoders of the videos of a point cloud (header)
+*/
+
+#ifndef __TENCCUDEPTHMAP__
+#define __TENCCUDEPTHMAP__
+
+#include <vector>
+
+#include "TLibCommon/CommonDef.h"
+
+namespace pcc_hm {
+
+//! \ingroup TLibEncoder
+//! \{
+
+#define CU_DEPTH_MAP_LOG2_UNIT       3      ///< one entry per 8x8 luma block, the smallest CU
+
+#define LFCN_CU_DEPTH_PRIOR_MARGIN   1      ///< depths checked beyond those of the prior video, which codes other content
+#define LFCN_CU_DEPTH_PRIOR_SHIFT    0.1    ///< split threshold change where the prior video stopped or went on splitting
+
+class TComDataCU;
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// log2 luma size of the final CU covering each 8x8 block of each picture of a video, pictures indexed by POC. The
+/// sizes rather than the depths are kept, so that videos coded with different CTU sizes can read each other's map.
+/// Every picture is allocated up front, the wavefront threads then only write the blocks of their own CTU.
+class TEncCuDepthMap
+{
+private:
+  Int                               m_iWidth;     ///< in blocks
+  Int                               m_iHeight;
+  std::vector< std::vector<UChar> > m_frames;     ///< [POC][y * m_iWidth + x], 0 before the block is coded
+
+public:
+  TEncCuDepthMap() : m_iWidth( 0 ), m_iHeight( 0 ) {}
+  virtual ~TEncCuDepthMap() {}
+
+  /// pictures of iPicWidth x iPicHeight luma samples, iNumFrames of them
+  Void    create            ( Int iPicWidth, Int iPicHeight, Int iNumFrames );
+  Void    destroy           ();
+
+  Bool    isCreated         () const                  { return !m_frames.empty(); }
+  Int     getWidth          () const                  { return m_iWidth;  }
+  Int     getHeight         () const                  { return m_iHeight; }
+  Int     getNumFrames      () const                  { return Int( m_frames.size() ); }
+  std::vector<UChar>&       getFrame( Int iPOC )       { return m_frames[iPOC]; }
+  const std::vector<UChar>& getFrame( Int iPOC ) const { return m_frames[iPOC]; }
+
+  /// records the final CUs of a compressed CTU of picture iPOC
+  Void    storeCtu          ( Int iPOC, const TComDataCU* pCtu );
+  /// smallest and largest depth, relative to CTUs of 1 << uiLog2MaxCUSize, of the final CUs of picture iPOC over the
+  /// iSize x iSize luma area at (iPelX, iPelY); false when the picture or a block of the area is not recorded
+  Bool    getDepthRange     ( Int iPOC, Int iPelX, Int iPelY, Int iSize, UInt uiLog2MaxCUSize,
+                              Int& riMinDepth, Int& riMaxDepth ) const;
+};
+
+//! \}
+
+} // namespace pcc_hm
+
+#endif // __TENCCUDEPTHMAP__
@@ -0,0 +1,113 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TEncFeatureQuantizer.cpp
+    \brief    two-decimal quantisation of the CU features
+*/
+
+#include "TEncFeatureQuantizer.h"
+
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+namespace pcc_hm {
+
+//! \ingroup TLibEncoder
+//! \{
+
+// above this magnitude twice the hundredths no longer fit the mantissa of a Double
+static const Double MAX_EXACT_VALUE = 1.0e13;
+
+Int64 TEncFeatureQuantizer::toHundredths( Double dValue )
+{
+  const Double dScaled = dValue * 100.0;
+  const Int64  iFloor  = (Int64)floor( dScaled );
+
+  // dScaled is the correctly rounded product, so iFloor is the floor of the exact product or one above it;
+  // in both cases the result is iFloor or iFloor + 1, decided by the midpoint iFloor + 0.5; the margin
+  // bounds the rounding error of dScaled, inside it the rounded product cannot be trusted
+  const Double dFrac   = dScaled - (Double)iFloor;
+  const Double dMargin = ldexp( fabs( dScaled ), -50 );
+  if( dFrac < 0.5 - dMargin )
+  {
+    return iFloor;
+  }
+  if( dFrac > 0.5 + dMargin )
+  {
+    return iFloor + 1;
+  }
+
+  // close to the midpoint: the fused multiply-add gives the sign of the exact dValue * 200 - ( 2 * iFloor + 1 )
+  const Double dDiff = fma( dValue, 200.0, -( 2.0 * (Double)iFloor + 1.0 ) );
+  if( dDiff < 0.0 )
+  {
+    return iFloor;
+  }
+  if( dDiff > 0.0 )
+  {
+    return iFloor + 1;
+  }
+  return ( iFloor & 1 ) ? iFloor + 1 : iFloor;
+}
+
+Double TEncFeatureQuantizer::roundToHundredths( Double dValue )
+{
+  if( !xIsExact( dValue ) )
+  {
+    return xRoundByStream( dValue );
+  }
+
+  // both the hundredths and 100 are exact, so the division is the correctly rounded value of the decimal
+  // string, which is what reading it back returns
+  const Double dRounded = (Double)toHundredths( dValue ) / 100.0;
+  return ( dRounded == 0.0 ) ? copysign( 0.0, dValue ) : dRounded;
+}
+
+Bool TEncFeatureQuantizer::xIsExact( Double dValue )
+{
+  return fabs( dValue ) < MAX_EXACT_VALUE;   // also false for NaN
+}
+
+Double TEncFeatureQuantizer::xRoundByStream( Double dValue )
+{
+  std::stringstream strCode;
+  strCode << std::setiosflags( std::ios::fixed ) << std::setprecision( 2 ) << dValue;
+  Double dCode;
+  strCode >> dCode;
+  return dCode;
+}
+
+//! \}
+
+} // namespace pcc_hm
@@ -1767,6 +1767,10 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
         pcPic->getPicYuvResi()->DefaultConvertPix( pcPic->getPicYuvOrg(), pcSlice->getSPS()->getBitDepths() );
       }
 
+#ifdef SDMTEST
+      m_pcEncTop->getLFCNContext()->getThresholdControl().beginPicture( pcSlice->getPOC(), pcSlice->getSliceType() );
+      m_pcEncTop->getLFCNContext()->getNearLayerPrior().beginPicture( pcSlice->getPOC() );
+#endif
       for(UInt nextCtuTsAddr = 0; nextCtuTsAddr < numberOfCtusInFrame; )
       {
         m_pcSliceEncoder->precompressSlice( pcPic );
@@ -1935,6 +1939,9 @@ Void TEncGOP::compressGOP( Int iPOCLast, Int iNumPicRcvd, TComList<TComPic*>& rc
         }
         nextCtuTsAddr = curSliceSegmentEnd;
       }
+#ifdef SDMTEST
+      m_pcEncTop->getLFCNContext()->getThresholdControl().endPicture();
+#endif
     }
 
     duData.clear();
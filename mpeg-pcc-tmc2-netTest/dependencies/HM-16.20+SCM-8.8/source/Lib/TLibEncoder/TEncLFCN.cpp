@@ -0,0 +1,433 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TEncLFCN.cpp
+    \brief    lightweight fully connected network (LFCN) for CU split decision
+*/
+
+#include "TEncLFCN.h"
+
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+
+namespace pcc_hm {
+
+//! \ingroup TLibEncoder
+//! \{
+
+/// trained weights, transposed from the Keras (input, output) kernel layout to row-major [output][input]
+const TEncLFCNSplitModel::Weights g_lfcnDefaultWeights[NUMBER_OF_LFCN_MODELS] =
+{
+  // P-slice geometry
+  {
+    {
+      -0.1798137f, -0.119140275f, -0.5683938f,
+      0.015715983f, 0.010980937f, 0.013555974f,
+      -0.09532983f, -0.041487183f, 0.042025037f,
+      -0.12949441f, -0.015314037f, -0.7310104f,
+      -0.016367447f, -0.019670215f, -0.004070325f,
+      0.56853455f, 0.4799034f, 1.1931382f,
+      -0.13140851f, -0.040534467f, -0.6871277f,
+      -0.12590483f, -0.050889056f, -0.026506832f,
+      0.5730921f, 0.57576144f, 1.1419412f,
+      0.07826559f, -0.029060448f, -0.056911822f
+    },
+    {
+      0.8574694f, -0.03832592f, -0.029819846f, 0.8761555f, -0.05974367f,
+      -0.2603977f, 0.86793953f, -0.04469238f, -0.18879512f, -0.078819275f
+    },
+    {
+      -1.5059104f, -0.0066613876f, 0.010881705f, -1.8950084f, 0.008852309f,
+      1.2992209f, -1.8162f, 0.06479486f, 1.1962177f, 0.071519755f,
+      -1.3450825f, -0.010042782f, -0.031549543f, -1.8535957f, -0.011014264f,
+      1.3258094f, -1.7824688f, 0.057287093f, 1.0893365f, 0.0057525644f,
+      -1.43051f, -0.10854612f, -0.010803781f, -1.8098618f, 0.023642553f,
+      1.350649f, -1.7318273f, 0.059295353f, 1.1233077f, -0.06867385f,
+      1.477028f, 0.043490637f, -0.035900652f, 1.8292805f, 0.037875876f,
+      -1.3084512f, 1.8208646f, 0.07287708f, -1.1840847f, -0.06903744f,
+      1.480278f, 0.025427084f, -0.08626275f, 1.7869675f, 0.035256337f,
+      -1.28103f, 1.7572726f, -0.05606584f, -1.1880049f, -0.036188617f
+    },
+    { -0.18987358f, -0.08684765f, -0.29997537f, 0.23931256f, 0.29157344f },
+    { 2.3271866f, 2.291772f, 2.3157434f, -2.4887452f, -2.4943295f },
+    { -0.3431725f }
+  },
+  // P-slice attribute
+  {
+    {
+      0.38778436f, 0.059003677f, 0.92511517f,
+      -0.007314995f, 0.065315135f, -0.09174364f,
+      0.33233833f, 0.07027739f, 0.9075054f,
+      0.36591738f, 0.41112804f, 0.8722612f,
+      0.4208757f, 0.0588191f, 1.0292256f,
+      0.3915192f, 0.02490963f, 1.1075729f,
+      0.022857603f, 0.04832394f, -0.039412506f,
+      -0.015012168f, 0.008314324f, 0.039779317f,
+      0.0021270008f, -0.03013271f, 0.009898708f,
+      -0.0051038982f, 0.024819389f, 0.036773242f
+    },
+    {
+      -0.09741153f, -0.05833369f, -0.09079688f, -0.6771248f, -0.11397923f,
+      -0.6344252f, -0.06651615f, -0.029567974f, -0.05385367f, -0.04727762f
+    },
+    {
+      -0.9188661f, -0.08677276f, -0.8767638f, -2.9734714f, -1.0080203f,
+      -3.598869f, -0.09670318f, -0.010417917f, 0.01552383f, 0.004715443f,
+      -1.0477335f, 0.050005186f, -1.1435426f, -2.757544f, -1.1630646f,
+      -3.1084049f, -0.04485282f, 0.03764891f, -0.0738545f, -0.06587834f,
+      -0.9269158f, -0.0061682737f, -0.9832114f, -2.9321315f, -1.0566517f,
+      -3.3781476f, -0.022119856f, 0.026927702f, 0.030917257f, 0.0051364466f,
+      0.8647607f, 0.10102158f, 0.9889068f, 2.9902015f, 0.93173665f,
+      3.4908228f, -0.050046027f, 0.016772207f, -0.0945312f, -0.041220848f,
+      1.0614995f, -0.047413867f, 1.1729834f, 2.7917132f, 1.1421729f,
+      3.0106144f, -0.060104396f, -0.025491703f, 0.037042968f, -0.021615531f
+    },
+    { 1.7809409f, 1.437488f, 1.700708f, -1.6271535f, -1.4059961f },
+    { -2.4459467f, -2.511491f, -2.4142091f, 2.8143487f, 2.7357085f },
+    { 0.48611394f }
+  },
+  // I-slice geometry
+  {
+    {
+      0.6891816f, 0.13167034f, 1.7472414f,
+      -0.032851584f, -0.054828633f, 0.04121032f,
+      -0.07149959f, -0.47254786f, -0.75080377f,
+      0.1327268f, 0.6590843f, 1.8364912f,
+      -0.031111201f, 0.014007426f, -0.101214945f,
+      -0.013056578f, -0.032431256f, -0.004063612f,
+      -0.17099088f, -0.6763731f, -0.5388431f,
+      -0.13880853f, -0.43721578f, -0.76438826f,
+      -2.5727057f, -0.11417717f, 0.29453498f,
+      -0.5805173f, -0.59266067f, -0.35285744f
+    },
+    {
+      0.053268004f, -0.15858771f, 0.9373012f, -0.0056827045f, -0.060157437f,
+      -0.011107092f, 1.0216832f, 0.9162116f, 0.7341579f, 0.9352663f
+    },
+    {
+      0.730095f, 0.009160237f, -2.1620114f, 0.57881624f, -0.00031412483f,
+      0.072738044f, -3.095519f, -2.2669876f, -3.8781316f, -3.7643235f,
+      -1.5902374f, 0.0020384693f, 1.9589972f, -1.7947954f, -0.029971926f,
+      -0.08819018f, 1.5223482f, 2.0884976f, 1.2264118f, 1.1565139f,
+      -1.4260284f, -0.024743749f, -0.50337994f, -0.67919695f, 0.057302352f,
+      0.013006314f, -0.6347482f, -0.42797062f, 4.9437575f, -0.026370969f,
+      1.8777653f, 0.029532894f, -2.2293231f, 1.8029268f, 0.03557874f,
+      -0.1172115f, -1.7568599f, -2.1458473f, -0.46441874f, -1.3415911f,
+      2.1345243f, -0.025439087f, -2.6179252f, 2.536627f, -0.014848113f,
+      0.086894706f, -2.2616343f, -2.5100088f, 1.3488111f, -1.7141935f
+    },
+    { -0.40222603f, 0.038892575f, -0.48762688f, -0.06750394f, 0.04712745f },
+    { 4.585394f, -4.635746f, -5.3902903f, 1.4180381f, 1.6833978f },
+    { -1.2666923f }
+  },
+  // I-slice attribute
+  {
+    {
+      -0.3399334f, -0.28761864f, -1.027468f,
+      -4.2346177f, -0.2260642f, 0.0034996956f,
+      -0.09606053f, -0.030421784f, 0.015534068f,
+      -1.9594648f, -0.1238716f, 1.1255032f,
+      -0.083944865f, -0.05297501f, 0.024796126f,
+      0.7173832f, 0.84043366f, 1.6061252f,
+      0.5212202f, 0.7088765f, 1.6438757f,
+      -0.029234419f, -0.05069234f, 0.08391107f,
+      -0.42640632f, -0.20634308f, -1.0014163f,
+      0.035182115f, -0.04941558f, -0.10561229f
+    },
+    {
+      1.0356098f, 0.4776824f, -0.1347511f, 0.11729125f, -0.052083444f,
+      -0.2584819f, -0.1723621f, -0.09161258f, 1.0184947f, -0.03605778f
+    },
+    {
+      -2.437292f, 1.157308f, 0.043091673f, -3.456434f, -0.09521533f,
+      0.8435426f, 0.6038032f, 0.044319823f, -2.3413324f, -0.022077857f,
+      1.610624f, 6.680512f, 0.05795094f, 0.05806105f, -0.00036730454f,
+      -1.6657287f, -1.8238503f, 0.031158386f, 1.5640033f, 0.013171807f,
+      -1.5597881f, -2.5165f, -0.016092842f, -2.4778214f, -0.089662425f,
+      1.1937068f, 0.95434284f, 0.038542103f, -1.2784584f, -0.014771372f,
+      1.6304326f, 6.8099475f, 0.0010595184f, -0.06356614f, -0.059034307f,
+      -1.6841154f, -1.814911f, -0.024861578f, 1.5854845f, 0.022822618f,
+      -1.4551742f, -5.1118183f, 0.042020276f, -1.4688472f, -0.010170054f,
+      1.5154018f, 1.2709001f, -0.06378681f, -1.3741953f, 0.03274649f
+    },
+    { -0.88686234f, 0.00551265f, -0.46492913f, -0.017391888f, -0.17816842f },
+    { 2.8143318f, -3.5012615f, 1.5834863f, -3.524372f, 1.5158705f },
+    { -0.7981659f }
+  }
+
+};
+
+static const TEncLFCNSplitModel s_lfcnSplitModels[NUMBER_OF_LFCN_MODELS] =
+{
+  TEncLFCNSplitModel( g_lfcnDefaultWeights[LFCN_P_GEOMETRY]  ),
+  TEncLFCNSplitModel( g_lfcnDefaultWeights[LFCN_P_ATTRIBUTE] ),
+  TEncLFCNSplitModel( g_lfcnDefaultWeights[LFCN_I_GEOMETRY]  ),
+  TEncLFCNSplitModel( g_lfcnDefaultWeights[LFCN_I_ATTRIBUTE] )
+};
+
+const TEncLFCNSplitModel& getLFCNSplitModel( SliceType eSliceType, Bool bAttribute )
+{
+  if( eSliceType == I_SLICE )
+  {
+    return s_lfcnSplitModels[bAttribute ? LFCN_I_ATTRIBUTE : LFCN_I_GEOMETRY];
+  }
+  return s_lfcnSplitModels[bAttribute ? LFCN_P_ATTRIBUTE : LFCN_P_GEOMETRY];
+}
+
+// ====================================================================================================================
+// Model files
+//
+// All values little-endian:
+//   char[8] "LFCNMODL", UInt32 version, UInt32 number of networks, then for each network
+//     Int32 slice type (1 P, 2 I), Int32 video type (0 geometry, 1 attribute), Int32 minimum QP, Int32 maximum QP,
+//     UInt32 number of layers, then for each layer
+//       UInt32 inputs, UInt32 outputs, UInt32 activation (LFCNActivation), Float32 weight[outputs][inputs],
+//       Float32 bias[outputs]
+// ====================================================================================================================
+
+static const TChar LFCN_MODEL_MAGIC[8] = { 'L', 'F', 'C', 'N', 'M', 'O', 'D', 'L' };
+
+static Bool xReadU32( const UChar*& rpData, const UChar* pEnd, UInt& ruiValue )
+{
+  if( pEnd - rpData < 4 )
+  {
+    return false;
+  }
+  ruiValue = (UInt)rpData[0] | ( (UInt)rpData[1] << 8 ) | ( (UInt)rpData[2] << 16 ) | ( (UInt)rpData[3] << 24 );
+  rpData  += 4;
+  return true;
+}
+
+static Bool xReadFloats( const UChar*& rpData, const UChar* pEnd, std::vector<Float>& rcValues, UInt uiCount )
+{
+  rcValues.resize( uiCount );
+  for( UInt i = 0; i < uiCount; i++ )
+  {
+    UInt uiBits;
+    if( !xReadU32( rpData, pEnd, uiBits ) )
+    {
+      return false;
+    }
+    memcpy( &rcValues[i], &uiBits, sizeof( Float ) );
+    if( !std::isfinite( rcValues[i] ) )
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+Bool TEncLFCNNetwork::parse( const UChar*& rpData, const UChar* pEnd, std::string& rcError )
+{
+  UInt uiSliceType, uiVideoType, uiMinQP, uiMaxQP, uiNumLayers;
+  if( !xReadU32( rpData, pEnd, uiSliceType ) || !xReadU32( rpData, pEnd, uiVideoType ) ||
+      !xReadU32( rpData, pEnd, uiMinQP ) || !xReadU32( rpData, pEnd, uiMaxQP ) || !xReadU32( rpData, pEnd, uiNumLayers ) )
+  {
+    rcError = "truncated network header";
+    return false;
+  }
+
+  std::stringstream error;
+  if( uiSliceType != P_SLICE && uiSliceType != I_SLICE )
+  {
+    error << "slice type " << uiSliceType << " is neither P (1) nor I (2)";
+  }
+  else if( uiVideoType > 1 )
+  {
+    error << "video type " << uiVideoType << " is neither geometry (0) nor attribute (1)";
+  }
+  else if( (Int)uiMinQP > (Int)uiMaxQP )
+  {
+    error << "QP range " << (Int)uiMinQP << ".." << (Int)uiMaxQP << " is empty";
+  }
+  else if( uiNumLayers == 0 || uiNumLayers > LFCN_MAX_LAYERS )
+  {
+    error << uiNumLayers << " layers, between 1 and " << LFCN_MAX_LAYERS << " are supported";
+  }
+  if( !error.str().empty() )
+  {
+    rcError = error.str();
+    return false;
+  }
+
+  m_eSliceType = (SliceType)uiSliceType;
+  m_bAttribute = uiVideoType == 1;
+  m_iMinQP     = (Int)uiMinQP;
+  m_iMaxQP     = (Int)uiMaxQP;
+  m_cLayers.assign( uiNumLayers, LFCNLayer() );
+
+  UInt uiExpectedIn = LFCN_NUM_INPUT;
+  for( UInt l = 0; l < uiNumLayers; l++ )
+  {
+    LFCNLayer& layer = m_cLayers[l];
+    UInt       uiActivation;
+    if( !xReadU32( rpData, pEnd, layer.uiNumIn ) || !xReadU32( rpData, pEnd, layer.uiNumOut ) ||
+        !xReadU32( rpData, pEnd, uiActivation ) )
+    {
+      rcError = "truncated layer header";
+      return false;
+    }
+    const UInt uiExpectedOut = ( l + 1 == uiNumLayers ) ? 1 : layer.uiNumOut;
+    if( layer.uiNumIn != uiExpectedIn || layer.uiNumOut != uiExpectedOut || layer.uiNumOut == 0 ||
+        layer.uiNumOut > LFCN_MAX_WIDTH || uiActivation >= NUMBER_OF_LFCN_ACTIVATIONS )
+    {
+      error << "layer " << l << " is " << layer.uiNumIn << "x" << layer.uiNumOut << " with activation " << uiActivation
+            << ", expected " << uiExpectedIn << " inputs and ";
+      if( l + 1 == uiNumLayers )
+      {
+        error << "1 output";
+      }
+      else
+      {
+        error << "1 to " << LFCN_MAX_WIDTH << " outputs";
+      }
+      rcError = error.str();
+      return false;
+    }
+    layer.eActivation = (LFCNActivation)uiActivation;
+    if( !xReadFloats( rpData, pEnd, layer.weight, layer.uiNumIn * layer.uiNumOut ) ||
+        !xReadFloats( rpData, pEnd, layer.bias, layer.uiNumOut ) )
+    {
+      error << "layer " << l << " has truncated or non-finite weights";
+      rcError = error.str();
+      return false;
+    }
+    uiExpectedIn = layer.uiNumOut;
+  }
+  return true;
+}
+
+Float TEncLFCNNetwork::predict( const Float* x ) const
+{
+  Float        buffer[2][LFCN_MAX_WIDTH];
+  const Float* in = x;
+  for( UInt l = 0; l < (UInt)m_cLayers.size(); l++ )
+  {
+    const LFCNLayer& layer = m_cLayers[l];
+    Float*           out   = buffer[l & 1];
+    for( UInt i = 0; i < layer.uiNumOut; i++ )
+    {
+      const Float* w   = &layer.weight[i * layer.uiNumIn];
+      Float        sum = 0.0f;
+      for( UInt j = 0; j < layer.uiNumIn; j++ )
+      {
+        sum += w[j] * in[j];
+      }
+      sum += layer.bias[i];
+      switch( layer.eActivation )
+      {
+        case LFCN_ACTIVATION_RELU:    out[i] = LFCNRelu::apply( sum );    break;
+        case LFCN_ACTIVATION_SIGMOID: out[i] = LFCNSigmoid::apply( sum ); break;
+        default:                      out[i] = sum;                       break;
+      }
+    }
+    in = out;
+  }
+  return in[0];
+}
+
+Bool TEncLFCNModelSet::load( const std::string& fileName, std::string& rcError )
+{
+  clear();
+
+  FILE* pFile = fopen( fileName.c_str(), "rb" );
+  if( pFile == NULL )
+  {
+    rcError = "can't open " + fileName;
+    return false;
+  }
+  std::vector<UChar> cData;
+  UChar              aucChunk[4096];
+  size_t             uiRead;
+  while( ( uiRead = fread( aucChunk, 1, sizeof( aucChunk ), pFile ) ) > 0 )
+  {
+    cData.insert( cData.end(), aucChunk, aucChunk + uiRead );
+  }
+  fclose( pFile );
+
+  const UChar* pData = cData.empty() ? NULL : &cData[0];
+  const UChar* pEnd  = pData + cData.size();
+  UInt         uiVersion, uiNumNetworks;
+  if( cData.size() < sizeof( LFCN_MODEL_MAGIC ) || memcmp( pData, LFCN_MODEL_MAGIC, sizeof( LFCN_MODEL_MAGIC ) ) != 0 )
+  {
+    rcError = fileName + " is not an LFCN model file";
+    return false;
+  }
+  pData += sizeof( LFCN_MODEL_MAGIC );
+  if( !xReadU32( pData, pEnd, uiVersion ) || uiVersion != LFCN_MODEL_FILE_VERSION || !xReadU32( pData, pEnd, uiNumNetworks ) )
+  {
+    rcError = fileName + " has an unsupported version";
+    return false;
+  }
+
+  std::vector<TEncLFCNNetwork> cNetworks( uiNumNetworks );
+  for( UInt n = 0; n < uiNumNetworks; n++ )
+  {
+    std::string error;
+    if( !cNetworks[n].parse( pData, pEnd, error ) )
+    {
+      std::stringstream message;
+      message << fileName << ", network " << n << ": " << error;
+      rcError = message.str();
+      return false;
+    }
+  }
+  if( pData != pEnd )
+  {
+    rcError = fileName + " has trailing data after the last network";
+    return false;
+  }
+
+  m_fileName = fileName;
+  m_cNetworks.swap( cNetworks );
+  return true;
+}
+
+const TEncLFCNNetwork* TEncLFCNModelSet::find( SliceType eSliceType, Bool bAttribute, Int iQP ) const
+{
+  const TEncLFCNNetwork* pcBest = NULL;
+  for( UInt n = 0; n < (UInt)m_cNetworks.size(); n++ )
+  {
+    const TEncLFCNNetwork& network = m_cNetworks[n];
+    if( network.matches( eSliceType, bAttribute, iQP ) && ( pcBest == NULL || network.getQPRange() < pcBest->getQPRange() ) )
+    {
+      pcBest = &network;
+    }
+  }
+  return pcBest;
+}
+
+//! \}
+
+} // namespace pcc_hm
@@ -0,0 +1,228 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TEncLFCN.h
+    \brief    lightweight fully connected network (LFCN) for CU split decision (header)
+*/
+
+#ifndef __TENCLFCN__
+#define __TENCLFCN__
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "TLibCommon/CommonDef.h"
+
+namespace pcc_hm {
+
+//! \ingroup TLibEncoder
+//! \{
+
+// ====================================================================================================================
+// Constants
+// ====================================================================================================================
+
+#define LFCN_NUM_INPUT                                    3 ///< DV, CD, QP
+#define LFCN_NUM_HIDDEN1                                 10
+#define LFCN_NUM_HIDDEN2                                  5
+
+#define LFCN_MODEL_FILE_VERSION                           1
+#define LFCN_MAX_LAYERS                                   8 ///< layers of a network loaded from a model file
+#define LFCN_MAX_WIDTH                                   64 ///< outputs of a layer of a network loaded from a model file
+
+/// one model per slice type and video type
+enum LFCNModelType
+{
+  LFCN_P_GEOMETRY  = 0,
+  LFCN_P_ATTRIBUTE = 1,
+  LFCN_I_GEOMETRY  = 2,
+  LFCN_I_ATTRIBUTE = 3,
+  NUMBER_OF_LFCN_MODELS = 4
+};
+
+/// activation of a layer of a network loaded from a model file
+enum LFCNActivation
+{
+  LFCN_ACTIVATION_RELU    = 0,
+  LFCN_ACTIVATION_SIGMOID = 1,
+  LFCN_ACTIVATION_LINEAR  = 2,
+  NUMBER_OF_LFCN_ACTIVATIONS = 3
+};
+
+// ====================================================================================================================
+// Activations and layers
+// ====================================================================================================================
+
+struct LFCNRelu
+{
+  static inline Float apply( Float u ) { return u > 0.0f ? u : 0.0f; }
+};
+
+struct LFCNSigmoid
+{
+  static inline Float apply( Float u ) { return 1.0f / ( 1.0f + expf( -u ) ); }
+};
+
+/// dense layer out = Act( W * in + b ), W is row-major [NumOut][NumIn] so that every output is one contiguous dot product
+template <Int NumIn, Int NumOut, class Act>
+struct LFCNDense
+{
+  static inline Void forward( const Float* weight, const Float* bias, const Float* in, Float* out )
+  {
+    for( Int i = 0; i < NumOut; i++ )
+    {
+      const Float* w   = weight + i * NumIn;
+      Float        sum = 0.0f;
+      for( Int j = 0; j < NumIn; j++ )
+      {
+        sum += w[j] * in[j];
+      }
+      out[i] = Act::apply( sum + bias[i] );
+    }
+  }
+};
+
+/// weights of a two-hidden-layer network with a single sigmoid output
+template <Int NumIn, Int NumHidden1, Int NumHidden2>
+struct LFCNWeights
+{
+  Float weight1[NumHidden1 * NumIn];
+  Float bias1  [NumHidden1];
+  Float weight2[NumHidden2 * NumHidden1];
+  Float bias2  [NumHidden2];
+  Float weight3[NumHidden2];
+  Float bias3  [1];
+};
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// LFCN inference, the layer sizes and activations are template parameters and all intermediate buffers live on the stack
+template <Int NumIn, Int NumHidden1, Int NumHidden2, class Act1, class Act2>
+class TEncLFCNModel
+{
+public:
+  typedef LFCNWeights<NumIn, NumHidden1, NumHidden2> Weights;
+
+  explicit TEncLFCNModel( const Weights& weights ) : m_pcWeights( &weights ) {}
+
+  Void           setWeights( const Weights& weights ) { m_pcWeights = &weights; }
+  const Weights& getWeights() const                   { return *m_pcWeights;    }
+
+  /// returns the split probability for the feature vector x[NumIn]
+  Float predict( const Float* x ) const
+  {
+    Float hidden1[NumHidden1];
+    Float hidden2[NumHidden2];
+    Float y;
+    LFCNDense<NumIn,      NumHidden1, Act1       >::forward( m_pcWeights->weight1, m_pcWeights->bias1, x,       hidden1 );
+    LFCNDense<NumHidden1, NumHidden2, Act2       >::forward( m_pcWeights->weight2, m_pcWeights->bias2, hidden1, hidden2 );
+    LFCNDense<NumHidden2, 1,          LFCNSigmoid>::forward( m_pcWeights->weight3, m_pcWeights->bias3, hidden2, &y      );
+    return y;
+  }
+
+private:
+  const Weights* m_pcWeights;
+};
+
+typedef TEncLFCNModel<LFCN_NUM_INPUT, LFCN_NUM_HIDDEN1, LFCN_NUM_HIDDEN2, LFCNRelu, LFCNSigmoid> TEncLFCNSplitModel;
+
+extern const TEncLFCNSplitModel::Weights g_lfcnDefaultWeights[NUMBER_OF_LFCN_MODELS];
+
+/// returns the split model for the slice type and the video type (geometry or attribute)
+const TEncLFCNSplitModel& getLFCNSplitModel( SliceType eSliceType, Bool bAttribute );
+
+/// dense layer of a network loaded from a model file, weights row-major [outputs][inputs]
+struct LFCNLayer
+{
+  UInt               uiNumIn;
+  UInt               uiNumOut;
+  LFCNActivation     eActivation;
+  std::vector<Float> weight;
+  std::vector<Float> bias;
+};
+
+/// LFCN whose depth and layer sizes are only known at run time, bounded by LFCN_MAX_LAYERS and LFCN_MAX_WIDTH
+class TEncLFCNNetwork
+{
+private:
+  SliceType              m_eSliceType;
+  Bool                   m_bAttribute;
+  Int                    m_iMinQP;
+  Int                    m_iMaxQP;
+  std::vector<LFCNLayer> m_cLayers;
+
+public:
+  TEncLFCNNetwork() : m_eSliceType( P_SLICE ), m_bAttribute( false ), m_iMinQP( 0 ), m_iMaxQP( MAX_QP ) {}
+
+  /// parses one network of a model file at rpData, advancing it; false with a message if it is not a valid split model
+  Bool    parse             ( const UChar*& rpData, const UChar* pEnd, std::string& rcError );
+
+  Bool    matches           ( SliceType eSliceType, Bool bAttribute, Int iQP ) const
+  {
+    return m_eSliceType == eSliceType && m_bAttribute == bAttribute && iQP >= m_iMinQP && iQP <= m_iMaxQP;
+  }
+  Int     getQPRange        () const                  { return m_iMaxQP - m_iMinQP;        }
+  UInt    getNumLayers      () const                  { return (UInt)m_cLayers.size();     }
+  const LFCNLayer& getLayer ( UInt uiIdx ) const      { return m_cLayers[uiIdx];           }
+
+  /// returns the split probability for the feature vector x[LFCN_NUM_INPUT]
+  Float   predict           ( const Float* x ) const;
+};
+
+/// networks of a model file, selected by slice type, video type and QP
+class TEncLFCNModelSet
+{
+private:
+  std::string                  m_fileName;
+  std::vector<TEncLFCNNetwork> m_cNetworks;
+
+public:
+  /// reads and validates a model file, the set stays empty on failure
+  Bool    load              ( const std::string& fileName, std::string& rcError );
+  Void    clear             ()                        { m_fileName.clear(); m_cNetworks.clear(); }
+  Bool    isEmpty           () const                  { return m_cNetworks.empty();        }
+  UInt    getNumNetworks    () const                  { return (UInt)m_cNetworks.size();   }
+  const std::string& getFileName() const              { return m_fileName;                 }
+
+  /// network with the narrowest QP range covering iQP, NULL if the file has none for this slice and video type
+  const TEncLFCNNetwork* find( SliceType eSliceType, Bool bAttribute, Int iQP ) const;
+};
+
+//! \}
+
+} // namespace pcc_hm
+
+#endif // __TENCLFCN__
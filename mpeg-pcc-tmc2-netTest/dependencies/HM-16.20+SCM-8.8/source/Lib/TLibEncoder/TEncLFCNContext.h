@@ -0,0 +1,139 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TEncLFCNContext.h
+    \brief    per-encoder state of the LFCN split decision
+*/
+
+#ifndef __TENCLFCNCONTEXT__
+#define __TENCLFCNCONTEXT__
+
+#include "TLibCommon/CommonDef.h"
+#include "TEncOccupancySummary.h"
+#include "TEncCuDecisionStore.h"
+#include "TEncLFCN.h"
+#include "TEncLFCNThresholdControl.h"
+#include "TEncNearLayerPrior.h"
+#include "TEncCuDepthMap.h"
+#include "TEncPatchSummary.h"
+
+namespace pcc_hm {
+
+//! \ingroup TLibEncoder
+//! \{
+
+/// V-PCC video carried by the encoder
+enum LFCNVideoType
+{
+  LFCN_VIDEO_OCCUPANCY = -1,  ///< occupancy map, or any video without occupancy guidance: full RDO
+  LFCN_VIDEO_GEOMETRY  = 0,
+  LFCN_VIDEO_ATTRIBUTE = 1
+};
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// occupancy summary and video type of one HM encoder instance, owned by TEncTop and shared with its TEncCu, so that
+/// several encoders can run the LFCN decision concurrently within one process
+class TEncLFCNContext
+{
+private:
+  LFCNVideoType                     m_eVideoType;
+  TEncOccupancySummary              m_cOccupancySummary;
+  TEncCuSplitHistory                m_cSplitHistory;    ///< split decisions of the picture, shared by the CU encoders
+  TEncLFCNModelSet                  m_cModelSet;        ///< split models loaded from the model file, empty for the compiled ones
+  TEncLFCNThresholdControl          m_cThresholdControl;
+  TEncNearLayerPrior                m_cNearLayerPrior;  ///< final CUs of the near layer pictures of the GOF
+  TEncCuDepthMap                    m_cCuDepthMap;      ///< final CUs of the pictures, recorded when created by the caller
+  TEncCuDepthMap                    m_cCuDepthPrior;    ///< final CUs of the same pictures in another video, e.g. geometry
+  TEncPatchSummary                  m_cPatchSummary;    ///< patch of each block of the GOF, empty without block to patch map
+  std::vector<UChar>                m_emptyCtus;        ///< CTUs of the picture coded by the empty CTU fast path, read by SAO
+
+public:
+  TEncLFCNContext() : m_eVideoType( LFCN_VIDEO_OCCUPANCY ) {}
+  virtual ~TEncLFCNContext() {}
+
+  /// video type and occupancy map of the GOF about to be encoded, without occupancy the decision is disabled
+  Void    init              ( LFCNVideoType eVideoType, const std::vector<const UChar*>& occupancyFrames,
+                              Int iOccupancyWidth, Int iOccupancyHeight, Int iOccupancyPrecision )
+  {
+    m_cOccupancySummary.create( occupancyFrames, iOccupancyWidth, iOccupancyHeight, iOccupancyPrecision );
+    m_eVideoType = m_cOccupancySummary.isEmpty() ? LFCN_VIDEO_OCCUPANCY : eVideoType;
+    m_cSplitHistory.reset();
+    m_cNearLayerPrior.reset();
+  }
+
+  LFCNVideoType                       getVideoType      () const      { return m_eVideoType;        }
+  const TEncOccupancySummary&         getOccupancySummary() const     { return m_cOccupancySummary; }
+  TEncCuSplitHistory&                 getSplitHistory   ()            { return m_cSplitHistory;     }
+  TEncLFCNModelSet&                   getModelSet       ()            { return m_cModelSet;         }
+  TEncLFCNThresholdControl&           getThresholdControl()           { return m_cThresholdControl; }
+  TEncNearLayerPrior&                 getNearLayerPrior ()            { return m_cNearLayerPrior;   }
+  TEncCuDepthMap&                     getCuDepthMap     ()            { return m_cCuDepthMap;       }
+  TEncCuDepthMap&                     getCuDepthPrior   ()            { return m_cCuDepthPrior;     }
+  TEncPatchSummary&                   getPatchSummary   ()            { return m_cPatchSummary;     }
+  const std::vector<UChar>&           getEmptyCtus      () const      { return m_emptyCtus;         }
+
+  Void    initEmptyCtus     ( UInt uiNumCtus )                        { m_emptyCtus.assign( uiNumCtus, 0 ); }
+  /// every CTU of the picture is recorded by its CU encoder, before the loop filters read the picture
+  Void    setEmptyCtu       ( UInt uiCtuRsAddr, Bool bEmpty )         { m_emptyCtus[uiCtuRsAddr] = bEmpty ? 1 : 0; }
+
+  /// returns the split probability of x[LFCN_NUM_INPUT], from the network of the model file matching the slice type,
+  /// video type and QP if there is one, from the compiled model otherwise
+  Float   predictSplit      ( SliceType eSliceType, Int iQP, const Float* x ) const
+  {
+    const Bool             bAttribute = m_eVideoType == LFCN_VIDEO_ATTRIBUTE;
+    const TEncLFCNNetwork* pcNetwork  = m_cModelSet.find( eSliceType, bAttribute, iQP );
+    return pcNetwork != NULL ? pcNetwork->predict( x ) : getLFCNSplitModel( eSliceType, bAttribute ).predict( x );
+  }
+
+  /// =0 unoccupied, =1 fully occupied, =2 boundary CU, the occupancy frame is shared by the two maps of a frame
+  Int     classifyCU        ( Int iWidth, Int iHeight, Int iPelY, Int iPelX, Int iPOC ) const
+  {
+    return m_cOccupancySummary.getCategory( iPOC / 2, iPelX, iPelY, iWidth, iHeight );
+  }
+
+  /// patches covered by the CU, the block to patch map is shared by the two maps of a frame like the occupancy
+  PatchAreaCategory classifyPatchArea( Int iWidth, Int iHeight, Int iPelY, Int iPelX, Int iPOC ) const
+  {
+    return m_cPatchSummary.getCategory( iPOC / 2, iPelX, iPelY, iWidth, iHeight );
+  }
+};
+
+//! \}
+
+} // namespace pcc_hm
+
+#endif // __TENCLFCNCONTEXT__
@@ -0,0 +1,165 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TEncLFCNFeature.cpp
+    \brief    prediction distortion features of the LFCN split decision
+*/
+
+#include <cstdlib>
+#include <cassert>
+#include <algorithm>
+
+#include "TEncLFCNFeature.h"
+
+namespace pcc_hm {
+
+//! \ingroup TLibEncoder
+//! \{
+
+TEncLFCNFeature::TEncLFCNFeature()
+: m_piDistortion( NULL )
+, m_piSum       ( NULL )
+, m_piSumSq     ( NULL )
+, m_uiMaxWidth  ( 0 )
+, m_uiMaxHeight ( 0 )
+, m_iWidth      ( 0 )
+, m_iHeight     ( 0 )
+{
+}
+
+TEncLFCNFeature::~TEncLFCNFeature()
+{
+  destroy();
+}
+
+Void TEncLFCNFeature::create( UInt uiMaxWidth, UInt uiMaxHeight )
+{
+  destroy();
+  m_uiMaxWidth   = uiMaxWidth;
+  m_uiMaxHeight  = uiMaxHeight;
+  m_piDistortion = new Int  [ uiMaxWidth * uiMaxHeight ];
+  m_piSum        = new Int64[ ( uiMaxWidth + 1 ) * ( uiMaxHeight + 1 ) ];
+  m_piSumSq      = new Int64[ ( uiMaxWidth + 1 ) * ( uiMaxHeight + 1 ) ];
+
+  // the first row and column of the tables stay zero
+  std::fill_n( m_piSum,   ( uiMaxWidth + 1 ) * ( uiMaxHeight + 1 ), Int64( 0 ) );
+  std::fill_n( m_piSumSq, ( uiMaxWidth + 1 ) * ( uiMaxHeight + 1 ), Int64( 0 ) );
+}
+
+Void TEncLFCNFeature::destroy()
+{
+  delete[] m_piDistortion; m_piDistortion = NULL;
+  delete[] m_piSum;        m_piSum        = NULL;
+  delete[] m_piSumSq;      m_piSumSq      = NULL;
+}
+
+Void TEncLFCNFeature::initDistortion( const Pel* piOrg, Int iOrgStride, const Pel* piPred, Int iPredStride,
+                                      Int iWidth, Int iHeight, Int iScale, Int iQP )
+{
+  assert( iWidth <= Int( m_uiMaxWidth ) && iHeight <= Int( m_uiMaxHeight ) );
+
+  m_iWidth  = iWidth;
+  m_iHeight = iHeight;
+
+  const UInt uiStride = m_uiMaxWidth + 1;
+  for( Int y = 0; y < iHeight; y++ )
+  {
+    Int*         piDist   = m_piDistortion + y * m_uiMaxWidth;
+    const Int64* piSumUp  = m_piSum   + y * uiStride;
+    const Int64* piSqUp   = m_piSumSq + y * uiStride;
+    Int64*       piSum    = m_piSum   + ( y + 1 ) * uiStride;
+    Int64*       piSumSq  = m_piSumSq + ( y + 1 ) * uiStride;
+    Int64        iRowSum   = 0;
+    Int64        iRowSumSq = 0;
+    for( Int x = 0; x < iWidth; x++ )
+    {
+      const Int iDist = iScale * abs( piOrg[x] - piPred[x] ) / iQP;
+      piDist[x]       = iDist;
+      iRowSum        += iDist;
+      iRowSumSq      += Int64( iDist ) * iDist;
+      piSum  [x + 1]  = piSumUp[x + 1] + iRowSum;
+      piSumSq[x + 1]  = piSqUp [x + 1] + iRowSumSq;
+    }
+    piOrg  += iOrgStride;
+    piPred += iPredStride;
+  }
+}
+
+Void TEncLFCNFeature::initActivity( const Pel* piOrg, Int iOrgStride, Int iWidth, Int iHeight, Int iScale, Int iQP )
+{
+  Int64 iSum = 0;
+  for( Int y = 0; y < iHeight; y++ )
+  {
+    for( Int x = 0; x < iWidth; x++ )
+    {
+      iSum += piOrg[y * iOrgStride + x];
+    }
+  }
+  const Int64 iNum  = Int64( iWidth ) * iHeight;
+  const Pel   iMean = Pel( ( iSum + ( iNum >> 1 ) ) / iNum );
+
+  // a constant prediction row, read with a zero stride
+  assert( iWidth <= MAX_CU_SIZE );
+  Pel aiMean[MAX_CU_SIZE];
+  std::fill_n( aiMean, iWidth, iMean );
+  initDistortion( piOrg, iOrgStride, aiMean, 0, iWidth, iHeight, iScale, iQP );
+}
+
+Double TEncLFCNFeature::getVariance( Int x, Int y, Int iWidth, Int iHeight ) const
+{
+  const Int64 iNum   = Int64( iWidth ) * iHeight;
+  const Int64 iSum   = getSum  ( x, y, iWidth, iHeight );
+  const Int64 iSumSq = getSumSq( x, y, iWidth, iHeight );
+  // n * sum(d^2) - sum(d)^2 is exact in integer arithmetic
+  return Double( iNum * iSumSq - iSum * iSum ) / ( Double( iNum ) * Double( iNum ) );
+}
+
+Double TEncLFCNFeature::getMaxQuadrantVariance() const
+{
+  const Int iHalfWidth  = m_iWidth  >> 1;
+  const Int iHalfHeight = m_iHeight >> 1;
+
+  Double dMaxVariance = getVariance( 0, 0, m_iWidth, m_iHeight );
+  for( Int i = 0; i < 2; i++ )
+  {
+    for( Int j = 0; j < 2; j++ )
+    {
+      dMaxVariance = std::max( dMaxVariance, getVariance( j * iHalfWidth, i * iHalfHeight, iHalfWidth, iHalfHeight ) );
+    }
+  }
+  return dMaxVariance;
+}
+
+//! \}
+
+} // namespace pcc_hm
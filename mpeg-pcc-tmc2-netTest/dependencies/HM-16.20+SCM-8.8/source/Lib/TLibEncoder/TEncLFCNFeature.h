@@ -0,0 +1,108 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TEncLFCNFeature.h
+    \brief    prediction distortion features of the LFCN split decision (header)
+*/
+
+#ifndef __TENCLFCNFEATURE__
+#define __TENCLFCNFEATURE__
+
+#include "TLibCommon/CommonDef.h"
+
+namespace pcc_hm {
+
+//! \ingroup TLibEncoder
+//! \{
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// prediction distortion map of the current CU with summed-area tables of the distortion and the squared distortion,
+/// so that the mean and variance of any sub-block are available in constant time
+class TEncLFCNFeature
+{
+private:
+  Int*    m_piDistortion;   ///< distortion map, stride m_uiMaxWidth
+  Int64*  m_piSum;          ///< summed-area table of the distortion, stride m_uiMaxWidth + 1
+  Int64*  m_piSumSq;        ///< summed-area table of the squared distortion, stride m_uiMaxWidth + 1
+  UInt    m_uiMaxWidth;
+  UInt    m_uiMaxHeight;
+  Int     m_iWidth;
+  Int     m_iHeight;
+
+public:
+  TEncLFCNFeature();
+  virtual ~TEncLFCNFeature();
+
+  Void    create            ( UInt uiMaxWidth, UInt uiMaxHeight );
+  Void    destroy           ();
+
+  /// builds the map scale * |org - pred| / QP and its summed-area tables in a single pass
+  Void    initDistortion    ( const Pel* piOrg, Int iOrgStride, const Pel* piPred, Int iPredStride,
+                              Int iWidth, Int iHeight, Int iScale, Int iQP );
+  /// same map against the mean of the original CU, for decisions taken before any prediction is available
+  Void    initActivity      ( const Pel* piOrg, Int iOrgStride, Int iWidth, Int iHeight, Int iScale, Int iQP );
+
+  Int     getWidth          () const                  { return m_iWidth;  }
+  Int     getHeight         () const                  { return m_iHeight; }
+  Int     getDistortion     ( Int x, Int y ) const    { return m_piDistortion[y * m_uiMaxWidth + x]; }
+
+  Int64   getSum            ( Int x, Int y, Int iWidth, Int iHeight ) const { return xGetRect( m_piSum,   x, y, iWidth, iHeight ); }
+  Int64   getSumSq          ( Int x, Int y, Int iWidth, Int iHeight ) const { return xGetRect( m_piSumSq, x, y, iWidth, iHeight ); }
+  Double  getVariance       ( Int x, Int y, Int iWidth, Int iHeight ) const;
+
+  /// maximum of the variance of the whole CU and of its four quadrants (DV before normalization)
+  Double  getMaxQuadrantVariance() const;
+
+  /// normalized CU depth feature (CD): 1 for 64x64, 0.5 for 32x32, 0 for 16x16
+  static Double getDepthFeature( UInt uiDepth )       { return uiDepth < 3 ? ( 2 - Int( uiDepth ) ) / 2.0 : -0.5; }
+  /// normalized QP feature
+  static Double getQPFeature   ( Int iQP )            { return ( 51 - iQP ) / 51.0; }
+
+private:
+  Int64   xGetRect          ( const Int64* piTable, Int x, Int y, Int iWidth, Int iHeight ) const
+  {
+    const UInt   uiStride = m_uiMaxWidth + 1;
+    const Int64* piTop    = piTable + y * uiStride + x;
+    const Int64* piBottom = piTop + iHeight * uiStride;
+    return piBottom[iWidth] - piBottom[0] - piTop[iWidth] + piTop[0];
+  }
+};
+
+//! \}
+
+} // namespace pcc_hm
+
+#endif // __TENCLFCNFEATURE__
@@ -0,0 +1,147 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TEncLFCNThresholdControl.cpp
+    \brief    per-picture adaptation of the LFCN split thresholds to an encoding time target
+*/
+
+#include "TEncLFCNThresholdControl.h"
+
+#include <cstdio>
+
+namespace pcc_hm {
+
+//! \ingroup TLibEncoder
+//! \{
+
+static const TChar s_acSliceTypeName[NUMBER_OF_SLICE_TYPES] = { 'B', 'P', 'I' };
+
+TEncLFCNThresholdControl::TEncLFCNThresholdControl()
+: m_dTargetReduction ( 0 )
+, m_dPictureBudget   ( 0 )
+, m_bVerbose         ( true )
+, m_iPOC             ( 0 )
+, m_eSliceType       ( I_SLICE )
+, m_bCalibrating     ( false )
+, m_uiCtuTime        ( 0 )
+, m_uiNumCtus        ( 0 )
+, m_uiNumDecisions   ( 0 )
+, m_uiNumPruned      ( 0 )
+, m_uiNumEarlySplits ( 0 )
+{
+  init( false, 0, 0 );
+}
+
+Void TEncLFCNThresholdControl::init( Bool bAttribute, Double dTargetReduction, Double dPictureBudget, Bool bVerbose )
+{
+  m_dTargetReduction = dTargetReduction;
+  m_dPictureBudget   = dPictureBudget;
+  m_bVerbose         = bVerbose;
+  m_bCalibrating     = false;
+
+  m_adThreshold[B_SLICE] = bAttribute ? LFCN_ATTRIBUTE_P_THRESHOLD : LFCN_GEOMETRY_P_THRESHOLD;
+  m_adThreshold[P_SLICE] = bAttribute ? LFCN_ATTRIBUTE_P_THRESHOLD : LFCN_GEOMETRY_P_THRESHOLD;
+  m_adThreshold[I_SLICE] = bAttribute ? LFCN_ATTRIBUTE_I_THRESHOLD : LFCN_GEOMETRY_I_THRESHOLD;
+  m_adSplitThreshold[B_SLICE] = bAttribute ? LFCN_ATTRIBUTE_P_SPLIT_THRESHOLD : LFCN_GEOMETRY_P_SPLIT_THRESHOLD;
+  m_adSplitThreshold[P_SLICE] = bAttribute ? LFCN_ATTRIBUTE_P_SPLIT_THRESHOLD : LFCN_GEOMETRY_P_SPLIT_THRESHOLD;
+  m_adSplitThreshold[I_SLICE] = bAttribute ? LFCN_ATTRIBUTE_I_SPLIT_THRESHOLD : LFCN_GEOMETRY_I_SPLIT_THRESHOLD;
+  for( Int i = 0; i < NUMBER_OF_SLICE_TYPES; i++ )
+  {
+    m_adFullCtuTime[i] = -1;
+  }
+}
+
+Void TEncLFCNThresholdControl::beginPicture( Int iPOC, SliceType eSliceType )
+{
+  m_iPOC           = iPOC;
+  m_eSliceType     = eSliceType;
+  m_uiCtuTime      = 0;
+  m_uiNumCtus      = 0;
+  m_uiNumDecisions = 0;
+  m_uiNumPruned    = 0;
+  m_uiNumEarlySplits = 0;
+
+  // the reduction target needs the full RDO time, the budget does not
+  m_bCalibrating   = m_dPictureBudget <= 0 && m_dTargetReduction > 0 && m_adFullCtuTime[eSliceType] < 0;
+}
+
+Void TEncLFCNThresholdControl::endPicture()
+{
+  if( !isActive() )
+  {
+    return;
+  }
+
+  const UInt   uiNumCtus      = m_uiNumCtus;
+  const UInt   uiNumDecisions = m_uiNumDecisions;
+  const UInt   uiNumPruned    = m_uiNumPruned;
+  const Double dTime          = (Double)m_uiCtuTime * 1e-6;
+  const Double dThreshold     = getThreshold( m_eSliceType );
+  Double       dTarget        = m_dPictureBudget;
+
+  if( m_bCalibrating )
+  {
+    // a picture without LFCN decisions says nothing about the pruning, measure again on the next one
+    if( uiNumDecisions > 0 && uiNumCtus > 0 )
+    {
+      m_adFullCtuTime[m_eSliceType] = dTime / uiNumCtus;
+    }
+    dTarget = 0;
+  }
+  else
+  {
+    if( m_dPictureBudget <= 0 )
+    {
+      dTarget = ( 1.0 - m_dTargetReduction ) * m_adFullCtuTime[m_eSliceType] * uiNumCtus;
+    }
+    // a higher threshold prunes more; without decisions the threshold has no effect on this slice type
+    if( uiNumDecisions > 0 && dTarget > 0 )
+    {
+      const Double dStep = Clip3( -LFCN_THRESHOLD_MAX_STEP, LFCN_THRESHOLD_MAX_STEP, LFCN_THRESHOLD_GAIN * ( dTime / dTarget - 1.0 ) );
+      m_adThreshold[m_eSliceType] = Clip3( LFCN_THRESHOLD_MIN, LFCN_THRESHOLD_MAX, m_adThreshold[m_eSliceType] + dStep );
+    }
+  }
+
+  if( m_bVerbose )
+  {
+    printf( "LFCN POC %4d %c-slice: threshold %.3f -> %.3f, CTU time %9.1f ms (target %9.1f ms%s), pruned %5.1f%% of %u decisions, %u early splits\n",
+            m_iPOC, s_acSliceTypeName[m_eSliceType], dThreshold, m_adThreshold[m_eSliceType], dTime, dTarget,
+            m_bCalibrating ? ", full RDO reference" : "", uiNumDecisions ? 100.0 * uiNumPruned / uiNumDecisions : 0.0, uiNumDecisions,
+            UInt( m_uiNumEarlySplits ) );
+  }
+  m_bCalibrating = false;
+}
+
+//! \}
+
+} // namespace pcc_hm
@@ -0,0 +1,139 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** \file     TEncLFCNThresholdControl.h
+    \brief    per-picture adaptation of the LFCN split thresholds to an encoding time target (header)
+*/
+
+#ifndef __TENCLFCNTHRESHOLDCONTROL__
+#define __TENCLFCNTHRESHOLDCONTROL__
+
+#include <atomic>
+
+#include "TLibCommon/CommonDef.h"
+
+namespace pcc_hm {
+
+//! \ingroup TLibEncoder
+//! \{
+
+#define LFCN_GEOMETRY_I_THRESHOLD    0.3    ///< fixed split thresholds, the sub-CUs are skipped when the LFCN output is below
+#define LFCN_GEOMETRY_P_THRESHOLD    0.6
+#define LFCN_ATTRIBUTE_I_THRESHOLD   0.3
+#define LFCN_ATTRIBUTE_P_THRESHOLD   0.6
+
+#define LFCN_GEOMETRY_I_SPLIT_THRESHOLD    0.9    ///< early split thresholds, the modes of the CU are skipped when the
+#define LFCN_GEOMETRY_P_SPLIT_THRESHOLD    0.9    ///< LFCN output on the pre-RDO features reaches them
+#define LFCN_ATTRIBUTE_I_SPLIT_THRESHOLD   0.8
+#define LFCN_ATTRIBUTE_P_SPLIT_THRESHOLD   0.8
+
+#define LFCN_THRESHOLD_MIN           0.1    ///< safe range of the adapted thresholds
+#define LFCN_THRESHOLD_MAX           0.9
+#define LFCN_THRESHOLD_MAX_STEP      0.1    ///< largest change of a threshold between two pictures
+#define LFCN_THRESHOLD_GAIN          0.25   ///< threshold change per relative deviation from the time target
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// adapts the split threshold of each slice type after every picture so that the CTU compression time meets either a
+/// target reduction of the full RDO time or a time budget per picture. The full RDO time is measured on the first
+/// picture of each slice type, encoded without pruning. The counters are updated concurrently by the wavefront threads.
+class TEncLFCNThresholdControl
+{
+private:
+  Double               m_dTargetReduction;                          ///< fraction of the full RDO time to save, 0 off
+  Double               m_dPictureBudget;                            ///< CTU compression time of a picture in ms, 0 off
+  Double               m_adThreshold     [NUMBER_OF_SLICE_TYPES];
+  Double               m_adSplitThreshold[NUMBER_OF_SLICE_TYPES];   ///< early split thresholds, not adapted
+  Double               m_adFullCtuTime   [NUMBER_OF_SLICE_TYPES];   ///< full RDO time of a CTU in ms, <0 not measured
+  Bool                 m_bVerbose;
+
+  // current picture
+  Int                  m_iPOC;
+  SliceType            m_eSliceType;
+  Bool                 m_bCalibrating;
+  std::atomic<UInt64>  m_uiCtuTime;                                 ///< in ns
+  std::atomic<UInt>    m_uiNumCtus;
+  std::atomic<UInt>    m_uiNumDecisions;
+  std::atomic<UInt>    m_uiNumPruned;
+  std::atomic<UInt>    m_uiNumEarlySplits;
+
+public:
+  TEncLFCNThresholdControl();
+  virtual ~TEncLFCNThresholdControl() {}
+
+  /// fixed thresholds of the video type, adapted when dTargetReduction or dPictureBudget is positive
+  Void    init              ( Bool bAttribute, Double dTargetReduction, Double dPictureBudget, Bool bVerbose = true );
+  Bool    isActive          () const                  { return m_dTargetReduction > 0 || m_dPictureBudget > 0; }
+
+  Void    beginPicture      ( Int iPOC, SliceType eSliceType );
+  /// adapts the threshold of the slice type from the time and the decisions of the picture, and reports them
+  Void    endPicture        ();
+
+  /// threshold of the current picture
+  Double  getThreshold      ( SliceType eSliceType ) const
+  {
+    return m_bCalibrating ? 0.0 : m_adThreshold[eSliceType];
+  }
+  /// split threshold of the current picture moved by dShift within the safe range, e.g. by a prior of the CU
+  Double  getThreshold      ( SliceType eSliceType, Double dShift ) const
+  {
+    return m_bCalibrating ? 0.0 : Clip3( LFCN_THRESHOLD_MIN, LFCN_THRESHOLD_MAX, m_adThreshold[eSliceType] + dShift );
+  }
+  /// early split threshold of the current picture, above any LFCN output while the full RDO time is measured
+  Double  getSplitThreshold ( SliceType eSliceType ) const
+  {
+    return m_bCalibrating ? 2.0 : m_adSplitThreshold[eSliceType];
+  }
+  Void    addCtuTime        ( UInt64 uiNanoseconds )
+  {
+    m_uiCtuTime += uiNanoseconds;
+    m_uiNumCtus++;
+  }
+  Void    addDecision       ( Bool bPruned )
+  {
+    m_uiNumDecisions++;
+    if( bPruned )
+    {
+      m_uiNumPruned++;
+    }
+  }
+  Void    addEarlySplit     ()                        { m_uiNumEarlySplits++; }
+};
+
+//! \}
+
+} // namespace pcc_hm
+
+#endif // __TENCLFCNTHRESHOLDCONTROL__
@@ -0,0 +1,134 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TEncNearLayerPrior.cpp
+    \brief    final CUs of the near layer pictures of V-PCC, prior of the far layer pictures
+*/
+
+#include <algorithm>
+
+#include "TEncNearLayerPrior.h"
+#include "TLibCommon/TComDataCU.h"
+
+namespace pcc_hm {
+
+//! \ingroup TLibEncoder
+//! \{
+
+static const Int NO_POC = MAX_INT;
+
+TEncNearLayerPrior::TEncNearLayerPrior()
+: m_uiNumCtus      ( 0 )
+, m_uiNumPartsInCtu( 0 )
+{
+}
+
+Void TEncNearLayerPrior::create( UInt uiNumCtus, UInt uiNumPartsInCtu )
+{
+  const size_t uiSize = size_t( NEAR_LAYER_PRIOR_SLOTS ) * uiNumCtus * uiNumPartsInCtu;
+  m_uiNumCtus       = uiNumCtus;
+  m_uiNumPartsInCtu = uiNumPartsInCtu;
+  m_slotPOC  .assign( NEAR_LAYER_PRIOR_SLOTS, NO_POC );
+  m_depths   .assign( uiSize, 0 );
+  m_partSizes.assign( uiSize, SChar( NUMBER_OF_PART_SIZES ) );
+  m_predModes.assign( uiSize, SChar( NUMBER_OF_PREDICTION_MODES ) );
+}
+
+Void TEncNearLayerPrior::destroy()
+{
+  m_slotPOC  .clear();
+  m_depths   .clear();
+  m_partSizes.clear();
+  m_predModes.clear();
+}
+
+Void TEncNearLayerPrior::reset()
+{
+  std::fill( m_slotPOC.begin(), m_slotPOC.end(), NO_POC );
+}
+
+Void TEncNearLayerPrior::beginPicture( Int iPOC )
+{
+  if ( isCreated() && isNearLayer( iPOC ) )
+  {
+    m_slotPOC[xGetSlot( iPOC )] = iPOC;
+  }
+}
+
+Void TEncNearLayerPrior::storeCtu( Int iPOC, const TComDataCU* pCtu )
+{
+  const Int iSlot = xGetSlot( iPOC );
+  if ( !isCreated() || m_slotPOC[iSlot] != iPOC || pCtu->getCtuRsAddr() >= m_uiNumCtus )
+  {
+    return;
+  }
+  const size_t uiOffset = ( size_t( iSlot ) * m_uiNumCtus + pCtu->getCtuRsAddr() ) * m_uiNumPartsInCtu;
+  for ( UInt uiIdx = 0; uiIdx < m_uiNumPartsInCtu; uiIdx++ )
+  {
+    m_depths   [uiOffset + uiIdx] = pCtu->getDepth( uiIdx );
+    m_partSizes[uiOffset + uiIdx] = SChar( pCtu->getPartitionSize( uiIdx ) );
+    m_predModes[uiOffset + uiIdx] = SChar( pCtu->getPredictionMode( uiIdx ) );
+  }
+}
+
+Bool TEncNearLayerPrior::getCu( Int iPOC, UInt uiCtuRsAddr, UInt uiAbsZorderIdx, UInt uiNumParts, TEncNearLayerCu& rcCu ) const
+{
+  if ( !isCreated() || iPOC < 0 || !isNearLayer( iPOC ) || m_slotPOC[xGetSlot( iPOC )] != iPOC || uiCtuRsAddr >= m_uiNumCtus ||
+       uiAbsZorderIdx + uiNumParts > m_uiNumPartsInCtu || uiNumParts == 0 )
+  {
+    return false;
+  }
+  const size_t uiOffset = ( size_t( xGetSlot( iPOC ) ) * m_uiNumCtus + uiCtuRsAddr ) * m_uiNumPartsInCtu + uiAbsZorderIdx;
+  rcCu.iMinDepth = MAX_INT;
+  rcCu.iMaxDepth = 0;
+  rcCu.bInter    = true;
+  for ( UInt uiIdx = 0; uiIdx < uiNumParts; uiIdx++ )
+  {
+    // partitions outside of the picture keep the sizes of their initialization
+    if ( m_partSizes[uiOffset + uiIdx] == NUMBER_OF_PART_SIZES )
+    {
+      return false;
+    }
+    rcCu.iMinDepth = std::min( rcCu.iMinDepth, Int( m_depths[uiOffset + uiIdx] ) );
+    rcCu.iMaxDepth = std::max( rcCu.iMaxDepth, Int( m_depths[uiOffset + uiIdx] ) );
+    rcCu.bInter    = rcCu.bInter && m_predModes[uiOffset + uiIdx] == MODE_INTER;
+  }
+  rcCu.b2Nx2N = rcCu.iMinDepth == rcCu.iMaxDepth && m_partSizes[uiOffset] == SIZE_2Nx2N &&
+                ( m_uiNumPartsInCtu >> ( 2 * rcCu.iMinDepth ) ) == uiNumParts;
+  return true;
+}
+
+//! \}
+
+} // namespace pcc_hm
@@ -0,0 +1,110 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TEncNearLayerPrior.h
+    \brief    final CUs of the near layer pictures of V-PCC, prior of the far layer pictures (header)
+*/
+
+#ifndef __TENCNEARLAYERPRIOR__
+#define __TENCNEARLAYERPRIOR__
+
+#include <vector>
+
+#include "TLibCommon/CommonDef.h"
+
+namespace pcc_hm {
+
+//! \ingroup TLibEncoder
+//! \{
+
+#define NEAR_LAYER_PRIOR_SLOTS      16    ///< near layer pictures kept, covers the distance in coding order of a GOP
+
+class TComDataCU;
+
+/// final CUs of the near layer picture covering a CU of the far layer picture
+struct TEncNearLayerCu
+{
+  Int  iMinDepth;   ///< smallest depth of the near layer CUs in the area
+  Int  iMaxDepth;   ///< largest depth of the near layer CUs in the area
+  Bool bInter;      ///< every near layer CU in the area is inter coded
+  Bool b2Nx2N;      ///< the area is one near layer CU coded with a single PU
+};
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// depth, partition size and prediction mode of every partition of the near layer pictures (even POC) in the two map
+/// mode of V-PCC, looked up by the CUs of the following far layer picture (odd POC), which shares the patch layout and
+/// nearly the content of its near layer. A slot is claimed when a near layer picture starts, before the wavefront
+/// threads write its CTUs.
+class TEncNearLayerPrior
+{
+private:
+  UInt                 m_uiNumCtus;
+  UInt                 m_uiNumPartsInCtu;
+  std::vector<Int>     m_slotPOC;     ///< near layer POC of each slot
+  std::vector<UChar>   m_depths;      ///< [slot][ctuRsAddr][zorder]
+  std::vector<SChar>   m_partSizes;
+  std::vector<SChar>   m_predModes;
+
+public:
+  TEncNearLayerPrior();
+  virtual ~TEncNearLayerPrior() {}
+
+  Void    create            ( UInt uiNumCtus, UInt uiNumPartsInCtu );
+  Void    destroy           ();
+  /// forgets every near layer picture, e.g. when the POC numbering restarts
+  Void    reset             ();
+
+  Bool    isCreated         () const                  { return !m_slotPOC.empty(); }
+  static Bool isNearLayer   ( Int iPOC )              { return ( iPOC & 1 ) == 0; }
+
+  /// claims the slot of a near layer picture about to be compressed
+  Void    beginPicture      ( Int iPOC );
+  /// records the final CUs of a CTU of a near layer picture
+  Void    storeCtu          ( Int iPOC, const TComDataCU* pCtu );
+  /// near layer CUs of picture iPOC covering uiNumParts partitions from uiAbsZorderIdx of a CTU; false when the
+  /// picture is not recorded
+  Bool    getCu             ( Int iPOC, UInt uiCtuRsAddr, UInt uiAbsZorderIdx, UInt uiNumParts, TEncNearLayerCu& rcCu ) const;
+
+private:
+  Int     xGetSlot          ( Int iPOC ) const        { return ( iPOC >> 1 ) % NEAR_LAYER_PRIOR_SLOTS; }
+};
+
+//! \}
+
+} // namespace pcc_hm
+
+#endif // __TENCNEARLAYERPRIOR__
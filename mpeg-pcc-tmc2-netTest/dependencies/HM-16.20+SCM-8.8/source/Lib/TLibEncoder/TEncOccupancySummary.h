@@ -0,0 +1,103 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TEncOccupancySummary.h
+    \brief    summed-area tables of the V-PCC occupancy map for the CU level decisions (header)
+*/
+
+#ifndef __TENCOCCUPANCYSUMMARY__
+#define __TENCOCCUPANCYSUMMARY__
+
+#include <vector>
+
+#include "TLibCommon/CommonDef.h"
+
+namespace pcc_hm {
+
+//! \ingroup TLibEncoder
+//! \{
+
+/// occupancy of a block of the coded picture
+enum OccupancyCategory
+{
+  OCCUPANCY_EMPTY    = 0,   ///< no occupied sample
+  OCCUPANCY_FULL     = 1,   ///< every sample occupied
+  OCCUPANCY_BOUNDARY = 2    ///< partially occupied, the block straddles a patch border
+};
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// per-frame summed-area tables of the occupancy map, built once when the occupancy video reaches the encoder, so that
+/// the number of occupied samples under any block, and hence its category, is available in constant time
+class TEncOccupancySummary
+{
+private:
+  std::vector< std::vector<UInt> > m_frameSums;   ///< one table per occupancy frame, stride m_iWidth + 1
+  Int                              m_iWidth;      ///< occupancy map width, in occupancy samples
+  Int                              m_iHeight;     ///< occupancy map height, in occupancy samples
+  Int                              m_iPrecision;  ///< luma samples per occupancy sample in each direction
+
+public:
+  TEncOccupancySummary();
+  virtual ~TEncOccupancySummary();
+
+  /// builds the tables from the luma planes of the occupancy frames (stride iWidth), any non-zero sample is occupied
+  Void    create            ( const std::vector<const UChar*>& frames, Int iWidth, Int iHeight, Int iPrecision );
+  Void    destroy           ();
+
+  Bool    isEmpty           () const                  { return m_frameSums.empty(); }
+  Int     getNumFrames      () const                  { return Int( m_frameSums.size() ); }
+  Int     getWidth          () const                  { return m_iWidth; }
+  Int     getHeight         () const                  { return m_iHeight; }
+  Int     getPrecision      () const                  { return m_iPrecision; }
+
+  /// number of occupied samples of the block given in occupancy samples, clipped to the map
+  UInt    getOccupiedCount  ( Int iFrame, Int x, Int y, Int iWidth, Int iHeight ) const;
+
+  /// category of the block given in luma samples of the coded picture
+  OccupancyCategory getCategory  ( Int iFrame, Int iPelX, Int iPelY, Int iWidth, Int iHeight ) const;
+  /// category of the CTU at ( uiCtuPelX, uiCtuPelY ), for the CTU level fast decisions
+  OccupancyCategory getCtuCategory( Int iFrame, UInt uiCtuPelX, UInt uiCtuPelY, UInt uiMaxCUWidth, UInt uiMaxCUHeight ) const
+  {
+    return getCategory( iFrame, Int( uiCtuPelX ), Int( uiCtuPelY ), Int( uiMaxCUWidth ), Int( uiMaxCUHeight ) );
+  }
+};
+
+//! \}
+
+} // namespace pcc_hm
+
+#endif // __TENCOCCUPANCYSUMMARY__
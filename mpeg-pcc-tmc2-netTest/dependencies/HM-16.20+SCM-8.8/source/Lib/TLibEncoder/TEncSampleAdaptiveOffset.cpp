@@ -65,6 +65,9 @@ TEncSampleAdaptiveOffset::TEncSampleAdaptiveOffset()
   m_pppcBinCoderCABAC = NULL;
   m_statData = NULL;
   m_preDBFstatData = NULL;
+#ifdef SDMTEST
+  m_pSkippedCtus = NULL;
+#endif
 }
 
 TEncSampleAdaptiveOffset::~TEncSampleAdaptiveOffset()
@@ -320,6 +323,20 @@ Void TEncSampleAdaptiveOffset::getStatistics(SAOStatData*** blkStats, TComPicYuv
     Int height = (yPos + m_maxCUHeight > m_picHeight)?(m_picHeight- yPos):m_maxCUHeight;
     Int width  = (xPos + m_maxCUWidth  > m_picWidth )?(m_picWidth - xPos):m_maxCUWidth;
 
+#ifdef SDMTEST
+    if (isSkippedCtu(ctuRsAddr))
+    {
+      for (Int compIdx = 0; compIdx < numberOfComponents; compIdx++)
+      {
+        for (Int typeIdc = 0; typeIdc < NUM_SAO_NEW_TYPES; typeIdc++)
+        {
+          blkStats[ctuRsAddr][compIdx][typeIdc].reset();
+        }
+      }
+      continue;
+    }
+#endif
+
     pPic->getPicSym()->deriveLoopFilterBoundaryAvailibility(ctuRsAddr, isLeftAvail,isRightAvail,isAboveAvail,isBelowAvail,isAboveLeftAvail,isAboveRightAvail,isBelowLeftAvail,isBelowRightAvail);
 
     //NOTE: The number of skipped lines during gathering CTU statistics depends on the slice boundary availabilities.
@@ -864,6 +881,14 @@ Void TEncSampleAdaptiveOffset::decideBlkParams(TComPic* pic, Bool* sliceEnabled,
       codedParams[ctuRsAddr].reset();
       continue;
     }
+#ifdef SDMTEST
+    if(isSkippedCtu(ctuRsAddr))
+    {
+      codedParams[ctuRsAddr].reset();
+      reconParams[ctuRsAddr] = codedParams[ctuRsAddr];
+      continue;
+    }
+#endif
 
     m_pcRDGoOnSbacCoder->store(m_pppcRDSbacCoder[ SAO_CABACSTATE_BLK_CUR ]);
 
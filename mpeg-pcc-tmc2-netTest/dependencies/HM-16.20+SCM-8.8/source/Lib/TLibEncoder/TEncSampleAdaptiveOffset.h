@@ -111,6 +111,10 @@ public:
 #endif
 public: //methods
   Void getPreDBFStatistics(TComPic* pPic);
+#ifdef SDMTEST
+  //! CTUs (non-zero entries, raster order) left without statistics and coded with SAO off, NULL for none
+  Void setSkippedCtus(const std::vector<UChar>* pSkippedCtus) { m_pSkippedCtus = pSkippedCtus; }
+#endif
 private: //methods
 #if PCC_RDO_EXT
   Void getStatistics(SAOStatData*** blkStats, TComPicYuv* orgYuv, TComPicYuv* occupancyYuv, TComPicYuv* srcYuv, TComPic* pPic, Bool isCalculatePreDeblockSamples = false);
@@ -135,6 +139,9 @@ private: //methods
   inline Int64 estSaoDist(Int64 count, Int64 offset, Int64 diffSum, Int shift);
   inline Int estIterOffset(Int typeIdx, Double lambda, Int offsetInput, Int64 count, Int64 diffSum, Int shift, Int bitIncrease, Int64& bestDist, Double& bestCost, Int offsetTh );
   Void addPreDBFStatistics(SAOStatData*** blkStats);
+#ifdef SDMTEST
+  Bool isSkippedCtu(Int ctuRsAddr) const { return m_pSkippedCtus != NULL && ctuRsAddr < (Int)m_pSkippedCtus->size() && (*m_pSkippedCtus)[ctuRsAddr] != 0; }
+#endif
 private: //members
   //for RDO
   TEncSbac**             m_pppcRDSbacCoder;
@@ -155,6 +162,9 @@ private: //members
 #endif
   Int                    m_skipLinesR[MAX_NUM_COMPONENT][NUM_SAO_NEW_TYPES];
   Int                    m_skipLinesB[MAX_NUM_COMPONENT][NUM_SAO_NEW_TYPES];
+#ifdef SDMTEST
+  const std::vector<UChar>* m_pSkippedCtus;
+#endif
 };
 
 
@@ -0,0 +1,126 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TEncScratchArena.h
+    \brief    per-CTU scratch memory of the encoder side CU decision helpers (header)
+*/
+
+#ifndef __TENCSCRATCHARENA__
+#define __TENCSCRATCHARENA__
+
+#include <vector>
+#include <cassert>
+
+#include "TLibCommon/CommonDef.h"
+
+namespace pcc_hm {
+
+//! \ingroup TLibEncoder
+//! \{
+
+#define SCRATCH_ARENA_ALIGNMENT    32   ///< alignment of every block handed out by the arena, in bytes
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// bump allocator for the temporary buffers of the CU level decisions (distortion tiles, CNN feature maps, ...).
+/// Memory is handed out linearly and given back all at once by reset() at the start of each CTU, or in stack order
+/// by release() of a mark obtained with getMark(). When a CTU needs more than the current capacity the excess is
+/// served from overflow blocks and the buffer is enlarged on the next reset(), so that no heap allocation happens per
+/// CU once the encoder has reached its steady state.
+class TEncScratchArena
+{
+private:
+  UChar*              m_pucAlloc;       ///< heap block as returned by xMalloc
+  UChar*              m_pucBuffer;      ///< m_pucAlloc rounded up to SCRATCH_ARENA_ALIGNMENT
+  UInt                m_uiCapacity;
+  UInt                m_uiUsed;
+  UInt                m_uiOverflowSize; ///< bytes currently served from m_overflowBlocks
+  UInt                m_uiPeak;         ///< largest m_uiUsed + m_uiOverflowSize since the last reset()
+  std::vector<UChar*> m_overflowBlocks;
+
+public:
+  TEncScratchArena();
+  virtual ~TEncScratchArena();
+
+  Void    create            ( UInt uiCapacity );
+  Void    destroy           ();
+
+  /// gives back every block, and enlarges the buffer if the last CTU did not fit in it
+  Void    reset             ();
+
+  UInt    getMark           () const                  { return m_uiUsed; }
+  /// gives back every block allocated from the buffer since uiMark was taken
+  Void    release           ( UInt uiMark )           { assert( uiMark <= m_uiUsed ); m_uiUsed = uiMark; }
+
+  UInt    getCapacity       () const                  { return m_uiCapacity; }
+  UInt    getUsed           () const                  { return m_uiUsed + m_uiOverflowSize; }
+
+  template<typename T>
+  T*      alloc             ( UInt uiNum )
+  {
+    return reinterpret_cast<T*>( xAlloc( uiNum * UInt( sizeof( T ) ) ) );
+  }
+
+  /// uiRows x uiCols matrix with contiguous, aligned rows; the row pointers live in the arena as well
+  template<typename T>
+  T**     allocMatrix       ( UInt uiRows, UInt uiCols )
+  {
+    T** ppRows = alloc<T*>( uiRows );
+    T*  pData  = alloc<T>( uiRows * xGetStride<T>( uiCols ) );
+    for ( UInt i = 0; i < uiRows; i++ )
+    {
+      ppRows[i] = pData + i * xGetStride<T>( uiCols );
+    }
+    return ppRows;
+  }
+
+private:
+  UChar*  xAlloc            ( UInt uiSize );
+
+  /// number of elements of one matrix row, rounded up so that every row starts aligned
+  template<typename T>
+  static UInt xGetStride    ( UInt uiCols )
+  {
+    const UInt uiBytes = ( uiCols * UInt( sizeof( T ) ) + SCRATCH_ARENA_ALIGNMENT - 1 ) & ~UInt( SCRATCH_ARENA_ALIGNMENT - 1 );
+    return uiBytes / UInt( sizeof( T ) );
+  }
+};
+
+//! \}
+
+} // namespace pcc_hm
+
+#endif // __TENCSCRATCHARENA__
@@ -70,6 +70,7 @@ Void TEncSlice::destroy()
 {
   m_picYuvPred.destroy();
   m_picYuvResi.destroy();
+  m_cWavefront.destroy();
 
   // free lambda and QP arrays
   m_vdRdPicLambda.clear();
@@ -581,6 +582,7 @@ Void TEncSlice::setSearchRange( TComSlice* pcSlice )
       iRefPOC = pcSlice->getRefPic(e, iRefIdx)->getPOC();
       Int newSearchRange = Clip3(m_pcCfg->getMinSearchWindow(), iMaxSR, (iMaxSR*ADAPT_SR_SCALE*abs(iCurrPOC - iRefPOC)+iOffset)/iGOPSize);
       m_pcPredSearch->setAdaptiveSearchRange(iDir, iRefIdx, newSearchRange);
+      m_cWavefront.setAdaptiveSearchRange(iDir, iRefIdx, newSearchRange);
     }
   }
 }
@@ -1092,9 +1094,18 @@ Void TEncSlice::compressSlice( TComPic* pcPic, const Bool bCompressEntireSlice,
     xSetPredFromPPS(lastPalette,lastPaletteSize,pcSlice);
   }
 
+  // with wavefront threads, the CTU rows are compressed concurrently instead of by the loop below
+  UInt firstSerialCtuTsAddr = startCtuTsAddr;
+  if ( m_cWavefront.isApplicable( pcPic, pcSlice, startCtuTsAddr, boundingCtuTsAddr ) )
+  {
+    m_cWavefront.compressSlice( pcPic, pcSlice, *m_pcRdCost, *m_pcTrQuant, bFastDeltaQP, lastPaletteSize, lastPalette,
+                                m_uiPicTotalBits, m_uiPicDist, m_dPicRdCost );
+    firstSerialCtuTsAddr = boundingCtuTsAddr;
+  }
+
   // for every CTU in the slice segment (may terminate sooner if there is a byte limit on the slice-segment)
 
-  for( UInt ctuTsAddr = startCtuTsAddr; ctuTsAddr < boundingCtuTsAddr; ++ctuTsAddr )
+  for( UInt ctuTsAddr = firstSerialCtuTsAddr; ctuTsAddr < boundingCtuTsAddr; ++ctuTsAddr )
   {
     const UInt ctuRsAddr = pcPic->getPicSym()->getCtuTsToRsAddrMap(ctuTsAddr);
     // initialize CTU encoder
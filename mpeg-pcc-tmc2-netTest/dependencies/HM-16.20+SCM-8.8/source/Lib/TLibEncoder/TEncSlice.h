@@ -46,6 +46,7 @@
 #include "TEncCu.h"
 #include "WeightPredAnalysis.h"
 #include "TEncRateCtrl.h"
+#include "TEncWavefront.h"
 namespace pcc_hm {
 
 //! \ingroup TLibEncoder
@@ -103,6 +104,7 @@ private:
   PaletteInfoBuffer       m_lastSliceSegmentEndPaletteState;
   PaletteInfoBuffer       m_entropyCodingSyncPaletteState;
   Int                     m_numIDRs, m_numFrames;
+  TEncWavefront           m_cWavefront;                         ///< CTU row threads of compressSlice, with entropy coding sync
 
   Double   calculateLambda( const TComSlice* pSlice, const Int GOPid, const Int depth, const Double refQP, const Double dQP, Int &iQP );
   Void     setUpLambda(TComSlice* slice, const Double dLambda, Int iQP);
@@ -137,6 +139,7 @@ public:
   Void    setSearchRange      ( TComSlice* pcSlice  );                                  ///< set ME range adaptively
 
   TEncCu*        getCUEncoder() { return m_pcCuEncoder; }                        ///< CU encoder
+  TEncWavefront* getWavefront() { return &m_cWavefront; }                       ///< CTU row threads
   Void    xDetermineStartAndBoundingCtuTsAddr  ( UInt& startCtuTsAddr, UInt& boundingCtuTsAddr, TComPic* pcPic );
   UInt    getSliceIdx()         { return m_uiSliceIdx;                    }
   Void    setSliceIdx(UInt i)   { m_uiSliceIdx = i;                       }
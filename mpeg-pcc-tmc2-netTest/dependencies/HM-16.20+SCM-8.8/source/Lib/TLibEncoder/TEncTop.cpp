@@ -232,6 +232,35 @@ Void TEncTop::init(Bool isFieldCoding)
   // initialize encoder search class
   m_cSearch.init( this, &m_cTrQuant, m_iSearchRange, m_bipredSearchRange, m_motionEstimationSearchMethod, m_maxCUWidth, m_maxCUHeight, m_maxTotalCUDepth, &m_cEntropyCoder, &m_cRdCost, getRDSbacCoder(), getRDGoOnSbacCoder() );
 
+  // initialize the CU encoders of the wavefront threads like the one above
+  m_cSliceEncoder.getWavefront()->create( this, sps0, &m_cSliceEncoder );
+#ifdef SDMTEST
+  m_cLFCNContext.getSplitHistory().create( sps0.getPicWidthInLumaSamples(), sps0.getPicHeightInLumaSamples(), m_maxCUWidth, m_maxTotalCUDepth );
+  const UInt uiNumCtus = ( ( sps0.getPicWidthInLumaSamples() + m_maxCUWidth - 1 ) / m_maxCUWidth ) *
+                         ( ( sps0.getPicHeightInLumaSamples() + m_maxCUHeight - 1 ) / m_maxCUHeight );
+  if( m_lfcnNearLayerPrior )
+  {
+    m_cLFCNContext.getNearLayerPrior().create( uiNumCtus, 1 << ( 2 * m_maxTotalCUDepth ) );
+  }
+  if( m_lfcnEmptyCtuFastPath )
+  {
+    m_cLFCNContext.initEmptyCtus( uiNumCtus );
+    m_cEncSAO.setSkippedCtus( &m_cLFCNContext.getEmptyCtus() );
+  }
+  if( !m_lfcnModelFile.empty() )
+  {
+    std::string error;
+    if( !m_cLFCNContext.getModelSet().load( m_lfcnModelFile, error ) )
+    {
+      printf( "Error: LFCN model file: %s\n", error.c_str() );
+      exit( EXIT_FAILURE );
+    }
+    printf( "LFCN model file %s: %u networks\n", m_lfcnModelFile.c_str(), m_cLFCNContext.getModelSet().getNumNetworks() );
+  }
+  m_cLFCNContext.getThresholdControl().init( m_cLFCNContext.getVideoType() == LFCN_VIDEO_ATTRIBUTE, m_lfcnTimeReduction,
+                                             m_lfcnPictureTimeBudget );
+#endif
+
   m_iMaxRefPicNum = 0;
 }
 
@@ -57,6 +57,9 @@
 #include "TEncSampleAdaptiveOffset.h"
 #include "TEncPreanalyzer.h"
 #include "TEncRateCtrl.h"
+#ifdef SDMTEST
+#include "TEncLFCNContext.h"
+#endif
 namespace pcc_hm {
 //! \ingroup TLibEncoder
 //! \{
@@ -111,6 +114,9 @@ private:
   TEncPreanalyzer         m_cPreanalyzer;                 ///< image characteristics analyzer for TM5-step3-like adaptive QP
 
   TEncRateCtrl            m_cRateCtrl;                    ///< Rate control class
+#ifdef SDMTEST
+  TEncLFCNContext         m_cLFCNContext;                 ///< state of the LFCN split decision of this encoder
+#endif
 
 protected:
   Void  xGetNewPicBuffer  ( TComPic*& rpcPic, Int ppsId ); ///< get picture buffer which will be processed. If ppsId<0, then the ppsMap will be queried for the first match.
@@ -154,6 +160,9 @@ public:
   TEncSbac***             getRDSbacCoder        () { return  m_pppcRDSbacCoder;       }
   TEncSbac*               getRDGoOnSbacCoder    () { return  &m_cRDGoOnSbacCoder;     }
   TEncRateCtrl*           getRateCtrl           () { return &m_cRateCtrl;             }
+#ifdef SDMTEST
+  TEncLFCNContext*        getLFCNContext        () { return &m_cLFCNContext;          }
+#endif
   TComPPS*                getPPS                (Int id) { return  m_ppsMap.getPS(id);}
   TComSPS*                getSPS                (Int id) { return  m_spsMap.getPS(id);}
   TComPPS*                copyToNewPPS          (Int ppsId, TComPPS* pps0);
@@ -0,0 +1,428 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TEncWavefront.cpp
+    \brief    wavefront parallel compression of the CTU rows of a picture
+*/
+
+#include <thread>
+
+#include "TEncWavefront.h"
+#include "TEncTop.h"
+
+namespace pcc_hm {
+
+//! \ingroup TLibEncoder
+//! \{
+
+// ====================================================================================================================
+// TEncWavefrontWorker
+// ====================================================================================================================
+
+TEncWavefrontWorker::TEncWavefrontWorker()
+: m_uiMaxTotalCUDepth ( 0 )
+, m_pppcRDSbacCoder   ( NULL )
+, m_pppcBinCoderCABAC ( NULL )
+{
+}
+
+TEncWavefrontWorker::~TEncWavefrontWorker()
+{
+  destroy();
+}
+
+Void TEncWavefrontWorker::create( TEncTop* pcEncTop, TComSPS& rcSPS, TEncSlice* pcSliceEncoder )
+{
+  m_uiMaxTotalCUDepth = pcEncTop->getMaxTotalCUDepth();
+
+#if FAST_BIT_EST
+  m_pppcBinCoderCABAC = new TEncBinCABACCounter** [m_uiMaxTotalCUDepth+1];
+#else
+  m_pppcBinCoderCABAC = new TEncBinCABAC** [m_uiMaxTotalCUDepth+1];
+#endif
+  m_pppcRDSbacCoder   = new TEncSbac** [m_uiMaxTotalCUDepth+1];
+  for ( UInt uiDepth = 0; uiDepth < m_uiMaxTotalCUDepth+1; uiDepth++ )
+  {
+#if FAST_BIT_EST
+    m_pppcBinCoderCABAC[uiDepth] = new TEncBinCABACCounter* [CI_NUM];
+#else
+    m_pppcBinCoderCABAC[uiDepth] = new TEncBinCABAC* [CI_NUM];
+#endif
+    m_pppcRDSbacCoder[uiDepth]   = new TEncSbac* [CI_NUM];
+    for ( Int iCIIdx = 0; iCIIdx < CI_NUM; iCIIdx++ )
+    {
+#if FAST_BIT_EST
+      m_pppcBinCoderCABAC[uiDepth][iCIIdx] = new TEncBinCABACCounter;
+#else
+      m_pppcBinCoderCABAC[uiDepth][iCIIdx] = new TEncBinCABAC;
+#endif
+      m_pppcRDSbacCoder  [uiDepth][iCIIdx] = new TEncSbac;
+      m_pppcRDSbacCoder  [uiDepth][iCIIdx]->init( m_pppcBinCoderCABAC[uiDepth][iCIIdx] );
+    }
+  }
+  m_cRDGoOnSbacCoder.init( &m_cRDGoOnBinCoderCABAC );
+
+  m_cCuEncoder.create( m_uiMaxTotalCUDepth, pcEncTop->getMaxCUWidth(), pcEncTop->getMaxCUHeight(), pcEncTop->getChromaFormatIdc(),
+                       pcEncTop->getPaletteMaxSize(), pcEncTop->getPaletteMaxPredSize() );
+  m_cCuEncoder.init( pcEncTop, &m_cSearch, &m_cTrQuant, &m_cRdCost, &m_cEntropyCoder, m_pppcRDSbacCoder, &m_cRDGoOnSbacCoder );
+  m_cCuEncoder.setSliceEncoder( pcSliceEncoder );
+
+  m_cTrQuant.init( 1 << pcEncTop->getQuadtreeTULog2MaxSize(),
+                   pcEncTop->getUseRDOQ(),
+                   pcEncTop->getUseRDOQTS(),
+                   pcEncTop->getUseSelectiveRDOQ(),
+                   true
+                  ,pcEncTop->getUseTransformSkipFast()
+#if ADAPTIVE_QP_SELECTION
+                  ,pcEncTop->getUseAdaptQpSelect()
+#endif
+                  );
+
+  // same scaling lists as TEncTop::xInitScalingLists() gave to the transform of TEncTop
+  const Int maxLog2TrDynamicRange[MAX_NUM_CHANNEL_TYPE] =
+  {
+      rcSPS.getMaxLog2TrDynamicRange(CHANNEL_TYPE_LUMA),
+      rcSPS.getMaxLog2TrDynamicRange(CHANNEL_TYPE_CHROMA)
+  };
+  if ( pcEncTop->getUseScalingListId() == SCALING_LIST_OFF )
+  {
+    m_cTrQuant.setFlatScalingList( maxLog2TrDynamicRange, rcSPS.getBitDepths() );
+    m_cTrQuant.setUseScalingList( false );
+  }
+  else
+  {
+    m_cTrQuant.setScalingList( &( rcSPS.getScalingList() ), maxLog2TrDynamicRange, rcSPS.getBitDepths() );
+    m_cTrQuant.setUseScalingList( true );
+  }
+
+  m_cSearch.init( pcEncTop, &m_cTrQuant, pcEncTop->getSearchRange(), pcEncTop->getBipredSearchRange(), pcEncTop->getMotionEstimationSearchMethod(),
+                  pcEncTop->getMaxCUWidth(), pcEncTop->getMaxCUHeight(), m_uiMaxTotalCUDepth, &m_cEntropyCoder, &m_cRdCost, m_pppcRDSbacCoder, &m_cRDGoOnSbacCoder );
+}
+
+Void TEncWavefrontWorker::destroy()
+{
+  if ( m_pppcRDSbacCoder == NULL )
+  {
+    return;
+  }
+  m_cCuEncoder.destroy();
+  m_cSearch.destroy();
+
+  for ( UInt uiDepth = 0; uiDepth < m_uiMaxTotalCUDepth+1; uiDepth++ )
+  {
+    for ( Int iCIIdx = 0; iCIIdx < CI_NUM; iCIIdx++ )
+    {
+      delete m_pppcRDSbacCoder  [uiDepth][iCIIdx];
+      delete m_pppcBinCoderCABAC[uiDepth][iCIIdx];
+    }
+    delete [] m_pppcRDSbacCoder  [uiDepth];
+    delete [] m_pppcBinCoderCABAC[uiDepth];
+  }
+  delete [] m_pppcRDSbacCoder;
+  delete [] m_pppcBinCoderCABAC;
+  m_pppcRDSbacCoder   = NULL;
+  m_pppcBinCoderCABAC = NULL;
+}
+
+Void TEncWavefrontWorker::initSlice( const TComRdCost& rcRdCost, const TComTrQuant& rcTrQuant, const Bool bFastDeltaQP )
+{
+  m_cRdCost = rcRdCost;
+#if RDOQ_CHROMA_LAMBDA
+  m_cTrQuant.setLambdas( rcTrQuant.getLambdas() );
+#else
+  m_cTrQuant.setLambda( rcTrQuant.getLambda() );
+#endif
+  m_cCuEncoder.setFastDeltaQp( bFastDeltaQP );
+}
+
+Int TEncWavefrontWorker::compressCtu( TComDataCU* pCtu, PaletteInfoBuffer& rcPalette )
+{
+  const UInt    paletteMaxPredSize = pCtu->getSlice()->getSPS()->getSpsScreenExtension().getPaletteMaxPredSize();
+  TEncSbac*     pcCtuSbacCoder     = m_pppcRDSbacCoder[0][CI_CURR_BEST];
+  TEncBinCABAC* pcCtuBinCoder      = (TEncBinCABAC*) pcCtuSbacCoder->getEncBinIf();
+
+  for ( UChar comp = 0; comp < MAX_NUM_COMPONENT; comp++ )
+  {
+    pCtu->setLastPaletteInLcuSizeFinal( comp, rcPalette.lastPaletteSize[comp] );
+    for ( UInt idx = 0; idx < paletteMaxPredSize; idx++ )
+    {
+      pCtu->setLastPaletteInLcuFinal( comp, rcPalette.lastPalette[comp][idx], idx );
+    }
+  }
+
+  // trial encodings on the go-on coder, starting from the contexts at the end of the previous CTU of the row
+  m_cEntropyCoder.setEntropyCoder( &m_cRDGoOnSbacCoder );
+  m_cEntropyCoder.setBitstream( &m_cBitCounter );
+  m_cBitCounter.resetBits();
+  m_cRDGoOnSbacCoder.load( pcCtuSbacCoder );
+  ((TEncBinCABAC*)m_cRDGoOnSbacCoder.getEncBinIf())->setBinCountingEnableFlag( true );
+
+  m_cCuEncoder.compressCtu( pCtu, rcPalette.lastPaletteSize, rcPalette.lastPalette );
+
+  // true encode of the decisions, which brings the contexts to their state at the end of this CTU
+  m_cEntropyCoder.setEntropyCoder( pcCtuSbacCoder );
+  m_cEntropyCoder.setBitstream( &m_cBitCounter );
+  pcCtuBinCoder->setBinCountingEnableFlag( true );
+  pcCtuSbacCoder->resetBits();
+  pcCtuBinCoder->setBinsCoded( 0 );
+
+  m_cCuEncoder.encodeCtu( pCtu );
+
+  pcCtuBinCoder->setBinCountingEnableFlag( false );
+  const Int numberOfWrittenBits = m_cEntropyCoder.getNumberOfWrittenBits();
+
+  if ( pCtu->getLastPaletteInLcuSizeFinal( COMPONENT_Y ) )
+  {
+    for ( UChar comp = 0; comp < MAX_NUM_COMPONENT; comp++ )
+    {
+      rcPalette.lastPaletteSize[comp] = pCtu->getLastPaletteInLcuSizeFinal( comp );
+      for ( UInt idx = 0; idx < paletteMaxPredSize; idx++ )
+      {
+        rcPalette.lastPalette[comp][idx] = pCtu->getLastPaletteInLcuFinal( comp, idx );
+      }
+    }
+  }
+
+  return numberOfWrittenBits;
+}
+
+// ====================================================================================================================
+// TEncWavefront
+// ====================================================================================================================
+
+TEncWavefront::TEncWavefront()
+: m_pcCfg              ( NULL )
+, m_pcSyncContextStates( NULL )
+, m_uiNextRow          ( 0 )
+{
+}
+
+TEncWavefront::~TEncWavefront()
+{
+  destroy();
+}
+
+Void TEncWavefront::create( TEncTop* pcEncTop, TComSPS& rcSPS, TEncSlice* pcSliceEncoder )
+{
+  destroy();
+  m_pcCfg = pcEncTop;
+  if ( !pcEncTop->getEntropyCodingSyncEnabledFlag() || pcEncTop->getWppThreads() <= 1 )
+  {
+    return;
+  }
+
+  const UInt frameHeightInCtus = ( rcSPS.getPicHeightInLumaSamples() + rcSPS.getMaxCUHeight() - 1 ) / rcSPS.getMaxCUHeight();
+  const UInt numThreads        = std::min( UInt( pcEncTop->getWppThreads() ), frameHeightInCtus );
+  for ( UInt i = 0; i < numThreads; i++ )
+  {
+    m_workers.push_back( new TEncWavefrontWorker );
+    m_workers.back()->create( pcEncTop, rcSPS, pcSliceEncoder );
+  }
+  m_pcSyncContextStates = new TEncSbac[frameHeightInCtus];
+  m_rows.resize( frameHeightInCtus );
+}
+
+Void TEncWavefront::destroy()
+{
+  for ( size_t i = 0; i < m_workers.size(); i++ )
+  {
+    m_workers[i]->destroy();
+    delete m_workers[i];
+  }
+  m_workers.clear();
+  if ( m_pcSyncContextStates )
+  {
+    delete [] m_pcSyncContextStates;
+    m_pcSyncContextStates = NULL;
+  }
+  m_rows.clear();
+}
+
+Void TEncWavefront::setAdaptiveSearchRange( Int iDir, Int iRefIdx, Int iSearchRange )
+{
+  for ( size_t i = 0; i < m_workers.size(); i++ )
+  {
+    m_workers[i]->setAdaptiveSearchRange( iDir, iRefIdx, iSearchRange );
+  }
+}
+
+Bool TEncWavefront::isApplicable( TComPic* pcPic, TComSlice* pcSlice, const UInt startCtuTsAddr, const UInt boundingCtuTsAddr )
+{
+  if ( m_workers.size() <= 1 )
+  {
+    return false;
+  }
+
+  // one slice segment and one tile covering the picture: every CTU row is a substream of its own
+  const TComPicSym* pcPicSym = pcPic->getPicSym();
+  if ( startCtuTsAddr != 0 || boundingCtuTsAddr != pcPicSym->getNumberOfCtusInFrame() || pcPicSym->getNumTiles() != 1 ||
+       pcPicSym->getFrameWidthInCtus() < 2 || pcPicSym->getFrameHeightInCtus() != UInt( m_rows.size() ) )
+  {
+    return false;
+  }
+  if ( pcSlice->getSliceMode() == FIXED_NUMBER_OF_BYTES || pcSlice->getSliceSegmentMode() == FIXED_NUMBER_OF_BYTES ||
+       pcSlice->getPPS()->getDependentSliceSegmentsEnabledFlag() )
+  {
+    return false;
+  }
+
+  // tools updating encoder state from one CTU to the next in raster order
+  if ( m_pcCfg->getUseRateCtrl() || m_pcCfg->getLumaLevelToDeltaQPMapping().isEnabled() )
+  {
+    return false;
+  }
+#if ADAPTIVE_QP_SELECTION
+  if ( m_pcCfg->getUseAdaptQpSelect() )
+  {
+    return false;
+  }
+#endif
+  return !m_pcCfg->getUsePaletteMode() && !m_pcCfg->getUseIntraBlockCopy();
+}
+
+Void TEncWavefront::compressSlice( TComPic* pcPic, TComSlice* pcSlice, const TComRdCost& rcRdCost, const TComTrQuant& rcTrQuant,
+                                   const Bool bFastDeltaQP, const UChar* lastPaletteSize, const Pel lastPalette[][MAX_PALETTE_PRED_SIZE],
+                                   UInt64& ruiPicTotalBits, UInt64& ruiPicDist, Double& rdPicRdCost )
+{
+  for ( size_t i = 0; i < m_workers.size(); i++ )
+  {
+    m_workers[i]->initSlice( rcRdCost, rcTrQuant, bFastDeltaQP );
+  }
+  for ( UChar comp = 0; comp < MAX_NUM_COMPONENT; comp++ )
+  {
+    m_cFirstRowPalette.lastPaletteSize[comp] = lastPaletteSize[comp];
+    memcpy( m_cFirstRowPalette.lastPalette[comp], lastPalette[comp], sizeof( Pel ) * MAX_PALETTE_PRED_SIZE );
+  }
+  m_rows.assign( m_rows.size(), RowState() );
+  m_uiNextRow = 0;
+
+  // the calling thread is the first worker
+  std::vector<std::thread> threads;
+  for ( size_t i = 1; i < m_workers.size(); i++ )
+  {
+    threads.push_back( std::thread( &TEncWavefront::xCompressRows, this, m_workers[i], pcPic, pcSlice ) );
+  }
+  xCompressRows( m_workers[0], pcPic, pcSlice );
+  for ( size_t i = 0; i < threads.size(); i++ )
+  {
+    threads[i].join();
+  }
+
+  // sums in raster order, as the serial loop would have made them
+  UInt64 uiWrittenBits = 0;
+  for ( size_t uiRow = 0; uiRow < m_rows.size(); uiRow++ )
+  {
+    uiWrittenBits   += m_rows[uiRow].uiWrittenBits;
+    ruiPicTotalBits += m_rows[uiRow].uiTotalBits;
+    ruiPicDist      += m_rows[uiRow].uiTotalDistortion;
+    rdPicRdCost     += m_rows[uiRow].dTotalCost;
+  }
+  pcSlice->setSliceBits( (UInt)( pcSlice->getSliceBits() + uiWrittenBits ) );
+  pcSlice->setSliceSegmentBits( (UInt)( pcSlice->getSliceSegmentBits() + uiWrittenBits ) );
+}
+
+Void TEncWavefront::xCompressRows( TEncWavefrontWorker* pcWorker, TComPic* pcPic, TComSlice* pcSlice )
+{
+  const UInt        frameWidthInCtus = pcPic->getPicSym()->getFrameWidthInCtus();
+  PaletteInfoBuffer cPalette;
+
+  for ( ;; )
+  {
+    UInt uiRow;
+    {
+      std::lock_guard<std::mutex> lock( m_mutex );
+      uiRow = m_uiNextRow++;
+    }
+    if ( uiRow >= UInt( m_rows.size() ) )
+    {
+      return;
+    }
+    RowState& rcRow = m_rows[uiRow];
+
+    for ( UInt uiCol = 0; uiCol < frameWidthInCtus; uiCol++ )
+    {
+      if ( uiRow > 0 )
+      {
+        // the CTUs above and above-right give the intra references and merge candidates of this CTU
+        xWaitForRow( uiRow - 1, std::min( uiCol + 2, frameWidthInCtus ) );
+      }
+
+      const UInt  ctuRsAddr = uiRow * frameWidthInCtus + uiCol;
+      TComDataCU* pCtu      = pcPic->getCtu( ctuRsAddr );
+      pCtu->initCtu( pcPic, ctuRsAddr );
+
+      if ( uiCol == 0 )
+      {
+        // the first row starts from the slice contexts, the others from the contexts at the end of the second CTU above
+        pcWorker->getCtuSbacCoder()->resetEntropy( pcSlice );
+        if ( uiRow == 0 )
+        {
+          cPalette = m_cFirstRowPalette;
+        }
+        else
+        {
+          pcWorker->getCtuSbacCoder()->loadContexts( &m_pcSyncContextStates[uiRow - 1] );
+          cPalette = m_rows[uiRow - 1].cSyncPalette;
+        }
+      }
+
+      rcRow.uiWrittenBits     += pcWorker->compressCtu( pCtu, cPalette );
+      rcRow.uiTotalBits       += pCtu->getTotalBits();
+      rcRow.uiTotalDistortion += pCtu->getTotalDistortion();
+      rcRow.dTotalCost        += pCtu->getTotalCost();
+
+      if ( uiCol == 1 )
+      {
+        m_pcSyncContextStates[uiRow].loadContexts( pcWorker->getCtuSbacCoder() );
+        rcRow.cSyncPalette = cPalette;
+      }
+
+      {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        rcRow.uiNumCompressedCtus = uiCol + 1;
+      }
+      m_cRowProgress.notify_all();
+    }
+  }
+}
+
+Void TEncWavefront::xWaitForRow( UInt uiRow, UInt uiNumCtus )
+{
+  std::unique_lock<std::mutex> lock( m_mutex );
+  m_cRowProgress.wait( lock, [&] { return m_rows[uiRow].uiNumCompressedCtus >= uiNumCtus; } );
+}
+
+//! \}
+
+} // namespace pcc_hm
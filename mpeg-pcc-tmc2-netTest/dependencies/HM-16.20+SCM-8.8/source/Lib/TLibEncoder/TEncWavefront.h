@@ -0,0 +1,166 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ITU/ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ITU/ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/** \file     TEncWavefront.h
+    \brief    wavefront parallel compression of the CTU rows of a picture (header)
+*/
+
+#ifndef __TENCWAVEFRONT__
+#define __TENCWAVEFRONT__
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include "TLibCommon/CommonDef.h"
+#include "TLibCommon/ContextTables.h"
+#include "TLibCommon/TComBitCounter.h"
+#include "TLibCommon/TComPic.h"
+#include "TLibCommon/TComRdCost.h"
+#include "TLibCommon/TComTrQuant.h"
+#include "TEncCu.h"
+#include "TEncSearch.h"
+#include "TEncEntropy.h"
+#include "TEncSbac.h"
+#include "TEncBinCoderCABACCounter.h"
+
+namespace pcc_hm {
+
+//! \ingroup TLibEncoder
+//! \{
+
+class TEncTop;
+class TEncSlice;
+
+// ====================================================================================================================
+// Class definition
+// ====================================================================================================================
+
+/// CTU coding tools of one wavefront thread, set up like the ones of TEncTop
+class TEncWavefrontWorker
+{
+private:
+  TEncCu                  m_cCuEncoder;
+  TEncSearch              m_cSearch;
+  TComTrQuant             m_cTrQuant;
+  TComRdCost              m_cRdCost;
+  TEncEntropy             m_cEntropyCoder;
+  TComBitCounter          m_cBitCounter;
+  UInt                    m_uiMaxTotalCUDepth;
+  TEncSbac***             m_pppcRDSbacCoder;
+  TEncSbac                m_cRDGoOnSbacCoder;
+#if FAST_BIT_EST
+  TEncBinCABACCounter***  m_pppcBinCoderCABAC;
+  TEncBinCABACCounter     m_cRDGoOnBinCoderCABAC;
+#else
+  TEncBinCABAC***         m_pppcBinCoderCABAC;
+  TEncBinCABAC            m_cRDGoOnBinCoderCABAC;
+#endif
+
+public:
+  TEncWavefrontWorker();
+  virtual ~TEncWavefrontWorker();
+
+  Void    create              ( TEncTop* pcEncTop, TComSPS& rcSPS, TEncSlice* pcSliceEncoder );
+  Void    destroy             ();
+
+  /// lambdas and cost settings of the slice, as set up by TEncSlice on the coding tools of TEncTop
+  Void    initSlice           ( const TComRdCost& rcRdCost, const TComTrQuant& rcTrQuant, const Bool bFastDeltaQP );
+  Void    setAdaptiveSearchRange( Int iDir, Int iRefIdx, Int iSearchRange ) { m_cSearch.setAdaptiveSearchRange( iDir, iRefIdx, iSearchRange ); }
+
+  /// contexts used and updated by compressCtu()
+  TEncSbac* getCtuSbacCoder   ()                        { return m_pppcRDSbacCoder[0][CI_CURR_BEST]; }
+
+  /// makes the decisions of the CTU and encodes them, returns the number of bits written
+  Int     compressCtu         ( TComDataCU* pCtu, PaletteInfoBuffer& rcPalette );
+};
+
+/// compresses the CTU rows of a picture concurrently, each row starting once the first two CTUs of the row above are
+/// done and from the contexts those left, as entropy coding sync (WPP) allows. Every CTU is decided from the same
+/// contexts, neighbours and lambdas as in the serial loop of TEncSlice, so the result does not depend on the number
+/// of threads.
+class TEncWavefront
+{
+private:
+  /// progress and statistics of one CTU row
+  struct RowState
+  {
+    UInt                  uiNumCompressedCtus;
+    UInt64                uiWrittenBits;
+    UInt64                uiTotalBits;
+    UInt64                uiTotalDistortion;
+    Double                dTotalCost;
+    PaletteInfoBuffer     cSyncPalette;           ///< palette predictor at the end of the second CTU of the row
+
+    RowState() : uiNumCompressedCtus( 0 ), uiWrittenBits( 0 ), uiTotalBits( 0 ), uiTotalDistortion( 0 ), dTotalCost( 0 ) {}
+  };
+
+  TEncCfg*                          m_pcCfg;
+  std::vector<TEncWavefrontWorker*> m_workers;
+  TEncSbac*                         m_pcSyncContextStates;  ///< per CTU row, contexts at the end of its second CTU
+  std::vector<RowState>             m_rows;
+  PaletteInfoBuffer                 m_cFirstRowPalette;
+  UInt                              m_uiNextRow;            ///< first CTU row not yet taken by a thread
+  std::mutex                        m_mutex;                ///< guards m_uiNextRow and uiNumCompressedCtus
+  std::condition_variable           m_cRowProgress;
+
+public:
+  TEncWavefront();
+  virtual ~TEncWavefront();
+
+  /// creates min(WppThreads, number of CTU rows) workers when entropy coding sync is enabled
+  Void    create              ( TEncTop* pcEncTop, TComSPS& rcSPS, TEncSlice* pcSliceEncoder );
+  Void    destroy             ();
+
+  Int     getNumThreads       () const                  { return Int( m_workers.size() ); }
+  Void    setAdaptiveSearchRange( Int iDir, Int iRefIdx, Int iSearchRange );
+
+  /// true when the slice segment covers the picture and uses no tool carrying state across CTU rows
+  Bool    isApplicable        ( TComPic* pcPic, TComSlice* pcSlice, const UInt startCtuTsAddr, const UInt boundingCtuTsAddr );
+
+  /// compresses every CTU of the picture, and adds their bits and costs as the serial loop of TEncSlice does
+  Void    compressSlice       ( TComPic* pcPic, TComSlice* pcSlice, const TComRdCost& rcRdCost, const TComTrQuant& rcTrQuant,
+                                const Bool bFastDeltaQP, const UChar* lastPaletteSize, const Pel lastPalette[][MAX_PALETTE_PRED_SIZE],
+                                UInt64& ruiPicTotalBits, UInt64& ruiPicDist, Double& rdPicRdCost );
+
+private:
+  Void    xCompressRows       ( TEncWavefrontWorker* pcWorker, TComPic* pcPic, TComSlice* pcSlice );
+  Void    xWaitForRow         ( UInt uiRow, UInt uiNumCtus );
+};
+
+//! \}
+
+} // namespace pcc_hm
+
+#endif // __TENCWAVEFRONT__
@@ -591,6 +591,62 @@ bool parseParameters( int                   argc,
       encoderParams.nbThread_,
       encoderParams.nbThread_,
       "Number of thread used for parallel processing" )
+    ( "videoEncoderParallelSegments",
+      encoderParams.videoEncoderParallelSegments_,
+      encoderParams.videoEncoderParallelSegments_,
+      "Maximum number of closed intra period segments (all intra or IDR refresh) of a video encoded concurrently "
+      "by the HM library. 1: one sequence per video" )
+    ( "videoEncoderWppThreads",
+      encoderParams.videoEncoderWppThreads_,
+      encoderParams.videoEncoderWppThreads_,
+      "Number of CTU rows of a picture compressed concurrently by the HM library. Values greater than 1 enable "
+      "entropy coding sync (WaveFrontSynchro). 1: configuration unchanged" )
+    ( "videoEncoderLFCNModelFile",
+      encoderParams.videoEncoderLFCNModelFile_,
+      encoderParams.videoEncoderLFCNModelFile_,
+      "LFCN model file (export_lfcn_model.py) replacing the CU split models compiled into the HM library, with "
+      "networks per slice type, video type and QP range. Empty: compiled models" )
+    ( "videoEncoderLFCNTimeReduction",
+      encoderParams.videoEncoderLFCNTimeReduction_,
+      encoderParams.videoEncoderLFCNTimeReduction_,
+      "Fraction of the full RDO CTU compression time the HM library saves by adapting the LFCN split thresholds "
+      "after each picture; the full RDO time is measured on the first picture of each slice type. 0: fixed "
+      "thresholds" )
+    ( "videoEncoderLFCNPictureTimeBudget",
+      encoderParams.videoEncoderLFCNPictureTimeBudget_,
+      encoderParams.videoEncoderLFCNPictureTimeBudget_,
+      "CTU compression time of a picture in ms the LFCN split thresholds adapt to, overrides "
+      "videoEncoderLFCNTimeReduction. 0: off" )
+    ( "videoEncoderLFCNEarlySplit",
+      encoderParams.videoEncoderLFCNEarlySplit_,
+      encoderParams.videoEncoderLFCNEarlySplit_,
+      "Split the CUs whose LFCN output on features computed before the mode checks reaches the early split "
+      "threshold, skipping the modes of their depth" )
+    ( "videoEncoderLFCNCtuDepthRange",
+      encoderParams.videoEncoderLFCNCtuDepthRange_,
+      encoderParams.videoEncoderLFCNCtuDepthRange_,
+      "Predict per CTU the range of CU depths checked by the HM library, from the original samples, the occupancy, "
+      "the QP and the final depths of the collocated CTU" )
+    ( "videoEncoderLFCNNearLayerPrior",
+      encoderParams.videoEncoderLFCNNearLayerPrior_,
+      encoderParams.videoEncoderLFCNNearLayerPrior_,
+      "Bound the CUs of the far layer (D1/T1) pictures checked by the HM library by the final CUs of their near "
+      "layer (D0/T0) picture, with two maps in a single stream" )
+    ( "videoEncoderLFCNGeometryPrior",
+      encoderParams.videoEncoderLFCNGeometryPrior_,
+      encoderParams.videoEncoderLFCNGeometryPrior_,
+      "Keep the final CUs of the geometry video and use them to bound the CU depths and move the LFCN split "
+      "thresholds of the attribute video" )
+    ( "videoEncoderLFCNPatchAware",
+      encoderParams.videoEncoderLFCNPatchAware_,
+      encoderParams.videoEncoderLFCNPatchAware_,
+      "Hand the block to patch map over to the HM library: the LFCN decisions are skipped for the CUs crossing patch "
+      "borders and made more readily inside the patches" )
+    ( "videoEncoderLFCNEmptyCtuFastPath",
+      encoderParams.videoEncoderLFCNEmptyCtuFastPath_,
+      encoderParams.videoEncoderLFCNEmptyCtuFastPath_,
+      "Code the unoccupied CTUs at depth 0 without mode search in the HM library (skip merge in P slices, planar "
+      "in I slices, no SAO), for these video types: 1 geometry, 2 attribute, 3 both" )
     ( "keepIntermediateFiles",
       encoderParams.keepIntermediateFiles_,
       encoderParams.keepIntermediateFiles_,
@@ -36,9 +36,14 @@
 
 #include "PCCHDRToolsLibColorConverter.h"
 #include "PCCHDRToolsLibColorConverterImpl.h"
+#include <mutex>
 
 using namespace pcc;
 
+// HDRTools keeps its project parameters in a library global, so conversions must not overlap when several
+// videos are encoded concurrently.
+static std::mutex hdrToolsMutex;
+
 template <typename T>
 PCCHDRToolsLibColorConverter<T>::PCCHDRToolsLibColorConverter() {}
 template <typename T>
@@ -50,6 +55,7 @@ void PCCHDRToolsLibColorConverter<T>::convert( std::string        configFile,
                                                PCCVideo<T, 3>&    videoDst,
                                                const std::string& externalPath,
                                                const std::string& fileName ) {
+  std::lock_guard<std::mutex>         lock( hdrToolsMutex );
   PCCHDRToolsLibColorConverterImpl<T> converter;
   converter.convert( configFile, videoSrc, videoDst );
 }
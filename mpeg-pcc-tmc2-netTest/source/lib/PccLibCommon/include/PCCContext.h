@@ -36,6 +36,7 @@
 #include "PCCCommon.h"
 #include "PCCMath.h"
 #include "PCCVideo.h"
+#include "PCCCuDepthMap.h"
 #include "PCCBitstreamCommon.h"
 #include "PCCHighLevelSyntax.h"
 #include <map>
@@ -93,6 +94,7 @@ class PCCAtlasContext {
     return attrFrames_[attrIdx][partIdx][index];
   }
   PCCVideoAttribute& getVideoAuxAttribute( size_t attrIdx, size_t partIdx ) { return attrAuxFrames_[attrIdx][partIdx]; }
+  PCCCuDepthMap&     getGeometryCuDepthMap() { return geoCuDepthMap_; }
 
   // GPA related functions
   std::vector<SubContext>& getSubContexts() { return subContexts_; }
@@ -117,6 +119,7 @@ class PCCAtlasContext {
   std::vector<std::vector<std::vector<std::vector<size_t>>>> attrWidth_;
   std::vector<std::vector<std::vector<std::vector<size_t>>>> attrHeight_;
   std::vector<std::vector<PCCVideoAttribute>>                attrAuxFrames_;
+  PCCCuDepthMap                                              geoCuDepthMap_;
   std::vector<SubContext>                                    subContexts_;
   std::vector<unionPatch>                                    unionPatch_;
 };
@@ -162,6 +165,7 @@ class PCCContext : public PCCHighLevelSyntax {
     return atlasContexts_[atlId].getVideoAuxAttribute( attrIdx, partIdx );
   }
   PCCVideoAttribute& getVideoRawPointsAttribute() { return atlasContexts_[atlasIndex_].getVideoAuxAttribute( 0, 0 ); }
+  PCCCuDepthMap&     getGeometryCuDepthMap() { return atlasContexts_[atlasIndex_].getGeometryCuDepthMap(); }
 
   // fame context related functions
   std::vector<PCCAtlasFrameContext>::iterator begin() { return atlasContexts_[atlasIndex_].getFrameContexts().begin(); }
@@ -0,0 +1,74 @@
+/* The copyright in this software is being made available under the BSD
+ * License, included below. This software may be subject to other third party
+ * and contributor rights, including patent rights, and no such rights are
+ * granted under this license.
+ *
+ * Copyright (c) 2010-2017, ISO/IEC
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *  * Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *  * Neither the name of the ISO/IEC nor the names of its contributors may
+ *    be used to endorse or promote products derived from this software without
+ *    specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PCCCuDepthMap_h
+#define PCCCuDepthMap_h
+
+#include "PCCCommon.h"
+
+namespace pcc {
+
+// Final CU sizes of a coded video: log2 of the luma size of the CU covering each 8x8 block of each frame, in raster
+// order, 0 where no CU was recorded. Kept by the context between the geometry and the attribute encodes, which code
+// the same patches.
+class PCCCuDepthMap {
+ public:
+  PCCCuDepthMap() {}
+  ~PCCCuDepthMap() {}
+
+  void clear() {
+    width_  = 0;
+    height_ = 0;
+    frames_.clear();
+  }
+  void resize( size_t width, size_t height, size_t frameCount ) {
+    width_  = width;
+    height_ = height;
+    frames_.assign( frameCount, std::vector<uint8_t>( width * height, 0 ) );
+  }
+  bool                        empty() const { return frames_.empty(); }
+  size_t                      getWidth() const { return width_; }
+  size_t                      getHeight() const { return height_; }
+  size_t                      getFrameCount() const { return frames_.size(); }
+  std::vector<uint8_t>&       getFrame( size_t index ) { return frames_[index]; }
+  const std::vector<uint8_t>& getFrame( size_t index ) const { return frames_[index]; }
+
+ private:
+  size_t                            width_  = 0;  // in 8x8 blocks
+  size_t                            height_ = 0;
+  std::vector<std::vector<uint8_t>> frames_;
+};
+
+};  // namespace pcc
+
+#endif /* PCCCuDepthMap_h */
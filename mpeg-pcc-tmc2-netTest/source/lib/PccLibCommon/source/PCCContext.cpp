@@ -193,6 +193,7 @@ void PCCAtlasContext::clearVideoFrames() {
   geoWidth_.clear();
   geoHeight_.clear();
   geoAuxFrames_.clear();
+  geoCuDepthMap_.clear();
 
   // clearing structures for attributes
   for ( size_t attrIdx = 0; attrIdx < attrFrames_.size(); attrIdx++ ) {
@@ -72,6 +72,17 @@ class PCCEncoderParameters {
   std::string       colorSpaceConversionConfig_;
   std::string       inverseColorSpaceConversionConfig_;
   size_t            nbThread_;
+  size_t            videoEncoderParallelSegments_;
+  size_t            videoEncoderWppThreads_;
+  std::string       videoEncoderLFCNModelFile_;
+  double            videoEncoderLFCNTimeReduction_;
+  double            videoEncoderLFCNPictureTimeBudget_;
+  bool              videoEncoderLFCNEarlySplit_;
+  bool              videoEncoderLFCNCtuDepthRange_;
+  bool              videoEncoderLFCNNearLayerPrior_;
+  bool              videoEncoderLFCNGeometryPrior_;
+  bool              videoEncoderLFCNPatchAware_;
+  size_t            videoEncoderLFCNEmptyCtuFastPath_;
   size_t            frameCount_;
   size_t            groupOfFramesSize_;
   std::string       uncompressedDataPath_;
@@ -42,6 +42,7 @@ class PCCVideo;
 class PCCContext;
 class PCCVideoBitstream;
 class PCCLogger;
+class PCCCuDepthMap;
 
 class PCCVideoEncoder {
  public:
@@ -83,9 +84,46 @@ class PCCVideoEncoder {
                  const bool         patchColorSubsampling             = false );
 
   void setLogger( PCCLogger& logger ) { logger_ = &logger; }
+  void setOccupancyMapVideo( const PCCVideo<uint8_t, 3>& video, const size_t occupancyPrecision ) {
+    occupancyMapVideo_  = &video;
+    occupancyPrecision_ = occupancyPrecision;
+  }
+  void setParallelSegments( const size_t parallelSegments ) { parallelSegments_ = parallelSegments; }
+  void setWppThreads( const size_t wppThreads ) { wppThreads_ = wppThreads; }
+  void setLFCNModelFile( const std::string& lfcnModelFile ) { lfcnModelFile_ = lfcnModelFile; }
+  void setLFCNEarlySplit( const bool lfcnEarlySplit ) { lfcnEarlySplit_ = lfcnEarlySplit; }
+  void setLFCNCtuDepthRange( const bool lfcnCtuDepthRange ) { lfcnCtuDepthRange_ = lfcnCtuDepthRange; }
+  void setLFCNNearLayerPrior( const bool lfcnNearLayerPrior ) { lfcnNearLayerPrior_ = lfcnNearLayerPrior; }
+  void setLFCNEmptyCtuFastPath( const size_t lfcnEmptyCtuFastPath ) { lfcnEmptyCtuFastPath_ = lfcnEmptyCtuFastPath; }
+  void setCuDepthMap( PCCCuDepthMap* cuDepthMap ) { cuDepthMap_ = cuDepthMap; }
+  void setCuDepthPrior( const PCCCuDepthMap* cuDepthPrior ) { cuDepthPrior_ = cuDepthPrior; }
+  // block to patch maps of the frames of the context, to be set once they are generated from the occupancy map video
+  void setBlockToPatch( PCCContext& context, const size_t occupancyResolution );
+  void clearBlockToPatch() { blockToPatch_.clear(); }
+  void setLFCNTimeTarget( const double lfcnTimeReduction, const double lfcnPictureTimeBudget ) {
+    lfcnTimeReduction_     = lfcnTimeReduction;
+    lfcnPictureTimeBudget_ = lfcnPictureTimeBudget;
+  }
 
  private:
-  PCCLogger* logger_ = nullptr;
+  PCCLogger*                  logger_             = nullptr;
+  const PCCVideo<uint8_t, 3>* occupancyMapVideo_  = nullptr;
+  size_t                      occupancyPrecision_ = 4;
+  size_t                      parallelSegments_   = 1;
+  size_t                      wppThreads_         = 1;
+  std::string                 lfcnModelFile_      = {};
+  double                      lfcnTimeReduction_     = 0;
+  double                      lfcnPictureTimeBudget_ = 0;
+  bool                        lfcnEarlySplit_        = false;
+  bool                        lfcnCtuDepthRange_     = false;
+  bool                        lfcnNearLayerPrior_    = false;
+  size_t                      lfcnEmptyCtuFastPath_  = 0;
+  PCCCuDepthMap*              cuDepthMap_            = nullptr;
+  const PCCCuDepthMap*        cuDepthPrior_          = nullptr;
+  std::vector<const size_t*>  blockToPatch_          = {};
+  size_t                      blockToPatchWidth_     = 0;
+  size_t                      blockToPatchHeight_    = 0;
+  size_t                      occupancyResolution_   = 16;
 };
 
 };  // namespace pcc
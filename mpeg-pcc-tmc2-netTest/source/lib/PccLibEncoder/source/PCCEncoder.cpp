@@ -45,6 +45,8 @@
 #include "PCCChrono.h"
 #include "PCCEncoder.h"
 #include "PCCEncoderConstant.h"
+#include <functional>
+#include <mutex>
 #if defined( ENABLE_TBB )
 #include <tbb/tbb.h>
 #endif
@@ -117,6 +119,16 @@ int PCCEncoder::encode( const PCCGroupOfFrames& sources, PCCContext& context, PC
 
   PCCVideoEncoder videoEncoder;
   videoEncoder.setLogger( *logger_ );
+  videoEncoder.setParallelSegments( params_.videoEncoderParallelSegments_ );
+  videoEncoder.setWppThreads( params_.videoEncoderWppThreads_ );
+  videoEncoder.setLFCNModelFile( params_.videoEncoderLFCNModelFile_ );
+  videoEncoder.setLFCNTimeTarget( params_.videoEncoderLFCNTimeReduction_, params_.videoEncoderLFCNPictureTimeBudget_ );
+  videoEncoder.setLFCNEarlySplit( params_.videoEncoderLFCNEarlySplit_ );
+  videoEncoder.setLFCNCtuDepthRange( params_.videoEncoderLFCNCtuDepthRange_ );
+  // the near and far layers alternate in one stream only with two maps in a single stream
+  videoEncoder.setLFCNNearLayerPrior( params_.videoEncoderLFCNNearLayerPrior_ && params_.mapCountMinus1_ > 0 &&
+                                      !params_.multipleStreams_ );
+  videoEncoder.setLFCNEmptyCtuFastPath( params_.videoEncoderLFCNEmptyCtuFastPath_ );
   size_t            atlasIndex = context.getAtlasIndex();
   const size_t      pointCount = sources[0].getPointCount();
   auto&             sps        = context.getVps();
@@ -157,6 +169,7 @@ int PCCEncoder::encode( const PCCGroupOfFrames& sources, PCCContext& context, PC
                          8,                                         // internalBitDepth
                          false,                                     // useConversion
                          params_.keepIntermediateFiles_ );          // keepIntermediateFiles
+  videoEncoder.setOccupancyMapVideo( videoOccupancyMap, params_.occupancyPrecision_ );
   if ( params_.offsetLossyOM_ > 0 ) { modifyOccupancyMap( sources, context ); }
   if ( !params_.useRawPointsSeparateVideo_ && ( params_.rawPointsPatch_ || params_.lossyRawPointsPatch_ ) ) {
     markRawPatchLocationOccupancyMapVideo( context );
@@ -167,6 +180,7 @@ int PCCEncoder::encode( const PCCGroupOfFrames& sources, PCCContext& context, PC
   } else {
     generateBlockToPatchFromOccupancyMapVideo( context, params_.occupancyResolution_, params_.occupancyPrecision_ );
   }
+  if ( params_.videoEncoderLFCNPatchAware_ ) { videoEncoder.setBlockToPatch( context, params_.occupancyResolution_ ); }
 
   // Generate GEOMETRY IMAGE & dilation
   generateGeometryVideo( sources, context );
@@ -182,43 +196,96 @@ int PCCEncoder::encode( const PCCGroupOfFrames& sources, PCCContext& context, PC
   size_t nbyteGeoMP              = ( geometryMPVideoBitDepth <= 8 ) ? 1 : 2;
   size_t internalBitDepth        = params_.videoEncoderInternalBitdepth_;
   if ( params_.rawPointsPatch_ ) { internalBitDepth = geometryVideoBitDepth; }
-  auto&       videoBitstreamD0 = params_.multipleStreams_ ? context.createVideoBitstream( VIDEO_GEOMETRY_D0 )
-                                                          : context.createVideoBitstream( VIDEO_GEOMETRY );
+  // HM loads the 3D motion and PCC RDO side information into process globals, so the encodes using it must not
+  // overlap.
+  std::mutex motionSideInfoMutex;
+  auto       lockMotionSideInfo = [&]() {
+    return ( params_.use3dmc_ || params_.usePccRDO_ ) ? std::unique_lock<std::mutex>( motionSideInfoMutex )
+                                                      : std::unique_lock<std::mutex>();
+  };
+  if ( params_.multipleStreams_ && params_.lossyRawPointsPatch_ ) {
+    std::cout << "Error: lossyRawPointsPatch has not been implemented for "
+                 "absoluteD1_ = 0 as "
+                 "yet. Exiting... "
+              << std::endl;
+    std::exit( -1 );
+  }
+  auto&      asps              = context.getAtlasSequenceParameterSet( atlasIndex );
+  const bool useAuxiliaryVideo = asps.getRawPatchEnabledFlag() && asps.getAuxiliaryVideoEnabledFlag();
+  if ( useAuxiliaryVideo ) {
+    placeAuxiliaryPointsTiles( context );
+    generateRawPointsGeometryVideo( context );
+  }
+
+  // D0, an absolute D1 and the auxiliary geometry only read the shared context, so they are encoded as
+  // independent tasks; a predictive D1 is chained after D0 as it is formed from the reconstructed D0. All the
+  // bitstreams are created first: createVideoBitstream() appends to a vector and would invalidate the
+  // references used by the running tasks.
+  const PCCVideoType geometryType = params_.multipleStreams_ ? VIDEO_GEOMETRY_D0 : VIDEO_GEOMETRY;
+  context.createVideoBitstream( geometryType );
+  if ( params_.multipleStreams_ ) { context.createVideoBitstream( VIDEO_GEOMETRY_D1 ); }
+  if ( useAuxiliaryVideo ) { context.createVideoBitstream( VIDEO_GEOMETRY_RAW ); }
+  auto&       videoBitstreamD0 = context.getVideoBitstream( geometryType );
   auto&       videoGeometry    = context.getVideoGeometryMultiple()[0];
   std::string geometryConfigFile =
       params_.multipleStreams_
           ? params_.geometry0Config_
           : ( params_.mapCountMinus1_ == 0 ? getEncoderConfig1L( params_.geometryConfig_ ) : params_.geometryConfig_ );
-  videoEncoder.compress( videoGeometry,                             // video
-                         path.str(),                                // path
-                         params_.geometryQP_ + params_.deltaQPD0_,  // QP
-                         videoBitstreamD0,                          // bitstream
-                         geometryConfigFile,                        // config file
-                         params_.videoEncoderGeometryPath_,         // encoder path
-                         params_.videoEncoderGeometryCodecId_,      // Codec id
-                         params_.byteStreamVideoCoderGeometry_,     // byteStreamVideoCoder
-                         context,                                   // context
-                         nbyteGeo,                                  // nbyte
-                         false,                                     // use444CodecIo
-                         params_.use3dmc_,                          // use3dmv
-                         params_.usePccRDO_,                        // usePccRDO
-                         params_.shvcLayerIndex_,                   // SHVC layer index
-                         params_.shvcRateX_,                        // SHVC rate X
-                         params_.shvcRateY_,                        // SHVC rate Y
-                         internalBitDepth,                          // internalBitDepth
-                         false,                                     // useConversion
-                         params_.keepIntermediateFiles_ );          // keep intermediate
-  size_t sizeGeometryVideo = videoBitstreamD0.size();
-  std::cout << "sizeGeometryVideo: " << sizeGeometryVideo << std::endl;
-  if ( params_.multipleStreams_ ) {
-    if ( params_.lossyRawPointsPatch_ ) {
-      std::cout << "Error: lossyRawPointsPatch has not been implemented for "
-                   "absoluteD1_ = 0 as "
-                   "yet. Exiting... "
-                << std::endl;
-      std::exit( -1 );
-    }
-    if ( !params_.absoluteD1_ ) {
+  auto compressGeometryD1 = [&]( PCCVideoEncoder& encoder ) {
+    TRACE_PICTURE( "Geometry\n" );
+    TRACE_PICTURE( "MapIdx = 1, AuxiliaryVideoFlag = 0\n" );
+    auto  lock             = lockMotionSideInfo();
+    auto& videoGeometryD1  = context.getVideoGeometryMultiple()[1];
+    auto& videoBitstreamD1 = context.getVideoBitstream( VIDEO_GEOMETRY_D1 );
+    encoder.compress( videoGeometryD1,                           // video
+                      path.str(),                                // path
+                      params_.geometryQP_ + params_.deltaQPD1_,  // QP
+                      videoBitstreamD1,                          // bitstream
+                      params_.geometry1Config_,                  // config file
+                      params_.videoEncoderGeometryPath_,         // encoder path
+                      params_.videoEncoderGeometryCodecId_,      // Codec id
+                      params_.byteStreamVideoCoderGeometry_,     // byteStreamVideoCoder
+                      context,                                   // context
+                      nbyteGeo,                                  // nbyte
+                      false,                                     // use444CodecIo
+                      params_.use3dmc_,                          // use3dmv
+                      params_.usePccRDO_,                        // usePccRDO
+                      params_.shvcLayerIndex_,                   // SHVC layer index
+                      params_.shvcRateX_,                        // SHVC rate X
+                      params_.shvcRateY_,                        // SHVC rate Y
+                      internalBitDepth,                          // internalBitDepth
+                      false,                                     // useConversion
+                      params_.keepIntermediateFiles_ );          // keep intermediate
+  };
+  std::vector<std::function<void()>> geometryTasks;
+  geometryTasks.push_back( [&] {
+    PCCVideoEncoder encoder = videoEncoder;
+    // the final CUs of the first geometry video guide the attribute encode
+    if ( params_.videoEncoderLFCNGeometryPrior_ ) { encoder.setCuDepthMap( &context.getGeometryCuDepthMap() ); }
+    {
+      auto lock = lockMotionSideInfo();
+      encoder.compress( videoGeometry,                             // video
+                        path.str(),                                // path
+                        params_.geometryQP_ + params_.deltaQPD0_,  // QP
+                        videoBitstreamD0,                          // bitstream
+                        geometryConfigFile,                        // config file
+                        params_.videoEncoderGeometryPath_,         // encoder path
+                        params_.videoEncoderGeometryCodecId_,      // Codec id
+                        params_.byteStreamVideoCoderGeometry_,     // byteStreamVideoCoder
+                        context,                                   // context
+                        nbyteGeo,                                  // nbyte
+                        false,                                     // use444CodecIo
+                        params_.use3dmc_,                          // use3dmv
+                        params_.usePccRDO_,                        // usePccRDO
+                        params_.shvcLayerIndex_,                   // SHVC layer index
+                        params_.shvcRateX_,                        // SHVC rate X
+                        params_.shvcRateY_,                        // SHVC rate Y
+                        internalBitDepth,                          // internalBitDepth
+                        false,                                     // useConversion
+                        params_.keepIntermediateFiles_ );          // keep intermediate
+    }
+    encoder.setCuDepthMap( nullptr );
+    if ( params_.multipleStreams_ && !params_.absoluteD1_ ) {
       // Form differential video geometry1
       for ( size_t f = 0; f < frames.size(); ++f ) {
         auto& frame1 = context.getVideoGeometryMultiple()[1].getFrame( f );
@@ -226,67 +293,55 @@ int PCCEncoder::encode( const PCCGroupOfFrames& sources, PCCContext& context, PC
         dilate3DPadding( sources[f], frames[f], frames[f].getTitleFrameContext(), frame1,
                          videoOccupancyMap.getFrame( f ) );
       }
+      compressGeometryD1( encoder );
     }
-
-    // Compress geometry1
-    TRACE_PICTURE( "Geometry\n" );
-    TRACE_PICTURE( "MapIdx = 1, AuxiliaryVideoFlag = 0\n" );
-    auto& videoGeometryD1  = context.getVideoGeometryMultiple()[1];
-    auto& videoBitstreamD1 = context.createVideoBitstream( VIDEO_GEOMETRY_D1 );
-    videoEncoder.compress( videoGeometryD1,                           // video
-                           path.str(),                                // path
-                           params_.geometryQP_ + params_.deltaQPD1_,  // QP
-                           videoBitstreamD1,                          // bitstream
-                           params_.geometry1Config_,                  // config file
-                           params_.videoEncoderGeometryPath_,         // encoder path
-                           params_.videoEncoderGeometryCodecId_,      // Codec id
-                           params_.byteStreamVideoCoderGeometry_,     // byteStreamVideoCoder
-                           context,                                   // context
-                           nbyteGeo,                                  // nbyte
-                           false,                                     // use444CodecIo
-                           params_.use3dmc_,                          // use3dmv
-                           params_.usePccRDO_,                        // usePccRDO
-                           params_.shvcLayerIndex_,                   // SHVC layer index
-                           params_.shvcRateX_,                        // SHVC rate X
-                           params_.shvcRateY_,                        // SHVC rate Y
-                           internalBitDepth,                          // internalBitDepth
-                           false,                                     // useConversion
-                           params_.keepIntermediateFiles_ );          // keep intermediate
-    size_t sizeGeometryVideoD1 = videoBitstreamD1.size();
+  } );
+  if ( params_.multipleStreams_ && params_.absoluteD1_ ) {
+    geometryTasks.push_back( [&] {
+      PCCVideoEncoder encoder = videoEncoder;
+      compressGeometryD1( encoder );
+    } );
+  }
+  if ( useAuxiliaryVideo ) {
+    geometryTasks.push_back( [&] {
+      TRACE_PICTURE( "MapIdx = 0, AuxiliaryVideoFlag = 1\n" );
+      std::cout << "*******Video: Aux (Geometry) ********" << std::endl;
+      PCCVideoEncoder encoder                         = videoEncoder;
+      encoder.setLFCNNearLayerPrior( false );
+      auto&           videoRawPointsGeometryBitstream = context.getVideoBitstream( VIDEO_GEOMETRY_RAW );
+      auto&           videoRawPointsGeometry          = context.getVideoRawPointsGeometry();
+      encoder.compress( videoRawPointsGeometry,                 // video,
+                        path.str(),                             // path,
+                        params_.auxGeometryQP_,                 // qp,
+                        videoRawPointsGeometryBitstream,        // bitstream,
+                        params_.geometryAuxVideoConfig_,        // encoderConfig,
+                        params_.videoEncoderGeometryPath_,      // encoderPath,
+                        params_.videoEncoderGeometryCodecId_,   // codecId,
+                        params_.byteStreamVideoCoderGeometry_,  // byteStreamVideoCoder,
+                        context,                                // context
+                        nbyteGeoMP,                             // nbyte
+                        false,                                  // use444CodecIo
+                        false,                                  // use3dmv
+                        false,                                  // usePccRDO
+                        params_.shvcLayerIndex_,                // SHVC layer index
+                        params_.shvcRateX_,                     // SHVC rate X
+                        params_.shvcRateY_,                     // SHVC rate Y
+                        internalBitDepth,                       // internalBitDepth
+                        false,                                  // useConversion
+                        params_.keepIntermediateFiles_ );       // keepIntermediateFiles
+    } );
+  }
+  runVideoEncodeTasks( geometryTasks );
+  size_t sizeGeometryVideo = videoBitstreamD0.size();
+  std::cout << "sizeGeometryVideo: " << sizeGeometryVideo << std::endl;
+  if ( params_.multipleStreams_ ) {
+    size_t sizeGeometryVideoD1 = context.getVideoBitstream( VIDEO_GEOMETRY_D1 ).size();
     std::cout << "sizeGeometryVideoD1: " << sizeGeometryVideoD1 << std::endl;
     std::cout << "geometryVideo ->" << ( sizeGeometryVideo + sizeGeometryVideoD1 ) << "=" << sizeGeometryVideo << "+"
               << sizeGeometryVideoD1 << " B ("
               << ( ( sizeGeometryVideo + sizeGeometryVideoD1 ) * 8.0 ) / ( 2 * frames.size() * pointCount ) << " bpp)"
               << std::endl;
   }
-  auto& asps = context.getAtlasSequenceParameterSet( atlasIndex );
-  if ( asps.getRawPatchEnabledFlag() && asps.getAuxiliaryVideoEnabledFlag() ) {
-    TRACE_PICTURE( "MapIdx = 0, AuxiliaryVideoFlag = 1\n" );
-    std::cout << "*******Video: Aux (Geometry) ********" << std::endl;
-    placeAuxiliaryPointsTiles( context );
-    auto& videoRawPointsGeometryBitstream = context.createVideoBitstream( VIDEO_GEOMETRY_RAW );
-    generateRawPointsGeometryVideo( context );
-    auto& videoRawPointsGeometry = context.getVideoRawPointsGeometry();
-    videoEncoder.compress( videoRawPointsGeometry,                 // video,
-                           path.str(),                             // path,
-                           params_.auxGeometryQP_,                 // qp,
-                           videoRawPointsGeometryBitstream,        // bitstream,
-                           params_.geometryAuxVideoConfig_,        // encoderConfig,
-                           params_.videoEncoderGeometryPath_,      // encoderPath,
-                           params_.videoEncoderGeometryCodecId_,   // codecId,
-                           params_.byteStreamVideoCoderGeometry_,  // byteStreamVideoCoder,
-                           context,                                // context
-                           nbyteGeoMP,                             // nbyte
-                           false,                                  // use444CodecIo
-                           false,                                  // use3dmv
-                           false,                                  // usePccRDO
-                           params_.shvcLayerIndex_,                // SHVC layer index
-                           params_.shvcRateX_,                     // SHVC rate X
-                           params_.shvcRateY_,                     // SHVC rate Y
-                           internalBitDepth,                       // internalBitDepth
-                           false,                                  // useConversion
-                           params_.keepIntermediateFiles_ );       // keepIntermediateFiles
-  }
   // Tile summary
   printf( "****TileInfo***Summary******************\n" );
   fflush( stdout );
@@ -425,8 +480,16 @@ int PCCEncoder::encode( const PCCGroupOfFrames& sources, PCCContext& context, PC
     // ENCODE ATTRIBUTE IMAGE
     TRACE_PICTURE( "Attribute\n" );
     std::cout << "attribute video " << std::endl;
-    auto&        videoBitstream = params_.multipleStreams_ ? context.createVideoBitstream( VIDEO_ATTRIBUTE_T0 )
-                                                           : context.createVideoBitstream( VIDEO_ATTRIBUTE );
+    // Same task layout as the geometry: T0, an absolute T1 and the auxiliary attribute are independent, a
+    // predictive T1 is chained after T0.
+    const PCCVideoType attributeType = params_.multipleStreams_ ? VIDEO_ATTRIBUTE_T0 : VIDEO_ATTRIBUTE;
+    context.createVideoBitstream( attributeType );
+    if ( params_.multipleStreams_ ) { context.createVideoBitstream( VIDEO_ATTRIBUTE_T1 ); }
+    if ( useAuxiliaryVideo ) {
+      context.createVideoBitstream( VIDEO_ATTRIBUTE_RAW );
+      generateRawPointsAttributeVideo( context );
+    }
+    auto&        videoBitstream = context.getVideoBitstream( attributeType );
     const size_t nbyteAtt       = 1;
     int attrPartitionIndex      = sps.getAttributeInformation( atlasIndex ).getAttributeDimensionPartitionsMinus1( 0 );
     int attrTypeId              = sps.getAttributeInformation( atlasIndex ).getAttributeTypeId( 0 );
@@ -437,36 +500,68 @@ int PCCEncoder::encode( const PCCGroupOfFrames& sources, PCCContext& context, PC
                                                                : params_.attribute0Config_ )
                               : ( params_.mapCountMinus1_ == 0 ? getEncoderConfig1L( params_.attributeConfig_ )
                                                                : params_.attributeConfig_ );
-    videoEncoder.compress( context.getVideoAttributesMultiple()[0],         // video,
-                           path.str(),                                      // path
-                           params_.attributeQP_ + params_.deltaQPT0_,       // qp
-                           videoBitstream,                                  // bitstream
-                           encoderConfig0,                                  // encoderConfig
-                           params_.videoEncoderAttributePath_,              // encoderPath
-                           params_.videoEncoderAttributeCodecId_,           // codecId
-                           params_.byteStreamVideoCoderAttribute_,          // byteStreamVideoCoder
-                           context,                                         // context
-                           nbyteAtt,                                        // nbyte
-                           params_.attributeVideo444_,                      // use444CodecIo
-                           params_.use3dmc_,                                // use3dmv
-                           params_.usePccRDO_,                              // usePccRDO
-                           params_.shvcLayerIndex_,                         // SHVC layer index
-                           params_.shvcRateX_,                              // SHVC rate X
-                           params_.shvcRateY_,                              // SHVC rate Y
-                           params_.rawPointsPatch_ ? 8 : internalBitDepth,  // internalBitDepth
-                           !params_.rawPointsPatch_,                        // useConversion
-                           params_.keepIntermediateFiles_,                  // keepIntermediateFiles
-                           params_.colorSpaceConversionConfig_,             // colorSpaceConversionConfig
-                           params_.inverseColorSpaceConversionConfig_,      // inverseColorSpaceConversionConfig
-                           params_.colorSpaceConversionPath_ );             // colorSpaceConversionPath
-
-    auto sizeAttributeVideo = videoBitstream.size();
-    std::cout << "attribute video ->" << sizeAttributeVideo << " B ("
-              << ( sizeAttributeVideo * 8.0 ) / ( 2 * frames.size() * pointCount ) << " bpp)" << std::endl;
-
-    if ( params_.multipleStreams_ ) {
-      // Form differential video attribute1
-      if ( !params_.absoluteT1_ ) {
+    auto compressAttributeT1 = [&]( PCCVideoEncoder& encoder ) {
+      TRACE_PICTURE( "Attribute\n" );
+      TRACE_PICTURE( "AttrIdx = 0, AttrPartIdx = %d, AttrTypeID = %d, MapIdx = 1, AuxiliaryVideoFlag = 0\n",
+                     attrPartitionIndex, attrTypeId );
+      auto  lock             = lockMotionSideInfo();
+      auto& videoBitstreamT1 = context.getVideoBitstream( VIDEO_ATTRIBUTE_T1 );
+      auto  encoderConfig1 =
+          params_.mapCountMinus1_ == 0 ? getEncoderConfig1L( params_.attributeConfig_ ) : params_.attribute1Config_;
+      encoder.compress( context.getVideoAttributesMultiple()[1],         // video,
+                        path.str(),                                      // path
+                        params_.attributeQP_ + params_.deltaQPT1_,       // qp
+                        videoBitstreamT1,                                // bitstream
+                        encoderConfig1,                                  // encoderConfig
+                        params_.videoEncoderAttributePath_,              // encoderPath
+                        params_.videoEncoderAttributeCodecId_,           // codecId
+                        params_.byteStreamVideoCoderAttribute_,          // byteStreamVideoCoder
+                        context,                                         // context
+                        nbyteAtt,                                        // nbyte
+                        params_.attributeVideo444_,                      // use444CodecIo
+                        params_.use3dmc_,                                // use3dmv
+                        params_.usePccRDO_,                              // usePccRDO
+                        params_.shvcLayerIndex_,                         // SHVC layer index
+                        params_.shvcRateX_,                              // SHVC rate X
+                        params_.shvcRateY_,                              // SHVC rate Y
+                        params_.rawPointsPatch_ ? 8 : internalBitDepth,  // internalBitDepth
+                        !params_.rawPointsPatch_,                        // useConversion
+                        params_.keepIntermediateFiles_,                  // keepIntermediateFiles
+                        params_.colorSpaceConversionConfig_,             // colorSpaceConversionConfig
+                        params_.inverseColorSpaceConversionConfig_,      // inverseColorSpaceConversionConfig
+                        params_.colorSpaceConversionPath_ );             // keepIntermediateFiles
+    };
+    if ( params_.videoEncoderLFCNGeometryPrior_ ) { videoEncoder.setCuDepthPrior( &context.getGeometryCuDepthMap() ); }
+    std::vector<std::function<void()>> attributeTasks;
+    attributeTasks.push_back( [&] {
+      PCCVideoEncoder encoder = videoEncoder;
+      {
+        auto lock = lockMotionSideInfo();
+        encoder.compress( context.getVideoAttributesMultiple()[0],         // video,
+                          path.str(),                                      // path
+                          params_.attributeQP_ + params_.deltaQPT0_,       // qp
+                          videoBitstream,                                  // bitstream
+                          encoderConfig0,                                  // encoderConfig
+                          params_.videoEncoderAttributePath_,              // encoderPath
+                          params_.videoEncoderAttributeCodecId_,           // codecId
+                          params_.byteStreamVideoCoderAttribute_,          // byteStreamVideoCoder
+                          context,                                         // context
+                          nbyteAtt,                                        // nbyte
+                          params_.attributeVideo444_,                      // use444CodecIo
+                          params_.use3dmc_,                                // use3dmv
+                          params_.usePccRDO_,                              // usePccRDO
+                          params_.shvcLayerIndex_,                         // SHVC layer index
+                          params_.shvcRateX_,                              // SHVC rate X
+                          params_.shvcRateY_,                              // SHVC rate Y
+                          params_.rawPointsPatch_ ? 8 : internalBitDepth,  // internalBitDepth
+                          !params_.rawPointsPatch_,                        // useConversion
+                          params_.keepIntermediateFiles_,                  // keepIntermediateFiles
+                          params_.colorSpaceConversionConfig_,             // colorSpaceConversionConfig
+                          params_.inverseColorSpaceConversionConfig_,      // inverseColorSpaceConversionConfig
+                          params_.colorSpaceConversionPath_ );             // colorSpaceConversionPath
+      }
+      if ( params_.multipleStreams_ && !params_.absoluteT1_ ) {
+        // Form differential video attribute1
         for ( size_t f = 0; f < frames.size(); ++f ) {
           auto& frame0 = context.getVideoAttributesMultiple()[0].getFrame( f );
           auto& frame1 = context.getVideoAttributesMultiple()[1].getFrame( f );
@@ -479,75 +574,64 @@ int PCCEncoder::encode( const PCCGroupOfFrames& sources, PCCContext& context, PC
           }
         }
         std::cout << "attribute prediction done " << std::endl;
+        compressAttributeT1( encoder );
       }
+    } );
+    if ( params_.multipleStreams_ && params_.absoluteT1_ ) {
+      attributeTasks.push_back( [&] {
+        PCCVideoEncoder encoder = videoEncoder;
+        compressAttributeT1( encoder );
+      } );
+    }
+    if ( useAuxiliaryVideo ) {
+      attributeTasks.push_back( [&] {
+        TRACE_PICTURE( "Attribute\n" );
+        TRACE_PICTURE( "AttrIdx = 0, AttrPartIdx = %d, AttrTypeID = %d, MapIdx = 0, AuxiliaryVideoFlag = 1\n",
+                       attrPartitionIndex, attrTypeId );
+        std::cout << "*******Video: Aux (Attribute) ********" << std::endl;
+        PCCVideoEncoder encoder                 = videoEncoder;
+        encoder.setLFCNNearLayerPrior( false );
+        encoder.setCuDepthPrior( nullptr );
+        auto&           videoBitstreamMP        = context.getVideoBitstream( VIDEO_ATTRIBUTE_RAW );
+        auto&           videoRawPointsAttribute = context.getVideoRawPointsAttribute();
+        const size_t    nByteAttMP              = 1;
+        encoder.compress( videoRawPointsAttribute,                     // video,
+                          path.str(),                                  // path
+                          params_.auxAttributeQP_,                     // qp
+                          videoBitstreamMP,                            // bitstream
+                          params_.attributeAuxVideoConfig_,            // encoderConfig
+                          params_.videoEncoderAttributePath_,          // encoderPath
+                          params_.videoEncoderAttributeCodecId_,       // codecId
+                          params_.byteStreamVideoCoderAttribute_,      // byteStreamVideoCoder
+                          context,                                     // context
+                          nByteAttMP,                                  // nbyte
+                          params_.attributeVideo444_,                  // use444CodecIo
+                          false,                                       // use3dmv
+                          false,                                       // usePccRDO
+                          params_.shvcLayerIndex_,                     // SHVC layer index
+                          params_.shvcRateX_,                          // SHVC rate X
+                          params_.shvcRateY_,                          // SHVC rate Y
+                          10,                                          // internalBitDepth
+                          !params_.rawPointsPatch_,                    // useConversion
+                          params_.keepIntermediateFiles_,              // keepIntermediateFiles
+                          params_.colorSpaceConversionConfig_,         // colorSpaceConversionConfig
+                          params_.inverseColorSpaceConversionConfig_,  // inverseColorSpaceConversionConfig
+                          params_.colorSpaceConversionPath_ );         // colorSpaceConversionPath
+      } );
+    }
+    runVideoEncodeTasks( attributeTasks );
 
-      // compress attribute1
-      TRACE_PICTURE( "Attribute\n" );
-      TRACE_PICTURE( "AttrIdx = 0, AttrPartIdx = %d, AttrTypeID = %d, MapIdx = 1, AuxiliaryVideoFlag = 0\n",
-                     attrPartitionIndex, attrTypeId );
-      auto& videoBitstreamT1 = context.createVideoBitstream( VIDEO_ATTRIBUTE_T1 );
-      auto  encoderConfig1 =
-          params_.mapCountMinus1_ == 0 ? getEncoderConfig1L( params_.attributeConfig_ ) : params_.attribute1Config_;
-      videoEncoder.compress( context.getVideoAttributesMultiple()[1],         // video,
-                             path.str(),                                      // path
-                             params_.attributeQP_ + params_.deltaQPT1_,       // qp
-                             videoBitstreamT1,                                // bitstream
-                             encoderConfig1,                                  // encoderConfig
-                             params_.videoEncoderAttributePath_,              // encoderPath
-                             params_.videoEncoderAttributeCodecId_,           // codecId
-                             params_.byteStreamVideoCoderAttribute_,          // byteStreamVideoCoder
-                             context,                                         // context
-                             nbyteAtt,                                        // nbyte
-                             params_.attributeVideo444_,                      // use444CodecIo
-                             params_.use3dmc_,                                // use3dmv
-                             params_.usePccRDO_,                              // usePccRDO
-                             params_.shvcLayerIndex_,                         // SHVC layer index
-                             params_.shvcRateX_,                              // SHVC rate X
-                             params_.shvcRateY_,                              // SHVC rate Y
-                             params_.rawPointsPatch_ ? 8 : internalBitDepth,  // internalBitDepth
-                             !params_.rawPointsPatch_,                        // useConversion
-                             params_.keepIntermediateFiles_,                  // keepIntermediateFiles
-                             params_.colorSpaceConversionConfig_,             // colorSpaceConversionConfig
-                             params_.inverseColorSpaceConversionConfig_,      // inverseColorSpaceConversionConfig
-                             params_.colorSpaceConversionPath_ );             // keepIntermediateFiles
-      size_t sizeAttributeVideoT1 = videoBitstreamT1.size();
+    auto sizeAttributeVideo = videoBitstream.size();
+    std::cout << "attribute video ->" << sizeAttributeVideo << " B ("
+              << ( sizeAttributeVideo * 8.0 ) / ( 2 * frames.size() * pointCount ) << " bpp)" << std::endl;
+    if ( params_.multipleStreams_ ) {
+      size_t sizeAttributeVideoT1 = context.getVideoBitstream( VIDEO_ATTRIBUTE_T1 ).size();
       std::cout << "attribute video ->" << ( sizeAttributeVideo + sizeAttributeVideoT1 ) << "=" << sizeAttributeVideo
                 << "+" << sizeAttributeVideoT1 << " B ("
                 << ( ( sizeAttributeVideo + sizeAttributeVideoT1 ) * 8.0 ) / ( 2 * frames.size() * pointCount )
                 << " bpp)" << std::endl;
     }
-
-    if ( asps.getRawPatchEnabledFlag() && asps.getAuxiliaryVideoEnabledFlag() ) {
-      TRACE_PICTURE( "Attribute\n" );
-      TRACE_PICTURE( "AttrIdx = 0, AttrPartIdx = %d, AttrTypeID = %d, MapIdx = 0, AuxiliaryVideoFlag = 1\n",
-                     attrPartitionIndex, attrTypeId );
-      std::cout << "*******Video: Aux (Attribute) ********" << std::endl;
-      auto& videoBitstreamMP = context.createVideoBitstream( VIDEO_ATTRIBUTE_RAW );
-      generateRawPointsAttributeVideo( context );
-      auto&        videoRawPointsAttribute = context.getVideoRawPointsAttribute();
-      const size_t nByteAttMP              = 1;
-      videoEncoder.compress( videoRawPointsAttribute,                     // video,
-                             path.str(),                                  // path
-                             params_.auxAttributeQP_,                     // qp
-                             videoBitstreamMP,                            // bitstream
-                             params_.attributeAuxVideoConfig_,            // encoderConfig
-                             params_.videoEncoderAttributePath_,          // encoderPath
-                             params_.videoEncoderAttributeCodecId_,       // codecId
-                             params_.byteStreamVideoCoderAttribute_,      // byteStreamVideoCoder
-                             context,                                     // context
-                             nByteAttMP,                                  // nbyte
-                             params_.attributeVideo444_,                  // use444CodecIo
-                             false,                                       // use3dmv
-                             false,                                       // usePccRDO
-                             params_.shvcLayerIndex_,                     // SHVC layer index
-                             params_.shvcRateX_,                          // SHVC rate X
-                             params_.shvcRateY_,                          // SHVC rate Y
-                             10,                                          // internalBitDepth
-                             !params_.rawPointsPatch_,                    // useConversion
-                             params_.keepIntermediateFiles_,              // keepIntermediateFiles
-                             params_.colorSpaceConversionConfig_,         // colorSpaceConversionConfig
-                             params_.inverseColorSpaceConversionConfig_,  // inverseColorSpaceConversionConfig
-                             params_.colorSpaceConversionPath_ );         // colorSpaceConversionPath
+    if ( useAuxiliaryVideo ) {
       printf( "generateRawPointsAttributefromVideo \n" );
       for ( size_t fi = 0; fi < context.size(); fi++ ) { generateRawPointsAttributefromVideo( context, fi ); }
     }
@@ -729,6 +813,21 @@ int PCCEncoder::encode( const PCCGroupOfFrames& sources, PCCContext& context, PC
   return 0;
 }
 
+void PCCEncoder::runVideoEncodeTasks( const std::vector<std::function<void()>>& tasks ) {
+#if defined( ENABLE_TBB )
+  if ( params_.nbThread_ != 1 && tasks.size() > 1 ) {
+    tbb::task_arena limited( static_cast<int>( params_.nbThread_ ) );
+    limited.execute( [&] {
+      tbb::task_group group;
+      for ( const auto& task : tasks ) { group.run( task ); }
+      group.wait();
+    } );
+    return;
+  }
+#endif
+  for ( const auto& task : tasks ) { task(); }
+}
+
 void PCCEncoder::printMap( std::vector<bool> img, const size_t sizeU, const size_t sizeV ) {
   std::cout << std::endl;
   std::cout << "PrintMap size = " << sizeU << " x " << sizeV << std::endl;
@@ -135,6 +135,17 @@ PCCEncoderParameters::PCCEncoderParameters() {
   geometryAuxVideoConfig_                  = {};
   attributeAuxVideoConfig_                 = {};
   nbThread_                                = 1;
+  videoEncoderParallelSegments_            = 1;
+  videoEncoderWppThreads_                  = 1;
+  videoEncoderLFCNModelFile_               = "";
+  videoEncoderLFCNTimeReduction_           = 0.;
+  videoEncoderLFCNPictureTimeBudget_       = 0.;
+  videoEncoderLFCNEarlySplit_              = false;
+  videoEncoderLFCNCtuDepthRange_           = false;
+  videoEncoderLFCNNearLayerPrior_          = false;
+  videoEncoderLFCNGeometryPrior_           = false;
+  videoEncoderLFCNPatchAware_              = false;
+  videoEncoderLFCNEmptyCtuFastPath_        = 0;
   keepIntermediateFiles_                   = false;
   absoluteD1_                              = false;
   absoluteT1_                              = false;
@@ -335,6 +346,17 @@ void PCCEncoderParameters::print() {
   std::cout << "\t groupOfFramesSize                          " << groupOfFramesSize_ << std::endl;
   std::cout << "\t colorTransform                             " << colorTransform_ << std::endl;
   std::cout << "\t nbThread                                   " << nbThread_ << std::endl;
+  std::cout << "\t videoEncoderParallelSegments               " << videoEncoderParallelSegments_ << std::endl;
+  std::cout << "\t videoEncoderWppThreads                     " << videoEncoderWppThreads_ << std::endl;
+  std::cout << "\t videoEncoderLFCNModelFile                  " << videoEncoderLFCNModelFile_ << std::endl;
+  std::cout << "\t videoEncoderLFCNTimeReduction              " << videoEncoderLFCNTimeReduction_ << std::endl;
+  std::cout << "\t videoEncoderLFCNPictureTimeBudget          " << videoEncoderLFCNPictureTimeBudget_ << std::endl;
+  std::cout << "\t videoEncoderLFCNEarlySplit                 " << videoEncoderLFCNEarlySplit_ << std::endl;
+  std::cout << "\t videoEncoderLFCNCtuDepthRange              " << videoEncoderLFCNCtuDepthRange_ << std::endl;
+  std::cout << "\t videoEncoderLFCNNearLayerPrior             " << videoEncoderLFCNNearLayerPrior_ << std::endl;
+  std::cout << "\t videoEncoderLFCNGeometryPrior              " << videoEncoderLFCNGeometryPrior_ << std::endl;
+  std::cout << "\t videoEncoderLFCNPatchAware                 " << videoEncoderLFCNPatchAware_ << std::endl;
+  std::cout << "\t videoEncoderLFCNEmptyCtuFastPath           " << videoEncoderLFCNEmptyCtuFastPath_ << std::endl;
   std::cout << "\t keepIntermediateFiles                      " << keepIntermediateFiles_ << std::endl;
   std::cout << "\t multipleStreams                            " << multipleStreams_ << std::endl;
   std::cout << "\t multipleStreams                            " << multipleStreams_ << std::endl;
@@ -851,6 +873,25 @@ bool PCCEncoderParameters::check() {
     colorSpaceConversionConfig_        = "";
   }
 
+  if ( !videoEncoderLFCNModelFile_.empty() && !exist( videoEncoderLFCNModelFile_ ) ) {
+    ret = false;
+    std::cerr << "ERROR: videoEncoderLFCNModelFile not exist : " << videoEncoderLFCNModelFile_ << std::endl;
+  }
+  if ( videoEncoderLFCNTimeReduction_ < 0. || videoEncoderLFCNTimeReduction_ >= 1. ) {
+    ret = false;
+    std::cerr << "ERROR: videoEncoderLFCNTimeReduction must be in [0, 1) : " << videoEncoderLFCNTimeReduction_
+              << std::endl;
+  }
+  if ( videoEncoderLFCNPictureTimeBudget_ < 0. ) {
+    ret = false;
+    std::cerr << "ERROR: videoEncoderLFCNPictureTimeBudget must not be negative : "
+              << videoEncoderLFCNPictureTimeBudget_ << std::endl;
+  }
+  if ( videoEncoderLFCNEmptyCtuFastPath_ > 3 ) {
+    ret = false;
+    std::cerr << "ERROR: videoEncoderLFCNEmptyCtuFastPath must be in [0, 3] : "
+              << videoEncoderLFCNEmptyCtuFastPath_ << std::endl;
+  }
   if ( compressedStreamPath_.empty() ) {
     ret = false;
     std::cerr << "compressedStreamPath not set\n";
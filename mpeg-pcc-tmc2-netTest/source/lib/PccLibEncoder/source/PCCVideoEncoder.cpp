@@ -51,6 +51,26 @@ PCCVideoEncoder::PCCVideoEncoder() = default;
 
 PCCVideoEncoder::~PCCVideoEncoder() = default;
 
+void PCCVideoEncoder::setBlockToPatch( PCCContext& context, const size_t occupancyResolution ) {
+  blockToPatch_.clear();
+  blockToPatchWidth_   = 0;
+  blockToPatchHeight_  = 0;
+  occupancyResolution_ = occupancyResolution;
+  for ( size_t i = 0; i < context.size(); i++ ) {
+    auto&        frame  = context.getFrame( i ).getTitleFrameContext();
+    const size_t width  = frame.getWidth() / occupancyResolution;
+    const size_t height = frame.getHeight() / occupancyResolution;
+    if ( ( i > 0 && ( width != blockToPatchWidth_ || height != blockToPatchHeight_ ) ) ||
+         frame.getBlockToPatch().size() < width * height ) {
+      blockToPatch_.clear();
+      return;
+    }
+    blockToPatch_.push_back( frame.getBlockToPatch().data() );
+    blockToPatchWidth_  = width;
+    blockToPatchHeight_ = height;
+  }
+}
+
 template <typename T>
 void PCCVideoEncoder::patchColorSubsmple( PCCVideo<T, 3>&    video,
                                           PCCContext&        contexts,
@@ -379,6 +399,23 @@ bool PCCVideoEncoder::compress( PCCVideo<T, 3>&    video,
   params.shvcLayerIndex_              = shvcLayerIndex;
   params.shvcRateX_                   = shvcRateX;
   params.shvcRateY_                   = shvcRateY;
+  params.occupancyMapVideo_           = occupancyMapVideo_;
+  params.occupancyPrecision_          = occupancyPrecision_;
+  params.parallelSegments_            = parallelSegments_;
+  params.wppThreads_                  = wppThreads_;
+  params.lfcnModelFile_               = lfcnModelFile_;
+  params.lfcnTimeReduction_           = lfcnTimeReduction_;
+  params.lfcnPictureTimeBudget_       = lfcnPictureTimeBudget_;
+  params.lfcnEarlySplit_              = lfcnEarlySplit_;
+  params.lfcnCtuDepthRange_           = lfcnCtuDepthRange_;
+  params.lfcnNearLayerPrior_          = lfcnNearLayerPrior_;
+  params.lfcnEmptyCtuFastPath_        = lfcnEmptyCtuFastPath_;
+  params.cuDepthMap_                  = cuDepthMap_;
+  params.cuDepthPrior_                = cuDepthPrior_;
+  params.blockToPatch_                = blockToPatch_;
+  params.blockToPatchWidth_           = blockToPatchWidth_;
+  params.blockToPatchHeight_          = blockToPatchHeight_;
+  params.occupancyResolution_         = occupancyResolution_;
   printf( "Encode: video size = %zu x %zu num frames = %zu \n", video.getWidth(), video.getHeight(),
           video.getFrameCount() );
   fflush( stdout );
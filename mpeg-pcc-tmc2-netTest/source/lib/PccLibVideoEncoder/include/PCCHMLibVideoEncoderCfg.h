@@ -381,6 +381,14 @@ class PCCHMLibVideoEncoderCfg {
   std::vector<Int> m_tileColumnWidth;
   std::vector<Int> m_tileRowHeight;
   Bool             m_entropyCodingSyncEnabledFlag;
+  Int              m_wppThreads;
+  std::string      m_lfcnModelFile;
+  Double           m_lfcnTimeReduction;
+  Double           m_lfcnPictureTimeBudget;
+  Bool             m_lfcnEarlySplit;
+  Bool             m_lfcnCtuDepthRange;
+  Bool             m_lfcnNearLayerPrior;
+  UInt             m_lfcnEmptyCtuFastPath;
 
   Bool m_bUseConstrainedIntraPred;  ///< flag for using constrained intra
                                     /// prediction
@@ -35,6 +35,7 @@
 
 #include "PCCCommon.h"
 #include "PCCVideo.h"
+#include "PCCCuDepthMap.h"
 #include "PCCVideoBitstream.h"
 
 namespace pcc {
@@ -61,6 +62,37 @@ struct PCCVideoEncoderParameters {
   int32_t     shvcLayerIndex_              = 8;
   int32_t     shvcRateX_                   = 0;
   int32_t     shvcRateY_                   = 0;
+  // occupancy map video of the current GOF, shared with the encoder without going through intermediate files
+  const PCCVideo<uint8_t, 3>* occupancyMapVideo_  = nullptr;
+  size_t                      occupancyPrecision_ = 4;
+  // maximum number of independently decodable segments encoded concurrently, 1 encodes the video in one sequence
+  size_t                      parallelSegments_   = 1;
+  // number of CTU rows compressed concurrently with entropy coding sync (WPP), 1 keeps the configuration unchanged
+  size_t                      wppThreads_         = 1;
+  // LFCN model file replacing the compiled CU split models, empty to keep them
+  std::string                 lfcnModelFile_      = {};
+  // fraction of the full RDO CTU time saved by adapting the LFCN split thresholds, 0 keeps them fixed
+  double                      lfcnTimeReduction_     = 0;
+  // CTU compression time of a picture in ms the LFCN split thresholds adapt to, 0 off
+  double                      lfcnPictureTimeBudget_ = 0;
+  // split confidently predicted CUs without checking their modes
+  bool                        lfcnEarlySplit_        = false;
+  // bound the CU depths of each CTU by a predicted range
+  bool                        lfcnCtuDepthRange_     = false;
+  // bound the CUs of the far layer pictures by those of the near layer
+  bool                        lfcnNearLayerPrior_    = false;
+  // video types whose unoccupied CTUs are coded at depth 0 without mode search: 1 geometry, 2 attribute, 0 none
+  size_t                      lfcnEmptyCtuFastPath_  = 0;
+  // final CU sizes of the coded frames, recorded for the encoder of another video when set
+  PCCCuDepthMap*              cuDepthMap_            = nullptr;
+  // final CU sizes of the same frames in another video, bounding the CUs checked by the LFCN decision when set
+  const PCCCuDepthMap*        cuDepthPrior_          = nullptr;
+  // block to patch map of each atlas frame of the GOF (patch index + 1, 0 for padding), in blocks of
+  // occupancyResolution_ samples; the LFCN decision tells patch borders from patch interiors when set
+  std::vector<const size_t*>  blockToPatch_          = {};
+  size_t                      blockToPatchWidth_     = 0;
+  size_t                      blockToPatchHeight_    = 0;
+  size_t                      occupancyResolution_   = 16;
 };
 
 template <class T>
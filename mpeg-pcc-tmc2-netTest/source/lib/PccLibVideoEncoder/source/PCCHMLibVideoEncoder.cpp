@@ -36,6 +36,10 @@
 #include "PCCVideo.h"
 #include "PCCHMLibVideoEncoder.h"
 #include "PCCHMLibVideoEncoderImpl.h"
+#include <memory>
+#if defined( ENABLE_TBB )
+#include <tbb/tbb.h>
+#endif
 
 #ifdef SDMTEST  // MesksCode
 #include "TLibEncoder/SDMManner.h"
@@ -44,6 +48,54 @@
 
 using namespace pcc;
 
+// Length of the segments a video of frameCount frames is split into to be coded by up to workerCount HM
+// instances, 0 to code it as one sequence. Segments are made of whole independent periods and hold an even
+// number of frames, the two maps of a point cloud frame sharing one occupancy frame.
+static size_t getSegmentLength( const int independentLength, const size_t frameCount, const size_t workerCount ) {
+  if ( workerCount <= 1 || independentLength <= 0 ) { return 0; }
+  const size_t period = static_cast<size_t>( independentLength );
+  size_t       length = ( frameCount + workerCount - 1 ) / workerCount;
+  length              = ( ( length + period - 1 ) / period ) * period;
+  while ( length % 2 != 0 ) { length += period; }
+  return length < frameCount ? length : 0;
+}
+
+#ifdef SDMTEST  // MesksCode
+// Hands the frames [start, start + count) of the CU depth prior to one HM instance, and makes it record its own
+// final CUs when the caller keeps them. A prior of another size or length is dropped.
+static void cuDepthMapInit( pcc_hm::TEncLFCNContext&         context,
+                            const PCCVideoEncoderParameters& params,
+                            const size_t                     width,
+                            const size_t                     height,
+                            const size_t                     frameCount,
+                            const size_t                     start,
+                            const size_t                     count ) {
+  auto& cuDepthMap   = context.getCuDepthMap();
+  auto& cuDepthPrior = context.getCuDepthPrior();
+  cuDepthMap.destroy();
+  cuDepthPrior.destroy();
+  if ( params.cuDepthMap_ != nullptr ) { cuDepthMap.create( int( width ), int( height ), int( count ) ); }
+  const PCCCuDepthMap* prior = params.cuDepthPrior_;
+  if ( prior == nullptr || prior->getFrameCount() != frameCount ) { return; }
+  cuDepthPrior.create( int( width ), int( height ), int( count ) );
+  if ( size_t( cuDepthPrior.getWidth() ) != prior->getWidth() ||
+       size_t( cuDepthPrior.getHeight() ) != prior->getHeight() ) {
+    cuDepthPrior.destroy();
+    return;
+  }
+  for ( size_t i = 0; i < count; i++ ) { cuDepthPrior.getFrame( int( i ) ) = prior->getFrame( start + i ); }
+}
+
+// Copies the final CUs recorded by one HM instance to the frames of the caller from start.
+static void cuDepthMapStore( pcc_hm::TEncLFCNContext& context, PCCVideoEncoderParameters& params, const size_t start ) {
+  if ( params.cuDepthMap_ == nullptr ) { return; }
+  auto& cuDepthMap = context.getCuDepthMap();
+  for ( int i = 0; i < cuDepthMap.getNumFrames(); i++ ) {
+    params.cuDepthMap_->getFrame( start + i ) = cuDepthMap.getFrame( i );
+  }
+}
+#endif  // SDMTEST
+
 template <typename T>
 PCCHMLibVideoEncoder<T>::PCCHMLibVideoEncoder() {}
 template <typename T>
@@ -96,15 +148,105 @@ void PCCHMLibVideoEncoder<T>::encode( PCCVideo<T, 3>&            videoSrc,
 #endif
 
   if ( params.inputColourSpaceConvert_ ) { cmd << " --InputColourSpaceConvert=RGBtoGBR"; }
+  if ( params.wppThreads_ > 1 ) { cmd << " --WaveFrontSynchro=1 --WppThreads=" << params.wppThreads_; }
+  if ( !params.lfcnModelFile_.empty() ) { cmd << " --LFCNModelFile=" << params.lfcnModelFile_; }
+  if ( params.lfcnTimeReduction_ > 0 ) { cmd << " --LFCNTimeReduction=" << params.lfcnTimeReduction_; }
+  if ( params.lfcnPictureTimeBudget_ > 0 ) { cmd << " --LFCNPictureTimeBudget=" << params.lfcnPictureTimeBudget_; }
+  if ( params.lfcnEarlySplit_ ) { cmd << " --LFCNEarlySplit=1"; }
+  if ( params.lfcnCtuDepthRange_ ) { cmd << " --LFCNCtuDepthRange=1"; }
+  if ( params.lfcnNearLayerPrior_ ) { cmd << " --LFCNNearLayerPrior=1"; }
+  if ( params.lfcnEmptyCtuFastPath_ > 0 ) { cmd << " --LFCNEmptyCtuFastPath=" << params.lfcnEmptyCtuFastPath_; }
   std::cout << cmd.str() << std::endl;
 
 #ifdef SDMTEST  // MesksCode
-  occupancyDciInit( videoSrc.getWidth(), videoSrc.getHeight(), videoSrc.getFrameCount(), params.srcYuvFileName_ );
-#endif  // EXTRAFEATURES
+  OccupancyMapView occupancyView;
+  if ( params.occupancyMapVideo_ != nullptr ) {
+    const PCCVideo<uint8_t, 3>& occupancyMapVideo = *params.occupancyMapVideo_;
+    for ( size_t i = 0; i < occupancyMapVideo.getFrameCount(); i++ ) {
+      occupancyView.frames.push_back( occupancyMapVideo.getFrame( i ).getChannel( 0 ).data() );
+    }
+    occupancyView.width     = static_cast<int>( occupancyMapVideo.getWidth() );
+    occupancyView.height    = static_cast<int>( occupancyMapVideo.getHeight() );
+    occupancyView.precision = static_cast<int>( params.occupancyPrecision_ );
+  }
+  // the map only describes the videos of the atlas frame size, not the occupancy map or the auxiliary videos
+  if ( !params.blockToPatch_.empty() && params.blockToPatchWidth_ * params.occupancyResolution_ == width &&
+       params.blockToPatchHeight_ * params.occupancyResolution_ == height ) {
+    occupancyView.blockToPatch       = params.blockToPatch_;
+    occupancyView.blockToPatchWidth  = static_cast<int>( params.blockToPatchWidth_ );
+    occupancyView.blockToPatchHeight = static_cast<int>( params.blockToPatchHeight_ );
+    occupancyView.blockSize          = static_cast<int>( params.occupancyResolution_ );
+  }
+  if ( params.cuDepthMap_ != nullptr ) {
+    const size_t blockSize = size_t( 1 ) << CU_DEPTH_MAP_LOG2_UNIT;
+    params.cuDepthMap_->resize( ( width + blockSize - 1 ) / blockSize, ( height + blockSize - 1 ) / blockSize,
+                                frameCount );
+  }
+#endif  // SDMTEST
 
   PCCHMLibVideoEncoderImpl<T> encoder;                      // MesksCode
-  clock_t                     startClock = clock();
-  encoder.encode( videoSrc, cmd.str(), bitstream, videoRec );
+  if ( !encoder.configure( cmd.str() ) ) { return; }
+  const size_t segmentLength =
+      getSegmentLength( encoder.getIndependentSegmentLength(), frameCount, params.parallelSegments_ );
+  clock_t startClock = clock();
+  if ( segmentLength == 0 ) {
+#ifdef SDMTEST  // MesksCode
+    occupancyDciInit( encoder.getLFCNContext(), occupancyView, params.srcYuvFileName_ );
+    cuDepthMapInit( encoder.getLFCNContext(), params, width, height, frameCount, 0, frameCount );
+#endif  // SDMTEST
+    encoder.encode( videoSrc, bitstream, videoRec );
+#ifdef SDMTEST  // MesksCode
+    cuDepthMapStore( encoder.getLFCNContext(), params, 0 );
+#endif  // SDMTEST
+  } else {
+    // Every segment is coded as its own sequence by its own HM instance, the access units and the
+    // reconstructed frames are then concatenated in segment order.
+    const size_t                   segmentCount = ( frameCount + segmentLength - 1 ) / segmentLength;
+    std::vector<PCCVideo<T, 3>>    segmentRec( segmentCount );
+    std::vector<PCCVideoBitstream> segmentBitstream( segmentCount, PCCVideoBitstream( bitstream.type() ) );
+    printf( "Encode %zu segments of %zu frames \n", segmentCount, segmentLength );
+    auto encodeSegment = [&]( const size_t s ) {
+      const size_t   start = s * segmentLength;
+      const size_t   count = ( std::min )( segmentLength, frameCount - start );
+      PCCVideo<T, 3> segmentSrc;
+      segmentSrc.getFrames().assign( videoSrc.getFrames().begin() + start,
+                                     videoSrc.getFrames().begin() + start + count );
+      std::unique_ptr<PCCHMLibVideoEncoderImpl<T>> segmentEncoder;
+      if ( s > 0 ) {
+        segmentEncoder.reset( new PCCHMLibVideoEncoderImpl<T>() );
+        segmentEncoder->configure( cmd.str() );
+      }
+      PCCHMLibVideoEncoderImpl<T>& impl = s > 0 ? *segmentEncoder : encoder;
+#ifdef SDMTEST  // MesksCode
+      // picture POC uses occupancy frame POC / 2, segments start on an even frame
+      OccupancyMapView segmentView = occupancyView;
+      segmentView.frames.erase( segmentView.frames.begin(),
+                                segmentView.frames.begin() + ( std::min )( start / 2, segmentView.frames.size() ) );
+      segmentView.blockToPatch.erase(
+          segmentView.blockToPatch.begin(),
+          segmentView.blockToPatch.begin() + ( std::min )( start / 2, segmentView.blockToPatch.size() ) );
+      occupancyDciInit( impl.getLFCNContext(), segmentView, params.srcYuvFileName_ );
+      cuDepthMapInit( impl.getLFCNContext(), params, width, height, frameCount, start, count );
+#endif  // SDMTEST
+      impl.encode( segmentSrc, segmentBitstream[s], segmentRec[s] );
+#ifdef SDMTEST  // MesksCode
+      cuDepthMapStore( impl.getLFCNContext(), params, start );
+#endif  // SDMTEST
+    };
+#if defined( ENABLE_TBB )
+    tbb::task_arena limited( static_cast<int>( ( std::min )( params.parallelSegments_, segmentCount ) ) );
+    limited.execute( [&] { tbb::parallel_for( size_t( 0 ), segmentCount, encodeSegment ); } );
+#else
+    for ( size_t s = 0; s < segmentCount; s++ ) { encodeSegment( s ); }
+#endif
+    bitstream.vector().clear();
+    videoRec.clear();
+    for ( size_t s = 0; s < segmentCount; s++ ) {
+      bitstream.vector().insert( bitstream.vector().end(), segmentBitstream[s].vector().begin(),
+                                 segmentBitstream[s].vector().end() );
+      for ( auto& frame : segmentRec[s] ) { videoRec.getFrames().push_back( std::move( frame ) ); }
+    }
+  }
   clock_t endClock = clock();
   printf( "\nTotal Time: %12.3f sec. \n", ( endClock - startClock ) * 1.0 / CLOCKS_PER_SEC );       // MesksCode
 }
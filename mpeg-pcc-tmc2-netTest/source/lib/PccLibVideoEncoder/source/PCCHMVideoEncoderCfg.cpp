@@ -1011,6 +1011,14 @@ Bool PCCHMLibVideoEncoderCfg::parseCfg( Int argc, TChar* argv[] ) {
   ("TileRowHeightArray",                              cfg_RowHeight,                            cfg_RowHeight, "Array containing tile row height values in units of CTU")
   ("LFCrossTileBoundaryFlag",                         m_bLFCrossTileBoundaryFlag,                        true, "1: cross-tile-boundary loop filtering. 0:non-cross-tile-boundary loop filtering")
   ("WaveFrontSynchro",                                m_entropyCodingSyncEnabledFlag,                   false, "0: entropy coding sync disabled; 1 entropy coding sync enabled")
+  ("WppThreads",                                      m_wppThreads,                                         1, "Number of CTU rows compressed concurrently when entropy coding sync is enabled")
+  ("LFCNModelFile",                                   m_lfcnModelFile,                             string(""), "LFCN model file replacing the compiled CU split models, empty to use the compiled ones")
+  ("LFCNTimeReduction",                               m_lfcnTimeReduction,                                0.0, "Fraction of the full RDO CTU compression time saved by adapting the LFCN split thresholds after each picture, 0: fixed thresholds")
+  ("LFCNPictureTimeBudget",                           m_lfcnPictureTimeBudget,                            0.0, "CTU compression time of a picture in ms the LFCN split thresholds adapt to, overrides LFCNTimeReduction, 0: off")
+  ("LFCNEarlySplit",                                  m_lfcnEarlySplit,                                 false, "Split CUs whose LFCN output on pre-RDO features reaches the early split threshold without checking their modes")
+  ("LFCNCtuDepthRange",                               m_lfcnCtuDepthRange,                              false, "Bound the CU depths checked in each CTU by a range predicted from the original samples, the occupancy, the QP and the collocated CTU")
+  ("LFCNNearLayerPrior",                              m_lfcnNearLayerPrior,                             false, "Bound the CUs of the far layer pictures (odd POC) of geometry and attribute by the final CUs of their near layer picture")
+  ("LFCNEmptyCtuFastPath",                            m_lfcnEmptyCtuFastPath,                               0u, "Code the unoccupied CTUs at depth 0 without mode search (skip merge in P slices, planar in I slices) for these video types: 1 geometry, 2 attribute, 3 both")
   ("ScalingList",                                     m_useScalingListId,                    SCALING_LIST_OFF, "0/off: no scaling list, 1/default: default scaling lists, 2/file: scaling lists specified in ScalingListFile")
   ("ScalingListFile",                                 m_scalingListFileName,                       string(""), "Scaling list file name. Use an empty string to produce help.")
   ("SignHideFlag,-SBH",                               m_signDataHidingEnabledFlag,                                    true)
@@ -2547,6 +2555,10 @@ Void PCCHMLibVideoEncoderCfg::xCheckParameter() {
                   "applied together, except in the High Throughput Intra 4:4:4 "
                   "16 profile" );
   }
+  xConfirmPara( m_wppThreads < 1, "WppThreads must be at least 1" );
+  xConfirmPara( m_lfcnTimeReduction < 0 || m_lfcnTimeReduction >= 1, "LFCNTimeReduction must be in the range of 0 to less than 1" );
+  xConfirmPara( m_lfcnPictureTimeBudget < 0, "LFCNPictureTimeBudget must not be negative" );
+  xConfirmPara( m_lfcnEmptyCtuFastPath > 3, "LFCNEmptyCtuFastPath must be in the range of 0 to 3" );
 
   xConfirmPara( m_iSourceWidth % TComSPS::getWinUnitX( m_chromaFormatIDC ) != 0,
                 "Picture width must be an integer multiple of the specified "
@@ -3457,6 +3469,17 @@ Void PCCHMLibVideoEncoderCfg::xPrintParameter() {
   const Int iWaveFrontSubstreams =
       m_entropyCodingSyncEnabledFlag ? ( m_iSourceHeight + m_uiMaxCUHeight - 1 ) / m_uiMaxCUHeight : 1;
   printf( " WaveFrontSynchro:%d WaveFrontSubstreams:%d", m_entropyCodingSyncEnabledFlag ? 1 : 0, iWaveFrontSubstreams );
+  if ( m_entropyCodingSyncEnabledFlag ) { printf( " WppThreads:%d", m_wppThreads ); }
+  if ( !m_lfcnModelFile.empty() ) { printf( " LFCNModelFile:%s", m_lfcnModelFile.c_str() ); }
+  if ( m_lfcnPictureTimeBudget > 0 ) {
+    printf( " LFCNPictureTimeBudget:%.1f", m_lfcnPictureTimeBudget );
+  } else if ( m_lfcnTimeReduction > 0 ) {
+    printf( " LFCNTimeReduction:%.2f", m_lfcnTimeReduction );
+  }
+  if ( m_lfcnEarlySplit ) { printf( " LFCNEarlySplit:1" ); }
+  if ( m_lfcnCtuDepthRange ) { printf( " LFCNCtuDepthRange:1" ); }
+  if ( m_lfcnNearLayerPrior ) { printf( " LFCNNearLayerPrior:1" ); }
+  if ( m_lfcnEmptyCtuFastPath ) { printf( " LFCNEmptyCtuFastPath:%u", m_lfcnEmptyCtuFastPath ); }
   printf( " ScalingList:%d ", m_useScalingListId );
   printf( "TMVPMode:%d ", m_TMVPModeId );
 #if ADAPTIVE_QP_SELECTION